@@ -0,0 +1,230 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferPool_h
+#define itkImageBufferPool_h
+
+#include "itkObject.h"
+#include "itkIntTypes.h"
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageBufferPool
+ * \brief Recycles the pixel buffers of the images.
+ *
+ * When the pool is enabled, ImportImageContainer allocates its large buffers
+ * from the pool, and gives them back to the pool instead of freeing them.
+ * A pipeline executed repeatedly, or iterative algorithms allocating images
+ * of the same sizes, then reuse the same memory instead of paying for a new
+ * allocation and its page faults at each update.
+ *
+ * The buffers are grouped in size classes, spaced by one eighth of a power
+ * of two, so that a buffer can be reused for a slightly smaller image. Only
+ * buffers of at least MinimumBufferSize bytes are pooled, and the pool
+ * keeps at most MaximumPooledSize bytes of released buffers. Only the
+ * trivial pixel types (scalars, and fixed size aggregates of scalars
+ * without constructors) are pooled.
+ *
+ * The buffers are allocated with new TElement[], and a released buffer is
+ * only reused for elements of the same type, so a buffer can always be
+ * freed with delete[] on its element type. When a container gives up the
+ * ownership of a pooled buffer (ContainerManageMemoryOff()), the buffer is
+ * detached from the pool and the application frees it as any other buffer.
+ *
+ * A buffer reused from the pool is not zero-filled unless the image asks for
+ * initialized pixels. New buffers are not touched by the allocation, so
+ * their pages are first touched by the threads of the filter writing them.
+ *
+ * The pool is enabled process-wide with SetEnabled(), or for the duration of
+ * an ImageBufferPool::EnabledScope:
+ * \code
+ * {
+ *   const itk::ImageBufferPool::EnabledScope poolScope;
+ *   filter->Update();
+ * }
+ * \endcode
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferPool : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(ImageBufferPool);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferPool;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferPool, Object);
+
+  /** There is a single pool per process: New() returns it. */
+  static Pointer
+  New();
+
+  /** Return the single instance of the pool. */
+  static Pointer
+  GetInstance();
+
+  /** Enable or disable the pool for the whole process. Disabled by default.
+   * Buffers allocated from the pool are given back to it even after it is
+   * disabled. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+
+  /** Enable the pool from its construction to its destruction. */
+  class ITKCommon_EXPORT EnabledScope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_ASSIGN(EnabledScope);
+
+    EnabledScope();
+    ~EnabledScope();
+  };
+
+  /** Whether elements of type TElement can be stored in pooled buffers. */
+  template <typename TElement>
+  static constexpr bool
+  IsPoolable()
+  {
+    return std::is_trivially_default_constructible<TElement>::value &&
+           std::is_trivially_destructible<TElement>::value && alignof(TElement) <= alignof(std::max_align_t);
+  }
+
+  /** Return a buffer of at least numberOfElements elements, or nullptr when
+   * its size is smaller than MinimumBufferSize. Throws
+   * MemoryAllocationError when the memory cannot be allocated. TElement
+   * must be poolable: the elements of a reused buffer are not constructed. */
+  template <typename TElement>
+  TElement *
+  Allocate(SizeValueType numberOfElements)
+  {
+    return static_cast<TElement *>(this->AllocateBuffer(
+      numberOfElements * sizeof(TElement), sizeof(TElement), &NewElements<TElement>, &DeleteElements<TElement>));
+  }
+
+  /** Give back a buffer. Returns false, without doing anything, when the
+   * buffer was not allocated by the pool. */
+  bool
+  Release(void * buffer);
+
+  /** Stop tracking a buffer allocated by the pool: it is then owned by the
+   * caller, which frees it with delete[]. Does nothing for other buffers. */
+  void
+  Detach(void * buffer);
+
+  /** Free all the buffers currently in the pool. */
+  void
+  Clear();
+
+  /** Smallest buffer size, in bytes, handled by the pool. Defaults to
+   * 64 KiB: smaller buffers are left to the regular allocator. */
+  void
+  SetMinimumBufferSize(SizeValueType numberOfBytes);
+  SizeValueType
+  GetMinimumBufferSize() const;
+
+  /** Maximum number of bytes of released buffers kept by the pool. Buffers
+   * released beyond this limit are freed. Defaults to 1 GiB. */
+  void
+  SetMaximumPooledSize(SizeValueType numberOfBytes);
+  SizeValueType
+  GetMaximumPooledSize() const;
+
+  /** Statistics. A hit is an allocation served by a released buffer. */
+  SizeValueType
+  GetNumberOfHits() const;
+  SizeValueType
+  GetNumberOfMisses() const;
+  /** Number of bytes of released buffers currently kept by the pool. */
+  SizeValueType
+  GetPooledSize() const;
+  /** Number of bytes of buffers currently in use. */
+  SizeValueType
+  GetAllocatedSize() const;
+  void
+  ResetStatistics();
+
+  /** Size class of a buffer of numberOfBytes bytes. */
+  static SizeValueType
+  GetSizeClass(SizeValueType numberOfBytes);
+
+protected:
+  ImageBufferPool() = default;
+  ~ImageBufferPool() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using NewFunctionType = void * (*)(SizeValueType);
+  using DeleteFunctionType = void (*)(void *);
+
+  template <typename TElement>
+  static void *
+  NewElements(SizeValueType numberOfElements)
+  {
+    return new (std::nothrow) TElement[numberOfElements];
+  }
+
+  template <typename TElement>
+  static void
+  DeleteElements(void * buffer)
+  {
+    delete[] static_cast<TElement *>(buffer);
+  }
+
+  void *
+  AllocateBuffer(SizeValueType      numberOfBytes,
+                 SizeValueType      elementSize,
+                 NewFunctionType    newFunction,
+                 DeleteFunctionType deleteFunction);
+
+  /** The released buffers are grouped by size class and by element type,
+   * which is identified by the function freeing the buffer. */
+  using ReleasedBuffersKeyType = std::pair<SizeValueType, DeleteFunctionType>;
+
+  struct AllocatedBufferType
+  {
+    SizeValueType      m_SizeClass;
+    DeleteFunctionType m_DeleteFunction;
+  };
+
+  mutable std::mutex                                    m_Mutex;
+  std::map<ReleasedBuffersKeyType, std::vector<void *>> m_ReleasedBuffers;
+  std::unordered_map<void *, AllocatedBufferType>       m_AllocatedBuffers;
+  SizeValueType                                         m_MinimumBufferSize{ 64 * 1024 };
+  SizeValueType                                         m_MaximumPooledSize{ SizeValueType{ 1 } << 30 };
+  SizeValueType                                         m_PooledSize{ 0 };
+  SizeValueType                                         m_AllocatedSize{ 0 };
+  SizeValueType                                         m_NumberOfHits{ 0 };
+  SizeValueType                                         m_NumberOfMisses{ 0 };
+};
+} // end namespace itk
+
+#endif
@@ -36,6 +36,13 @@ namespace itk
  *
  * \tparam TElement The element type stored in the container.
  *
+ * When the ImageBufferPool is enabled, the memory managed by the container
+ * is allocated from, and released to, the pool.
+ *
+ * When MultiThreaderBase::GetGlobalDefaultNUMAAware() is on, the buffers
+ * of trivial elements allocated with UseDefaultConstructor are zero-filled
+ * in parallel by NUMATopology::FirstTouchZeroFill().
+ *
  * \ingroup ImageObjects
  * \ingroup IOFilters
  * \ingroup ITKCommon
@@ -146,8 +153,11 @@ public:
    *  is intended to be used by external applications.
    *  Note that the normal logic of this class set the value of the boolean
    *  flag. This may override your setting if you call this methods prematurely.
+   *  A buffer allocated from the ImageBufferPool is detached from the pool
+   *  when the container stops managing it, and is freed with delete[].
    *  \warning Improper use of these methods will result in memory leaks */
-  itkSetMacro(ContainerManageMemory, bool);
+  virtual void
+  SetContainerManageMemory(bool manageMemory);
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
@@ -29,6 +29,9 @@
 #define itkImportImageContainer_hxx
 
 #include "itkImportImageContainer.h"
+#include "itkImageBufferPool.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNUMATopology.h"
 #include <algorithm> // For copy_n.
 
 namespace itk
@@ -170,9 +173,32 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
   // does not do this by default.
   TElement * data;
 
+  if (ImageBufferPool::IsPoolable<TElement>() && ImageBufferPool::GetEnabled())
+  {
+    // Reuse a released buffer when possible. Allocation failures throw.
+    data = ImageBufferPool::GetInstance()->Allocate<TElement>(size);
+    if (data)
+    {
+      if (UseDefaultConstructor)
+      {
+        std::fill_n(data, size, TElement());
+      }
+      return data;
+    }
+  }
+
+  // Zero-fill trivial elements in parallel so that, on NUMA machines, their
+  // pages are placed on the nodes of the threads that process them.
+  const bool firstTouch =
+    UseDefaultConstructor && ImageBufferPool::IsPoolable<TElement>() && MultiThreaderBase::GetGlobalDefaultNUMAAware();
+
   try
   {
-    if (UseDefaultConstructor)
+    if (firstTouch)
+    {
+      data = new TElement[size];
+    }
+    else if (UseDefaultConstructor)
     {
       data = new TElement[size](); // POD types initialized to 0, others use default constructor.
     }
@@ -191,9 +217,30 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
     // of memory.  Do not use the exception macro.
     throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
   }
+  if (firstTouch)
+  {
+    NUMATopology::FirstTouchZeroFill(data, static_cast<SizeValueType>(size) * sizeof(TElement));
+  }
   return data;
 }
 
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::SetContainerManageMemory(bool manageMemory)
+{
+  if (m_ContainerManageMemory == manageMemory)
+  {
+    return;
+  }
+  if (m_ContainerManageMemory && ImageBufferPool::IsPoolable<TElement>())
+  {
+    // The application now owns the buffer and frees it with delete[]
+    ImageBufferPool::GetInstance()->Detach(m_ImportPointer);
+  }
+  m_ContainerManageMemory = manageMemory;
+  this->Modified();
+}
+
 template <typename TElementIdentifier, typename TElement>
 void
 ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
@@ -201,7 +248,10 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (!ImageBufferPool::IsPoolable<TElement>() || !ImageBufferPool::GetInstance()->Release(m_ImportPointer))
+    {
+      delete[] m_ImportPointer;
+    }
   }
   m_ImportPointer = nullptr;
   m_Capacity = 0;
@@ -35,6 +35,7 @@
 #include "itkImageRegion.h"
 #include "itkImageIORegion.h"
 #include "itkSingletonMacro.h"
+#include "itkPipelineProfiler.h"
 #include <functional>
 #include <thread>
 #include "itkProgressReporter.h"
@@ -218,6 +219,21 @@ public:
   static ThreadIdType
   GetGlobalDefaultNumberOfThreads();
 
+  /** Set/Get whether the multi-threaded executions are NUMA-aware. When on:
+   * - each work unit of ParallelizeImageRegion runs on the node matching its
+   *   position in the region,
+   * - the image buffers allocated with initialized pixels are zero-filled in
+   *   parallel, each node touching its share of the buffer first.
+   *
+   * Off by default. The default is picked up from the
+   * ITK_GLOBAL_DEFAULT_NUMA_AWARE environment variable.
+   *
+   * \sa NUMATopology */
+  static void
+  SetGlobalDefaultNUMAAware(bool numaAware);
+  static bool
+  GetGlobalDefaultNUMAAware();
+
 #if !defined(ITK_LEGACY_REMOVE)
   /** Get/Set the number of threads to use.
    * DEPRECATED! Use WorkUnits and MaximumNumberOfThreads instead. */
@@ -340,15 +356,22 @@ ITK_GCC_PRAGMA_DIAG_POP()
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [funcP](const IndexValueType index[], const SizeValueType size[]) {
-        ImageRegion<VDimension> region;
-        for (unsigned int d = 0; d < VDimension; ++d)
-        {
-          region.SetIndex(d, index[d]);
-          region.SetSize(d, size[d]);
-        }
-        funcP(region);
-      },
+      PipelineProfiler::InstrumentImageRegionFunctor(
+        VDimension,
+        NUMAAwareImageRegionFunctor(
+          VDimension,
+          requestedRegion.GetIndex().m_InternalArray,
+          requestedRegion.GetSize().m_InternalArray,
+          [funcP](const IndexValueType index[], const SizeValueType size[]) {
+            ImageRegion<VDimension> region;
+            for (unsigned int d = 0; d < VDimension; ++d)
+            {
+              region.SetIndex(d, index[d]);
+              region.SetSize(d, size[d]);
+            }
+            funcP(region);
+          }),
+        filter),
       filter);
   }
 
@@ -389,22 +412,29 @@ ITK_GCC_PRAGMA_DIAG_POP()
         SplitDimension,
         splitRegion.GetIndex().m_InternalArray,
         splitRegion.GetSize().m_InternalArray,
-        [&](const IndexValueType index[], const SizeValueType size[]) {
-          ImageRegion<VDimension> restrictedRequestedRegion;
-          restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
-          restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
-          for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
-          {
-            if (dimension == restrictedDirection)
-            {
-              continue;
-            }
-            restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
-            restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
-            ++splitDimension;
-          }
-          funcP(restrictedRequestedRegion);
-        },
+        PipelineProfiler::InstrumentImageRegionFunctor(
+          SplitDimension,
+          NUMAAwareImageRegionFunctor(
+            SplitDimension,
+            splitRegion.GetIndex().m_InternalArray,
+            splitRegion.GetSize().m_InternalArray,
+            [&](const IndexValueType index[], const SizeValueType size[]) {
+              ImageRegion<VDimension> restrictedRequestedRegion;
+              restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
+              restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
+              for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
+              {
+                if (dimension == restrictedDirection)
+                {
+                  continue;
+                }
+                restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
+                restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
+                ++splitDimension;
+              }
+              funcP(restrictedRequestedRegion);
+            }),
+          filter),
         filter);
     }
   }
@@ -448,6 +478,16 @@ protected:
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
   ParallelizeImageRegionHelper(void * arg);
 
+  /** Wrap an image region functor so that each work unit runs on the NUMA
+   * node matching its position in the region. Returns the functor
+   * unchanged when the execution is not NUMA-aware or the machine has a
+   * single node. */
+  static ThreadingFunctorType
+  NUMAAwareImageRegionFunctor(unsigned int         dimension,
+                              const IndexValueType index[],
+                              const SizeValueType  size[],
+                              ThreadingFunctorType funcP);
+
   /** The number of work units to create. */
   ThreadIdType m_NumberOfWorkUnits;
 
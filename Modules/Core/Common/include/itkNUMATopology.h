@@ -0,0 +1,90 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNUMATopology_h
+#define itkNUMATopology_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include <vector>
+
+namespace itk
+{
+/** \class NUMATopology
+ * \brief Non-uniform memory access (NUMA) nodes of the machine, and
+ * placement of threads and memory on them.
+ *
+ * The NUMA-aware execution of MultiThreaderBase assigns the parts of a
+ * region or buffer to the nodes proportionally to their position: the part
+ * starting at a fraction f of the whole runs on node floor(f * nodes). The
+ * parallel first-touch initialization of the image buffers uses the same
+ * mapping, so that the work units of the threaded filters, split along the
+ * slowest dimension by ImageRegionSplitterSlowDimension, access the memory
+ * of their own node.
+ *
+ * The threads are not pinned: the ThreadPool cannot direct work to a
+ * specific thread, so each work unit instead binds its thread to its node
+ * for its own duration with a ScopedNodeBinding.
+ *
+ * The topology is read from /sys/devices/system/node on Linux. On other
+ * systems, a single node is reported and the thread placement functions
+ * do nothing.
+ *
+ * \sa MultiThreaderBase::SetGlobalDefaultNUMAAware
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT NUMATopology
+{
+public:
+  /** Number of NUMA nodes. At least 1. */
+  static unsigned int
+  GetNumberOfNodes();
+
+  /** Processors of the given node. */
+  static const std::vector<unsigned int> &
+  GetProcessorsOfNode(unsigned int node);
+
+  /** Node of a part starting at position of a whole of the given size. */
+  static unsigned int
+  GetNodeOfPosition(SizeValueType position, SizeValueType size);
+
+  /** Restrict the calling thread to the processors of a node, and restore
+   * its previous affinity at destruction. Only the processors already
+   * allowed to the thread, e.g. by the cpuset of the process, are used; the
+   * affinity is left unchanged when the node has none of them. */
+  class ITKCommon_EXPORT ScopedNodeBinding
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_ASSIGN(ScopedNodeBinding);
+
+    explicit ScopedNodeBinding(unsigned int node);
+    ~ScopedNodeBinding();
+
+  private:
+    std::vector<unsigned int> m_PreviousProcessors;
+  };
+
+  /** Set numberOfBytes bytes of the buffer to zero, in parallel, each node
+   * touching first its share of the buffer. The buffer is zero-filled
+   * serially on a single node machine, and when called from a thread of the
+   * ThreadPool. */
+  static void
+  FirstTouchZeroFill(void * buffer, SizeValueType numberOfBytes);
+};
+} // end namespace itk
+
+#endif
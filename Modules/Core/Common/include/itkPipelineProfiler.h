@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineProfiler_h
+#define itkPipelineProfiler_h
+
+#include "itkObject.h"
+#include "itkIntTypes.h"
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+class ProcessObject;
+
+/** \class PipelineProfiler
+ * \brief Records a timeline of the pipeline execution.
+ *
+ * When enabled with PipelineProfiler::SetEnabled(true), every
+ * ProcessObject::UpdateOutputData() records the wall time spent in the
+ * GenerateData() of the filter, the change of the process memory usage, and
+ * the requested and buffered regions of its primary image output. Every
+ * work unit run by MultiThreaderBase::ParallelizeImageRegion() is recorded
+ * with the thread which executed it, which shows the load balance between
+ * the threads.
+ *
+ * The timeline can be written in the Chrome trace event JSON format with
+ * WriteChromeTrace(), and inspected offline with chrome://tracing or
+ * https://ui.perfetto.dev .
+ *
+ * Profiling is disabled by default. When disabled, the cost of the
+ * instrumentation is a test of a global flag.
+ *
+ * \code
+ * itk::PipelineProfiler::SetEnabled(true);
+ * writer->Update();
+ * itk::PipelineProfiler::GetInstance()->WriteChromeTrace("pipeline.json");
+ * \endcode
+ *
+ * \sa TimeProbesCollectorBase, MemoryProbesCollectorBase
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineProfiler : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(PipelineProfiler);
+
+  /** Standard class type aliases. */
+  using Self = PipelineProfiler;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PipelineProfiler, Object);
+
+  /** There is a single profiler per process: New() returns it. */
+  static Pointer
+  New();
+
+  /** Return the single instance of the profiler. */
+  static Pointer
+  GetInstance();
+
+  /** Enable or disable the recording of the pipeline execution. Disabled
+   * by default. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+
+  /** A recorded event. Timestamp and Duration are in microseconds since the
+   * creation of the profiler. */
+  struct Event
+  {
+    std::string                                      Name;
+    std::string                                      Category;
+    double                                           Timestamp;
+    double                                           Duration;
+    unsigned int                                     ThreadIndex;
+    std::vector<std::pair<std::string, std::string>> Arguments;
+    std::vector<std::pair<std::string, double>>      Values;
+  };
+
+  /** Return a copy of the events recorded so far. */
+  std::vector<Event>
+  GetEvents() const;
+
+  SizeValueType
+  GetNumberOfEvents() const;
+
+  /** Forget the events recorded so far. */
+  void
+  Clear();
+
+  /** Write the recorded events in the Chrome trace event JSON format. */
+  void
+  WriteChromeTrace(std::ostream & os) const;
+  void
+  WriteChromeTrace(const std::string & fileName) const;
+
+  /** Record the event. Thread safe. */
+  void
+  AddEvent(Event event);
+
+  /** Time in microseconds since the creation of the profiler. */
+  double
+  GetTimestamp() const;
+
+  /** Record the execution of a process object from its construction to its
+   * destruction. Does nothing when the profiler is disabled. */
+  class ITKCommon_EXPORT ProcessObjectScope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_ASSIGN(ProcessObjectScope);
+
+    explicit ProcessObjectScope(ProcessObject * processObject);
+    ~ProcessObjectScope();
+
+  private:
+    ProcessObject * m_ProcessObject;
+    double          m_Start{ 0.0 };
+    SizeValueType   m_MemoryUsage{ 0 };
+  };
+
+  /** Wrap a MultiThreaderBase image region functor so that each work unit
+   * is recorded. Returns the functor unchanged when the profiler is
+   * disabled. */
+  using ImageRegionFunctorType = std::function<void(const IndexValueType index[], const SizeValueType size[])>;
+  static ImageRegionFunctorType
+  InstrumentImageRegionFunctor(unsigned int           dimension,
+                               ImageRegionFunctorType functor,
+                               const ProcessObject *  filter);
+
+protected:
+  PipelineProfiler();
+  ~PipelineProfiler() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  unsigned int
+  GetThreadIndex(std::thread::id id);
+
+  static Pointer m_Instance;
+
+  const std::chrono::steady_clock::time_point m_Origin;
+
+  mutable std::mutex           m_Mutex;
+  std::vector<Event>           m_Events;
+  std::vector<std::thread::id> m_ThreadIds;
+};
+} // end namespace itk
+
+#endif
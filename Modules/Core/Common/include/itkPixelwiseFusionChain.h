@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPixelwiseFusionChain_h
+#define itkPixelwiseFusionChain_h
+
+#include "itkProcessObject.h"
+#include "itkImage.h"
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+
+/** \class PixelwiseFusionStage
+ * \brief Secondary base class of the pixel-wise filters which can be fused
+ * into a downstream filter.
+ *
+ * A pixel-wise filter implementing this interface can be executed on the
+ * fly, one scanline at a time, by the filter consuming its output. The
+ * intermediate output image of the fused filter is then neither allocated
+ * nor written.
+ *
+ * \sa PixelwiseFusionChain
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PixelwiseFusionStage
+{
+public:
+  virtual ~PixelwiseFusionStage() = default;
+
+  /** Return true if the filter can currently be run as part of a fused
+   * chain: it must have a single input, its input and output must be
+   * itk::Image of the same dimension with trivially copyable pixels, and its
+   * pixel operation must not depend on the input data as a whole.
+   *
+   * Fusion bypasses GenerateData() and only calls
+   * BeforeThreadedGenerateData() and the pixel functor, so the pixel-wise
+   * base classes only return true for themselves. A subclass must override
+   * this method to opt in, and should only do so if all its work is done by
+   * the functor. */
+  virtual bool
+  CanBeFused() const = 0;
+
+  /** The filter, as a process object. */
+  virtual ProcessObject *
+  GetFusedProcessObject() = 0;
+
+  /** The input image of the filter. */
+  virtual DataObject *
+  GetFusedInput() = 0;
+
+  /** Size in bytes of an output pixel of the filter. */
+  virtual size_t
+  GetFusedOutputPixelSize() const = 0;
+
+  /** Prepare the pixel operation, as BeforeThreadedGenerateData() would. */
+  virtual void
+  FusedBeforeThreadedGenerateData() = 0;
+
+  /** Conclude the pixel operation, as AfterThreadedGenerateData() would,
+   * once the downstream filter has been updated. Does nothing by default. */
+  virtual void
+  FusedAfterThreadedGenerateData()
+  {}
+
+  /** Pointer to the input pixel at the given index. Only valid if the input
+   * has been updated. */
+  virtual const void *
+  GetFusedInputScanline(const IndexValueType * index) const = 0;
+
+  /** Apply the pixel operation to `length` consecutive input pixels. May be
+   * called concurrently from several threads. */
+  virtual void
+  FusedProcessScanline(const void * input, void * output, SizeValueType length) = 0;
+
+  /** Set when a downstream filter computes the output of this filter on the
+   * fly. While set, updating the filter only brings its input up to date. */
+  void
+  SetFusedIntoDownstream(bool fused)
+  {
+    m_FusedIntoDownstream = fused;
+  }
+  bool
+  GetFusedIntoDownstream() const
+  {
+    return m_FusedIntoDownstream;
+  }
+
+  /** True if images of this type can be passed through a fused chain. */
+  template <typename TImage>
+  static constexpr bool
+  IsFusibleImageType()
+  {
+    return std::is_same<TImage, Image<typename TImage::PixelType, TImage::ImageDimension>>::value &&
+           std::is_trivially_copyable<typename TImage::PixelType>::value;
+  }
+
+private:
+  bool m_FusedIntoDownstream{ false };
+};
+
+
+/** \class PixelwiseFusionChain
+ * \brief Chain of pixel-wise filters executed on the fly by a downstream
+ * filter.
+ *
+ * When pixel-wise fusion is enabled on a filter, the filter walks its input
+ * upstream as long as the input is produced by a PixelwiseFusionStage which
+ * can be fused, and collects those stages in a PixelwiseFusionChain. During
+ * the update, only the input of the farthest stage (the root of the chain) is
+ * updated, and each scanline of the filter input is computed by passing the
+ * corresponding root scanline through all the stages. Intermediate results
+ * are kept in small per-thread scanline buffers instead of full images,
+ * turning one memory pass and one image allocation per filter into a single
+ * pass.
+ *
+ * The intermediate outputs of the fused filters are not generated. They are
+ * computed normally the next time they are requested directly. Fusion must
+ * therefore not be enabled when the intermediate outputs are also consumed by
+ * another filter updated in the same pipeline update.
+ *
+ * Fusion is opt-in, either per filter or with
+ * SetGlobalDefaultPixelwiseFusion() for the filters created afterward.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PixelwiseFusionChain
+{
+public:
+  /** Scratch memory used to pass scanlines between the stages. One buffer
+   * must be used per thread. */
+  class ITKCommon_EXPORT ScanlineBuffer
+  {
+  public:
+    void *
+    GetScanline(unsigned int which, size_t numberOfBytes);
+
+  private:
+    std::vector<std::max_align_t> m_Scanlines[2];
+  };
+
+  /** Collect the fusible stages producing the input, nearest first. */
+  void
+  Build(DataObject * input);
+
+  /** Forget all the stages. */
+  void
+  Clear();
+
+  bool
+  IsEmpty() const
+  {
+    return m_Stages.empty();
+  }
+
+  /** Return true if the given process object is one of the stages. */
+  bool
+  Contains(const ProcessObject * processObject) const;
+
+  /** Return true if at least one stage is also a stage of the other chain. */
+  bool
+  SharesStagesWith(const PixelwiseFusionChain & other) const;
+
+  /** Mark the stages as fused (or not) into the downstream filter. */
+  void
+  SetFusedIntoDownstream(bool fused);
+
+  /** Bring the input of the farthest stage up to date. This must be done
+   * before BeforeThreadedGenerateData(), which may look at the input. */
+  void
+  UpdateInput();
+
+  /** Prepare the pixel operations of all the stages, farthest first. */
+  void
+  BeforeThreadedGenerateData();
+
+  /** Conclude the pixel operations of all the stages, farthest first. */
+  void
+  AfterThreadedGenerateData();
+
+  /** Compute `length` pixels of the chain output, starting at the given
+   * index, into `output`. */
+  void
+  ProcessScanline(const IndexValueType * index, SizeValueType length, void * output, ScanlineBuffer & buffer) const;
+
+  /** Names of the fused filters, farthest first. */
+  std::vector<std::string>
+  GetFusedFilterNames() const;
+
+  static void
+  SetGlobalDefaultPixelwiseFusion(bool);
+  static bool
+  GetGlobalDefaultPixelwiseFusion();
+
+private:
+  std::vector<PixelwiseFusionStage *> m_Stages;
+};
+
+} // end namespace itk
+
+#endif
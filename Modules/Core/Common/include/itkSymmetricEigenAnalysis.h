@@ -820,6 +820,44 @@ public:
     return ComputeEigenValuesAndVectorsWithEigenLibraryImpl(A, EigenValues, EigenVectors, true);
   }
 
+  /** Compute Eigen values of A using a closed-form (non-iterative) solver.
+   * For 2x2 and 3x3 matrices the eigen values are computed analytically from
+   * the roots of the characteristic polynomial, which is considerably faster
+   * than the iterative QR solver used by ComputeEigenValues(). The closed-form
+   * solution is slightly less accurate for nearly degenerate matrices. For any
+   * other dimension this falls back to the iterative solver.
+   *
+   * Same requirements on A and 'EigenValues' as ComputeEigenValues().
+   */
+  unsigned int
+  ComputeEigenValuesClosedForm(const TMatrix & A, TVector & EigenValues) const
+  {
+    using ValueType = decltype(GetMatrixValueType(true));
+    using EigenLibMatrixType = Eigen::Matrix<ValueType, VDimension, VDimension, Eigen::RowMajor>;
+    EigenLibMatrixType inputMatrix;
+    for (unsigned int row = 0; row < VDimension; ++row)
+    {
+      for (unsigned int col = 0; col < VDimension; ++col)
+      {
+        inputMatrix(row, col) = A(row, col);
+      }
+    }
+    using EigenSolverType = Eigen::SelfAdjointEigenSolver<EigenLibMatrixType>;
+    EigenSolverType solver;
+    solver.computeDirect(inputMatrix, Eigen::EigenvaluesOnly);
+    auto eigenValues = solver.eigenvalues();
+    if (m_OrderEigenValues == EigenValueOrderEnum::OrderByMagnitude)
+    {
+      detail::sortEigenValuesByMagnitude(eigenValues, VDimension);
+    }
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      EigenValues[i] = eigenValues[i];
+    }
+    // No error code
+    return 1;
+  }
+
   void
   SetOrderEigenValues(const bool b)
   {
@@ -115,6 +115,12 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
   int
   GetNumberOfCurrentlyIdleThreads() const;
 
+  /** Whether the calling thread is one of the threads of the pool. A thread
+   * of the pool which adds work to the pool and waits for it may deadlock,
+   * when all the threads of the pool are waiting. */
+  static bool
+  IsPoolThread();
+
   /** Set/Get wait for threads.
   This function should be used carefully, probably only during static
   initialization phase to disable waiting for threads when ITK is built as a
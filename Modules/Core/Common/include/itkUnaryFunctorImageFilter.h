@@ -21,6 +21,7 @@
 #include "itkMath.h"
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkPixelwiseFusionChain.h"
 
 namespace itk
 {
@@ -36,8 +37,15 @@ namespace itk
  * UnaryFunctorImageFilter (like the CastImageFilter) can be used
  * to promote a 2D image to a 3D image, etc.
  *
+ * When PixelwiseFusion is on, the chain of pixel-wise filters directly
+ * upstream of this filter is executed on the fly, scanline by scanline, as
+ * part of this filter, instead of producing its intermediate images. This
+ * filter can itself be fused into a downstream filter. Subclasses are not
+ * fused unless they override CanBeFused().
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter TernaryFunctorImageFilter
+ * \sa PixelwiseFusionChain
  *
  * \ingroup   IntensityImageFilters     MultiThreaded
  * \ingroup ITKCommon
@@ -47,7 +55,9 @@ namespace itk
  * \endsphinx
  */
 template <typename TInputImage, typename TOutputImage, typename TFunction>
-class ITK_TEMPLATE_EXPORT UnaryFunctorImageFilter : public InPlaceImageFilter<TInputImage, TOutputImage>
+class ITK_TEMPLATE_EXPORT UnaryFunctorImageFilter
+  : public InPlaceImageFilter<TInputImage, TOutputImage>
+  , public PixelwiseFusionStage
 {
 public:
   ITK_DISALLOW_COPY_AND_ASSIGN(UnaryFunctorImageFilter);
@@ -108,6 +118,31 @@ public:
     }
   }
 
+  /** Set/Get whether the pixel-wise filters upstream of this filter are
+   * fused into it. Defaults to
+   * PixelwiseFusionChain::GetGlobalDefaultPixelwiseFusion(). */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  /** Names of the upstream filters fused into this filter during the last
+   * update, farthest first. */
+  const std::vector<std::string> &
+  GetFusedFilterNames() const
+  {
+    return m_FusedFilterNames;
+  }
+
+  /** Bypass the execution of this filter when it is fused into a downstream
+   * filter, and fuse the upstream filters into this one when PixelwiseFusion
+   * is on. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
+  /** The input is not generated when upstream filters are fused. */
+  bool
+  CanRunInPlace() const override;
+
 protected:
   UnaryFunctorImageFilter();
   ~UnaryFunctorImageFilter() override = default;
@@ -136,8 +171,49 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** PixelwiseFusionStage interface. Returns false for subclasses: a
+   * subclass whose work is entirely done by its functor can opt in by
+   * overriding CanBeFused() to return IsPixelwiseFusible(). */
+  bool
+  CanBeFused() const override;
+
+  /** True if the image types allow running the functor in a fused chain. */
+  bool
+  IsPixelwiseFusible() const;
+  ProcessObject *
+  GetFusedProcessObject() override
+  {
+    return this;
+  }
+  DataObject *
+  GetFusedInput() override
+  {
+    return this->GetPrimaryInput();
+  }
+  size_t
+  GetFusedOutputPixelSize() const override
+  {
+    return sizeof(OutputImagePixelType);
+  }
+  void
+  FusedBeforeThreadedGenerateData() override
+  {
+    this->BeforeThreadedGenerateData();
+  }
+  const void *
+  GetFusedInputScanline(const IndexValueType * index) const override;
+  void
+  FusedProcessScanline(const void * input, void * output, SizeValueType length) override;
+
 private:
   FunctorType m_Functor;
+
+  bool                     m_PixelwiseFusion;
+  PixelwiseFusionChain     m_FusionChain;
+  std::vector<std::string> m_FusedFilterNames;
 };
 } // end namespace itk
 
@@ -0,0 +1,304 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferPool.h"
+#include "itkMacro.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+namespace itk
+{
+namespace
+{
+std::atomic<bool> imageBufferPoolEnabled{ false };
+
+// Number of live ImageBufferPool::EnabledScope objects
+std::atomic<int> imageBufferPoolScopes{ 0 };
+
+// Number of buffers allocated by the pool and not yet released, which lets
+// Release() return immediately when the pool has never been used.
+std::atomic<SizeValueType> imageBufferPoolAllocatedBuffers{ 0 };
+} // namespace
+
+ImageBufferPool::Pointer
+ImageBufferPool::GetInstance()
+{
+  // The pool is never destroyed: buffers may be released to it by images
+  // destroyed during the static destruction.
+  static ImageBufferPool * const instance = new ImageBufferPool;
+  return instance;
+}
+
+ImageBufferPool::Pointer
+ImageBufferPool::New()
+{
+  return GetInstance();
+}
+
+ImageBufferPool::~ImageBufferPool()
+{
+  this->Clear();
+}
+
+void
+ImageBufferPool::SetEnabled(bool enabled)
+{
+  imageBufferPoolEnabled = enabled;
+}
+
+bool
+ImageBufferPool::GetEnabled()
+{
+  return imageBufferPoolEnabled || imageBufferPoolScopes > 0;
+}
+
+ImageBufferPool::EnabledScope::EnabledScope()
+{
+  ++imageBufferPoolScopes;
+}
+
+ImageBufferPool::EnabledScope::~EnabledScope()
+{
+  --imageBufferPoolScopes;
+}
+
+SizeValueType
+ImageBufferPool::GetSizeClass(SizeValueType numberOfBytes)
+{
+  // Eight classes per power of two
+  SizeValueType powerOfTwo = 1;
+  while (powerOfTwo <= numberOfBytes / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const SizeValueType step = std::max<SizeValueType>(powerOfTwo / 8, 1);
+  return ((numberOfBytes + step - 1) / step) * step;
+}
+
+void *
+ImageBufferPool::AllocateBuffer(SizeValueType      numberOfBytes,
+                                SizeValueType      elementSize,
+                                NewFunctionType    newFunction,
+                                DeleteFunctionType deleteFunction)
+{
+  const SizeValueType          sizeClass = GetSizeClass(numberOfBytes);
+  const ReleasedBuffersKeyType key(sizeClass, deleteFunction);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (numberOfBytes < m_MinimumBufferSize)
+    {
+      return nullptr;
+    }
+    auto released = m_ReleasedBuffers.find(key);
+    if (released != m_ReleasedBuffers.end() && !released->second.empty())
+    {
+      void * buffer = released->second.back();
+      released->second.pop_back();
+      m_PooledSize -= sizeClass;
+      m_AllocatedBuffers[buffer] = { sizeClass, deleteFunction };
+      m_AllocatedSize += sizeClass;
+      ++m_NumberOfHits;
+      ++imageBufferPoolAllocatedBuffers;
+      return buffer;
+    }
+    ++m_NumberOfMisses;
+  }
+
+  // The size class is a multiple of the element size for all the usual
+  // element sizes; otherwise the last partial element is not allocated.
+  const SizeValueType numberOfElements = sizeClass / elementSize;
+  void *              buffer = newFunction(numberOfElements);
+  if (buffer == nullptr)
+  {
+    // Give the released buffers back to the system and retry
+    this->Clear();
+    buffer = newFunction(numberOfElements);
+  }
+  if (buffer == nullptr)
+  {
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_AllocatedBuffers[buffer] = { sizeClass, deleteFunction };
+  m_AllocatedSize += sizeClass;
+  ++imageBufferPoolAllocatedBuffers;
+  return buffer;
+}
+
+bool
+ImageBufferPool::Release(void * buffer)
+{
+  if (buffer == nullptr || imageBufferPoolAllocatedBuffers == 0)
+  {
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  const auto                   allocated = m_AllocatedBuffers.find(buffer);
+  if (allocated == m_AllocatedBuffers.end())
+  {
+    return false;
+  }
+  const AllocatedBufferType allocatedBuffer = allocated->second;
+  m_AllocatedBuffers.erase(allocated);
+  m_AllocatedSize -= allocatedBuffer.m_SizeClass;
+  --imageBufferPoolAllocatedBuffers;
+
+  if (allocatedBuffer.m_SizeClass <= m_MaximumPooledSize - m_PooledSize)
+  {
+    m_ReleasedBuffers[{ allocatedBuffer.m_SizeClass, allocatedBuffer.m_DeleteFunction }].push_back(buffer);
+    m_PooledSize += allocatedBuffer.m_SizeClass;
+    return true;
+  }
+  lock.unlock();
+  allocatedBuffer.m_DeleteFunction(buffer);
+  return true;
+}
+
+void
+ImageBufferPool::Detach(void * buffer)
+{
+  if (buffer == nullptr || imageBufferPoolAllocatedBuffers == 0)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  const auto                  allocated = m_AllocatedBuffers.find(buffer);
+  if (allocated != m_AllocatedBuffers.end())
+  {
+    m_AllocatedSize -= allocated->second.m_SizeClass;
+    m_AllocatedBuffers.erase(allocated);
+    --imageBufferPoolAllocatedBuffers;
+  }
+}
+
+void
+ImageBufferPool::Clear()
+{
+  std::map<ReleasedBuffersKeyType, std::vector<void *>> releasedBuffers;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    releasedBuffers.swap(m_ReleasedBuffers);
+    m_PooledSize = 0;
+  }
+  for (auto & buffersOfKey : releasedBuffers)
+  {
+    const DeleteFunctionType deleteFunction = buffersOfKey.first.second;
+    for (void * buffer : buffersOfKey.second)
+    {
+      deleteFunction(buffer);
+    }
+  }
+}
+
+void
+ImageBufferPool::SetMinimumBufferSize(SizeValueType numberOfBytes)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_MinimumBufferSize != numberOfBytes)
+  {
+    m_MinimumBufferSize = numberOfBytes;
+    this->Modified();
+  }
+}
+
+SizeValueType
+ImageBufferPool::GetMinimumBufferSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MinimumBufferSize;
+}
+
+void
+ImageBufferPool::SetMaximumPooledSize(SizeValueType numberOfBytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_MaximumPooledSize == numberOfBytes)
+    {
+      return;
+    }
+    m_MaximumPooledSize = numberOfBytes;
+  }
+  if (this->GetPooledSize() > numberOfBytes)
+  {
+    this->Clear();
+  }
+  this->Modified();
+}
+
+SizeValueType
+ImageBufferPool::GetMaximumPooledSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumPooledSize;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfHits;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfMisses() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfMisses;
+}
+
+SizeValueType
+ImageBufferPool::GetPooledSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_PooledSize;
+}
+
+SizeValueType
+ImageBufferPool::GetAllocatedSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_AllocatedSize;
+}
+
+void
+ImageBufferPool::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_NumberOfHits = 0;
+  m_NumberOfMisses = 0;
+}
+
+void
+ImageBufferPool::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Enabled: " << ImageBufferPool::GetEnabled() << std::endl;
+  os << indent << "MinimumBufferSize: " << this->GetMinimumBufferSize() << std::endl;
+  os << indent << "MaximumPooledSize: " << this->GetMaximumPooledSize() << std::endl;
+  os << indent << "NumberOfHits: " << this->GetNumberOfHits() << std::endl;
+  os << indent << "NumberOfMisses: " << this->GetNumberOfMisses() << std::endl;
+  os << indent << "PooledSize: " << this->GetPooledSize() << std::endl;
+  os << indent << "AllocatedSize: " << this->GetAllocatedSize() << std::endl;
+}
+} // end namespace itk
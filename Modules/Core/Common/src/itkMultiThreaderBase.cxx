@@ -49,6 +49,7 @@
 #endif
 
 #include "itkTotalProgressReporter.h"
+#include "itkNUMATopology.h"
 
 namespace itk
 {
@@ -89,6 +90,12 @@ struct MultiThreaderBaseGlobals
   //  m_GlobalMaximumNumberOfThreads and larger or equal to 1 once it has been
   //  initialized in the constructor of the first MultiThreaderBase instantiation.
   ThreadIdType m_GlobalDefaultNumberOfThreads{ 0 };
+
+  // Global variable defining whether the multi-threaded executions are
+  // NUMA-aware. The ITK_GLOBAL_DEFAULT_NUMA_AWARE environment variable is
+  // only used as a fall back option, like for the default threader.
+  bool GlobalDefaultNUMAAwareIsInitialized{ false };
+  bool m_GlobalDefaultNUMAAware{ false };
 };
 
 itkGetGlobalSimpleMacro(MultiThreaderBase, MultiThreaderBaseGlobals, PimplGlobals);
@@ -240,6 +247,41 @@ MultiThreaderBase::SetGlobalDefaultNumberOfThreads(ThreadIdType val)
     std::max(m_PimplGlobals->m_GlobalDefaultNumberOfThreads, NumericTraits<ThreadIdType>::OneValue());
 }
 
+void
+MultiThreaderBase::SetGlobalDefaultNUMAAware(bool numaAware)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  m_PimplGlobals->m_GlobalDefaultNUMAAware = numaAware;
+  m_PimplGlobals->GlobalDefaultNUMAAwareIsInitialized = true;
+}
+
+bool
+MultiThreaderBase::GetGlobalDefaultNUMAAware()
+{
+  // This method must be concurrent thread safe
+  itkInitGlobalsMacro(PimplGlobals);
+
+  if (!m_PimplGlobals->GlobalDefaultNUMAAwareIsInitialized)
+  {
+    std::lock_guard<std::mutex> lock(m_PimplGlobals->globalDefaultInitializerLock);
+
+    // After we have the lock, double check the initialization
+    // flag to ensure it hasn't been changed by another thread.
+    if (!m_PimplGlobals->GlobalDefaultNUMAAwareIsInitialized)
+    {
+      std::string envVar;
+      if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_NUMA_AWARE", envVar))
+      {
+        envVar = itksys::SystemTools::UpperCase(envVar);
+        m_PimplGlobals->m_GlobalDefaultNUMAAware = (envVar == "1" || envVar == "ON" || envVar == "TRUE");
+      }
+      m_PimplGlobals->GlobalDefaultNUMAAwareIsInitialized = true;
+    }
+  }
+  return m_PimplGlobals->m_GlobalDefaultNUMAAware;
+}
+
 void
 MultiThreaderBase::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
 {
@@ -577,6 +619,35 @@ MultiThreaderBase ::ParallelizeImageRegionHelper(void * arg)
   return ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+MultiThreaderBase::ThreadingFunctorType
+MultiThreaderBase::NUMAAwareImageRegionFunctor(unsigned int         dimension,
+                                               const IndexValueType index[],
+                                               const SizeValueType  size[],
+                                               ThreadingFunctorType funcP)
+{
+  if (!MultiThreaderBase::GetGlobalDefaultNUMAAware() || NUMATopology::GetNumberOfNodes() < 2)
+  {
+    return funcP;
+  }
+
+  std::vector<IndexValueType> regionIndex(index, index + dimension);
+  std::vector<SizeValueType>  regionSize(size, size + dimension);
+  return [dimension, regionIndex, regionSize, funcP](const IndexValueType subIndex[], const SizeValueType subSize[]) {
+    // Linear position of the first pixel of the work unit in the region, as
+    // in an image buffer whose buffered region is the requested region.
+    SizeValueType position = 0;
+    SizeValueType stride = 1;
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      position += static_cast<SizeValueType>(subIndex[d] - regionIndex[d]) * stride;
+      stride *= regionSize[d];
+    }
+
+    const NUMATopology::ScopedNodeBinding binding(NUMATopology::GetNodeOfPosition(position, stride));
+    funcP(subIndex, subSize);
+  };
+}
+
 // Print method for the multithreader
 void
 MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
@@ -588,6 +659,7 @@ MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Global Maximum Number Of Threads: " << m_PimplGlobals->m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: " << m_PimplGlobals->m_GlobalDefaultNumberOfThreads << std::endl;
   os << indent << "Global Default Threader Type: " << m_PimplGlobals->m_GlobalDefaultThreader << std::endl;
+  os << indent << "Global Default NUMA Aware: " << m_PimplGlobals->m_GlobalDefaultNUMAAware << std::endl;
   os << indent << "SingleMethod: " << m_SingleMethod << std::endl;
   os << indent << "SingleData: " << m_SingleData << std::endl;
 }
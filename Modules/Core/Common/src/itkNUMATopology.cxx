@@ -0,0 +1,245 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkNUMATopology.h"
+#include "itkMultiThreaderBase.h"
+#include "itkThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#  define ITK_NUMA_TOPOLOGY_LINUX 1
+#endif
+
+namespace itk
+{
+namespace
+{
+// Parse a Linux cpulist, e.g. "0-3,8-11"
+std::vector<unsigned int>
+ParseProcessorList(const std::string & list)
+{
+  std::vector<unsigned int> processors;
+  std::istringstream        stream(list);
+  std::string               range;
+  while (std::getline(stream, range, ','))
+  {
+    unsigned int      first = 0;
+    unsigned int      last = 0;
+    char              dash = 0;
+    std::stringstream rangeStream(range);
+    if (!(rangeStream >> first))
+    {
+      continue;
+    }
+    last = first;
+    if (rangeStream >> dash >> last)
+    {
+      last = std::max(first, last);
+    }
+    for (unsigned int processor = first; processor <= last; ++processor)
+    {
+      processors.push_back(processor);
+    }
+  }
+  return processors;
+}
+
+std::vector<std::vector<unsigned int>>
+ReadTopology()
+{
+  std::vector<std::vector<unsigned int>> nodes;
+#if defined(ITK_NUMA_TOPOLOGY_LINUX)
+  for (unsigned int node = 0;; ++node)
+  {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!file)
+    {
+      break;
+    }
+    std::string list;
+    std::getline(file, list);
+    std::vector<unsigned int> processors = ParseProcessorList(list);
+    // Nodes without processors (memory only) cannot run threads
+    if (!processors.empty())
+    {
+      nodes.push_back(processors);
+    }
+  }
+#endif
+  if (nodes.empty())
+  {
+    std::vector<unsigned int> processors(std::max(std::thread::hardware_concurrency(), 1u));
+    for (unsigned int processor = 0; processor < processors.size(); ++processor)
+    {
+      processors[processor] = processor;
+    }
+    nodes.push_back(processors);
+  }
+  return nodes;
+}
+
+const std::vector<std::vector<unsigned int>> &
+GetTopology()
+{
+  static const std::vector<std::vector<unsigned int>> topology = ReadTopology();
+  return topology;
+}
+
+#if defined(ITK_NUMA_TOPOLOGY_LINUX)
+bool
+SetAffinity(pthread_t thread, const std::vector<unsigned int> & processors)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const unsigned int processor : processors)
+  {
+    if (processor < CPU_SETSIZE)
+    {
+      CPU_SET(processor, &set);
+    }
+  }
+  return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+}
+#endif
+} // namespace
+
+unsigned int
+NUMATopology::GetNumberOfNodes()
+{
+  return static_cast<unsigned int>(GetTopology().size());
+}
+
+const std::vector<unsigned int> &
+NUMATopology::GetProcessorsOfNode(unsigned int node)
+{
+  const std::vector<std::vector<unsigned int>> & topology = GetTopology();
+  return topology[std::min<size_t>(node, topology.size() - 1)];
+}
+
+unsigned int
+NUMATopology::GetNodeOfPosition(SizeValueType position, SizeValueType size)
+{
+  const unsigned int numberOfNodes = GetNumberOfNodes();
+  if (size == 0 || numberOfNodes == 1)
+  {
+    return 0;
+  }
+  // position * numberOfNodes / size, without overflow
+  const double fraction = static_cast<double>(position) / static_cast<double>(size);
+  return std::min(static_cast<unsigned int>(fraction * numberOfNodes), numberOfNodes - 1);
+}
+
+NUMATopology::ScopedNodeBinding::ScopedNodeBinding(unsigned int node)
+{
+#if defined(ITK_NUMA_TOPOLOGY_LINUX)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+  {
+    return;
+  }
+  std::vector<unsigned int> previousProcessors;
+  std::vector<unsigned int> nodeProcessors;
+  for (const unsigned int processor : NUMATopology::GetProcessorsOfNode(node))
+  {
+    // Stay within the processors allowed to the thread, e.g. by the cpuset
+    // of the process
+    if (processor < CPU_SETSIZE && CPU_ISSET(processor, &set))
+    {
+      nodeProcessors.push_back(processor);
+    }
+  }
+  if (nodeProcessors.empty())
+  {
+    return;
+  }
+  for (unsigned int processor = 0; processor < CPU_SETSIZE; ++processor)
+  {
+    if (CPU_ISSET(processor, &set))
+    {
+      previousProcessors.push_back(processor);
+    }
+  }
+  if (SetAffinity(pthread_self(), nodeProcessors))
+  {
+    m_PreviousProcessors = previousProcessors;
+  }
+#else
+  (void)node;
+#endif
+}
+
+NUMATopology::ScopedNodeBinding::~ScopedNodeBinding()
+{
+#if defined(ITK_NUMA_TOPOLOGY_LINUX)
+  if (!m_PreviousProcessors.empty())
+  {
+    SetAffinity(pthread_self(), m_PreviousProcessors);
+  }
+#endif
+}
+
+void
+NUMATopology::FirstTouchZeroFill(void * buffer, SizeValueType numberOfBytes)
+{
+  // Nothing to place on a single node. The threads of the pool must not
+  // wait for work added to the pool, so the fill is also serial when this is
+  // called from a work unit, e.g. by a filter allocating a temporary image.
+  if (GetNumberOfNodes() <= 1 || ThreadPool::IsPoolThread())
+  {
+    std::memset(buffer, 0, numberOfBytes);
+    return;
+  }
+
+  // Parts are aligned on pages, so that a page is not shared by two nodes
+  constexpr SizeValueType pageSize = 4096;
+
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const SizeValueType        numberOfParts =
+    std::max<SizeValueType>(1, std::min<SizeValueType>(threader->GetNumberOfWorkUnits(), numberOfBytes / pageSize));
+  auto * bytes = static_cast<char *>(buffer);
+
+  const auto partBegin = [bytes, numberOfBytes, numberOfParts](SizeValueType part) -> SizeValueType {
+    if (part == 0 || part == numberOfParts)
+    {
+      return part == 0 ? 0 : numberOfBytes;
+    }
+    const auto begin = static_cast<SizeValueType>(static_cast<double>(numberOfBytes) * part / numberOfParts);
+    return begin - (reinterpret_cast<std::uintptr_t>(bytes) + begin) % pageSize;
+  };
+
+  threader->ParallelizeArray(
+    0,
+    numberOfParts,
+    [&](SizeValueType part) {
+      const SizeValueType begin = partBegin(part);
+      const SizeValueType end = partBegin(part + 1);
+      const ScopedNodeBinding binding(GetNodeOfPosition(begin, numberOfBytes));
+      std::memset(bytes + begin, 0, end - begin);
+    },
+    nullptr);
+}
+} // end namespace itk
@@ -0,0 +1,371 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineProfiler.h"
+#include "itkProcessObject.h"
+#include "itkImageBase.h"
+#include "itkMemoryUsageObserver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace itk
+{
+namespace
+{
+std::atomic<bool> pipelineProfilerEnabled{ false };
+
+std::mutex pipelineProfilerInstanceMutex;
+
+SizeValueType
+GetProcessMemoryUsage()
+{
+  MemoryUsageObserver observer;
+  return observer.GetMemoryUsage();
+}
+
+template <typename TIndexOrSize>
+std::string
+FormatArray(const TIndexOrSize * values, unsigned int dimension)
+{
+  std::ostringstream os;
+  os << "[";
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    os << (d ? ", " : "") << values[d];
+  }
+  os << "]";
+  return os.str();
+}
+
+template <typename TRegion>
+std::string
+FormatRegion(const TRegion & region)
+{
+  return "index " + FormatArray(&region.GetIndex()[0], TRegion::ImageDimension) + " size " +
+         FormatArray(&region.GetSize()[0], TRegion::ImageDimension);
+}
+
+/** Describe the regions of the output when it is an image, trying all the
+ * dimensions from VDimension down to 1. */
+template <unsigned int VDimension>
+bool
+AppendImageRegions(const DataObject * output, PipelineProfiler::Event & event)
+{
+  const auto * image = dynamic_cast<const ImageBase<VDimension> *>(output);
+  if (image == nullptr)
+  {
+    return AppendImageRegions<VDimension - 1>(output, event);
+  }
+  event.Arguments.emplace_back("requestedRegion", FormatRegion(image->GetRequestedRegion()));
+  event.Arguments.emplace_back("bufferedRegion", FormatRegion(image->GetBufferedRegion()));
+  event.Values.emplace_back("requestedPixels", static_cast<double>(image->GetRequestedRegion().GetNumberOfPixels()));
+  return true;
+}
+
+template <>
+bool
+AppendImageRegions<0>(const DataObject *, PipelineProfiler::Event &)
+{
+  return false;
+}
+
+void
+WriteJSONString(std::ostream & os, const std::string & value)
+{
+  os << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+             << std::setfill(' ');
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+} // namespace
+
+PipelineProfiler::Pointer PipelineProfiler::m_Instance = nullptr;
+
+PipelineProfiler::PipelineProfiler()
+  : m_Origin(std::chrono::steady_clock::now())
+{}
+
+PipelineProfiler::Pointer
+PipelineProfiler::GetInstance()
+{
+  std::lock_guard<std::mutex> lock(pipelineProfilerInstanceMutex);
+  if (!PipelineProfiler::m_Instance)
+  {
+    PipelineProfiler::m_Instance = new PipelineProfiler;
+    // Remove extra reference from construction.
+    PipelineProfiler::m_Instance->UnRegister();
+  }
+  return PipelineProfiler::m_Instance;
+}
+
+PipelineProfiler::Pointer
+PipelineProfiler::New()
+{
+  return GetInstance();
+}
+
+void
+PipelineProfiler::SetEnabled(bool enabled)
+{
+  if (enabled)
+  {
+    // Create the instance before any event is recorded
+    GetInstance();
+  }
+  pipelineProfilerEnabled = enabled;
+}
+
+bool
+PipelineProfiler::GetEnabled()
+{
+  return pipelineProfilerEnabled;
+}
+
+double
+PipelineProfiler::GetTimestamp() const
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_Origin).count();
+}
+
+unsigned int
+PipelineProfiler::GetThreadIndex(std::thread::id id)
+{
+  const auto it = std::find(m_ThreadIds.begin(), m_ThreadIds.end(), id);
+  if (it != m_ThreadIds.end())
+  {
+    return static_cast<unsigned int>(it - m_ThreadIds.begin());
+  }
+  m_ThreadIds.push_back(id);
+  return static_cast<unsigned int>(m_ThreadIds.size() - 1);
+}
+
+void
+PipelineProfiler::AddEvent(Event event)
+{
+  const std::thread::id       id = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  event.ThreadIndex = this->GetThreadIndex(id);
+  m_Events.push_back(std::move(event));
+}
+
+std::vector<PipelineProfiler::Event>
+PipelineProfiler::GetEvents() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Events;
+}
+
+SizeValueType
+PipelineProfiler::GetNumberOfEvents() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<SizeValueType>(m_Events.size());
+}
+
+void
+PipelineProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Events.clear();
+}
+
+void
+PipelineProfiler::WriteChromeTrace(std::ostream & os) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  const std::ios::fmtflags flags = os.flags();
+  const std::streamsize    precision = os.precision();
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const char * separator = "\n";
+  for (unsigned int t = 0; t < m_ThreadIds.size(); ++t)
+  {
+    os << separator << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << t
+       << R"(,"args":{"name":"thread )" << t << "\"}}";
+    separator = ",\n";
+  }
+  for (const Event & event : m_Events)
+  {
+    os << separator << "{\"name\":";
+    WriteJSONString(os, event.Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, event.Category);
+    os << R"(,"ph":"X","ts":)" << std::fixed << std::setprecision(3) << event.Timestamp << ",\"dur\":" << event.Duration
+       << std::defaultfloat << std::setprecision(15) << ",\"pid\":1,\"tid\":" << event.ThreadIndex << ",\"args\":{";
+    const char * argumentSeparator = "";
+    for (const auto & argument : event.Arguments)
+    {
+      os << argumentSeparator;
+      WriteJSONString(os, argument.first);
+      os << ':';
+      WriteJSONString(os, argument.second);
+      argumentSeparator = ",";
+    }
+    for (const auto & value : event.Values)
+    {
+      os << argumentSeparator;
+      WriteJSONString(os, value.first);
+      os << ':' << value.second;
+      argumentSeparator = ",";
+    }
+    os << "}}";
+    separator = ",\n";
+
+    // Plot the memory usage of the process as a counter track
+    for (const auto & value : event.Values)
+    {
+      if (value.first == "memoryUsageKB")
+      {
+        os << separator << R"({"name":"memory","ph":"C","pid":1,"ts":)" << std::fixed << std::setprecision(3)
+           << event.Timestamp + event.Duration << std::defaultfloat << std::setprecision(15)
+           << R"(,"args":{"usageKB":)" << value.second << "}}";
+      }
+    }
+  }
+  os << "\n]}\n";
+
+  os.flags(flags);
+  os.precision(precision);
+}
+
+void
+PipelineProfiler::WriteChromeTrace(const std::string & fileName) const
+{
+  std::ofstream file(fileName.c_str());
+  if (!file)
+  {
+    itkExceptionMacro(<< "Cannot open " << fileName << " for writing");
+  }
+  this->WriteChromeTrace(file);
+  if (!file)
+  {
+    itkExceptionMacro(<< "Failed to write " << fileName);
+  }
+}
+
+PipelineProfiler::ProcessObjectScope::ProcessObjectScope(ProcessObject * processObject)
+  : m_ProcessObject(PipelineProfiler::GetEnabled() ? processObject : nullptr)
+{
+  if (m_ProcessObject != nullptr)
+  {
+    m_MemoryUsage = GetProcessMemoryUsage();
+    m_Start = PipelineProfiler::GetInstance()->GetTimestamp();
+  }
+}
+
+PipelineProfiler::ProcessObjectScope::~ProcessObjectScope()
+{
+  if (m_ProcessObject == nullptr)
+  {
+    return;
+  }
+  PipelineProfiler * profiler = PipelineProfiler::GetInstance();
+
+  Event event;
+  event.Timestamp = m_Start;
+  event.Duration = profiler->GetTimestamp() - m_Start;
+  event.Name = m_ProcessObject->GetNameOfClass();
+  if (!m_ProcessObject->GetObjectName().empty())
+  {
+    event.Name += " (" + m_ProcessObject->GetObjectName() + ")";
+  }
+  event.Category = "filter";
+
+  const SizeValueType memoryUsage = GetProcessMemoryUsage();
+  event.Values.emplace_back("memoryUsageKB", static_cast<double>(memoryUsage));
+  event.Values.emplace_back("memoryDeltaKB", static_cast<double>(memoryUsage) - static_cast<double>(m_MemoryUsage));
+
+  const ProcessObject::DataObjectPointerArray outputs = m_ProcessObject->GetIndexedOutputs();
+  if (!outputs.empty() && outputs[0] != nullptr)
+  {
+    AppendImageRegions<6>(outputs[0], event);
+  }
+  profiler->AddEvent(std::move(event));
+}
+
+PipelineProfiler::ImageRegionFunctorType
+PipelineProfiler::InstrumentImageRegionFunctor(unsigned int           dimension,
+                                               ImageRegionFunctorType functor,
+                                               const ProcessObject *  filter)
+{
+  if (!PipelineProfiler::GetEnabled())
+  {
+    return functor;
+  }
+  const std::string name = filter ? filter->GetNameOfClass() : "ParallelizeImageRegion";
+  return [dimension, functor, name](const IndexValueType index[], const SizeValueType size[]) {
+    PipelineProfiler * profiler = PipelineProfiler::GetInstance();
+    const double       start = profiler->GetTimestamp();
+    functor(index, size);
+
+    Event event;
+    event.Timestamp = start;
+    event.Duration = profiler->GetTimestamp() - start;
+    event.Name = name;
+    event.Category = "work unit";
+    event.Arguments.emplace_back("region",
+                                 "index " + FormatArray(index, dimension) + " size " + FormatArray(size, dimension));
+    SizeValueType pixels = 1;
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      pixels *= size[d];
+    }
+    event.Values.emplace_back("pixels", static_cast<double>(pixels));
+    profiler->AddEvent(std::move(event));
+  };
+}
+
+void
+PipelineProfiler::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Enabled: " << PipelineProfiler::GetEnabled() << std::endl;
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << std::endl;
+}
+} // end namespace itk
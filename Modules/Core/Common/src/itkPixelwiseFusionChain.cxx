@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPixelwiseFusionChain.h"
+
+namespace itk
+{
+
+namespace
+{
+bool globalDefaultPixelwiseFusion = false;
+} // namespace
+
+void *
+PixelwiseFusionChain::ScanlineBuffer::GetScanline(unsigned int which, size_t numberOfBytes)
+{
+  std::vector<std::max_align_t> & scanline = m_Scanlines[which % 2];
+
+  const size_t numberOfElements = (numberOfBytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+  if (scanline.size() < numberOfElements)
+  {
+    scanline.resize(numberOfElements);
+  }
+  return scanline.data();
+}
+
+void
+PixelwiseFusionChain::Build(DataObject * input)
+{
+  m_Stages.clear();
+
+  DataObject * current = input;
+  while (current != nullptr)
+  {
+    // Data which is already up to date is read directly
+    if (current->GetUpdateMTime() >= current->GetPipelineMTime() && !current->GetDataReleased())
+    {
+      break;
+    }
+
+    ProcessObject::Pointer source = current->GetSource();
+    auto *                 stage = dynamic_cast<PixelwiseFusionStage *>(source.GetPointer());
+    if (stage == nullptr || !stage->CanBeFused() || source->GetNumberOfIndexedOutputs() != 1 ||
+        source->GetInputs().size() != 1 || this->Contains(source))
+    {
+      break;
+    }
+
+    m_Stages.push_back(stage);
+    current = stage->GetFusedInput();
+  }
+}
+
+void
+PixelwiseFusionChain::Clear()
+{
+  m_Stages.clear();
+}
+
+bool
+PixelwiseFusionChain::Contains(const ProcessObject * processObject) const
+{
+  for (PixelwiseFusionStage * stage : m_Stages)
+  {
+    if (stage->GetFusedProcessObject() == processObject)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+PixelwiseFusionChain::SharesStagesWith(const PixelwiseFusionChain & other) const
+{
+  for (PixelwiseFusionStage * stage : m_Stages)
+  {
+    if (other.Contains(stage->GetFusedProcessObject()))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+PixelwiseFusionChain::SetFusedIntoDownstream(bool fused)
+{
+  for (PixelwiseFusionStage * stage : m_Stages)
+  {
+    stage->SetFusedIntoDownstream(fused);
+  }
+}
+
+void
+PixelwiseFusionChain::UpdateInput()
+{
+  if (!m_Stages.empty())
+  {
+    m_Stages.back()->GetFusedInput()->UpdateOutputData();
+  }
+}
+
+void
+PixelwiseFusionChain::BeforeThreadedGenerateData()
+{
+  for (auto it = m_Stages.rbegin(); it != m_Stages.rend(); ++it)
+  {
+    (*it)->FusedBeforeThreadedGenerateData();
+  }
+}
+
+void
+PixelwiseFusionChain::AfterThreadedGenerateData()
+{
+  for (auto it = m_Stages.rbegin(); it != m_Stages.rend(); ++it)
+  {
+    (*it)->FusedAfterThreadedGenerateData();
+  }
+}
+
+void
+PixelwiseFusionChain::ProcessScanline(const IndexValueType * index,
+                                      SizeValueType          length,
+                                      void *                 output,
+                                      ScanlineBuffer &       buffer) const
+{
+  // The farthest stage reads the root image, each following stage reads the
+  // scanline written by the previous one, and the nearest stage writes the
+  // requested output.
+  const void * input = m_Stages.back()->GetFusedInputScanline(index);
+  unsigned int which = 0;
+  for (auto it = m_Stages.rbegin(); it != m_Stages.rend(); ++it, ++which)
+  {
+    void * stageOutput =
+      (it + 1 == m_Stages.rend()) ? output : buffer.GetScanline(which, length * (*it)->GetFusedOutputPixelSize());
+    (*it)->FusedProcessScanline(input, stageOutput, length);
+    input = stageOutput;
+  }
+}
+
+std::vector<std::string>
+PixelwiseFusionChain::GetFusedFilterNames() const
+{
+  std::vector<std::string> names;
+  for (auto it = m_Stages.rbegin(); it != m_Stages.rend(); ++it)
+  {
+    names.emplace_back((*it)->GetFusedProcessObject()->GetNameOfClass());
+  }
+  return names;
+}
+
+void
+PixelwiseFusionChain::SetGlobalDefaultPixelwiseFusion(bool fusion)
+{
+  globalDefaultPixelwiseFusion = fusion;
+}
+
+bool
+PixelwiseFusionChain::GetGlobalDefaultPixelwiseFusion()
+{
+  return globalDefaultPixelwiseFusion;
+}
+
+} // end namespace itk
@@ -32,6 +32,7 @@
 #include <sstream>
 #include <algorithm>
 #include "itkMultiThreaderBase.h"
+#include "itkPipelineProfiler.h"
 
 namespace itk
 {
@@ -1704,6 +1705,11 @@ ProcessObject ::UpdateOutputData(DataObject * itkNotUsed(output))
   m_AbortGenerateData = false;
   m_Progress = 0u;
 
+  /**
+   * Record the execution in the pipeline timeline, when profiling is enabled
+   */
+  const PipelineProfiler::ProcessObjectScope profilerScope(this);
+
   try
   {
     this->GenerateData();
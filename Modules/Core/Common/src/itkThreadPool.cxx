@@ -29,6 +29,11 @@
 
 namespace itk
 {
+namespace
+{
+// Set in the threads of the pool
+thread_local bool isPoolThread = false;
+} // namespace
 
 struct ThreadPoolGlobals
 {
@@ -125,6 +130,12 @@ ThreadPool ::GetMutex()
   return m_PimplGlobals->m_Mutex;
 }
 
+bool
+ThreadPool ::IsPoolThread()
+{
+  return isPoolThread;
+}
+
 int
 ThreadPool ::GetNumberOfCurrentlyIdleThreads() const
 {
@@ -160,6 +171,7 @@ ThreadPool ::ThreadExecute()
 {
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  isPoolThread = true;
 
   while (true)
   {
@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferPool.h"
+#include "itkImage.h"
+
+#include "itkGTest.h"
+
+#include <complex>
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 2>;
+
+ImageType::Pointer
+CreateImage(itk::SizeValueType size, bool initializePixels = false)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { size, size } });
+  image->Allocate(initializePixels);
+  return image;
+}
+
+// Empty the pool and its statistics before each test
+class ImageBufferPoolFixture : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    m_Pool = itk::ImageBufferPool::GetInstance();
+    m_Pool->Clear();
+    m_Pool->ResetStatistics();
+    m_DefaultMaximumPooledSize = m_Pool->GetMaximumPooledSize();
+  }
+  void
+  TearDown() override
+  {
+    itk::ImageBufferPool::SetEnabled(false);
+    m_Pool->SetMaximumPooledSize(m_DefaultMaximumPooledSize);
+    m_Pool->Clear();
+  }
+
+  itk::ImageBufferPool::Pointer m_Pool;
+  itk::SizeValueType            m_DefaultMaximumPooledSize;
+};
+
+} // namespace
+
+
+TEST(ImageBufferPool, SizeClasses)
+{
+  EXPECT_EQ(65536u, itk::ImageBufferPool::GetSizeClass(65536));
+  EXPECT_EQ(65536u + 8192u, itk::ImageBufferPool::GetSizeClass(65537));
+  EXPECT_EQ(2 * 65536u, itk::ImageBufferPool::GetSizeClass(2 * 65536 - 1));
+  for (itk::SizeValueType size = 1; size < 100000; size += 97)
+  {
+    const itk::SizeValueType sizeClass = itk::ImageBufferPool::GetSizeClass(size);
+    EXPECT_GE(sizeClass, size);
+    EXPECT_LE(sizeClass, size + size / 8 + 1);
+  }
+
+  EXPECT_TRUE(itk::ImageBufferPool::IsPoolable<float>());
+  EXPECT_FALSE(itk::ImageBufferPool::IsPoolable<std::complex<float>>());
+}
+
+
+TEST_F(ImageBufferPoolFixture, DisabledByDefault)
+{
+  EXPECT_FALSE(itk::ImageBufferPool::GetEnabled());
+  EXPECT_EQ(itk::SizeValueType{ 1 } << 30, m_Pool->GetMaximumPooledSize());
+  CreateImage(256);
+  CreateImage(256);
+  EXPECT_EQ(0u, m_Pool->GetNumberOfHits());
+  EXPECT_EQ(0u, m_Pool->GetNumberOfMisses());
+  EXPECT_EQ(0u, m_Pool->GetPooledSize());
+}
+
+
+TEST_F(ImageBufferPoolFixture, ReusesReleasedBuffers)
+{
+  const itk::ImageBufferPool::EnabledScope poolScope;
+  EXPECT_TRUE(itk::ImageBufferPool::GetEnabled());
+
+  const float * firstBuffer = CreateImage(256)->GetBufferPointer();
+  EXPECT_EQ(0u, m_Pool->GetNumberOfHits());
+  EXPECT_EQ(1u, m_Pool->GetNumberOfMisses());
+  EXPECT_EQ(256u * 256u * sizeof(float), m_Pool->GetPooledSize());
+
+  // A slightly smaller image uses the same size class
+  auto image = CreateImage(250, true);
+  EXPECT_EQ(firstBuffer, image->GetBufferPointer());
+  EXPECT_EQ(1u, m_Pool->GetNumberOfHits());
+  EXPECT_EQ(0u, m_Pool->GetPooledSize());
+  EXPECT_EQ(256u * 256u * sizeof(float), m_Pool->GetAllocatedSize());
+  EXPECT_EQ(0.0f, image->GetPixel({ { 249, 249 } }));
+
+  image = nullptr;
+  EXPECT_EQ(0u, m_Pool->GetAllocatedSize());
+  m_Pool->Print(std::cout);
+
+  m_Pool->Clear();
+  EXPECT_EQ(0u, m_Pool->GetPooledSize());
+}
+
+
+TEST_F(ImageBufferPoolFixture, SmallBuffersAreNotPooled)
+{
+  itk::ImageBufferPool::SetEnabled(true);
+  CreateImage(16);
+  EXPECT_EQ(0u, m_Pool->GetNumberOfMisses());
+  EXPECT_EQ(0u, m_Pool->GetPooledSize());
+}
+
+
+TEST_F(ImageBufferPoolFixture, MaximumPooledSize)
+{
+  itk::ImageBufferPool::SetEnabled(true);
+  m_Pool->SetMaximumPooledSize(0);
+  CreateImage(256);
+  EXPECT_EQ(1u, m_Pool->GetNumberOfMisses());
+  EXPECT_EQ(0u, m_Pool->GetPooledSize());
+  EXPECT_EQ(0u, m_Pool->GetAllocatedSize());
+}
+
+
+TEST_F(ImageBufferPoolFixture, BuffersAllocatedWhileEnabledAreReleasedToThePool)
+{
+  ImageType::Pointer image;
+  {
+    const itk::ImageBufferPool::EnabledScope poolScope;
+    image = CreateImage(256);
+  }
+  EXPECT_FALSE(itk::ImageBufferPool::GetEnabled());
+  image = nullptr;
+  EXPECT_EQ(256u * 256u * sizeof(float), m_Pool->GetPooledSize());
+}
+
+
+TEST_F(ImageBufferPoolFixture, BuffersAreOnlyReusedForTheSameElementType)
+{
+  const itk::ImageBufferPool::EnabledScope poolScope;
+  CreateImage(256);
+
+  using IntegerImageType = itk::Image<int32_t, 2>;
+  auto image = IntegerImageType::New();
+  image->SetRegions(IntegerImageType::SizeType{ { 256, 256 } });
+  image->Allocate();
+  EXPECT_EQ(0u, m_Pool->GetNumberOfHits());
+  EXPECT_EQ(2u, m_Pool->GetNumberOfMisses());
+  EXPECT_EQ(256u * 256u * sizeof(float), m_Pool->GetPooledSize());
+}
+
+
+TEST_F(ImageBufferPoolFixture, UnmanagedBuffersAreDetached)
+{
+  const itk::ImageBufferPool::EnabledScope poolScope;
+
+  float * buffer;
+  {
+    auto image = CreateImage(256);
+    buffer = image->GetBufferPointer();
+    image->GetPixelContainer()->ContainerManageMemoryOff();
+    EXPECT_EQ(0u, m_Pool->GetAllocatedSize());
+  }
+  EXPECT_EQ(0u, m_Pool->GetPooledSize());
+
+  // The application owns the buffer
+  delete[] buffer;
+
+  // A buffer at the same address, which is not from the pool, is not pooled
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 256, 256 } });
+  image->GetPixelContainer()->SetImportPointer(new float[256 * 256], 256 * 256, true);
+  image = nullptr;
+  EXPECT_EQ(0u, m_Pool->GetPooledSize());
+}
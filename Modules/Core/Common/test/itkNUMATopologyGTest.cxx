@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNUMATopology.h"
+#include "itkMultiThreaderBase.h"
+#include "itkPoolMultiThreader.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+
+#include "itkGTest.h"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+
+// Restore the NUMA-aware default after each test
+class NUMATopologyFixture : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    m_NUMAAware = itk::MultiThreaderBase::GetGlobalDefaultNUMAAware();
+  }
+  void
+  TearDown() override
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultNUMAAware(m_NUMAAware);
+  }
+
+  bool m_NUMAAware{ false };
+};
+
+} // namespace
+
+
+TEST(NUMATopology, Topology)
+{
+  const unsigned int numberOfNodes = itk::NUMATopology::GetNumberOfNodes();
+  ASSERT_GE(numberOfNodes, 1u);
+  for (unsigned int node = 0; node < numberOfNodes; ++node)
+  {
+    EXPECT_FALSE(itk::NUMATopology::GetProcessorsOfNode(node).empty());
+  }
+
+  EXPECT_EQ(itk::NUMATopology::GetNodeOfPosition(0, 1000), 0u);
+  EXPECT_EQ(itk::NUMATopology::GetNodeOfPosition(999, 1000), numberOfNodes - 1);
+  EXPECT_EQ(itk::NUMATopology::GetNodeOfPosition(0, 0), 0u);
+  for (itk::SizeValueType position = 1; position < 1000; ++position)
+  {
+    EXPECT_GE(itk::NUMATopology::GetNodeOfPosition(position, 1000),
+              itk::NUMATopology::GetNodeOfPosition(position - 1, 1000));
+  }
+
+  // Binding to a node and back must not fail, whatever the platform
+  {
+    const itk::NUMATopology::ScopedNodeBinding binding(numberOfNodes - 1);
+  }
+}
+
+
+TEST(NUMATopology, FirstTouchZeroFill)
+{
+  // Odd sizes and offsets, to exercise the alignment of the parts on pages
+  for (const itk::SizeValueType numberOfBytes : { 1ul, 4095ul, 4097ul, 123457ul, 1000003ul })
+  {
+    std::vector<char> buffer(numberOfBytes + 3, 1);
+    itk::NUMATopology::FirstTouchZeroFill(buffer.data() + 1, numberOfBytes);
+    EXPECT_EQ(buffer.front(), 1);
+    EXPECT_EQ(buffer[numberOfBytes + 1], 1);
+    EXPECT_EQ(buffer.back(), 1);
+    EXPECT_TRUE(std::all_of(buffer.begin() + 1, buffer.begin() + 1 + numberOfBytes, [](char c) { return c == 0; }));
+  }
+}
+
+
+TEST(NUMATopology, FirstTouchZeroFillFromWorkUnits)
+{
+  // Allocating from the work units of the pool must not dispatch more work
+  // to the pool, which could deadlock
+  constexpr itk::SizeValueType numberOfBytes = 100000;
+  constexpr itk::SizeValueType numberOfBuffers = 16;
+
+  std::vector<std::vector<char>> buffers(numberOfBuffers, std::vector<char>(numberOfBytes, 1));
+
+  auto threader = itk::PoolMultiThreader::New();
+  threader->ParallelizeArray(
+    0,
+    numberOfBuffers,
+    [&buffers](itk::SizeValueType i) { itk::NUMATopology::FirstTouchZeroFill(buffers[i].data(), numberOfBytes); },
+    nullptr);
+
+  for (const auto & buffer : buffers)
+  {
+    EXPECT_TRUE(std::all_of(buffer.begin(), buffer.end(), [](char c) { return c == 0; }));
+  }
+}
+
+
+TEST_F(NUMATopologyFixture, GlobalDefaultNUMAAware)
+{
+  itk::MultiThreaderBase::SetGlobalDefaultNUMAAware(true);
+  EXPECT_TRUE(itk::MultiThreaderBase::GetGlobalDefaultNUMAAware());
+  itk::MultiThreaderBase::SetGlobalDefaultNUMAAware(false);
+  EXPECT_FALSE(itk::MultiThreaderBase::GetGlobalDefaultNUMAAware());
+}
+
+
+TEST_F(NUMATopologyFixture, InitializedImageIsZero)
+{
+  itk::MultiThreaderBase::SetGlobalDefaultNUMAAware(true);
+
+  using ImageType = itk::Image<double, 3>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 67, 45, 23 } });
+  image->Allocate(true);
+
+  itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), 0.0);
+  }
+}
+
+
+TEST_F(NUMATopologyFixture, ParallelizeImageRegionCoversRegion)
+{
+  using ImageType = itk::Image<unsigned int, 3>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 31, 17, 13 } });
+  image->Allocate(true);
+
+  itk::MultiThreaderBase::SetGlobalDefaultNUMAAware(true);
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  threader->SetNumberOfWorkUnits(5);
+  threader->ParallelizeImageRegion<3>(
+    image->GetBufferedRegion(),
+    [image](const ImageType::RegionType & region) {
+      itk::ImageRegionIterator<ImageType> it(image, region);
+      for (; !it.IsAtEnd(); ++it)
+      {
+        it.Set(it.Get() + 1);
+      }
+    },
+    nullptr);
+
+  itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), 1u);
+  }
+}
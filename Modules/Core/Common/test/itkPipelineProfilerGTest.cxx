@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPipelineProfiler.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkImage.h"
+
+#include "itkGTest.h"
+
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+
+struct PlusOne
+{
+  bool
+  operator!=(const PlusOne &) const
+  {
+    return false;
+  }
+  bool
+  operator==(const PlusOne & other) const
+  {
+    return !(*this != other);
+  }
+  float
+  operator()(const float & p) const
+  {
+    return p + 1.0f;
+  }
+};
+
+using ImageType = itk::Image<float, 2>;
+using FilterType = itk::UnaryFunctorImageFilter<ImageType, ImageType, PlusOne>;
+
+// The data objects do not keep their source alive: return both filters
+std::pair<FilterType::Pointer, FilterType::Pointer>
+CreatePipeline()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 32, 16 } });
+  image->Allocate();
+  image->FillBuffer(1.0f);
+
+  auto first = FilterType::New();
+  first->SetInput(image);
+  first->SetObjectName("first");
+  auto second = FilterType::New();
+  second->SetInput(first->GetOutput());
+  return { first, second };
+}
+
+} // namespace
+
+
+TEST(PipelineProfiler, DisabledByDefault)
+{
+  EXPECT_FALSE(itk::PipelineProfiler::GetEnabled());
+
+  itk::PipelineProfiler::Pointer profiler = itk::PipelineProfiler::GetInstance();
+  EXPECT_EQ(profiler, itk::PipelineProfiler::New());
+  profiler->Clear();
+
+  CreatePipeline().second->Update();
+  EXPECT_EQ(0u, profiler->GetNumberOfEvents());
+}
+
+
+TEST(PipelineProfiler, RecordsFiltersAndWorkUnits)
+{
+  itk::PipelineProfiler::Pointer profiler = itk::PipelineProfiler::GetInstance();
+  profiler->Clear();
+
+  itk::PipelineProfiler::SetEnabled(true);
+  CreatePipeline().second->Update();
+  itk::PipelineProfiler::SetEnabled(false);
+
+  unsigned int numberOfFilters = 0;
+  unsigned int numberOfWorkUnits = 0;
+  double       workUnitPixels = 0.0;
+  for (const auto & event : profiler->GetEvents())
+  {
+    EXPECT_GE(event.Duration, 0.0);
+    if (event.Category == "filter")
+    {
+      ++numberOfFilters;
+      ASSERT_EQ(2u, event.Arguments.size());
+      EXPECT_EQ("requestedRegion", event.Arguments[0].first);
+      EXPECT_EQ("index [0, 0] size [32, 16]", event.Arguments[0].second);
+      EXPECT_EQ("bufferedRegion", event.Arguments[1].first);
+      ASSERT_FALSE(event.Values.empty());
+      EXPECT_EQ("memoryUsageKB", event.Values[0].first);
+    }
+    else if (event.Category == "work unit")
+    {
+      ++numberOfWorkUnits;
+      workUnitPixels += event.Values[0].second;
+    }
+  }
+  EXPECT_EQ(2u, numberOfFilters);
+  EXPECT_GE(numberOfWorkUnits, 2u);
+  EXPECT_EQ(2.0 * 32 * 16, workUnitPixels);
+
+  std::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  EXPECT_EQ(0u, trace.str().find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.str().find("\"name\":\"UnaryFunctorImageFilter (first)\""));
+  EXPECT_NE(std::string::npos, trace.str().find("\"ph\":\"C\""));
+
+  profiler->Clear();
+  EXPECT_EQ(0u, profiler->GetNumberOfEvents());
+}
+
+
+TEST(PipelineProfiler, WriteToInvalidFileThrows)
+{
+  EXPECT_THROW(itk::PipelineProfiler::GetInstance()->WriteChromeTrace("/nonexistent-directory/trace.json"),
+               itk::ExceptionObject);
+}
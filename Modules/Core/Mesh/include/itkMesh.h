@@ -34,10 +34,13 @@
 #include "itkBoundingBox.h"
 #include "itkCellInterface.h"
 #include "itkMapContainer.h"
+#include "itkVectorContainer.h"
 #include "itkCommonEnums.h"
 #include "ITKMeshExport.h"
 #include <vector>
 #include <set>
+#include <mutex>
+#include <type_traits>
 
 namespace itk
 {
@@ -263,10 +266,67 @@ public:
   using BoundaryAssignmentsContainerPointer = typename BoundaryAssignmentsContainer::Pointer;
   using BoundaryAssignmentsContainerVector = std::vector<BoundaryAssignmentsContainerPointer>;
 
+  /** Containers of the compact cell storage.  The point identifiers of
+   * all the cells are stored contiguously in a CellsConnectivityContainer,
+   * and cell i uses the identifiers at positions [offsets[i], offsets[i+1])
+   * of a CellsOffsetsContainer.  See SetCompactCells(). */
+  using CellsConnectivityContainer = VectorContainer<SizeValueType, PointIdentifier>;
+  using CellsConnectivityContainerPointer = typename CellsConnectivityContainer::Pointer;
+  using CellsOffsetsContainer = VectorContainer<CellIdentifier, SizeValueType>;
+  using CellsOffsetsContainerPointer = typename CellsOffsetsContainer::Pointer;
+
+  /** \class CellView
+   * Lightweight, non-owning view of the geometry and the point
+   * identifiers of a cell, valid as long as the cells of the mesh are not
+   * modified.  It is obtained without allocating a cell object, whether
+   * the mesh stores its cells compactly or as cell objects.
+   * \ingroup ITKMesh
+   */
+  class CellView
+  {
+  public:
+    CellView(CellGeometryEnum type, const PointIdentifier * first, const PointIdentifier * last)
+      : m_Type(type)
+      , m_First(first)
+      , m_Last(last)
+    {}
+
+    CellGeometryEnum
+    GetType() const
+    {
+      return m_Type;
+    }
+
+    unsigned int
+    GetNumberOfPoints() const
+    {
+      return static_cast<unsigned int>(m_Last - m_First);
+    }
+
+    const PointIdentifier *
+    begin() const
+    {
+      return m_First;
+    }
+
+    const PointIdentifier *
+    end() const
+    {
+      return m_Last;
+    }
+
+    PointIdentifier operator[](unsigned int localId) const { return m_First[localId]; }
+
+  private:
+    CellGeometryEnum        m_Type;
+    const PointIdentifier * m_First;
+    const PointIdentifier * m_Last;
+  };
+
 protected:
   /** Holds cells used by the mesh.  Individual cells are accessed
    *  through cell identifiers.  */
-  CellsContainerPointer m_CellsContainer;
+  mutable CellsContainerPointer m_CellsContainer;
 
   /** An object containing data associated with the mesh's cells.
    *  Optionally, this can be nullptr, indicating that no data are associated
@@ -279,6 +339,16 @@ protected:
    *  container which holds the cell identifiers */
   mutable CellLinksContainerPointer m_CellLinksContainer;
 
+  /** Compact storage of the cells, used instead of cell objects when
+   *  the connectivity container is not null.  The const GetCells() and
+   *  GetCellsOffsets() leave it untouched; they fill m_CellsContainer and
+   *  m_FixedCellsOffsets on demand, under m_CompactCellsMutex.  */
+  CellsConnectivityContainerPointer    m_CellsConnectivity;
+  CellsOffsetsContainerPointer         m_CellsOffsets;
+  mutable CellsOffsetsContainerPointer m_FixedCellsOffsets;
+  CellGeometryEnum                     m_CompactCellsGeometry{ CellGeometryEnum::LAST_ITK_CELL };
+  mutable std::mutex                   m_CompactCellsMutex;
+
   /** A vector of objects containing explicit cell boundary assignments.
    *  The vector is indexed by the topological dimension of the cell
    *  boundary.  The container for each topological dimension holds
@@ -327,7 +397,9 @@ public:
   GetCellLinks() const;
 
   /** Access m_CellsContainer, which holds cells used by the mesh.
-   *  Individual cells are accessed through cell identifiers.  */
+   *  Individual cells are accessed through cell identifiers.  If the
+   *  cells are stored compactly, GetCells() first converts them to cell
+   *  objects, and the mesh no longer has compact cells.  */
   void
   SetCells(CellsContainer *);
 
@@ -337,6 +409,55 @@ public:
   const CellsContainer *
   GetCells() const;
 
+  /** Store the cells compactly, as cells of a single geometry whose point
+   *  identifiers are contiguous in the connectivity container, instead of
+   *  as one heap allocated cell object per cell.  The offsets container
+   *  holds one more element than there are cells; it may be null for
+   *  geometries with a fixed number of points, such as triangles or
+   *  tetrahedra, and is required for polygons.  Cell objects currently in
+   *  the mesh are released.
+   *
+   *  GetNumberOfCells(), GetCell(), GetCellView(), BuildCellLinks(),
+   *  Accept() and the neighborhood queries use the compact storage
+   *  directly; GetCell() gives a newly allocated copy of the cell.
+   *  SetCell() and the non-const GetCells() convert the cells to cell
+   *  objects and leave the compact storage.  The const GetCells() gives
+   *  cell objects converted once and cached, keeping the compact storage,
+   *  so that it is safe to call from several threads.  */
+  void
+  SetCompactCells(CellGeometryEnum             cellGeometry,
+                  CellsConnectivityContainer * connectivity,
+                  CellsOffsetsContainer *      offsets = nullptr);
+
+  /** Whether the cells are stored compactly.  */
+  bool
+  HasCompactCells() const
+  {
+    return m_CellsConnectivity.IsNotNull();
+  }
+
+  /** Get the geometry of the compactly stored cells.  */
+  itkGetConstMacro(CompactCellsGeometry, CellGeometryEnum);
+
+  /** Get the containers of the compactly stored cells.  The offsets
+   *  container is created on demand for fixed size geometries.  */
+  const CellsConnectivityContainer *
+  GetCellsConnectivity() const;
+
+  const CellsOffsetsContainer *
+  GetCellsOffsets() const;
+
+  /** Get a lightweight view of a cell, without allocating a cell object.
+   *  An exception is thrown if the cell does not exist.  */
+  CellView
+  GetCellView(CellIdentifier cellId) const;
+
+  /** Number of points of the cells of a geometry, or zero for the
+   *  geometries, such as polygons, whose cells have a variable number of
+   *  points.  */
+  static unsigned int
+  GetNumberOfPointsOfCellGeometry(CellGeometryEnum cellGeometry);
+
   /** Access m_CellDataContainer, which contains data associated with
    *  the mesh's cells.  Optionally, this can be nullptr, indicating that
    *  no data are associated with the cells.  The data for a cell can
@@ -491,6 +612,25 @@ protected:
   void
   ReleaseCellsMemory();
 
+  /** Create a cell object of the compact cells geometry holding the point
+   *  identifiers [first, last).  */
+  void
+  CreateCompactCell(const PointIdentifier * first, const PointIdentifier * last, CellAutoPointer & cell) const;
+
+  /** Create cell objects holding copies of the compactly stored cells.  */
+  CellsContainerPointer
+  CreateCompactCellObjects() const;
+
+  /** Convert the compactly stored cells to cell objects, and leave the
+   *  compact storage.  */
+  void
+  ExpandCompactCells();
+
+  /** Modification time of the cells, used to detect out of date cell
+   *  links.  */
+  ModifiedTimeType
+  GetCellsMTime() const;
+
   /** The bounding box (xmin,xmax, ymin,ymax, ...) of the mesh. The
    * bounding box is used for searching, picking, display, etc. */
   BoundingBoxPointer m_BoundingBox;
@@ -499,6 +639,20 @@ private:
   MeshClassCellsAllocationMethodEnum m_CellsAllocationMethod;
 }; // End Class: Mesh
 
+/** \class MeshSupportsCompactCells
+ * \brief Whether a mesh type may be given compactly stored cells.
+ *
+ * Only itk::Mesh itself is: QuadEdgeMesh and the other derived meshes
+ * rely on their own cell objects, so readers and filters fill them cell
+ * by cell.
+ *
+ * \ingroup ITKMesh
+ */
+template <typename TMesh>
+struct MeshSupportsCompactCells
+  : std::is_same<TMesh, Mesh<typename TMesh::PixelType, TMesh::PointDimension, typename TMesh::MeshTraits>>
+{};
+
 /** Define how to print enumeration */
 extern ITKMesh_EXPORT std::ostream &
                       operator<<(std::ostream & out, const MeshEnums::MeshClassCellsAllocationMethod value);
@@ -30,6 +30,14 @@
 
 #include "itkMesh.h"
 #include "itkProcessObject.h"
+#include "itkHexahedronCell.h"
+#include "itkPolygonCell.h"
+#include "itkQuadraticEdgeCell.h"
+#include "itkQuadraticTriangleCell.h"
+#include "itkQuadrilateralCell.h"
+#include "itkTetrahedronCell.h"
+#include "itkTriangleCell.h"
+#include "itkVertexCell.h"
 #include <algorithm>
 #include <iterator>
 
@@ -43,7 +51,12 @@ Mesh<TPixelType, VDimension, TMeshTraits>::PrintSelf(std::ostream & os, Indent i
   os << indent << "Number Of Points: " << ((this->m_PointsContainer.GetPointer()) ? this->m_PointsContainer->Size() : 0)
      << std::endl;
   os << indent << "Number Of Cell Links: " << ((m_CellLinksContainer) ? m_CellLinksContainer->Size() : 0) << std::endl;
-  os << indent << "Number Of Cells: " << ((m_CellsContainer) ? m_CellsContainer->Size() : 0) << std::endl;
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << std::endl;
+  os << indent << "Compact Cells: " << (this->HasCompactCells() ? "On" : "Off") << std::endl;
+  if (this->HasCompactCells())
+  {
+    os << indent << "Compact Cells Geometry: " << m_CompactCellsGeometry << std::endl;
+  }
   os << indent
      << "Cell Data Container pointer: " << ((m_CellDataContainer) ? m_CellDataContainer.GetPointer() : nullptr)
      << std::endl;
@@ -96,10 +109,13 @@ void
 Mesh<TPixelType, VDimension, TMeshTraits>::SetCells(CellsContainer * cells)
 {
   itkDebugMacro("setting Cells container to " << cells);
-  if (m_CellsContainer != cells)
+  if (m_CellsContainer != cells || this->HasCompactCells())
   {
     this->ReleaseCellsMemory();
     m_CellsContainer = cells;
+    m_CellsConnectivity = nullptr;
+    m_CellsOffsets = nullptr;
+    m_FixedCellsOffsets = nullptr;
     this->Modified();
   }
 }
@@ -111,6 +127,7 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 typename Mesh<TPixelType, VDimension, TMeshTraits>::CellsContainer *
 Mesh<TPixelType, VDimension, TMeshTraits>::GetCells()
 {
+  this->ExpandCompactCells();
   itkDebugMacro("returning Cells container of " << m_CellsContainer);
   return m_CellsContainer;
 }
@@ -119,10 +136,159 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 const typename Mesh<TPixelType, VDimension, TMeshTraits>::CellsContainer *
 Mesh<TPixelType, VDimension, TMeshTraits>::GetCells() const
 {
+  if (this->HasCompactCells())
+  {
+    // Convert the cells once, keeping the compact storage that other
+    // const methods may be reading concurrently
+    const std::lock_guard<std::mutex> lock(m_CompactCellsMutex);
+    if (!m_CellsContainer)
+    {
+      m_CellsContainer = this->CreateCompactCellObjects();
+    }
+  }
   itkDebugMacro("returning Cells container of " << m_CellsContainer);
   return m_CellsContainer;
 }
 
+/**
+ * Access routine to store the cells compactly.
+ */
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+void
+Mesh<TPixelType, VDimension, TMeshTraits>::SetCompactCells(CellGeometryEnum             cellGeometry,
+                                                           CellsConnectivityContainer * connectivity,
+                                                           CellsOffsetsContainer *      offsets)
+{
+  if (!connectivity)
+  {
+    itkExceptionMacro(<< "The connectivity container of the compact cells is null");
+  }
+
+  const unsigned int numberOfPoints = GetNumberOfPointsOfCellGeometry(cellGeometry);
+  if (offsets)
+  {
+    if (offsets->Size() == 0 || offsets->ElementAt(offsets->Size() - 1) != connectivity->Size())
+    {
+      itkExceptionMacro(<< "The offsets of the compact cells do not match the " << connectivity->Size()
+                        << " point identifiers of the connectivity container");
+    }
+  }
+  else if (numberOfPoints == 0)
+  {
+    itkExceptionMacro(<< "The offsets of the compact cells are required for " << cellGeometry << " cells");
+  }
+  else if (connectivity->Size() % numberOfPoints != 0)
+  {
+    itkExceptionMacro(<< "The " << connectivity->Size() << " point identifiers are not a whole number of "
+                      << cellGeometry << " cells");
+  }
+
+  itkDebugMacro("setting compact cells of geometry " << cellGeometry);
+  this->ReleaseCellsMemory();
+  // The cell objects are created on demand by the const GetCells()
+  m_CellsContainer = nullptr;
+  m_CellsAllocationMethod = MeshClassCellsAllocationMethodEnum::CellsAllocatedDynamicallyCellByCell;
+  m_CompactCellsGeometry = cellGeometry;
+  m_CellsConnectivity = connectivity;
+  m_CellsOffsets = offsets;
+  m_FixedCellsOffsets = nullptr;
+  this->Modified();
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+const typename Mesh<TPixelType, VDimension, TMeshTraits>::CellsConnectivityContainer *
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellsConnectivity() const
+{
+  return m_CellsConnectivity;
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+const typename Mesh<TPixelType, VDimension, TMeshTraits>::CellsOffsetsContainer *
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellsOffsets() const
+{
+  if (!m_CellsConnectivity || m_CellsOffsets)
+  {
+    return m_CellsOffsets;
+  }
+
+  // Fixed size cells: the offsets are multiples of the cell size
+  const std::lock_guard<std::mutex> lock(m_CompactCellsMutex);
+  if (!m_FixedCellsOffsets)
+  {
+    const unsigned int           numberOfPoints = GetNumberOfPointsOfCellGeometry(m_CompactCellsGeometry);
+    const CellIdentifier         numberOfCells = m_CellsConnectivity->Size() / numberOfPoints;
+    CellsOffsetsContainerPointer offsets = CellsOffsetsContainer::New();
+    offsets->Reserve(numberOfCells + 1);
+    for (CellIdentifier ii = 0; ii <= numberOfCells; ++ii)
+    {
+      offsets->SetElement(ii, ii * numberOfPoints);
+    }
+    m_FixedCellsOffsets = offsets;
+  }
+  return m_FixedCellsOffsets;
+}
+
+/**
+ * Get a view of a cell without allocating a cell object.
+ */
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+typename Mesh<TPixelType, VDimension, TMeshTraits>::CellView
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellView(CellIdentifier cellId) const
+{
+  if (this->HasCompactCells())
+  {
+    if (cellId >= this->GetNumberOfCells())
+    {
+      itkExceptionMacro(<< "Cell " << cellId << " does not exist");
+    }
+    const PointIdentifier * connectivity = m_CellsConnectivity->CastToSTLConstContainer().data();
+    if (m_CellsOffsets)
+    {
+      return CellView(m_CompactCellsGeometry,
+                      connectivity + m_CellsOffsets->ElementAt(cellId),
+                      connectivity + m_CellsOffsets->ElementAt(cellId + 1));
+    }
+    const unsigned int numberOfPoints = GetNumberOfPointsOfCellGeometry(m_CompactCellsGeometry);
+    return CellView(m_CompactCellsGeometry,
+                    connectivity + cellId * numberOfPoints,
+                    connectivity + (cellId + 1) * numberOfPoints);
+  }
+
+  CellType * cell = nullptr;
+  if (!m_CellsContainer || !m_CellsContainer->GetElementIfIndexExists(cellId, &cell))
+  {
+    itkExceptionMacro(<< "Cell " << cellId << " does not exist");
+  }
+  return CellView(cell->GetType(), cell->PointIdsBegin(), cell->PointIdsEnd());
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+unsigned int
+Mesh<TPixelType, VDimension, TMeshTraits>::GetNumberOfPointsOfCellGeometry(CellGeometryEnum cellGeometry)
+{
+  switch (cellGeometry)
+  {
+    case CellGeometryEnum::VERTEX_CELL:
+      return 1;
+    case CellGeometryEnum::LINE_CELL:
+      return 2;
+    case CellGeometryEnum::TRIANGLE_CELL:
+      return 3;
+    case CellGeometryEnum::QUADRILATERAL_CELL:
+      return 4;
+    case CellGeometryEnum::TETRAHEDRON_CELL:
+      return 4;
+    case CellGeometryEnum::HEXAHEDRON_CELL:
+      return 8;
+    case CellGeometryEnum::QUADRATIC_EDGE_CELL:
+      return 3;
+    case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+      return 6;
+    default:
+      return 0;
+  }
+}
+
 /**
  * Access routine to set the cell data container.
  */
@@ -217,8 +383,9 @@ void
 Mesh<TPixelType, VDimension, TMeshTraits>::SetCell(CellIdentifier cellId, CellAutoPointer & cellPointer)
 {
   /**
-   * Make sure a cells container exists.
+   * Make sure a cells container exists, holding cell objects.
    */
+  this->ExpandCompactCells();
   if (!m_CellsContainer)
   {
     this->SetCells(CellsContainer::New());
@@ -241,6 +408,21 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 bool
 Mesh<TPixelType, VDimension, TMeshTraits>::GetCell(CellIdentifier cellId, CellAutoPointer & cellPointer) const
 {
+  /**
+   * Compactly stored cells are copied to a new cell object.
+   */
+  if (this->HasCompactCells())
+  {
+    if (cellId >= this->GetNumberOfCells())
+    {
+      cellPointer.Reset();
+      return false;
+    }
+    const CellView view = this->GetCellView(cellId);
+    this->CreateCompactCell(view.begin(), view.end(), cellPointer);
+    return true;
+  }
+
   /**
    * If the cells container doesn't exist, then the cell doesn't exist.
    */
@@ -429,21 +611,15 @@ typename Mesh<TPixelType, VDimension, TMeshTraits>::CellFeatureCount
 Mesh<TPixelType, VDimension, TMeshTraits>::GetNumberOfCellBoundaryFeatures(int dimension, CellIdentifier cellId) const
 {
   /**
-   * Make sure the cell container exists and contains the given cell Id.
+   * Make sure the cell exists, and ask it for its boundary count of the
+   * given dimension.
    */
-  if (!m_CellsContainer)
-  {
-    return 0;
-  }
-  if (!m_CellsContainer->IndexExists(cellId))
+  CellAutoPointer cell;
+  if (!this->GetCell(cellId, cell))
   {
     return 0;
   }
-
-  /**
-   * Ask the cell for its boundary count of the given dimension.
-   */
-  return m_CellsContainer->GetElement(cellId)->GetNumberOfBoundaryFeatures(dimension);
+  return cell->GetNumberOfBoundaryFeatures(dimension);
 }
 
 /**
@@ -464,6 +640,14 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 typename Mesh<TPixelType, VDimension, TMeshTraits>::CellIdentifier
 Mesh<TPixelType, VDimension, TMeshTraits>::GetNumberOfCells() const
 {
+  if (this->HasCompactCells())
+  {
+    if (m_CellsOffsets)
+    {
+      return m_CellsOffsets->Size() - 1;
+    }
+    return m_CellsConnectivity->Size() / GetNumberOfPointsOfCellGeometry(m_CompactCellsGeometry);
+  }
   if (!m_CellsContainer)
   {
     return 0;
@@ -488,6 +672,9 @@ Mesh<TPixelType, VDimension, TMeshTraits>::Initialize()
   this->ReleaseCellsMemory();
 
   m_CellsContainer = nullptr;
+  m_CellsConnectivity = nullptr;
+  m_CellsOffsets = nullptr;
+  m_FixedCellsOffsets = nullptr;
   m_CellDataContainer = nullptr;
   m_CellLinksContainer = nullptr;
 }
@@ -521,10 +708,9 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellBoundaryFeature(int
    * This will be a geometric copy of the actual boundary feature, not
    * a pointer to an actual cell in the mesh.
    */
-  if ((!m_CellsContainer.IsNull()) && m_CellsContainer->IndexExists(cellId))
+  CellAutoPointer thecell;
+  if (this->GetCell(cellId, thecell))
   {
-    // Don't take ownership
-    CellType * thecell = m_CellsContainer->GetElement(cellId);
     if (thecell->GetBoundaryFeature(dimension, featureId, boundary))
     {
       return true;
@@ -565,7 +751,8 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellBoundaryFeatureNeighbors(int
   /**
    * Sanity check on mesh status.
    */
-  if (!this->m_PointsContainer || !m_CellsContainer || (!m_CellsContainer->IndexExists(cellId)))
+  CellAutoPointer cell;
+  if (!this->m_PointsContainer || !this->GetCell(cellId, cell))
   {
     /**
      * TODO: Throw EXCEPTION here?
@@ -614,7 +801,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellBoundaryFeatureNeighbors(int
     this->BuildCellLinks();
   }
   else if ((this->m_PointsContainer->GetMTime() > m_CellLinksContainer->GetMTime()) ||
-           (m_CellsContainer->GetMTime() > m_CellLinksContainer->GetMTime()))
+           (this->GetCellsMTime() > m_CellLinksContainer->GetMTime()))
   {
     this->BuildCellLinks();
   }
@@ -629,7 +816,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellBoundaryFeatureNeighbors(int
    * First, ask the cell to construct the boundary feature so we can look
    * at its points.
    */
-  m_CellsContainer->GetElement(cellId)->GetBoundaryFeature(dimension, featureId, boundary);
+  cell->GetBoundaryFeature(dimension, featureId, boundary);
 
   /**
    * Now get the cell links for the first point.  Also allocate a second set
@@ -722,7 +909,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellNeighbors(CellIdentifier cellI
   /**
    * Sanity check on mesh status.
    */
-  if (!this->m_PointsContainer || !m_CellsContainer || (!m_CellsContainer->IndexExists(cellId)))
+  if (!this->m_PointsContainer)
   {
     /**
      * TODO: Throw EXCEPTION here?
@@ -731,8 +918,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellNeighbors(CellIdentifier cellI
   }
 
   /**
-   * Get the cell itself.  IndexExists call above should ensure that
-   * GetCell() returns true, but be safe anyway.
+   * Get the cell itself.
    */
   CellAutoPointer cell;
   if (!this->GetCell(cellId, cell))
@@ -768,7 +954,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellNeighbors(CellIdentifier cellI
    * requires that the CellLinks be built.
    */
   if (!m_CellLinksContainer || (this->m_PointsContainer->GetMTime() > m_CellLinksContainer->GetMTime()) ||
-      (m_CellsContainer->GetMTime() > m_CellLinksContainer->GetMTime()))
+      (this->GetCellsMTime() > m_CellLinksContainer->GetMTime()))
   {
     this->BuildCellLinks();
   }
@@ -873,6 +1059,10 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetAssignedCellBoundaryIfOneExists(in
 
     if (m_BoundaryAssignmentsContainers[dimension]->GetElementIfIndexExists(assignId, &boundaryId))
     {
+      if (this->HasCompactCells())
+      {
+        return this->GetCell(boundaryId, boundary);
+      }
       CellType * boundaryptr = nullptr;
       const bool found = m_CellsContainer->GetElementIfIndexExists(boundaryId, &boundaryptr);
       if (found)
@@ -896,6 +1086,27 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 void
 Mesh<TPixelType, VDimension, TMeshTraits>::Accept(CellMultiVisitorType * mv) const
 {
+  if (this->HasCompactCells())
+  {
+    // A single cell object is reused for all the compactly stored cells
+    const CellIdentifier numberOfCells = this->GetNumberOfCells();
+    CellAutoPointer      cell;
+    for (CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      const CellView view = this->GetCellView(cellId);
+      if (cell)
+      {
+        cell->SetPointIds(view.begin(), view.end());
+      }
+      else
+      {
+        this->CreateCompactCell(view.begin(), view.end(), cell);
+      }
+      cell->Accept(cellId, mv);
+    }
+    return;
+  }
+
   if (!this->m_CellsContainer)
   {
     return;
@@ -928,7 +1139,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::BuildCellLinks() const
   /**
    * Make sure we have a cells and a points container.
    */
-  if (!this->m_PointsContainer || !m_CellsContainer)
+  if (!this->m_PointsContainer || (!m_CellsContainer && !this->HasCompactCells()))
   {
     /**
      * TODO: Throw EXCEPTION here?
@@ -944,6 +1155,23 @@ Mesh<TPixelType, VDimension, TMeshTraits>::BuildCellLinks() const
     this->m_CellLinksContainer = CellLinksContainer::New();
   }
 
+  /**
+   * The compactly stored cells are read in place.
+   */
+  if (this->HasCompactCells())
+  {
+    const CellIdentifier numberOfCells = this->GetNumberOfCells();
+    for (CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      for (const PointIdentifier pointId : this->GetCellView(cellId))
+      {
+        (m_CellLinksContainer->CreateElementAt(pointId)).insert(cellId);
+      }
+    }
+    this->m_CellLinksContainer->Modified();
+    return;
+  }
+
   /**
    * Loop through each cell, and add its identifier to the CellLinks of each
    * of its points.
@@ -969,6 +1197,105 @@ Mesh<TPixelType, VDimension, TMeshTraits>::BuildCellLinks() const
  * PROTECTED METHOD DEFINITIONS
  *****************************************************************************/
 
+/**
+ * Create a cell object of the compact cells geometry.
+ */
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+void
+Mesh<TPixelType, VDimension, TMeshTraits>::CreateCompactCell(const PointIdentifier * first,
+                                                             const PointIdentifier * last,
+                                                             CellAutoPointer &       cell) const
+{
+  switch (m_CompactCellsGeometry)
+  {
+    case CellGeometryEnum::VERTEX_CELL:
+      cell.TakeOwnership(new VertexCell<CellType>);
+      break;
+    case CellGeometryEnum::LINE_CELL:
+      cell.TakeOwnership(new LineCell<CellType>);
+      break;
+    case CellGeometryEnum::TRIANGLE_CELL:
+      cell.TakeOwnership(new TriangleCell<CellType>);
+      break;
+    case CellGeometryEnum::QUADRILATERAL_CELL:
+      cell.TakeOwnership(new QuadrilateralCell<CellType>);
+      break;
+    case CellGeometryEnum::POLYGON_CELL:
+      cell.TakeOwnership(new PolygonCell<CellType>);
+      break;
+    case CellGeometryEnum::TETRAHEDRON_CELL:
+      cell.TakeOwnership(new TetrahedronCell<CellType>);
+      break;
+    case CellGeometryEnum::HEXAHEDRON_CELL:
+      cell.TakeOwnership(new HexahedronCell<CellType>);
+      break;
+    case CellGeometryEnum::QUADRATIC_EDGE_CELL:
+      cell.TakeOwnership(new QuadraticEdgeCell<CellType>);
+      break;
+    case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+      cell.TakeOwnership(new QuadraticTriangleCell<CellType>);
+      break;
+    default:
+      itkExceptionMacro(<< "Unsupported geometry of the compact cells: " << m_CompactCellsGeometry);
+  }
+  cell->SetPointIds(first, last);
+}
+
+/**
+ * Create cell objects holding copies of the compactly stored cells.
+ */
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+typename Mesh<TPixelType, VDimension, TMeshTraits>::CellsContainerPointer
+Mesh<TPixelType, VDimension, TMeshTraits>::CreateCompactCellObjects() const
+{
+  itkDebugMacro("creating cell objects from the compact cells");
+  const CellIdentifier  numberOfCells = this->GetNumberOfCells();
+  CellsContainerPointer cells = CellsContainer::New();
+  cells->Reserve(numberOfCells);
+  for (CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    const CellView  view = this->GetCellView(cellId);
+    CellAutoPointer cell;
+    this->CreateCompactCell(view.begin(), view.end(), cell);
+    cells->SetElement(cellId, cell.ReleaseOwnership());
+  }
+  return cells;
+}
+
+/**
+ * Convert the compactly stored cells to cell objects.
+ */
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+void
+Mesh<TPixelType, VDimension, TMeshTraits>::ExpandCompactCells()
+{
+  if (!this->HasCompactCells())
+  {
+    return;
+  }
+
+  // Reuse the cell objects already given by the const GetCells(); the
+  // compact cells set the allocation method to cell by cell
+  if (!m_CellsContainer)
+  {
+    m_CellsContainer = this->CreateCompactCellObjects();
+  }
+  m_CellsConnectivity = nullptr;
+  m_CellsOffsets = nullptr;
+  m_FixedCellsOffsets = nullptr;
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+ModifiedTimeType
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCellsMTime() const
+{
+  if (this->HasCompactCells())
+  {
+    return std::max(m_CellsConnectivity->GetMTime(), this->GetMTime());
+  }
+  return m_CellsContainer ? m_CellsContainer->GetMTime() : 0;
+}
+
 /**
  * A protected default constructor allows the New() routine to create an
  * instance of Mesh.  All the containers are initialized to empty
@@ -1121,6 +1448,10 @@ Mesh<TPixelType, VDimension, TMeshTraits>::Graft(const DataObject * data)
 
   this->ReleaseCellsMemory();
   this->m_CellsContainer = mesh->m_CellsContainer;
+  this->m_CellsConnectivity = mesh->m_CellsConnectivity;
+  this->m_CellsOffsets = mesh->m_CellsOffsets;
+  this->m_FixedCellsOffsets = nullptr;
+  this->m_CompactCellsGeometry = mesh->m_CompactCellsGeometry;
   this->m_CellDataContainer = mesh->m_CellDataContainer;
   this->m_CellLinksContainer = mesh->m_CellLinksContainer;
   this->m_BoundaryAssignmentsContainers = mesh->m_BoundaryAssignmentsContainers;
@@ -1143,7 +1474,9 @@ Mesh<TPixelType, VDimension, TMeshTraits>::DeleteUnusedCellData()
   std::vector<typename CellDataContainer::ElementIdentifier> cell_data_to_delete;
   for (auto it = this->GetCellData()->Begin(); it != this->GetCellData()->End(); ++it)
   {
-    if (!this->GetCells()->IndexExists(it.Index()))
+    const bool cellExists = this->HasCompactCells() ? it.Index() < this->GetNumberOfCells()
+                                                     : this->GetCells()->IndexExists(it.Index());
+    if (!cellExists)
     {
       cell_data_to_delete.push_back(it.Index());
     }
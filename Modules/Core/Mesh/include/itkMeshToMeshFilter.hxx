@@ -30,6 +30,7 @@
 
 #include "itkMesh.h"
 #include "itkMeshToMeshFilter.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -186,6 +187,32 @@ MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCells()
 
   outputMesh->SetCellsAllocationMethod(MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell);
 
+  // Compactly stored cells are copied as flat arrays, without creating
+  // cell objects, unless the output mesh relies on its cell objects
+  if (MeshSupportsCompactCells<TOutputMesh>::value && inputMesh->HasCompactCells())
+  {
+    using OutputConnectivityContainer = typename TOutputMesh::CellsConnectivityContainer;
+    using OutputOffsetsContainer = typename TOutputMesh::CellsOffsetsContainer;
+    using OutputPointIdentifier = typename TOutputMesh::PointIdentifier;
+
+    const auto & inputConnectivity = inputMesh->GetCellsConnectivity()->CastToSTLConstContainer();
+
+    typename OutputConnectivityContainer::Pointer outputConnectivity = OutputConnectivityContainer::New();
+    outputConnectivity->Reserve(inputConnectivity.size());
+    std::transform(inputConnectivity.begin(),
+                   inputConnectivity.end(),
+                   outputConnectivity->CastToSTLContainer().begin(),
+                   [](typename TInputMesh::PointIdentifier id) { return static_cast<OutputPointIdentifier>(id); });
+
+    const auto & inputOffsets = inputMesh->GetCellsOffsets()->CastToSTLConstContainer();
+
+    typename OutputOffsetsContainer::Pointer outputOffsets = OutputOffsetsContainer::New();
+    outputOffsets->CastToSTLContainer().assign(inputOffsets.begin(), inputOffsets.end());
+
+    outputMesh->SetCompactCells(inputMesh->GetCompactCellsGeometry(), outputConnectivity, outputOffsets);
+    return;
+  }
+
   typename OutputCellsContainer::Pointer outputCells = OutputCellsContainer::New();
   const InputCellsContainer *            inputCells = inputMesh->GetCells();
 
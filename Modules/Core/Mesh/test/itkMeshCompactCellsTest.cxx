@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMesh.h"
+#include "itkTransformMeshFilter.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+int
+itkMeshCompactCellsTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 2;
+  using MeshType = itk::Mesh<float, Dimension>;
+  using PointType = MeshType::PointType;
+  using CellAutoPointer = MeshType::CellAutoPointer;
+  using ConnectivityContainer = MeshType::CellsConnectivityContainer;
+  using OffsetsContainer = MeshType::CellsOffsetsContainer;
+
+  // 1------3------5
+  //   \    | \    |
+  //      \ |    \ |
+  // 0      2------4
+
+  auto mesh = MeshType::New();
+  mesh->SetPoint(0, PointType{ { { 0.0, 0.0 } } });
+  mesh->SetPoint(1, PointType{ { { 0.0, 1.0 } } });
+  mesh->SetPoint(2, PointType{ { { 1.0, 0.0 } } });
+  mesh->SetPoint(3, PointType{ { { 1.0, 1.0 } } });
+  mesh->SetPoint(4, PointType{ { { 4.0, 0.0 } } });
+  mesh->SetPoint(5, PointType{ { { 5.0, 1.0 } } });
+
+  const MeshType::PointIdentifier triangles[] = { 1, 2, 3, 3, 2, 4, 3, 4, 5 };
+  auto                            connectivity = ConnectivityContainer::New();
+  connectivity->CastToSTLContainer().assign(std::begin(triangles), std::end(triangles));
+
+  // A connectivity which is not a whole number of triangles is rejected
+  auto partialConnectivity = ConnectivityContainer::New();
+  partialConnectivity->CastToSTLContainer().assign(std::begin(triangles), std::end(triangles) - 1);
+  ITK_TRY_EXPECT_EXCEPTION(mesh->SetCompactCells(itk::CellGeometryEnum::TRIANGLE_CELL, partialConnectivity));
+
+  // So are polygons without offsets
+  ITK_TRY_EXPECT_EXCEPTION(mesh->SetCompactCells(itk::CellGeometryEnum::POLYGON_CELL, connectivity));
+
+  mesh->SetCompactCells(itk::CellGeometryEnum::TRIANGLE_CELL, connectivity);
+  ITK_TEST_EXPECT_TRUE(mesh->HasCompactCells());
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), 3);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCompactCellsGeometry(), itk::CellGeometryEnum::TRIANGLE_CELL);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellsOffsets()->ElementAt(3), 9);
+
+  // Views and cell objects give the same point identifiers
+  for (MeshType::CellIdentifier cellId = 0; cellId < 3; ++cellId)
+  {
+    const MeshType::CellView view = mesh->GetCellView(cellId);
+    ITK_TEST_EXPECT_EQUAL(view.GetType(), itk::CellGeometryEnum::TRIANGLE_CELL);
+    ITK_TEST_EXPECT_EQUAL(view.GetNumberOfPoints(), 3);
+
+    CellAutoPointer cell;
+    ITK_TEST_EXPECT_TRUE(mesh->GetCell(cellId, cell));
+    ITK_TEST_EXPECT_EQUAL(cell->GetType(), itk::CellGeometryEnum::TRIANGLE_CELL);
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      ITK_TEST_EXPECT_EQUAL(view[ii], triangles[3 * cellId + ii]);
+      ITK_TEST_EXPECT_EQUAL(cell->GetPointIds()[ii], triangles[3 * cellId + ii]);
+    }
+  }
+  CellAutoPointer missingCell;
+  ITK_TEST_EXPECT_TRUE(!mesh->GetCell(3, missingCell));
+  ITK_TRY_EXPECT_EXCEPTION(mesh->GetCellView(3));
+
+  // The neighborhood queries use the cell links built from the compact
+  // cells
+  std::set<MeshType::CellIdentifier> neighbors;
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellBoundaryFeatureNeighbors(1, 1, 0, &neighbors), 1);
+  ITK_TEST_EXPECT_TRUE(mesh->HasCompactCells());
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellLinks()->ElementAt(3).size(), 3);
+
+  // Filters copy the compact cells as they are
+  using TransformType = itk::TranslationTransform<double, Dimension>;
+  auto transform = TransformType::New();
+  transform->SetIdentity();
+  using FilterType = itk::TransformMeshFilter<MeshType, MeshType, TransformType>;
+  auto filter = FilterType::New();
+  filter->SetInput(mesh);
+  filter->SetTransform(transform);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  MeshType::Pointer output = filter->GetOutput();
+  ITK_TEST_EXPECT_TRUE(output->HasCompactCells());
+  ITK_TEST_EXPECT_EQUAL(output->GetNumberOfCells(), 3);
+  ITK_TEST_EXPECT_EQUAL(output->GetCellView(2)[2], 5);
+
+  // Polygons are stored with their offsets
+  const MeshType::PointIdentifier polygons[] = { 0, 2, 3, 1, 2, 4, 3, 3, 4, 5 };
+  auto                            polygonConnectivity = ConnectivityContainer::New();
+  polygonConnectivity->CastToSTLContainer().assign(std::begin(polygons), std::end(polygons));
+  auto offsets = OffsetsContainer::New();
+  offsets->CastToSTLContainer() = { 0, 4, 7, 10 };
+  ITK_TRY_EXPECT_EXCEPTION(mesh->SetCompactCells(itk::CellGeometryEnum::POLYGON_CELL, connectivity, offsets));
+  mesh->SetCompactCells(itk::CellGeometryEnum::POLYGON_CELL, polygonConnectivity, offsets);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), 3);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellView(0).GetNumberOfPoints(), 4);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellView(1).GetNumberOfPoints(), 3);
+
+  // The const GetCells() gives cell objects, and keeps the compact cells
+  const MeshType *                 constMesh = mesh;
+  const MeshType::CellsContainer * cells = constMesh->GetCells();
+  ITK_TEST_EXPECT_TRUE(mesh->HasCompactCells());
+  ITK_TEST_EXPECT_EQUAL(cells->Size(), 3);
+  ITK_TEST_EXPECT_EQUAL(cells->ElementAt(0)->GetType(), itk::CellGeometryEnum::POLYGON_CELL);
+  ITK_TEST_EXPECT_EQUAL(cells->ElementAt(0)->GetNumberOfPoints(), 4);
+  ITK_TEST_EXPECT_TRUE(constMesh->GetCells() == cells);
+
+  // The non-const GetCells() converts the compact cells to cell objects
+  ITK_TEST_EXPECT_TRUE(mesh->GetCells() == cells);
+  ITK_TEST_EXPECT_TRUE(!mesh->HasCompactCells());
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellView(0)[3], 1);
+
+  return EXIT_SUCCESS;
+}
@@ -15,6 +15,7 @@
  *  limitations under the License.
  *
  *=========================================================================*/
+#include "itkQuadEdgeMesh.h"
 #include "itkQuadEdgeMeshPoint.h"
 
 #include <gtest/gtest.h>
@@ -29,3 +30,11 @@ TEST(QuadEdgeMeshTypeTraits, QuadEdgeMeshPointIsNotPOD)
   EXPECT_EQ(std::is_trivial<T>::value, false);
   EXPECT_EQ(std::is_standard_layout<T>::value, false);
 }
+
+// Only itk::Mesh may be given compact cells, QuadEdgeMesh needs its own
+// cell objects
+TEST(QuadEdgeMeshTypeTraits, QuadEdgeMeshDoesNotSupportCompactCells)
+{
+  EXPECT_EQ((itk::MeshSupportsCompactCells<itk::Mesh<float, 3>>::value), true);
+  EXPECT_EQ((itk::MeshSupportsCompactCells<itk::QuadEdgeMesh<float, 3>>::value), false);
+}
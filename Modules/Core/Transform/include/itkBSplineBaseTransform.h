@@ -65,6 +65,7 @@ public:
   using JacobianType = typename Superclass::JacobianType;
   using JacobianPositionType = typename Superclass::JacobianPositionType;
   using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
+  using NonZeroJacobianIndicesType = typename Superclass::NonZeroJacobianIndicesType;
 
   /** Transform category type. */
   using TransformCategoryEnum = typename Superclass::TransformCategoryEnum;
@@ -294,6 +295,14 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override = 0;
 
+  /** Compute the Jacobian restricted to the coefficients of the support region
+   * of \c p, i.e. SpaceDimension * GetNumberOfWeights() columns instead of
+   * GetNumberOfParameters(). The indices are empty outside the valid region. */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &,
+                                               JacobianType &,
+                                               NonZeroJacobianIndicesType &) const override;
+
   void
   ComputeJacobianWithRespectToPosition(const InputPointType &, JacobianPositionType &) const override
   {
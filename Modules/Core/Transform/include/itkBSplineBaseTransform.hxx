@@ -287,6 +287,57 @@ BSplineBaseTransform<TParametersValueType, NDimensions, VSplineOrder>::
   }
 }
 
+template <typename TParametersValueType, unsigned int NDimensions, unsigned int VSplineOrder>
+void
+BSplineBaseTransform<TParametersValueType, NDimensions, VSplineOrder>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       point,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  ContinuousIndexType index;
+  this->m_CoefficientImages[0]->TransformPhysicalPointToContinuousIndex(point, index);
+
+  // Outside the valid region the displacement is zero and so is the Jacobian.
+  if (!this->InsideValidRegion(index))
+  {
+    jacobian.SetSize(SpaceDimension, 0);
+    nonZeroJacobianIndices.clear();
+    return;
+  }
+
+  const unsigned long numberOfWeights = this->m_WeightsFunction->GetNumberOfWeights();
+  WeightsType         weights(numberOfWeights);
+  IndexType           supportIndex;
+  this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+
+  RegionType supportRegion;
+  SizeType   supportSize;
+  supportSize.Fill(SplineOrder + 1);
+  supportRegion.SetSize(supportSize);
+  supportRegion.SetIndex(supportIndex);
+
+  // Column (d * numberOfWeights + k) holds the derivative with respect to the
+  // d-th component of the k-th coefficient of the support region, which only
+  // affects the d-th output component.
+  const NumberOfParametersType numberOfParametersPerDimension = this->GetNumberOfParametersPerDimension();
+  jacobian.SetSize(SpaceDimension, SpaceDimension * numberOfWeights);
+  jacobian.Fill(0.0);
+  nonZeroJacobianIndices.resize(SpaceDimension * numberOfWeights);
+
+  const ParametersValueType *         basePointer = this->m_CoefficientImages[0]->GetBufferPointer();
+  ImageRegionConstIterator<ImageType> coeffIterator(this->m_CoefficientImages[0], supportRegion);
+  unsigned long                       counter = 0;
+  for (coeffIterator.GoToBegin(); !coeffIterator.IsAtEnd(); ++coeffIterator, ++counter)
+  {
+    const auto parameterIndex = static_cast<NumberOfParametersType>(&(coeffIterator.Value()) - basePointer);
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      jacobian(d, d * numberOfWeights + counter) = weights[counter];
+      nonZeroJacobianIndices[d * numberOfWeights + counter] = parameterIndex + d * numberOfParametersPerDimension;
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int NDimensions, unsigned int VSplineOrder>
 unsigned int
 BSplineBaseTransform<TParametersValueType, NDimensions, VSplineOrder>::GetNumberOfAffectedWeights() const
@@ -20,7 +20,9 @@
 
 #include "itkMultiTransform.h"
 
+#include <atomic>
 #include <deque>
+#include <mutex>
 
 namespace itk
 {
@@ -81,6 +83,14 @@ namespace itk
  * sub transform and adding them to a composite transform in reverse order.
  * The m_TransformsToOptimizeFlags is copied in reverse for the inverse.
  *
+ * Merging linear transforms:
+ * When MergeLinearTransforms is on, TransformPoint applies each run of
+ * consecutive linear sub-transforms (MatrixOffsetTransformBase-derived,
+ * translation and identity transforms, looking through nested composite
+ * transforms) as a single affine transform. For instance, a translation, a
+ * rigid and an affine transform followed by a displacement field transform
+ * cost two sub-transform evaluations per point instead of four.
+ *
  * \ingroup ITKTransform
  */
 template <typename TParametersValueType = double, unsigned int NDimensions = 3>
@@ -118,6 +128,7 @@ public:
   /** Jacobian types. */
   using JacobianType = typename Superclass::JacobianType;
   using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using NonZeroJacobianIndicesType = typename Superclass::NonZeroJacobianIndicesType;
   using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
   /** Transform category type. */
   using TransformCategoryEnum = typename Superclass::TransformCategoryEnum;
@@ -258,6 +269,23 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Set/Get whether TransformPoint applies the merged transform queue
+   * instead of every sub-transform. The merged queue is cached, and built
+   * again when this transform or any of its sub-transforms is modified.
+   * Transforming vectors, tensors and computing Jacobians is not affected.
+   * Results may differ from the unmerged ones by rounding errors. Off by
+   * default. */
+  itkSetMacro(MergeLinearTransforms, bool);
+  itkGetConstMacro(MergeLinearTransforms, bool);
+  itkBooleanMacro(MergeLinearTransforms);
+
+  /** Get the transforms applied by TransformPoint when MergeLinearTransforms
+   * is on, in queue order: the sub-transforms of nested composite transforms
+   * are listed in place of them, and each run of consecutive linear transforms
+   * is replaced by a single affine transform. */
+  const TransformQueueType &
+  GetMergedTransformQueue() const;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
@@ -406,6 +434,16 @@ public:
                                                           JacobianType &         outJacobian,
                                                           JacobianType &         cacheJacobian) const override;
 
+  /** Compute the Jacobian in sparse form by concatenating the sparse
+   * Jacobians of the sub transforms that are selected for optimization,
+   * composed with the Jacobians with respect to position of the transforms
+   * applied after them. Parameter indices follow the same ordering as
+   * ComputeJacobianWithRespectToParameters(). */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       p,
+                                               JacobianType &               outJacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const override;
+
 protected:
   CompositeTransform();
   ~CompositeTransform() override = default;
@@ -454,7 +492,40 @@ protected:
   mutable TransformsToOptimizeFlagsType m_TransformsToOptimizeFlags;
 
 private:
+  /** Merged transform queue, with the transforms it was built from and the
+   * modification time it is valid for. */
+  struct MergedTransforms
+  {
+    TransformQueueType          m_Queue;
+    std::vector<const Object *> m_Sources;
+    ModifiedTimeType            m_Time{ 0 };
+  };
+
+  /** Buffers of ComputeSparseJacobianWithRespectToParameters(), kept per
+   * thread and reused across points: the sparse Jacobian of a sub transform,
+   * and the columns composed so far, column by column. */
+  struct SparseJacobianBuffers
+  {
+    JacobianType                     m_SubJacobian;
+    NonZeroJacobianIndicesType       m_SubIndices;
+    std::vector<ParametersValueType> m_Columns;
+  };
+
+  bool
+  IsUpToDate(const MergedTransforms & mergedTransforms) const;
+
+  void
+  MergeTransforms(MergedTransforms & mergedTransforms) const;
+
   mutable ModifiedTimeType m_PreviousTransformsToOptimizeUpdateTime;
+
+  bool m_MergeLinearTransforms{ false };
+
+  /** The merged queue is built in the entry that is not current, so that
+   * threads still reading the current one are not disturbed. */
+  mutable MergedTransforms          m_MergedTransforms[2];
+  mutable std::atomic<unsigned int> m_CurrentMergedTransforms{ 0 };
+  mutable std::mutex                m_MergedTransformsMutex;
 };
 
 } // end namespace itk
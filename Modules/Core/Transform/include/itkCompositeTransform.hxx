@@ -19,6 +19,11 @@
 #define itkCompositeTransform_hxx
 
 #include "itkCompositeTransform.h"
+#include "itkAffineTransform.h"
+#include "itkIdentityTransform.h"
+#include "itkTranslationTransform.h"
+
+#include <functional>
 
 namespace itk
 {
@@ -71,9 +76,12 @@ typename CompositeTransform<TParametersValueType, NDimensions>::OutputPointType
 CompositeTransform<TParametersValueType, NDimensions>::TransformPoint(const InputPointType & inputPoint) const
 {
 
+  const TransformQueueType & transforms =
+    this->m_MergeLinearTransforms ? this->GetMergedTransformQueue() : this->m_TransformQueue;
+
   /* Apply in reverse queue order.  */
   OutputPointType outputPoint(inputPoint);
-  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  for (auto it = transforms.rbegin(); it != transforms.rend(); ++it)
   {
     outputPoint = (*it)->TransformPoint(outputPoint);
   }
@@ -81,6 +89,138 @@ CompositeTransform<TParametersValueType, NDimensions>::TransformPoint(const Inpu
 }
 
 
+template <typename TParametersValueType, unsigned int NDimensions>
+const typename CompositeTransform<TParametersValueType, NDimensions>::TransformQueueType &
+CompositeTransform<TParametersValueType, NDimensions>::GetMergedTransformQueue() const
+{
+  const MergedTransforms & current = this->m_MergedTransforms[this->m_CurrentMergedTransforms.load()];
+  if (this->IsUpToDate(current))
+  {
+    return current.m_Queue;
+  }
+
+  std::lock_guard<std::mutex> lock(this->m_MergedTransformsMutex);
+  const unsigned int          currentIndex = this->m_CurrentMergedTransforms.load();
+  if (this->IsUpToDate(this->m_MergedTransforms[currentIndex]))
+  {
+    return this->m_MergedTransforms[currentIndex].m_Queue;
+  }
+  MergedTransforms & next = this->m_MergedTransforms[1 - currentIndex];
+  this->MergeTransforms(next);
+  this->m_CurrentMergedTransforms.store(1 - currentIndex);
+  return next.m_Queue;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+CompositeTransform<TParametersValueType, NDimensions>::IsUpToDate(const MergedTransforms & mergedTransforms) const
+{
+  if (mergedTransforms.m_Time == 0 || this->GetMTime() > mergedTransforms.m_Time)
+  {
+    return false;
+  }
+  for (const Object * source : mergedTransforms.m_Sources)
+  {
+    if (source->GetMTime() > mergedTransforms.m_Time)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CompositeTransform<TParametersValueType, NDimensions>::MergeTransforms(MergedTransforms & mergedTransforms) const
+{
+  using MatrixOffsetTransformType = MatrixOffsetTransformBase<TParametersValueType, NDimensions, NDimensions>;
+  using TranslationTransformType = TranslationTransform<TParametersValueType, NDimensions>;
+  using IdentityTransformType = IdentityTransform<TParametersValueType, NDimensions>;
+  using AffineTransformType = AffineTransform<TParametersValueType, NDimensions>;
+  using MatrixType = typename AffineTransformType::MatrixType;
+
+  mergedTransforms.m_Queue.clear();
+  mergedTransforms.m_Sources.clear();
+  mergedTransforms.m_Time = this->GetMTime();
+
+  // The composition of the current run of linear transforms, and its first
+  // transform, applied when the run has no other transform.
+  MatrixType           matrix;
+  OutputVectorType     offset;
+  TransformTypePointer firstOfRun;
+  SizeValueType        runLength = 0;
+
+  const auto endRun = [&]() {
+    if (runLength == 1)
+    {
+      mergedTransforms.m_Queue.push_back(firstOfRun);
+    }
+    else if (runLength > 1)
+    {
+      auto affine = AffineTransformType::New();
+      affine->SetMatrix(matrix);
+      affine->SetOffset(offset);
+      mergedTransforms.m_Queue.push_back(affine.GetPointer());
+    }
+    runLength = 0;
+  };
+
+  // Transforms are applied in reverse queue order, so appending a transform
+  // to the run composes it on the right.
+  const std::function<void(const TransformQueueType &)> mergeQueue = [&](const TransformQueueType & queue) {
+    for (const TransformTypePointer & transform : queue)
+    {
+      mergedTransforms.m_Sources.push_back(transform.GetPointer());
+      mergedTransforms.m_Time = std::max(mergedTransforms.m_Time, transform->GetMTime());
+
+      if (const auto * nested = dynamic_cast<const Self *>(transform.GetPointer()))
+      {
+        mergeQueue(nested->GetTransformQueue());
+        continue;
+      }
+
+      MatrixType       transformMatrix;
+      OutputVectorType transformOffset;
+      transformMatrix.SetIdentity();
+      transformOffset.Fill(0.0);
+      if (const auto * matrixOffset = dynamic_cast<const MatrixOffsetTransformType *>(transform.GetPointer()))
+      {
+        transformMatrix = matrixOffset->GetMatrix();
+        transformOffset = matrixOffset->GetOffset();
+      }
+      else if (const auto * translation = dynamic_cast<const TranslationTransformType *>(transform.GetPointer()))
+      {
+        transformOffset = translation->GetOffset();
+      }
+      else if (dynamic_cast<const IdentityTransformType *>(transform.GetPointer()) == nullptr)
+      {
+        endRun();
+        mergedTransforms.m_Queue.push_back(transform);
+        continue;
+      }
+
+      if (runLength == 0)
+      {
+        matrix = transformMatrix;
+        offset = transformOffset;
+        firstOfRun = transform;
+      }
+      else
+      {
+        offset += matrix * transformOffset;
+        matrix = matrix * transformMatrix;
+      }
+      ++runLength;
+    }
+  };
+
+  mergeQueue(this->m_TransformQueue);
+  endRun();
+}
+
+
 template <typename TParametersValueType, unsigned int NDimensions>
 typename CompositeTransform<TParametersValueType, NDimensions>::OutputVectorType
 CompositeTransform<TParametersValueType, NDimensions>::TransformVector(const InputVectorType & inputVector) const
@@ -451,6 +591,7 @@ CompositeTransform<TParametersValueType, NDimensions>::GetInverseTransform() con
 {
   /* This method can't be defined in Superclass because of the call to New() */
   Pointer inverseTransform = New();
+  inverseTransform->SetMergeLinearTransforms(this->m_MergeLinearTransforms);
 
   if (this->GetInverse(inverseTransform))
   {
@@ -608,6 +749,106 @@ CompositeTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespec
   }
 }
 
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CompositeTransform<TParametersValueType, NDimensions>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       p,
+  JacobianType &               outJacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  if (this->GetNumberOfTransforms() == 1)
+  {
+    this->GetNthTransformConstPointer(0)->ComputeSparseJacobianWithRespectToParameters(
+      p, outJacobian, nonZeroJacobianIndices);
+    return;
+  }
+
+  /* Same chain rule as ComputeJacobianWithRespectToParametersCachedTemporaries,
+   * applied only to the nonzero columns of each sub transform. The buffers
+   * are reused across the points of a thread; a composite transform nested
+   * in this one uses the next set. */
+  static thread_local std::deque<SparseJacobianBuffers> threadBuffers;
+  static thread_local size_t                            depth = 0;
+  if (depth == threadBuffers.size())
+  {
+    threadBuffers.emplace_back();
+  }
+  SparseJacobianBuffers & buffers = threadBuffers[depth];
+  struct DepthGuard
+  {
+    size_t & m_Depth;
+    ~DepthGuard() { --m_Depth; }
+  } depthGuard{ ++depth };
+
+  std::vector<ParametersValueType> & columns = buffers.m_Columns;
+  columns.clear();
+  nonZeroJacobianIndices.clear();
+
+  NumberOfParametersType offset = NumericTraits<NumberOfParametersType>::ZeroValue();
+  OutputPointType        transformedPoint(p);
+
+  for (signed long tind = (signed long)this->GetNumberOfTransforms() - 1; tind >= 0; --tind)
+  {
+    const TransformType * const transform = this->GetNthTransformConstPointer(tind);
+
+    const size_t numberOfPreviousColumns = columns.size() / NDimensions;
+
+    if (this->GetNthTransformToOptimize(tind))
+    {
+      transform->ComputeSparseJacobianWithRespectToParameters(
+        transformedPoint, buffers.m_SubJacobian, buffers.m_SubIndices);
+      for (unsigned int c = 0; c < buffers.m_SubIndices.size(); ++c)
+      {
+        for (unsigned int r = 0; r < NDimensions; ++r)
+        {
+          columns.push_back(buffers.m_SubJacobian[r][c]);
+        }
+        nonZeroJacobianIndices.push_back(offset + buffers.m_SubIndices[c]);
+      }
+      offset += transform->GetNumberOfLocalParameters();
+    }
+
+    /* Left multiply the columns of the transforms applied before this one
+     * by dTk / dT{k-1}. */
+    if (numberOfPreviousColumns > 0)
+    {
+      JacobianPositionType jacobianWithRespectToPosition;
+      transform->ComputeJacobianWithRespectToPosition(transformedPoint, jacobianWithRespectToPosition);
+
+      double temp[NDimensions];
+      for (size_t c = 0; c < numberOfPreviousColumns; ++c)
+      {
+        ParametersValueType * column = &columns[c * NDimensions];
+        for (unsigned int r = 0; r < NDimensions; ++r)
+        {
+          temp[r] = 0.0;
+          for (unsigned int k = 0; k < NDimensions; ++k)
+          {
+            temp[r] += jacobianWithRespectToPosition[r][k] * column[k];
+          }
+        }
+        for (unsigned int r = 0; r < NDimensions; ++r)
+        {
+          column[r] = temp[r];
+        }
+      }
+    }
+
+    transformedPoint = transform->TransformPoint(transformedPoint);
+  }
+
+  // outJacobian keeps its memory when the number of columns does not change
+  const size_t numberOfColumns = columns.size() / NDimensions;
+  outJacobian.SetSize(NDimensions, numberOfColumns);
+  for (size_t c = 0; c < numberOfColumns; ++c)
+  {
+    for (unsigned int r = 0; r < NDimensions; ++r)
+    {
+      outJacobian[r][c] = columns[c * NDimensions + r];
+    }
+  }
+}
+
 
 template <typename TParametersValueType, unsigned int NDimensions>
 const typename CompositeTransform<TParametersValueType, NDimensions>::ParametersType &
@@ -963,6 +1204,8 @@ CompositeTransform<TParametersValueType, NDimensions>::PrintSelf(std::ostream &
 {
   Superclass::PrintSelf(os, indent);
 
+  os << indent << "MergeLinearTransforms: " << (this->m_MergeLinearTransforms ? "On" : "Off") << std::endl;
+
   if (this->GetNumberOfTransforms() == 0)
   {
     return;
@@ -1013,6 +1256,7 @@ CompositeTransform<TParametersValueType, NDimensions>::InternalClone() const
     clone->AddTransform((*tqIt)->Clone().GetPointer());
     clone->SetNthTransformToOptimize(i, (*tfIt));
   }
+  clone->SetMergeLinearTransforms(this->m_MergeLinearTransforms);
   return loPtr;
 }
 
@@ -26,6 +26,7 @@
 #include "vnl/vnl_vector_fixed.h"
 #include "vnl/vnl_matrix_fixed.h"
 #include "itkMatrix.h"
+#include <vector>
 
 namespace itk
 {
@@ -172,6 +173,9 @@ public:
 
   using NumberOfParametersType = typename Superclass::NumberOfParametersType;
 
+  /** Type of the list of parameter indices at which a sparse Jacobian is nonzero. */
+  using NonZeroJacobianIndicesType = std::vector<NumberOfParametersType>;
+
   /**  Method to transform a point.
    * \warning This method must be thread-safe. See, e.g., its use
    * in ResampleImageFilter.
@@ -514,6 +518,29 @@ public:
     this->ComputeJacobianWithRespectToParameters(p, jacobian);
   }
 
+  /** Compute the Jacobian with respect to the parameters in sparse form.
+   *
+   * On return, \c nonZeroJacobianIndices lists the parameters on which the
+   * transformed point \c p depends, and column \c k of \c jacobian (of size
+   * OutputSpaceDimension x nonZeroJacobianIndices.size()) holds the
+   * derivative with respect to parameter \c nonZeroJacobianIndices[k].
+   * Parameters that are not listed have a zero derivative.
+   *
+   * Transforms with local support on the parameters, such as the B-spline
+   * transforms, override this to return only the parameters of the support
+   * region, so that callers can accumulate derivatives without visiting every
+   * parameter for every point. The default implementation returns the dense
+   * Jacobian of ComputeJacobianWithRespectToParameters() with the indices
+   * 0, ..., GetNumberOfLocalParameters() - 1; for transforms of category
+   * DisplacementField these index the local parameters at \c p.
+   *
+   * Both arguments are assumed to be thread-local and are reused across
+   * calls to avoid repetitive memory allocation. */
+  virtual void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       p,
+                                               JacobianType &               jacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const;
+
 
   /** This provides the ability to get a local jacobian value
    *  in a dense/local transform, e.g. DisplacementFieldTransform. For such
@@ -21,6 +21,7 @@
 #include "itkTransform.h"
 #include "itkCrossHelper.h"
 #include "vnl/algo/vnl_svd_fixed.h"
+#include <numeric>
 
 namespace itk
 {
@@ -132,6 +133,20 @@ Transform<TParametersValueType, NInputDimensions, NOutputDimensions>::UpdateTran
 }
 
 
+template <typename TParametersValueType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void
+Transform<TParametersValueType, NInputDimensions, NOutputDimensions>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       p,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  // Dense fallback: every local parameter is reported as nonzero.
+  this->ComputeJacobianWithRespectToParameters(p, jacobian);
+  nonZeroJacobianIndices.resize(jacobian.cols());
+  std::iota(nonZeroJacobianIndices.begin(), nonZeroJacobianIndices.end(), NumberOfParametersType{ 0 });
+}
+
+
 template <typename TParametersValueType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 typename Transform<TParametersValueType, NInputDimensions, NOutputDimensions>::OutputVectorType
 Transform<TParametersValueType, NInputDimensions, NOutputDimensions>::TransformVector(
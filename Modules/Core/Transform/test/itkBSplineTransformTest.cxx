@@ -27,6 +27,8 @@
  *=========================================================================*/
 
 #include "itkBSplineTransform.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
 
 
 #include "itkTextOutput.h"
@@ -315,6 +317,49 @@ itkBSplineTransformTest1()
     std::cout << std::endl;
   }
 
+  /**
+   * The sparse Jacobian must hold the nonzero columns of the dense one
+   */
+  for (const double coordinate : { 7.5, 13.25, -10.0 })
+  {
+    inputPoint.Fill(coordinate);
+    JacobianType jacobian;
+    transform->ComputeJacobianWithRespectToParameters(inputPoint, jacobian);
+    JacobianType                              sparseJacobian;
+    TransformType::NonZeroJacobianIndicesType nonZeroJacobianIndices;
+    transform->ComputeSparseJacobianWithRespectToParameters(inputPoint, sparseJacobian, nonZeroJacobianIndices);
+
+    JacobianType scatteredJacobian(jacobian.rows(), jacobian.cols());
+    scatteredJacobian.Fill(0.0);
+    for (unsigned int k = 0; k < nonZeroJacobianIndices.size(); ++k)
+    {
+      for (unsigned int d = 0; d < SpaceDimension; ++d)
+      {
+        scatteredJacobian(d, nonZeroJacobianIndices[k]) += sparseJacobian(d, k);
+      }
+    }
+    if (coordinate < 0.0)
+    {
+      ITK_TEST_EXPECT_TRUE(nonZeroJacobianIndices.empty());
+    }
+    else
+    {
+      ITK_TEST_EXPECT_EQUAL(nonZeroJacobianIndices.size(), SpaceDimension * transform->GetNumberOfWeights());
+    }
+    for (unsigned int d = 0; d < jacobian.rows(); ++d)
+    {
+      for (unsigned int p = 0; p < jacobian.cols(); ++p)
+      {
+        if (itk::Math::NotAlmostEquals(scatteredJacobian(d, p), jacobian(d, p)))
+        {
+          std::cout << "Sparse Jacobian differs at [" << d << "," << p << "]: " << scatteredJacobian(d, p)
+                    << " != " << jacobian(d, p) << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
   /**
    * TODO: add test to check the numerical accuarcy of the jacobian output
    */
@@ -20,6 +20,8 @@
 
 #include "itkAffineTransform.h"
 #include "itkCompositeTransform.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkTranslationTransform.h"
 #include "itkMath.h"
 #include "itkTestingMacros.h"
@@ -749,6 +751,55 @@ itkCompositeTransformTest(int, char *[])
     return EXIT_FAILURE;
   }
 
+  /* The sparse Jacobian of the composite holds the same columns. */
+  {
+    CompositeType::JacobianType               jacSparse;
+    CompositeType::NonZeroJacobianIndicesType nonZeroJacobianIndices;
+    jacPoint2[0] = 1;
+    jacPoint2[1] = 2;
+    compositeTransform->ComputeSparseJacobianWithRespectToParameters(jacPoint2, jacSparse, nonZeroJacobianIndices);
+    CompositeType::JacobianType jacScattered(jacTruth.rows(), jacTruth.cols());
+    jacScattered.Fill(0.0);
+    for (unsigned int k = 0; k < nonZeroJacobianIndices.size(); ++k)
+    {
+      for (unsigned int d = 0; d < jacTruth.rows(); ++d)
+      {
+        jacScattered(d, nonZeroJacobianIndices[k]) = jacSparse(d, k);
+      }
+    }
+    if (!testJacobian(jacScattered, jacTruth))
+    {
+      std::cout << "Failed getting sparse jacobian for two active transforms." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    /* Also when the composite is nested in another one, whose sparse
+     * Jacobian is computed twice with the same buffers. */
+    auto nestedComposite = CompositeType::New();
+    nestedComposite->AddTransform(affine2);
+    nestedComposite->AddTransform(compositeTransform);
+    CompositeType::JacobianType jacNested;
+    nestedComposite->ComputeJacobianWithRespectToParameters(jacPoint2, jacNested);
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      nestedComposite->ComputeSparseJacobianWithRespectToParameters(jacPoint2, jacSparse, nonZeroJacobianIndices);
+      jacScattered.SetSize(jacNested.rows(), jacNested.cols());
+      jacScattered.Fill(0.0);
+      for (unsigned int k = 0; k < nonZeroJacobianIndices.size(); ++k)
+      {
+        for (unsigned int d = 0; d < jacNested.rows(); ++d)
+        {
+          jacScattered(d, nonZeroJacobianIndices[k]) = jacSparse(d, k);
+        }
+      }
+      if (!testJacobian(jacScattered, jacNested))
+      {
+        std::cout << "Failed getting sparse jacobian of nested composite transforms." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
   /* Test UpdateTransformParameters.
    * NOTE Once there are transforms that do something other than simple
    * addition in TransformUpdateParameters, this should be updated here.
@@ -933,6 +984,106 @@ itkCompositeTransformTest(int, char *[])
     return EXIT_FAILURE;
   }
 
+  /* Test merging of consecutive linear transforms */
+  std::cout << "Test merging of linear transforms." << std::endl;
+  using DisplacementFieldTransformType = itk::DisplacementFieldTransform<ScalarType, NDimensions>;
+  using DisplacementFieldType = DisplacementFieldTransformType::DisplacementFieldType;
+
+  DisplacementFieldType::SizeType fieldSize;
+  fieldSize.Fill(20);
+  auto field = DisplacementFieldType::New();
+  field->SetRegions(fieldSize);
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<DisplacementFieldType> it(field, field->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    DisplacementFieldType::PixelType displacement;
+    displacement[0] = 0.01 * it.GetIndex()[0] * it.GetIndex()[1];
+    displacement[1] = std::sin(0.3 * it.GetIndex()[0]);
+    it.Set(displacement);
+  }
+  auto displacementTransform = DisplacementFieldTransformType::New();
+  displacementTransform->SetDisplacementField(field);
+
+  auto makeAffine = [](double angle, double scale, double tx, double ty) {
+    auto                         affine = AffineType::New();
+    AffineType::OutputVectorType translation;
+    translation[0] = tx;
+    translation[1] = ty;
+    affine->Rotate2D(angle);
+    affine->Scale(scale);
+    affine->Translate(translation);
+    return affine;
+  };
+  auto makeTranslation = [](double tx, double ty) {
+    auto                                       translation = TranslationTransformType::New();
+    TranslationTransformType::OutputVectorType offset;
+    offset[0] = tx;
+    offset[1] = ty;
+    translation->Translate(offset);
+    return translation;
+  };
+
+  AffineType::Pointer firstAffine = makeAffine(0.3, 1.1, 2.0, -1.0);
+  auto                nestedLinearTransform = CompositeType::New();
+  nestedLinearTransform->AddTransform(makeAffine(-0.2, 0.9, 0.5, 0.25));
+  nestedLinearTransform->AddTransform(makeTranslation(1.5, 2.5));
+
+  auto mergedTransform = CompositeType::New();
+  ITK_TEST_SET_GET_BOOLEAN(mergedTransform, MergeLinearTransforms, false);
+  mergedTransform->AddTransform(makeTranslation(-3.0, 4.0));
+  mergedTransform->AddTransform(firstAffine);
+  mergedTransform->AddTransform(nestedLinearTransform);
+  mergedTransform->AddTransform(displacementTransform);
+  mergedTransform->AddTransform(makeAffine(0.1, 1.2, -0.5, 0.5));
+  mergedTransform->AddTransform(makeTranslation(0.75, -0.25));
+
+  // The linear transforms before and after the displacement field are merged
+  ITK_TEST_EXPECT_EQUAL(mergedTransform->GetMergedTransformQueue().size(), 3);
+  ITK_TEST_EXPECT_TRUE(mergedTransform->GetMergedTransformQueue()[1] == displacementTransform.GetPointer());
+
+  const auto checkMergedTransformPoint = [&mergedTransform]() {
+    bool pointsMatch = true;
+    for (double x = -2.0; x < 22.0; x += 1.7)
+    {
+      for (double y = -2.0; y < 22.0; y += 2.3)
+      {
+        CompositeType::InputPointType point;
+        point[0] = x;
+        point[1] = y;
+        mergedTransform->MergeLinearTransformsOff();
+        const CompositeType::OutputPointType expected = mergedTransform->TransformPoint(point);
+        mergedTransform->MergeLinearTransformsOn();
+        const CompositeType::OutputPointType merged = mergedTransform->TransformPoint(point);
+        if (!testPoint(expected, merged))
+        {
+          std::cerr << "Merged transform maps " << point << " to " << merged << " instead of " << expected << std::endl;
+          pointsMatch = false;
+        }
+      }
+    }
+    return pointsMatch;
+  };
+  if (!checkMergedTransformPoint())
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying a sub-transform, or a nested one, invalidates the merged queue
+  firstAffine->Rotate2D(0.5);
+  nestedLinearTransform->GetNthTransformModifiablePointer(1)->SetParameters(
+    makeTranslation(-4.0, 0.5)->GetParameters());
+  if (!checkMergedTransformPoint())
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A queue without linear runs is applied as is
+  auto onlyDisplacementTransform = CompositeType::New();
+  onlyDisplacementTransform->AddTransform(displacementTransform);
+  ITK_TEST_EXPECT_EQUAL(onlyDisplacementTransform->GetMergedTransformQueue().size(), 1);
+  mergedTransform->Print(std::cout);
+
   /* Test printing */
   compositeTransform->Print(std::cout);
 
@@ -20,6 +20,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkVectorInterpolateImageFunction.h"
+#include "itkVectorLinearInterpolateImageFunction.h"
 
 namespace itk
 {
@@ -29,6 +30,10 @@ namespace itk
  *
  * \brief Compose two displacement fields.
  *
+ * When the interpolator is the default VectorLinearInterpolateImageFunction,
+ * the composition is computed by ComposeWithLinearInterpolation(), a scanline
+ * kernel which interpolates directly from the displacement field buffer.
+ *
  * \author Nick Tustison
  * \author Brian Avants
  *
@@ -71,6 +76,7 @@ public:
   /** Other type alias */
   using RealType = typename VectorType::ComponentType;
   using InterpolatorType = VectorInterpolateImageFunction<InputFieldType, RealType>;
+  using DefaultInterpolatorType = VectorLinearInterpolateImageFunction<InputFieldType, RealType>;
 
   /** Get the interpolator. */
   itkGetModifiableObjectMacro(Interpolator, InterpolatorType);
@@ -124,6 +130,22 @@ public:
   virtual void
   SetInterpolator(InterpolatorType * interpolator);
 
+  /**
+   * Compose the displacement field with the warping field over the given
+   * region of the output, i.e. output(x) = w(x) + u(x + w(x)) where u is
+   * linearly interpolated from the displacement field and taken as zero
+   * outside of its buffer. The warping field and the output must share the
+   * same grid over the region. This produces the same values as the filter
+   * with its default interpolator but avoids the per-pixel virtual calls and
+   * index/point conversions, so it may be used directly by iterative
+   * algorithms which compose fields repeatedly.
+   */
+  static void
+  ComposeWithLinearInterpolation(const InputFieldType * displacementField,
+                                 const InputFieldType * warpingField,
+                                 OutputFieldType *      output,
+                                 const RegionType &     region);
+
 protected:
   /** Constructor */
   ComposeDisplacementFieldsImageFilter();
@@ -143,10 +165,11 @@ protected:
   void
   DynamicThreadedGenerateData(const RegionType &) override;
 
-
 private:
   /** The interpolator. */
   typename InterpolatorType::Pointer m_Interpolator;
+
+  bool m_UseLinearInterpolationKernel{ false };
 };
 
 } // end namespace itk
@@ -22,7 +22,8 @@
 
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
-#include "itkVectorLinearInterpolateImageFunction.h"
+#include "itkImageScanlineIterator.h"
+#include <typeinfo>
 
 namespace itk
 {
@@ -36,7 +37,6 @@ ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::ComposeDisplacem
   this->SetNumberOfRequiredInputs(2);
   this->DynamicMultiThreadingOn();
 
-  using DefaultInterpolatorType = VectorLinearInterpolateImageFunction<InputFieldType, RealType>;
   typename DefaultInterpolatorType::Pointer interpolator = DefaultInterpolatorType::New();
   this->m_Interpolator = interpolator;
 }
@@ -69,12 +69,23 @@ ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::BeforeThreadedGe
   {
     itkExceptionMacro("Displacement field not set in interpolator.");
   }
+
+  // Subclasses of the linear interpolator may change its behavior, so only the exact type is replaced by the kernel.
+  this->m_UseLinearInterpolationKernel = (typeid(*this->m_Interpolator) == typeid(DefaultInterpolatorType) &&
+                                          this->m_Interpolator->GetInputImage() == this->GetDisplacementField());
 }
 
 template <typename InputImage, typename TOutputImage>
 void
 ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::DynamicThreadedGenerateData(const RegionType & region)
 {
+  if (this->m_UseLinearInterpolationKernel)
+  {
+    Self::ComposeWithLinearInterpolation(
+      this->GetDisplacementField(), this->GetWarpingField(), this->GetOutput(), region);
+    return;
+  }
+
   typename OutputFieldType::Pointer     output = this->GetOutput();
   typename InputFieldType::ConstPointer warpingField = this->GetWarpingField();
 
@@ -115,6 +126,145 @@ ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::DynamicThreadedG
   }
 }
 
+template <typename InputImage, typename TOutputImage>
+void
+ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::ComposeWithLinearInterpolation(
+  const InputFieldType * displacementField,
+  const InputFieldType * warpingField,
+  OutputFieldType *      output,
+  const RegionType &     region)
+{
+  using InternalComputationType = typename NumericTraits<RealType>::RealType;
+  using MatrixType = typename InputFieldType::DirectionType;
+  using InputPixelType = typename InputFieldType::PixelType;
+
+  constexpr unsigned int NumberOfNeighbors = 1u << ImageDimension;
+
+  const typename InputFieldType::RegionType bufferedRegion = displacementField->GetBufferedRegion();
+  const typename InputFieldType::IndexType  startIndex = bufferedRegion.GetIndex();
+  const typename InputFieldType::IndexType  endIndex = bufferedRegion.GetUpperIndex();
+  const OffsetValueType *                   offsetTable = displacementField->GetOffsetTable();
+  const InputPixelType *                    buffer = displacementField->GetBufferPointer();
+  const typename InputFieldType::PointType  displacementOrigin = displacementField->GetOrigin();
+
+  // Mapping from physical space to the continuous index space of the displacement field.
+  const MatrixType & inverseDirection = displacementField->GetInverseDirection();
+  MatrixType         physicalToIndex;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      physicalToIndex[i][j] = inverseDirection[i][j] / displacementField->GetSpacing()[i];
+    }
+  }
+
+  // Step in continuous index of the displacement field per pixel along a scanline of the warping field.
+  InternalComputationType lineStep[ImageDimension];
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    lineStep[i] = 0.0;
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      lineStep[i] += physicalToIndex[i][j] * warpingField->GetDirection()[j][0] * warpingField->GetSpacing()[0];
+    }
+  }
+
+  ImageScanlineConstIterator<InputFieldType> ItW(warpingField, region);
+  ImageScanlineIterator<OutputFieldType>     ItF(output, region);
+
+  InternalComputationType lineStartIndex[ImageDimension];
+  InternalComputationType cindex[ImageDimension];
+  InternalComputationType distance[ImageDimension];
+  OffsetValueType         lowerOffset[ImageDimension];
+  OffsetValueType         upperOffset[ImageDimension];
+  InternalComputationType displacement[ImageDimension];
+
+  typename OutputFieldType::PixelType outDisplacement;
+  PointType                           lineStartPoint;
+
+  while (!ItW.IsAtEnd())
+  {
+    warpingField->TransformIndexToPhysicalPoint(ItW.GetIndex(), lineStartPoint);
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      lineStartIndex[i] = 0.0;
+      for (unsigned int j = 0; j < ImageDimension; ++j)
+      {
+        lineStartIndex[i] += physicalToIndex[i][j] * (lineStartPoint[j] - displacementOrigin[j]);
+      }
+    }
+
+    for (SizeValueType n = 0; !ItW.IsAtEndOfLine(); ++n, ++ItW, ++ItF)
+    {
+      const InputPixelType & warpVector = ItW.Get();
+
+      bool isInside = true;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        cindex[i] = lineStartIndex[i] + static_cast<InternalComputationType>(n) * lineStep[i];
+        for (unsigned int j = 0; j < ImageDimension; ++j)
+        {
+          cindex[i] += physicalToIndex[i][j] * warpVector[j];
+        }
+        // Same bounds as ImageFunction::IsInsideBuffer()
+        isInside = isInside && cindex[i] >= startIndex[i] - 0.5 && cindex[i] < endIndex[i] + 0.5;
+      }
+
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        displacement[d] = 0.0;
+      }
+      if (isInside)
+      {
+        // Neighbors are clamped to the buffer as in VectorLinearInterpolateImageFunction.
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          const IndexValueType baseIndex = Math::Floor<IndexValueType>(cindex[i]);
+          distance[i] = cindex[i] - static_cast<InternalComputationType>(baseIndex);
+          lowerOffset[i] = (std::max(baseIndex, startIndex[i]) - startIndex[i]) * offsetTable[i];
+          upperOffset[i] = (std::min(baseIndex + 1, endIndex[i]) - startIndex[i]) * offsetTable[i];
+        }
+        for (unsigned int counter = 0; counter < NumberOfNeighbors; ++counter)
+        {
+          InternalComputationType overlap = 1.0;
+          OffsetValueType         offset = 0;
+          unsigned int            upper = counter;
+          for (unsigned int i = 0; i < ImageDimension; ++i)
+          {
+            if (upper & 1)
+            {
+              offset += upperOffset[i];
+              overlap *= distance[i];
+            }
+            else
+            {
+              offset += lowerOffset[i];
+              overlap *= 1.0 - distance[i];
+            }
+            upper >>= 1;
+          }
+          if (overlap)
+          {
+            const InputPixelType & neighbor = buffer[offset];
+            for (unsigned int d = 0; d < ImageDimension; ++d)
+            {
+              displacement[d] += overlap * static_cast<InternalComputationType>(neighbor[d]);
+            }
+          }
+        }
+      }
+
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        outDisplacement[d] = static_cast<RealType>(warpVector[d] + displacement[d]);
+      }
+      ItF.Set(outDisplacement);
+    }
+    ItW.NextLine();
+    ItF.NextLine();
+  }
+}
+
 template <typename InputImage, typename TOutputImage>
 void
 ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
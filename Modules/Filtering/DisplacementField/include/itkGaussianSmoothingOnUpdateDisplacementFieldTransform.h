@@ -85,6 +85,16 @@ public:
   itkSetMacro(GaussianSmoothingVarianceForTheTotalField, ScalarType);
   itkGetConstReferenceMacro(GaussianSmoothingVarianceForTheTotalField, ScalarType);
 
+  /**
+   * Use a recursive (IIR) approximation of the Gaussian which smooths the
+   * field in place instead of the GaussianOperator convolution, which needs
+   * an intermediate image per dimension. The cost of the recursive filter
+   * does not depend on the variance. Default = false.
+   */
+  itkSetMacro(UseRecursiveGaussianSmoothing, bool);
+  itkGetConstMacro(UseRecursiveGaussianSmoothing, bool);
+  itkBooleanMacro(UseRecursiveGaussianSmoothing);
+
   /** Update the transform's parameters by the values in \c update.
    * We assume \c update is of the same length as Parameters. Throw
    * exception otherwise.
@@ -103,6 +113,16 @@ public:
   virtual DisplacementFieldPointer
   GaussianSmoothDisplacementField(DisplacementFieldType *, ScalarType);
 
+  /** Smooth the displacement field in-place with a third-order recursive
+   * Gaussian (Young and van Vliet) of the given variance, in voxel units,
+   * along each dimension, and zero the field on the boundary of its buffered
+   * region. No intermediate image is allocated unless the variance is below
+   * 0.5, where the result is blended with the unsmoothed field as in
+   * GaussianSmoothDisplacementField().
+   */
+  static void
+  RecursiveGaussianSmoothDisplacementField(DisplacementFieldType *, ScalarType);
+
 protected:
   GaussianSmoothingOnUpdateDisplacementFieldTransform();
   ~GaussianSmoothingOnUpdateDisplacementFieldTransform() override = default;
@@ -118,6 +138,8 @@ protected:
   ScalarType m_GaussianSmoothingVarianceForTheUpdateField;
   ScalarType m_GaussianSmoothingVarianceForTheTotalField;
 
+  bool m_UseRecursiveGaussianSmoothing{ false };
+
   /** Type of Gaussian Operator used during smoothing. Define here
    * so we can use a member var during the operation. */
   using GaussianSmoothingOperatorType = GaussianOperator<ScalarType, Superclass::Dimension>;
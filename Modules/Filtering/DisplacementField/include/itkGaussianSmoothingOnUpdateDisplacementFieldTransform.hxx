@@ -26,6 +26,7 @@
 #include "itkImageDuplicator.h"
 #include "itkImageLinearIteratorWithIndex.h"
 #include "itkImportImageFilter.h"
+#include "itkMultiThreaderBase.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkVectorNeighborhoodOperatorImageFilter.h"
 
@@ -138,6 +139,12 @@ GaussianSmoothingOnUpdateDisplacementFieldTransform<TParametersValueType, NDimen
     return field;
   }
 
+  if (this->m_UseRecursiveGaussianSmoothing)
+  {
+    Self::RecursiveGaussianSmoothDisplacementField(field, variance);
+    return field;
+  }
+
   using DuplicatorType = ImageDuplicator<DisplacementFieldType>;
   typename DuplicatorType::Pointer duplicator = DuplicatorType::New();
   duplicator->SetInputImage(field);
@@ -218,6 +225,147 @@ GaussianSmoothingOnUpdateDisplacementFieldTransform<TParametersValueType, NDimen
   return field;
 }
 
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+GaussianSmoothingOnUpdateDisplacementFieldTransform<TParametersValueType, NDimensions>::
+  RecursiveGaussianSmoothDisplacementField(DisplacementFieldType * field, ScalarType variance)
+{
+  if (variance <= 0.0)
+  {
+    return;
+  }
+
+  using RegionType = typename DisplacementFieldType::RegionType;
+  using RealType = typename NumericTraits<ScalarType>::RealType;
+  using RealVectorType = typename NumericTraits<DisplacementVectorType>::RealType;
+
+  const RegionType region = field->GetBufferedRegion();
+
+  // For small variances the smoothed field is blended with the original one.
+  ScalarType weight1 = 1.0;
+  if (variance < 0.5)
+  {
+    weight1 = 1.0 - 1.0 * (variance / 0.5);
+  }
+  const ScalarType weight2 = 1.0 - weight1;
+
+  DisplacementFieldPointer originalField;
+  if (weight2 > 0.0)
+  {
+    using DuplicatorType = ImageDuplicator<DisplacementFieldType>;
+    typename DuplicatorType::Pointer duplicator = DuplicatorType::New();
+    duplicator->SetInputImage(field);
+    duplicator->Update();
+    originalField = duplicator->GetOutput();
+  }
+
+  // Coefficients of the third-order recursive Gaussian from
+  // I.T. Young and L.J. van Vliet, "Recursive implementation of the Gaussian
+  // filter", Signal Processing 44 (1995) 139-151.  Their fit of q is poor for
+  // small variances, where q = variance / 3 matches the kernel of the
+  // GaussianOperator much more closely.
+  const RealType sigma = std::sqrt(static_cast<RealType>(variance));
+  RealType       q = static_cast<RealType>(variance) / 3.0;
+  if (variance >= 6.25)
+  {
+    q = 0.98711 * sigma - 0.96330;
+  }
+  else if (variance >= 2.5)
+  {
+    q = 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+  }
+  const RealType q2 = q * q;
+  const RealType q3 = q2 * q;
+  const RealType b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+  const RealType b1 = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+  const RealType b2 = -(1.4281 * q2 + 1.26661 * q3) / b0;
+  const RealType b3 = (0.422205 * q3) / b0;
+  const RealType B = 1.0 - (b1 + b2 + b3);
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+
+  for (unsigned int dimension = 0; dimension < NDimensions; ++dimension)
+  {
+    const SizeValueType length = region.GetSize(dimension);
+    if (length < 2)
+    {
+      continue;
+    }
+
+    multiThreader->template ParallelizeImageRegionRestrictDirection<NDimensions>(
+      dimension,
+      region,
+      [&](const RegionType & lineRegion) {
+        std::vector<RealVectorType> line(length);
+
+        ImageLinearIteratorWithIndex<DisplacementFieldType> It(field, lineRegion);
+        It.SetDirection(dimension);
+        for (It.GoToBegin(); !It.IsAtEnd(); It.NextLine())
+        {
+          // causal pass, initialized with the steady state of a constant extension of the line
+          RealVectorType w1 = It.Get();
+          RealVectorType w2 = w1;
+          RealVectorType w3 = w1;
+          for (SizeValueType n = 0; n < length; ++n, ++It)
+          {
+            const RealVectorType w = RealVectorType(It.Get()) * B + w1 * b1 + w2 * b2 + w3 * b3;
+            w3 = w2;
+            w2 = w1;
+            w1 = w;
+            line[n] = w;
+          }
+
+          // anti-causal pass, written back in place
+          RealVectorType y1 = line[length - 1];
+          RealVectorType y2 = y1;
+          RealVectorType y3 = y1;
+          for (SizeValueType n = length; n-- > 0;)
+          {
+            const RealVectorType y = line[n] * B + y1 * b1 + y2 * b2 + y3 * b3;
+            y3 = y2;
+            y2 = y1;
+            y1 = y;
+            line[n] = y;
+          }
+
+          It.GoToBeginOfLine();
+          for (SizeValueType n = 0; n < length; ++n, ++It)
+          {
+            It.Set(static_cast<DisplacementVectorType>(line[n]));
+          }
+        }
+      },
+      nullptr);
+  }
+
+  if (originalField.IsNotNull())
+  {
+    ImageRegionIterator<DisplacementFieldType>      fieldIt(field, region);
+    ImageRegionConstIterator<DisplacementFieldType> originalFieldIt(originalField, region);
+    for (fieldIt.GoToBegin(), originalFieldIt.GoToBegin(); !fieldIt.IsAtEnd(); ++fieldIt, ++originalFieldIt)
+    {
+      fieldIt.Set(fieldIt.Get() * weight1 + originalFieldIt.Get() * weight2);
+    }
+  }
+
+  // make sure boundary does not move
+  const DisplacementVectorType zeroVector(0.0);
+  for (unsigned int dimension = 0; dimension < NDimensions; ++dimension)
+  {
+    RegionType face = region;
+    face.SetSize(dimension, 1);
+    for (ImageRegionIterator<DisplacementFieldType> It(field, face); !It.IsAtEnd(); ++It)
+    {
+      It.Set(zeroVector);
+    }
+    face.SetIndex(dimension, region.GetIndex(dimension) + static_cast<IndexValueType>(region.GetSize(dimension)) - 1);
+    for (ImageRegionIterator<DisplacementFieldType> It(field, face); !It.IsAtEnd(); ++It)
+    {
+      It.Set(zeroVector);
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int NDimensions>
 typename LightObject::Pointer
 GaussianSmoothingOnUpdateDisplacementFieldTransform<TParametersValueType, NDimensions>::InternalClone() const
@@ -234,6 +382,7 @@ GaussianSmoothingOnUpdateDisplacementFieldTransform<TParametersValueType, NDimen
   // set fields not in the fixed parameters.
   rval->SetGaussianSmoothingVarianceForTheUpdateField(this->GetGaussianSmoothingVarianceForTheUpdateField());
   rval->SetGaussianSmoothingVarianceForTheTotalField(this->GetGaussianSmoothingVarianceForTheTotalField());
+  rval->SetUseRecursiveGaussianSmoothing(this->GetUseRecursiveGaussianSmoothing());
 
   rval->SetFixedParameters(this->GetFixedParameters());
   rval->SetParameters(this->GetParameters());
@@ -252,7 +401,8 @@ GaussianSmoothingOnUpdateDisplacementFieldTransform<TParametersValueType, NDimen
      << indent << "m_GaussianSmoothingVarianceForTheUpdateField: " << this->m_GaussianSmoothingVarianceForTheUpdateField
      << std::endl
      << indent << "m_GaussianSmoothingVarianceForTheTotalField: " << this->m_GaussianSmoothingVarianceForTheTotalField
-     << std::endl;
+     << std::endl
+     << indent << "m_UseRecursiveGaussianSmoothing: " << this->m_UseRecursiveGaussianSmoothing << std::endl;
 }
 } // namespace itk
 
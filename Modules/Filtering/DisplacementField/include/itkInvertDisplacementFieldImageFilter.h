@@ -31,6 +31,20 @@ namespace itk
  *
  * \brief Iteratively estimate the inverse field of a displacement field.
  *
+ * Each iteration composes the displacement field with the current estimate of
+ * the inverse and moves the estimate against the residual displacement. The
+ * iterations stop when either the maximum or the mean norm of the residual,
+ * measured in voxels, falls below its tolerance.
+ *
+ * Large deformations need many iterations at full resolution. Setting the
+ * number of levels greater than one estimates the inverse coarse-to-fine:
+ * the iterations are first run on a grid subsampled by a factor of
+ * 2^(NumberOfLevels - 1), and the estimate of each level is linearly
+ * resampled to the next finer grid as its starting point. The coarse grids
+ * span the same physical domain as the input field. The maximum number of
+ * iterations and the tolerances apply to each level, and the reported error
+ * norms are those of the final, full resolution level.
+ *
  * \author Nick Tustison
  * \author Brian Avants
  *
@@ -137,6 +151,10 @@ public:
   itkSetMacro(EnforceBoundaryCondition, bool);
   itkGetMacro(EnforceBoundaryCondition, bool);
 
+  /* Set/Get the number of coarse-to-fine levels. Default = 1, i.e. only full resolution. */
+  itkSetClampMacro(NumberOfLevels, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfLevels, unsigned int);
+
 protected:
   /** Constructor */
   InvertDisplacementFieldImageFilter();
@@ -157,18 +175,33 @@ protected:
   DynamicThreadedGenerateData(const RegionType &) override;
 
 private:
+  /** Run the fixed-point iterations of one level, updating the inverse field in place. */
+  void
+  IterativelyEstimateInverse(const DisplacementFieldType * displacementField,
+                             InverseDisplacementFieldType * inverseField,
+                             float                          startProgress,
+                             float                          endProgress);
+
+  /** Linearly resample a field onto the grid of a reference image, with zero displacement outside. */
+  template <typename TField>
+  typename TField::Pointer
+  ResampleField(const TField * field, const ImageBase<ImageDimension> * reference) const;
+
   /** The interpolator. */
   typename InterpolatorType::Pointer m_Interpolator;
 
   unsigned int m_MaximumNumberOfIterations{ 20 };
+  unsigned int m_NumberOfLevels{ 1 };
 
   RealType m_MaxErrorToleranceThreshold;
   RealType m_MeanErrorToleranceThreshold;
 
   // internal ivars necessary for multithreading basic operations
 
-  typename DisplacementFieldType::Pointer m_ComposedField;
-  typename RealImageType::Pointer         m_ScaledNormImage;
+  typename DisplacementFieldType::Pointer        m_ComposedField;
+  typename RealImageType::Pointer                m_ScaledNormImage;
+  typename DisplacementFieldType::ConstPointer   m_LevelDisplacementField;
+  typename InverseDisplacementFieldType::Pointer m_LevelInverseField;
 
   RealType    m_MaxErrorNorm;
   RealType    m_MeanErrorNorm;
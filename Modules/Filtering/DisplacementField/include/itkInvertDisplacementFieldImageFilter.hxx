@@ -22,7 +22,9 @@
 
 #include "itkComposeDisplacementFieldsImageFilter.h"
 #include "itkImageDuplicator.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include <mutex>
 #include "itkProgressTransformer.h"
 
@@ -94,11 +96,90 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     inverseDisplacementField->FillBuffer(zeroVector);
   }
 
+  // Coarse-to-fine levels. The estimate of each coarse level seeds the next finer one.
+  typename InverseDisplacementFieldType::Pointer coarseInverseField;
+  const float                                    levelProgress = 1.0f / static_cast<float>(this->m_NumberOfLevels);
+
+  for (unsigned int level = this->m_NumberOfLevels - 1; level > 0; --level)
+  {
+    const RegionType  region = displacementField->GetRequestedRegion();
+    const SpacingType spacing = displacementField->GetSpacing();
+    SizeType          coarseSize;
+    SpacingType       coarseSpacing;
+    for (unsigned int d = 0; d < ImageDimension; d++)
+    {
+      // The corner voxels of the coarse grid coincide with those of the full resolution grid.
+      const SizeValueType shrinkFactor = static_cast<SizeValueType>(1) << level;
+      const SizeValueType size = region.GetSize()[d];
+      coarseSize[d] = std::max((size - 1) / shrinkFactor + 1, std::min<SizeValueType>(2, size));
+      coarseSpacing[d] = spacing[d];
+      if (coarseSize[d] > 1)
+      {
+        coarseSpacing[d] *= static_cast<double>(size - 1) / static_cast<double>(coarseSize[d] - 1);
+      }
+    }
+    PointType origin;
+    displacementField->TransformIndexToPhysicalPoint(region.GetIndex(), origin);
+
+    typename RealImageType::Pointer coarseGrid = RealImageType::New();
+    coarseGrid->SetOrigin(origin);
+    coarseGrid->SetSpacing(coarseSpacing);
+    coarseGrid->SetDirection(displacementField->GetDirection());
+    coarseGrid->SetRegions(coarseSize);
+
+    typename DisplacementFieldType::Pointer coarseDisplacementField =
+      this->template ResampleField<DisplacementFieldType>(displacementField, coarseGrid);
+    const InverseDisplacementFieldType * previousInverseField =
+      coarseInverseField.IsNull() ? inverseDisplacementField.GetPointer() : coarseInverseField.GetPointer();
+    coarseInverseField = this->template ResampleField<InverseDisplacementFieldType>(previousInverseField, coarseGrid);
+
+    const float startProgress = static_cast<float>(this->m_NumberOfLevels - 1 - level) * levelProgress;
+    this->IterativelyEstimateInverse(
+      coarseDisplacementField, coarseInverseField, startProgress, startProgress + levelProgress);
+  }
+
+  if (coarseInverseField.IsNotNull())
+  {
+    typename InverseDisplacementFieldType::Pointer resampledInverseField =
+      this->template ResampleField<InverseDisplacementFieldType>(coarseInverseField, inverseDisplacementField);
+    ImageAlgorithm::Copy(resampledInverseField.GetPointer(),
+                         inverseDisplacementField.GetPointer(),
+                         inverseDisplacementField->GetBufferedRegion(),
+                         inverseDisplacementField->GetBufferedRegion());
+  }
+
+  this->IterativelyEstimateInverse(displacementField, inverseDisplacementField, 1.0f - levelProgress, 1.0f);
+
+  this->m_LevelDisplacementField = nullptr;
+  this->m_LevelInverseField = nullptr;
+  this->m_ComposedField = DisplacementFieldType::New();
+
+  this->UpdateProgress(1.0f);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::IterativelyEstimateInverse(
+  const DisplacementFieldType *  displacementField,
+  InverseDisplacementFieldType * inverseField,
+  float                          startProgress,
+  float                          endProgress)
+{
+  this->m_LevelDisplacementField = displacementField;
+  this->m_LevelInverseField = inverseField;
+
   for (unsigned int d = 0; d < ImageDimension; d++)
   {
     this->m_DisplacementFieldSpacing[d] = displacementField->GetSpacing()[d];
   }
 
+  // The composed field is allocated once per level and filled by the composition kernel in each iteration.
+  this->m_ComposedField = DisplacementFieldType::New();
+  this->m_ComposedField->CopyInformation(inverseField);
+  this->m_ComposedField->SetRegions(inverseField->GetRequestedRegion());
+  this->m_ComposedField->Allocate();
+
+  this->m_ScaledNormImage = RealImageType::New();
   this->m_ScaledNormImage->CopyInformation(displacementField);
   this->m_ScaledNormImage->SetRegions(displacementField->GetRequestedRegion());
   this->m_ScaledNormImage->Allocate(true); // initialize buffer to zero
@@ -108,7 +189,8 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
   this->m_MeanErrorNorm = NumericTraits<RealType>::max();
   unsigned int iteration = 0;
 
-  float oldProgress = 0.0f;
+  const float progressRange = endProgress - startProgress;
+  float       oldProgress = startProgress;
 
   while (iteration++ < this->m_MaximumNumberOfIterations && this->m_MaxErrorNorm > this->m_MaxErrorToleranceThreshold &&
          this->m_MeanErrorNorm > this->m_MeanErrorToleranceThreshold)
@@ -116,25 +198,16 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     itkDebugMacro("Iteration " << iteration << ": mean error norm = " << this->m_MeanErrorNorm
                                << ", max error norm = " << this->m_MaxErrorNorm);
 
-    using ComposerType = ComposeDisplacementFieldsImageFilter<DisplacementFieldType>;
-    typename ComposerType::Pointer composer = ComposerType::New();
-    composer->SetDisplacementField(displacementField);
-    composer->SetWarpingField(inverseDisplacementField);
-
-    this->m_ComposedField = composer->GetOutput();
-    this->m_ComposedField->Update();
-    this->m_ComposedField->DisconnectPipeline();
-
-    // Multithread processing to multiply each element of the composed field by 1 / spacing
+    // Multithread processing to compose the fields and multiply each element of the composed field by 1 / spacing
     this->m_MeanErrorNorm = NumericTraits<RealType>::ZeroValue();
     this->m_MaxErrorNorm = NumericTraits<RealType>::ZeroValue();
 
-    float               newProgress = float(2 * iteration - 1) / (2 * m_MaximumNumberOfIterations);
+    float newProgress = startProgress + progressRange * float(2 * iteration - 1) / (2 * m_MaximumNumberOfIterations);
     ProgressTransformer pt(oldProgress, newProgress, this);
     this->m_DoThreadedEstimateInverse = false;
     this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
     this->GetMultiThreader()->template ParallelizeImageRegion<TOutputImage::ImageDimension>(
-      this->GetOutput()->GetRequestedRegion(),
+      inverseField->GetRequestedRegion(),
       [this](const OutputImageRegionType & outputRegionForThread) {
         this->DynamicThreadedGenerateData(outputRegionForThread);
       },
@@ -149,20 +222,66 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     }
 
     oldProgress = newProgress;
-    newProgress = float(2 * iteration) / (2 * m_MaximumNumberOfIterations);
+    newProgress = startProgress + progressRange * float(2 * iteration) / (2 * m_MaximumNumberOfIterations);
     ProgressTransformer pt2(oldProgress, newProgress, this);
     // Multithread processing to estimate inverse field
     this->m_DoThreadedEstimateInverse = true;
     this->GetMultiThreader()->template ParallelizeImageRegion<TOutputImage::ImageDimension>(
-      this->GetOutput()->GetRequestedRegion(),
+      inverseField->GetRequestedRegion(),
       [this](const OutputImageRegionType & outputRegionForThread) {
         this->DynamicThreadedGenerateData(outputRegionForThread);
       },
       pt2.GetProcessObject());
     oldProgress = newProgress;
   }
+}
 
-  this->UpdateProgress(1.0f);
+template <typename TInputImage, typename TOutputImage>
+template <typename TField>
+typename TField::Pointer
+InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::ResampleField(
+  const TField *                    field,
+  const ImageBase<ImageDimension> * reference) const
+{
+  using FieldInterpolatorType = VectorLinearInterpolateImageFunction<TField, RealType>;
+  typename FieldInterpolatorType::Pointer interpolator = FieldInterpolatorType::New();
+  interpolator->SetInputImage(field);
+
+  typename TField::Pointer resampledField = TField::New();
+  resampledField->CopyInformation(reference);
+  resampledField->SetRegions(reference->GetLargestPossibleRegion());
+  resampledField->Allocate();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    resampledField->GetBufferedRegion(),
+    [&resampledField, &interpolator](const RegionType & region) {
+      const typename TField::PixelType zeroVector(0.0);
+      typename TField::PixelType       vector;
+      PointType                        point;
+      ImageRegionIteratorWithIndex<TField> It(resampledField, region);
+      for (It.GoToBegin(); !It.IsAtEnd(); ++It)
+      {
+        resampledField->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+        if (interpolator->IsInsideBuffer(point))
+        {
+          const typename FieldInterpolatorType::OutputType value = interpolator->Evaluate(point);
+          for (unsigned int d = 0; d < ImageDimension; d++)
+          {
+            vector[d] = static_cast<RealType>(value[d]);
+          }
+          It.Set(vector);
+        }
+        else
+        {
+          It.Set(zeroVector);
+        }
+      }
+    },
+    nullptr);
+
+  return resampledField;
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -179,7 +298,7 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::DynamicThreadedGe
 
   if (this->m_DoThreadedEstimateInverse)
   {
-    ImageRegionIterator<DisplacementFieldType> ItI(this->GetOutput(), region);
+    ImageRegionIterator<DisplacementFieldType> ItI(this->m_LevelInverseField, region);
 
     for (ItI.GoToBegin(), ItE.GoToBegin(), ItS.GoToBegin(); !ItI.IsAtEnd(); ++ItI, ++ItE, ++ItS)
     {
@@ -215,6 +334,11 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::DynamicThreadedGe
     {
       inverseSpacing[d] = 1.0 / this->m_DisplacementFieldSpacing[d];
     }
+
+    using ComposerType = ComposeDisplacementFieldsImageFilter<DisplacementFieldType>;
+    ComposerType::ComposeWithLinearInterpolation(
+      this->m_LevelDisplacementField, this->m_LevelInverseField, this->m_ComposedField, region);
+
     for (ItE.GoToBegin(), ItS.GoToBegin(); !ItE.IsAtEnd(); ++ItE, ++ItS)
     {
       const VectorType & displacement = ItE.Get();
@@ -254,6 +378,7 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::PrintSelf(std::os
   itkPrintSelfObjectMacro(Interpolator);
 
   os << "Maximum number of iterations: " << this->m_MaximumNumberOfIterations << std::endl;
+  os << "Number of levels: " << this->m_NumberOfLevels << std::endl;
   os << "Max error tolerance threshold: " << this->m_MaxErrorToleranceThreshold << std::endl;
   os << "Mean error tolerance threshold: " << this->m_MeanErrorToleranceThreshold << std::endl;
 }
@@ -21,6 +21,8 @@
 #include "itkGaussianSmoothingOnUpdateDisplacementFieldTransform.h"
 #include "itkNumericTraits.h"
 #include "itkMath.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
 
 /**
  * Test the UpdateTransformParameters and related methods,
@@ -172,6 +174,60 @@ itkGaussianSmoothingOnUpdateDisplacementFieldTransformTest(int, char *[])
     std::cout << std::endl;
   }
 
+  /* Compare the recursive smoothing with the GaussianOperator smoothing. */
+  std::cout << "Testing recursive Gaussian smoothing..." << std::endl;
+  ITK_TEST_SET_GET_BOOLEAN(displacementTransform, UseRecursiveGaussianSmoothing, false);
+
+  for (double variance : { 0.25, 0.5, 3.0 })
+  {
+    FieldType::Pointer operatorField = FieldType::New();
+    operatorField->SetRegions(region);
+    operatorField->Allocate();
+    FieldType::Pointer recursiveField = FieldType::New();
+    recursiveField->SetRegions(region);
+    recursiveField->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<FieldType> operatorIt(operatorField, region);
+    itk::ImageRegionIterator<FieldType>          recursiveIt(recursiveField, region);
+    for (; !operatorIt.IsAtEnd(); ++operatorIt, ++recursiveIt)
+    {
+      const FieldType::IndexType index = operatorIt.GetIndex();
+      FieldType::PixelType       vector;
+      vector[0] = (index[0] == dimLength / 2 && index[1] == dimLength / 2) ? 99.0 : 1.0;
+      vector[1] = 0.1 * index[0] - 0.2 * index[1];
+      operatorIt.Set(vector);
+      recursiveIt.Set(vector);
+    }
+
+    displacementTransform->UseRecursiveGaussianSmoothingOff();
+    displacementTransform->GaussianSmoothDisplacementField(operatorField, variance);
+    displacementTransform->UseRecursiveGaussianSmoothingOn();
+    displacementTransform->GaussianSmoothDisplacementField(recursiveField, variance);
+
+    double maximumValue = 0.0;
+    double maximumDifference = 0.0;
+    for (operatorIt.GoToBegin(), recursiveIt.GoToBegin(); !operatorIt.IsAtEnd(); ++operatorIt, ++recursiveIt)
+    {
+      const FieldType::IndexType index = operatorIt.GetIndex();
+      const bool                 isOnBoundary =
+        index[0] == 0 || index[1] == 0 || index[0] == dimLength - 1 || index[1] == dimLength - 1;
+      if (isOnBoundary && itk::Math::NotAlmostEquals(recursiveIt.Get().GetNorm(), 0.0))
+      {
+        std::cout << "0-valued boundaries not found after recursive smoothing at " << index << std::endl;
+        return EXIT_FAILURE;
+      }
+      maximumValue = std::max(maximumValue, operatorIt.Get().GetNorm());
+      maximumDifference = std::max(maximumDifference, (operatorIt.Get() - recursiveIt.Get()).GetNorm());
+    }
+    std::cout << "variance: " << variance << ", maximum difference: " << maximumDifference << std::endl;
+    if (maximumDifference > 0.1 * maximumValue)
+    {
+      std::cout << "Recursive smoothing differs from the GaussianOperator smoothing." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  displacementTransform->UseRecursiveGaussianSmoothingOff();
+
   /* Exercise Get/Set sigma */
   displacementTransform->SetGaussianSmoothingVarianceForTheUpdateField(2);
   std::cout << "sigma: " << displacementTransform->GetGaussianSmoothingVarianceForTheUpdateField() << std::endl;
@@ -18,6 +18,7 @@
 
 #include "itkInvertDisplacementFieldImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
 
 int
 itkInvertDisplacementFieldImageFilterTest(int, char *[])
@@ -125,5 +126,32 @@ itkInvertDisplacementFieldImageFilterTest(int, char *[])
 
   inverter->Print(std::cout, 3);
 
+  // Coarse-to-fine estimation of the same inverse
+  InverterType::Pointer multiLevelInverter = InverterType::New();
+  multiLevelInverter->SetInput(field);
+  multiLevelInverter->SetMaximumNumberOfIterations(numberOfIterations);
+  multiLevelInverter->SetMeanErrorToleranceThreshold(meanTolerance);
+  multiLevelInverter->SetMaxErrorToleranceThreshold(maxTolerance);
+  multiLevelInverter->SetEnforceBoundaryCondition(false);
+  multiLevelInverter->SetNumberOfLevels(3);
+  ITK_TEST_SET_GET_VALUE(3, multiLevelInverter->GetNumberOfLevels());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(multiLevelInverter->Update());
+
+  v = multiLevelInverter->GetOutput()->GetPixel(index);
+  delta = v + ones;
+  if (delta.GetNorm() > 0.05)
+  {
+    std::cerr << "Failed to find proper inverse with multiple levels." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (multiLevelInverter->GetMeanErrorNorm() > multiLevelInverter->GetMeanErrorToleranceThreshold() &&
+      multiLevelInverter->GetMaxErrorNorm() > multiLevelInverter->GetMaxErrorToleranceThreshold())
+  {
+    std::cerr << "Failed to converge properly with multiple levels." << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -122,6 +122,14 @@ public:
   itkGetConstMacro(BrightObject, bool);
   itkBooleanMacro(BrightObject);
 
+  /** Use a closed-form (non-iterative) eigen value solver for 2D and 3D
+   * Hessians instead of the iterative one. This is considerably faster, at the
+   * cost of a slightly lower accuracy for nearly degenerate Hessians. Default
+   * is "Off". \sa SymmetricEigenAnalysisFixedDimension::ComputeEigenValuesClosedForm */
+  itkSetMacro(UseClosedFormEigenSolver, bool);
+  itkGetConstMacro(UseClosedFormEigenSolver, bool);
+  itkBooleanMacro(UseClosedFormEigenSolver);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(DoubleConvertibleToOutputCheck, (Concept::Convertible<double, OutputPixelType>));
@@ -161,6 +169,7 @@ private:
   unsigned int m_ObjectDimension{ 1 };
   bool         m_BrightObject{ true };
   bool         m_ScaleObjectnessMeasure{ true };
+  bool         m_UseClosedFormEigenSolver{ false };
 };
 } // end namespace itk
 
@@ -75,7 +75,14 @@ HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::DynamicThreade
   {
     // Compute eigen values
     EigenValueArrayType eigenValues;
-    eigenCalculator.ComputeEigenValues(it.Get(), eigenValues);
+    if (m_UseClosedFormEigenSolver)
+    {
+      eigenCalculator.ComputeEigenValuesClosedForm(it.Get(), eigenValues);
+    }
+    else
+    {
+      eigenCalculator.ComputeEigenValues(it.Get(), eigenValues);
+    }
 
     // Sort the eigenvalues by magnitude but retain their sign.
     // The eigenvalues are to be sorted |e1|<=|e2|<=...<=|eN|
@@ -190,6 +197,7 @@ HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::PrintSelf(std:
   os << indent << "ScaleObjectnessMeasure: " << m_ScaleObjectnessMeasure << std::endl;
   os << indent << "ObjectDimension: " << m_ObjectDimension << std::endl;
   os << indent << "BrightObject: " << m_BrightObject << std::endl;
+  os << indent << "UseClosedFormEigenSolver: " << m_UseClosedFormEigenSolver << std::endl;
 }
 } // end namespace itk
 
@@ -62,6 +62,11 @@ extern ITKImageFeature_EXPORT std::ostream &
  * The filter computes a second output image (accessed by the GetScalesOutput method)
  * containing the scales at which each pixel gave the best response.
  *
+ * The precision of the computation is selected through THessianImage: with a
+ * SymmetricSecondRankTensor<float, N> pixel type the Hessian, the measure and
+ * the running best response are all kept in single precision, halving the
+ * memory footprint compared to the double default.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Generalizing vesselness with respect to dimensionality and shape"
@@ -107,6 +112,7 @@ public:
   using InputPixelType = typename TInputImage::PixelType;
   using OutputPixelType = typename TOutputImage::PixelType;
   using OutputRegionType = typename TOutputImage::RegionType;
+  using InputRegionType = typename TInputImage::RegionType;
 
   /** Image dimension. */
   static constexpr unsigned int ImageDimension = InputImageType ::ImageDimension;
@@ -120,8 +126,10 @@ public:
 
   /** Update image buffer that holds the best objectness response. This is not redundant from
    the output image because the latter may not be of float type, which is required for the comparisons
-   between responses at different scales. */
-  using UpdateBufferType = Image<double, Self::ImageDimension>;
+   between responses at different scales. Its precision follows the component type of the Hessian
+   image, so a float Hessian image keeps the whole computation in single precision. */
+  using UpdateBufferType =
+    Image<typename NumericTraits<typename HessianImageType::PixelType>::ValueType, Self::ImageDimension>;
   using BufferValueType = typename UpdateBufferType::ValueType;
 
   using DataObjectPointer = typename Superclass::DataObjectPointer;
@@ -202,6 +210,15 @@ public:
   itkGetConstMacro(GenerateHessianOutput, bool);
   itkBooleanMacro(GenerateHessianOutput);
 
+  /** Set/Get the number of pieces the output is divided into. Each piece
+   * is processed at all scales before the next one is started, so the
+   * Hessian and measure images of the internal mini-pipeline only cover one
+   * piece (padded by a margin proportional to SigmaMaximum) instead of the
+   * whole image. This reduces the peak memory use roughly by this factor.
+   * Default is 1, i.e. the whole image is processed at once. */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
   /** This is overloaded to create the Scales and Hessian output images */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
 
@@ -224,7 +241,12 @@ protected:
 
 private:
   void
-  UpdateMaximumResponse(double sigma);
+  UpdateMaximumResponse(double sigma, const OutputRegionType & outputRegion);
+
+  /** Copy the part of the input needed to compute the measure in the
+   * given piece of the output into a new image. */
+  typename InputImageType::ConstPointer
+  GenerateStreamInput(const OutputRegionType & streamRegion) const;
 
   double
   ComputeSigmaValue(int scaleLevel);
@@ -240,6 +262,8 @@ private:
   unsigned int        m_NumberOfSigmaSteps;
   SigmaStepMethodEnum m_SigmaStepMethod;
 
+  unsigned int m_NumberOfStreamDivisions;
+
   typename HessianToMeasureFilterType::Pointer m_HessianToMeasureFilter;
 
   typename HessianFilterType::Pointer m_HessianFilter;
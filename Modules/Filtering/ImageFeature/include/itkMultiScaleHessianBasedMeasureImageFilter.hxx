@@ -20,6 +20,8 @@
 
 #include "itkMultiScaleHessianBasedMeasureImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImageAlgorithm.h"
 #include "itkMath.h"
 
 /*
@@ -47,6 +49,8 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   m_NumberOfSigmaSteps = 10;
   m_SigmaStepMethod = Self::SigmaStepMethodEnum::LogarithmicSigmaSteps;
 
+  m_NumberOfStreamDivisions = 1;
+
   m_HessianFilter = HessianFilterType::New();
   m_HessianToMeasureFilter = nullptr;
 
@@ -162,11 +166,14 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   // Allocate the buffer
   AllocateUpdateBuffer();
 
-  typename InputImageType::ConstPointer input = this->GetInput();
+  this->m_HessianFilter->SetNormalizeAcrossScale(true);
 
-  this->m_HessianFilter->SetInput(input);
+  // Divide the output into pieces along the slowest dimension; all scales are
+  // computed on one piece before moving on to the next one.
+  const OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
 
-  this->m_HessianFilter->SetNormalizeAcrossScale(true);
+  ImageRegionSplitterSlowDimension::Pointer splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfPieces = splitter->GetNumberOfSplits(outputRegion, m_NumberOfStreamDivisions);
 
   // Create a process accumulator for tracking the progress of this
   // minipipeline
@@ -176,29 +183,49 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   // prevent a divide by zero
   if (m_NumberOfSigmaSteps > 0)
   {
-    progress->RegisterInternalFilter(this->m_HessianFilter, .5 / m_NumberOfSigmaSteps);
-    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / m_NumberOfSigmaSteps);
+    const float weight = .5f / (m_NumberOfSigmaSteps * numberOfPieces);
+    progress->RegisterInternalFilter(this->m_HessianFilter, weight);
+    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, weight);
   }
 
-  for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
+  for (unsigned int piece = 0; piece < numberOfPieces; ++piece)
   {
-    const double sigma = this->ComputeSigmaValue(scaleLevel);
+    OutputRegionType streamRegion = outputRegion;
+    splitter->GetSplit(piece, numberOfPieces, streamRegion);
 
-    itkDebugMacro(<< "Computing measure for scale with sigma = " << sigma);
+    if (numberOfPieces > 1)
+    {
+      itkDebugMacro(<< "Computing measure for piece " << piece << " : " << streamRegion);
+      this->m_HessianFilter->SetInput(this->GenerateStreamInput(streamRegion));
+    }
+    else
+    {
+      this->m_HessianFilter->SetInput(this->GetInput());
+    }
 
-    m_HessianFilter->SetSigma(sigma);
+    for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
+    {
+      const double sigma = this->ComputeSigmaValue(scaleLevel);
+
+      itkDebugMacro(<< "Computing measure for scale with sigma = " << sigma);
+
+      m_HessianFilter->SetSigma(sigma);
 
-    m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
+      m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
 
-    m_HessianToMeasureFilter->Update();
+      // The extent of the Hessian image changes with each piece
+      m_HessianToMeasureFilter->UpdateLargestPossibleRegion();
 
-    this->UpdateMaximumResponse(sigma);
+      this->UpdateMaximumResponse(sigma, streamRegion);
+    }
   }
 
+  // Do not keep the last piece of the input alive
+  this->m_HessianFilter->SetInput(this->GetInput());
+
   // Write out the best response to the output image
   // we can assume that the meta-data should match between these two
   // image, therefore we iterate over the desired output region
-  OutputRegionType                      outputRegion = this->GetOutput()->GetBufferedRegion();
   ImageRegionIterator<UpdateBufferType> it(m_UpdateBuffer, outputRegion);
   it.GoToBegin();
 
@@ -218,12 +245,12 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 
 template <typename TInputImage, typename THessianImage, typename TOutputImage>
 void
-MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponse(double sigma)
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponse(
+  double                   sigma,
+  const OutputRegionType & outputRegion)
 {
   // the meta-data should match between these images, therefore we
   // iterate over the desired output region
-  OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
-
   ImageRegionIterator<UpdateBufferType> oit(m_UpdateBuffer, outputRegion);
 
   typename ScalesImageType::Pointer    scalesImage = static_cast<ScalesImageType *>(this->ProcessObject::GetOutput(1));
@@ -281,6 +308,40 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 }
 
 
+template <typename TInputImage, typename THessianImage, typename TOutputImage>
+typename MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::InputImageType::ConstPointer
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::GenerateStreamInput(
+  const OutputRegionType & streamRegion) const
+{
+  const InputImageType * input = this->GetInput();
+
+  // The recursive (IIR) Gaussian derivative kernels decay slower than a true
+  // Gaussian; eight sigmas away from the center their contribution is below
+  // single precision, so pad the piece by this margin in each direction to
+  // make the measure in the piece independent of where the image was cut.
+  const double maximumSigma = std::max(m_SigmaMinimum, m_SigmaMaximum);
+
+  typename InputRegionType::SizeType radius;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    radius[d] = Math::Ceil<SizeValueType>(8.0 * maximumSigma / input->GetSpacing()[d]);
+  }
+
+  InputRegionType paddedRegion = streamRegion;
+  paddedRegion.PadByRadius(radius);
+  paddedRegion.Crop(input->GetBufferedRegion());
+
+  typename InputImageType::Pointer streamInput = InputImageType::New();
+  streamInput->CopyInformation(input);
+  streamInput->SetRegions(paddedRegion);
+  streamInput->Allocate();
+
+  ImageAlgorithm::Copy(input, streamInput.GetPointer(), paddedRegion, paddedRegion);
+
+  return streamInput.GetPointer();
+}
+
+
 template <typename TInputImage, typename THessianImage, typename TOutputImage>
 double
 MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::ComputeSigmaValue(int scaleLevel)
@@ -363,6 +424,7 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   os << indent << "SigmaMaximum:  " << m_SigmaMaximum << std::endl;
   os << indent << "NumberOfSigmaSteps:  " << m_NumberOfSigmaSteps << std::endl;
   os << indent << "SigmaStepMethod:  " << m_SigmaStepMethod << std::endl;
+  os << indent << "NumberOfStreamDivisions:  " << m_NumberOfStreamDivisions << std::endl;
   os << indent << "HessianToMeasureFilter: " << m_HessianToMeasureFilter << std::endl;
   os << indent << "NonNegativeHessianBasedMeasure:  " << m_NonNegativeHessianBasedMeasure << std::endl;
   os << indent << "GenerateScalesOutput: " << m_GenerateScalesOutput << std::endl;
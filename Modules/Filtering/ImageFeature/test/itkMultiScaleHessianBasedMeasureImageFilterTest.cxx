@@ -20,6 +20,7 @@
 #include "itkMultiScaleHessianBasedMeasureImageFilter.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkSimpleFilterWatcher.h"
 #include "itkTestingMacros.h"
 
@@ -202,6 +203,58 @@ itkMultiScaleHessianBasedMeasureImageFilterTest(int argc, char * argv[])
     std::cerr << e << std::endl;
   }
 
+  // Check the streamed path and the closed-form eigen solver separately
+  // against the default whole-image path, relative to the largest response
+  const auto compareOutputs = [](const OutputImageType * expected, const OutputImageType * actual, const char * name) {
+    constexpr double tolerance = 1e-5;
+
+    itk::ImageRegionConstIterator<OutputImageType> eit(expected, expected->GetBufferedRegion());
+    itk::ImageRegionConstIterator<OutputImageType> ait(actual, expected->GetBufferedRegion());
+    double                                         maximumResponse = 0.0;
+    double                                         maximumDifference = 0.0;
+    for (; !eit.IsAtEnd(); ++eit, ++ait)
+    {
+      maximumResponse = std::max(maximumResponse, static_cast<double>(itk::Math::abs(eit.Get())));
+      maximumDifference = std::max(maximumDifference, static_cast<double>(itk::Math::abs(eit.Get() - ait.Get())));
+    }
+    if (maximumDifference > tolerance * maximumResponse)
+    {
+      std::cerr << "Error in " << name << ": maximum difference " << maximumDifference << " exceeds "
+                << tolerance * maximumResponse << std::endl;
+      return false;
+    }
+    return true;
+  };
+
+  ITK_TEST_SET_GET_VALUE(1, multiScaleEnhancementFilter->GetNumberOfStreamDivisions());
+  ITK_TEST_SET_GET_VALUE(false, objectnessFilter->GetUseClosedFormEigenSolver());
+
+  OutputImageType::Pointer wholeOutput = multiScaleEnhancementFilter->GetOutput();
+  wholeOutput->DisconnectPipeline();
+
+  // Streaming only
+  constexpr unsigned int numberOfStreamDivisions = 4;
+  multiScaleEnhancementFilter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  ITK_TEST_SET_GET_VALUE(numberOfStreamDivisions, multiScaleEnhancementFilter->GetNumberOfStreamDivisions());
+  ITK_TRY_EXPECT_NO_EXCEPTION(multiScaleEnhancementFilter->Update());
+  if (!compareOutputs(wholeOutput, multiScaleEnhancementFilter->GetOutput(), "streamed output"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Closed-form eigen solver only
+  multiScaleEnhancementFilter->SetNumberOfStreamDivisions(1);
+  objectnessFilter->UseClosedFormEigenSolverOn();
+  ITK_TEST_SET_GET_VALUE(true, objectnessFilter->GetUseClosedFormEigenSolver());
+  ITK_TRY_EXPECT_NO_EXCEPTION(multiScaleEnhancementFilter->Update());
+  if (!compareOutputs(wholeOutput, multiScaleEnhancementFilter->GetOutput(), "closed-form output"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  objectnessFilter->UseClosedFormEigenSolverOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(multiScaleEnhancementFilter->Update());
+
   const HessianImageType * hessianImage = multiScaleEnhancementFilter->GetHessianOutput();
 
   std::cout << "Hessian Image Buffered Region = " << std::endl;
@@ -20,6 +20,7 @@
 
 #include "itkInPlaceImageFilter.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkPixelwiseFusionChain.h"
 
 
 #include <functional>
@@ -45,8 +46,14 @@ namespace itk
  * the pipeline. The SetConstant() and GetConstant() methods are provided as shortcuts
  * to set or get the constant value without manipulating the decorator.
  *
+ * When PixelwiseFusion is on, the chains of pixel-wise filters directly
+ * upstream of each image input are executed on the fly, scanline by
+ * scanline, as part of this filter, instead of producing their intermediate
+ * images.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter
+ * \sa PixelwiseFusionChain
  *
  * \ingroup IntensityImageFilters   MultiThreaded
  * \ingroup ITKImageFilterBase
@@ -211,6 +218,30 @@ public:
   }
 #endif // !defined( ITK_WRAPPING_PARSER )
 
+  /** Set/Get whether the pixel-wise filters upstream of this filter are
+   * fused into it. Defaults to
+   * PixelwiseFusionChain::GetGlobalDefaultPixelwiseFusion(). */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  /** Names of the upstream filters fused into this filter during the last
+   * update, farthest first, the filters of the first input before the ones
+   * of the second input. */
+  const std::vector<std::string> &
+  GetFusedFilterNames() const
+  {
+    return m_FusedFilterNames;
+  }
+
+  /** Fuse the upstream filters into this one when PixelwiseFusion is on. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
+  /** The first input is not generated when its upstream filters are fused. */
+  bool
+  CanRunInPlace() const override;
+
 
   /** ImageDimension constants */
   itkStaticConstMacro(InputImage1Dimension, unsigned int, TInputImage1::ImageDimension);
@@ -252,8 +283,27 @@ protected:
   void
   GenerateOutputInformation() override;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 private:
+  /** Fill line with the scanline of image starting at index, computed by
+   * chain when it is not empty. */
+  template <typename TImage>
+  static void
+  ReadScanline(const PixelwiseFusionChain &           chain,
+               const TImage *                         image,
+               const typename TOutputImage::IndexType & index,
+               SizeValueType                          length,
+               typename TImage::PixelType *           line,
+               PixelwiseFusionChain::ScanlineBuffer & buffer);
+
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction;
+
+  bool                     m_PixelwiseFusion;
+  PixelwiseFusionChain     m_FusionChain1;
+  PixelwiseFusionChain     m_FusionChain2;
+  std::vector<std::string> m_FusedFilterNames;
 };
 } // end namespace itk
 
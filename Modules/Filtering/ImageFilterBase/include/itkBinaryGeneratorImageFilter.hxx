@@ -21,6 +21,8 @@
 #include "itkBinaryGeneratorImageFilter.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <memory>
 
 
 namespace itk
@@ -33,6 +35,7 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::BinaryGene
   this->InPlaceOff();
   this->DynamicMultiThreadingOn();
   this->ThreaderUpdateProgressOff();
+  m_PixelwiseFusion = PixelwiseFusionChain::GetGlobalDefaultPixelwiseFusion();
 }
 
 template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
@@ -185,6 +188,47 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if (!m_FusionChain1.IsEmpty() || !m_FusionChain2.IsEmpty())
+  {
+    // At least one input is computed on the fly by the fused upstream
+    // filters: work on whole scanlines of both operands
+    const SizeValueType                     lineLength = outputRegionForThread.GetSize(0);
+    std::unique_ptr<Input1ImagePixelType[]> line1(new Input1ImagePixelType[lineLength]);
+    std::unique_ptr<Input2ImagePixelType[]> line2(new Input2ImagePixelType[lineLength]);
+    PixelwiseFusionChain::ScanlineBuffer    buffer1;
+    PixelwiseFusionChain::ScanlineBuffer    buffer2;
+    if (!inputPtr1)
+    {
+      std::fill_n(line1.get(), lineLength, this->GetConstant1());
+    }
+    if (!inputPtr2)
+    {
+      std::fill_n(line2.get(), lineLength, this->GetConstant2());
+    }
+
+    ImageScanlineIterator<TOutputImage> outputIt(outputPtr, outputRegionForThread);
+    while (!outputIt.IsAtEnd())
+    {
+      const typename TOutputImage::IndexType index = outputIt.GetIndex();
+      if (inputPtr1)
+      {
+        ReadScanline(m_FusionChain1, inputPtr1, index, lineLength, line1.get(), buffer1);
+      }
+      if (inputPtr2)
+      {
+        ReadScanline(m_FusionChain2, inputPtr2, index, lineLength, line2.get(), buffer2);
+      }
+      for (SizeValueType i = 0; i < lineLength; ++i)
+      {
+        outputIt.Set(functor(line1[i], line2[i]));
+        ++outputIt;
+      }
+      outputIt.NextLine();
+      progress.Completed(lineLength);
+    }
+    return;
+  }
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator<TInputImage1> inputIt1(inputPtr1, outputRegionForThread);
@@ -252,6 +296,122 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
     itkGenericExceptionMacro(<< "At most one of the inputs can be a constant.");
   }
 }
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+template <typename TImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::ReadScanline(
+  const PixelwiseFusionChain &             chain,
+  const TImage *                           image,
+  const typename TOutputImage::IndexType & index,
+  SizeValueType                            length,
+  typename TImage::PixelType *             line,
+  PixelwiseFusionChain::ScanlineBuffer &   buffer)
+{
+  if (!chain.IsEmpty())
+  {
+    chain.ProcessScanline(&index[0], length, line, buffer);
+    return;
+  }
+
+  typename TImage::RegionType region;
+  std::copy(index.begin(), index.end(), region.GetModifiableIndex().begin());
+  region.GetModifiableSize().Fill(1);
+  region.SetSize(0, length);
+
+  ImageScanlineConstIterator<TImage> it(image, region);
+  for (SizeValueType i = 0; !it.IsAtEndOfLine(); ++i, ++it)
+  {
+    line[i] = it.Get();
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::UpdateOutputData(DataObject * output)
+{
+  m_FusionChain1.Clear();
+  m_FusionChain2.Clear();
+  m_FusedFilterNames.clear();
+  if (m_PixelwiseFusion)
+  {
+    DataObject * input1 = ProcessObject::GetInput(0);
+    DataObject * input2 = ProcessObject::GetInput(1);
+    if (dynamic_cast<TInputImage1 *>(input1) != nullptr)
+    {
+      m_FusionChain1.Build(input1);
+    }
+    if (dynamic_cast<TInputImage2 *>(input2) != nullptr)
+    {
+      m_FusionChain2.Build(input2);
+    }
+
+    // A filter fused into one chain does not generate its output, so it
+    // cannot be shared with the other input.
+    if (m_FusionChain1.SharesStagesWith(m_FusionChain2))
+    {
+      m_FusionChain1.Clear();
+      m_FusionChain2.Clear();
+    }
+  }
+  if (m_FusionChain1.IsEmpty() && m_FusionChain2.IsEmpty())
+  {
+    Superclass::UpdateOutputData(output);
+    return;
+  }
+
+  m_FusedFilterNames = m_FusionChain1.GetFusedFilterNames();
+  const std::vector<std::string> names2 = m_FusionChain2.GetFusedFilterNames();
+  m_FusedFilterNames.insert(m_FusedFilterNames.end(), names2.begin(), names2.end());
+  itkDebugMacro(<< "Fusing " << m_FusedFilterNames.size() << " upstream filters");
+
+  m_FusionChain1.SetFusedIntoDownstream(true);
+  m_FusionChain2.SetFusedIntoDownstream(true);
+  try
+  {
+    m_FusionChain1.UpdateInput();
+    m_FusionChain2.UpdateInput();
+    m_FusionChain1.BeforeThreadedGenerateData();
+    m_FusionChain2.BeforeThreadedGenerateData();
+    Superclass::UpdateOutputData(output);
+    m_FusionChain1.AfterThreadedGenerateData();
+    m_FusionChain2.AfterThreadedGenerateData();
+  }
+  catch (...)
+  {
+    m_FusionChain1.SetFusedIntoDownstream(false);
+    m_FusionChain2.SetFusedIntoDownstream(false);
+    m_FusionChain1.Clear();
+    m_FusionChain2.Clear();
+    throw;
+  }
+  m_FusionChain1.SetFusedIntoDownstream(false);
+  m_FusionChain2.SetFusedIntoDownstream(false);
+  m_FusionChain1.Clear();
+  m_FusionChain2.Clear();
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+bool
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::CanRunInPlace() const
+{
+  return m_FusionChain1.IsEmpty() && Superclass::CanRunInPlace();
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "PixelwiseFusion: " << m_PixelwiseFusion << std::endl;
+  os << indent << "FusedFilterNames:";
+  for (const auto & name : m_FusedFilterNames)
+  {
+    os << " " << name;
+  }
+  os << std::endl;
+}
 } // end namespace itk
 
 #endif
@@ -91,6 +91,9 @@ public:
  * If you need to perform a dimensionaly reduction, you may want
  * to use the ExtractImageFilter instead of the CastImageFilter.
  *
+ * The filter can be fused into a downstream pixel-wise filter, see
+ * PixelwiseFusionChain, unless it runs in place.
+ *
  * \ingroup IntensityImageFilters  MultiThreaded
  * \sa UnaryFunctorImageFilter
  * \sa ExtractImageFilter
@@ -101,7 +104,9 @@ public:
  * \endsphinx
  */
 template <typename TInputImage, typename TOutputImage>
-class ITK_TEMPLATE_EXPORT CastImageFilter : public InPlaceImageFilter<TInputImage, TOutputImage>
+class ITK_TEMPLATE_EXPORT CastImageFilter
+  : public InPlaceImageFilter<TInputImage, TOutputImage>
+  , public PixelwiseFusionStage
 {
 public:
   ITK_DISALLOW_COPY_AND_ASSIGN(CastImageFilter);
@@ -126,6 +131,11 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(CastImageFilter, InPlaceImageFilter);
 
+  /** Bypass the execution of this filter when it is fused into a downstream
+   * filter. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
 protected:
   CastImageFilter();
   ~CastImageFilter() override = default;
@@ -151,6 +161,47 @@ protected:
   void
   DynamicThreadedGenerateDataDispatched(const OutputImageRegionType & outputRegionForThread);
 
+  /** PixelwiseFusionStage interface. Returns false for subclasses, and when
+   * the filter runs in place. */
+  bool
+  CanBeFused() const override;
+  ProcessObject *
+  GetFusedProcessObject() override
+  {
+    return this;
+  }
+  DataObject *
+  GetFusedInput() override
+  {
+    return this->GetPrimaryInput();
+  }
+  size_t
+  GetFusedOutputPixelSize() const override
+  {
+    return sizeof(OutputPixelType);
+  }
+  void
+  FusedBeforeThreadedGenerateData() override
+  {
+    this->BeforeThreadedGenerateData();
+  }
+  const void *
+  GetFusedInputScanline(const IndexValueType * index) const override;
+  void
+  FusedProcessScanline(const void * input, void * output, SizeValueType length) override;
+
+  template <typename TInputPixelType,
+            typename TOutputPixelType,
+            typename std::enable_if<mpl::is_static_castable<TInputPixelType, TOutputPixelType>::value, int>::type = 0>
+  static void
+  CastScanline(const TInputPixelType * input, TOutputPixelType * output, SizeValueType length);
+
+  template <typename TInputPixelType,
+            typename TOutputPixelType,
+            typename std::enable_if<!mpl::is_static_castable<TInputPixelType, TOutputPixelType>::value, int>::type = 0>
+  static void
+  CastScanline(const TInputPixelType * input, TOutputPixelType * output, SizeValueType length);
+
 private:
 };
 } // end namespace itk
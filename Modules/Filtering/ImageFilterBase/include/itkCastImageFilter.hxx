@@ -166,6 +166,90 @@ CastImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDataDispatche
   }
 }
 
+
+template <typename TInputImage, typename TOutputImage>
+void
+CastImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * output)
+{
+  if (this->GetFusedIntoDownstream())
+  {
+    // A downstream filter computes our output on the fly: only the input
+    // has to be up to date.
+    this->GetPrimaryInput()->UpdateOutputData();
+    return;
+  }
+  Superclass::UpdateOutputData(output);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+CastImageFilter<TInputImage, TOutputImage>::CanBeFused() const
+{
+  // Running in place does not touch the pixels, and is left to GenerateData().
+  return typeid(*this) == typeid(Self) && PixelwiseFusionStage::IsFusibleImageType<TInputImage>() &&
+         PixelwiseFusionStage::IsFusibleImageType<TOutputImage>() &&
+         Superclass::InputImageDimension == Superclass::OutputImageDimension &&
+         !(this->GetInPlace() && this->CanRunInPlace());
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+const void *
+CastImageFilter<TInputImage, TOutputImage>::GetFusedInputScanline(const IndexValueType * index) const
+{
+  const TInputImage *             inputPtr = this->GetInput();
+  typename TInputImage::IndexType inputIndex;
+  std::copy(index, index + Superclass::InputImageDimension, inputIndex.begin());
+  return inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(inputIndex);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+CastImageFilter<TInputImage, TOutputImage>::FusedProcessScanline(const void *  input,
+                                                                 void *        output,
+                                                                 SizeValueType length)
+{
+  CastScanline<InputPixelType, OutputPixelType>(
+    static_cast<const InputPixelType *>(input), static_cast<OutputPixelType *>(output), length);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TInputPixelType,
+          typename TOutputPixelType,
+          typename std::enable_if<mpl::is_static_castable<TInputPixelType, TOutputPixelType>::value, int>::type>
+void
+CastImageFilter<TInputImage, TOutputImage>::CastScanline(const TInputPixelType * input,
+                                                         TOutputPixelType *      output,
+                                                         SizeValueType           length)
+{
+  for (SizeValueType i = 0; i < length; ++i)
+  {
+    output[i] = static_cast<TOutputPixelType>(input[i]);
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TInputPixelType,
+          typename TOutputPixelType,
+          typename std::enable_if<!mpl::is_static_castable<TInputPixelType, TOutputPixelType>::value, int>::type>
+void
+CastImageFilter<TInputImage, TOutputImage>::CastScanline(const TInputPixelType * input,
+                                                         TOutputPixelType *      output,
+                                                         SizeValueType           length)
+{
+  for (SizeValueType i = 0; i < length; ++i)
+  {
+    for (unsigned int k = 0; k < TOutputPixelType::Dimension; k++)
+    {
+      output[i][k] = static_cast<typename TOutputPixelType::ValueType>(input[i][k]);
+    }
+  }
+}
+
 } // end namespace itk
 
 #endif
@@ -21,6 +21,7 @@
 #include "itkMath.h"
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkPixelwiseFusionChain.h"
 
 #include <functional>
 
@@ -45,14 +46,23 @@ namespace itk
  * UnaryGeneratorImageFilter can be used to promote a 2D image to a 3D
  * image, etc.
  *
+ * When PixelwiseFusion is on, the chain of pixel-wise filters directly
+ * upstream of this filter is executed on the fly, scanline by scanline, as
+ * part of this filter, instead of producing its intermediate images. This
+ * filter can itself be fused into a downstream filter. Subclasses are not
+ * fused unless they override CanBeFused().
+ *
  * \sa UnaryFunctorImageFilter
  * \sa BinaryGeneratorImageFilter TernaryGeneratormageFilter
+ * \sa PixelwiseFusionChain
  *
  * \ingroup ITKImageFilterBase MultiThreaded
  *
  */
 template <typename TInputImage, typename TOutputImage>
-class UnaryGeneratorImageFilter : public InPlaceImageFilter<TInputImage, TOutputImage>
+class UnaryGeneratorImageFilter
+  : public InPlaceImageFilter<TInputImage, TOutputImage>
+  , public PixelwiseFusionStage
 {
 public:
   ITK_DISALLOW_COPY_AND_ASSIGN(UnaryGeneratorImageFilter);
@@ -94,6 +104,7 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_FusedProcessScanlineFunction = MakeFusedProcessScanlineFunction(f);
 
     this->Modified();
   }
@@ -103,6 +114,7 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_FusedProcessScanlineFunction = MakeFusedProcessScanlineFunction(f);
 
     this->Modified();
   }
@@ -118,6 +130,7 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_FusedProcessScanlineFunction = MakeFusedProcessScanlineFunction(funcPointer);
 
     this->Modified();
   }
@@ -127,6 +140,7 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_FusedProcessScanlineFunction = MakeFusedProcessScanlineFunction(funcPointer);
 
     this->Modified();
   }
@@ -146,11 +160,37 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, functor](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(functor, outputRegionForThread);
     };
+    m_FusedProcessScanlineFunction = MakeFusedProcessScanlineFunction(functor);
 
     this->Modified();
   }
 #endif // !defined( ITK_WRAPPING_PARSER )
 
+  /** Set/Get whether the pixel-wise filters upstream of this filter are
+   * fused into it. Defaults to
+   * PixelwiseFusionChain::GetGlobalDefaultPixelwiseFusion(). */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  /** Names of the upstream filters fused into this filter during the last
+   * update, farthest first. */
+  const std::vector<std::string> &
+  GetFusedFilterNames() const
+  {
+    return m_FusedFilterNames;
+  }
+
+  /** Bypass the execution of this filter when it is fused into a downstream
+   * filter, and fuse the upstream filters into this one when PixelwiseFusion
+   * is on. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
+  /** The input is not generated when upstream filters are fused. */
+  bool
+  CanRunInPlace() const override;
+
 protected:
   UnaryGeneratorImageFilter();
   ~UnaryGeneratorImageFilter() override = default;
@@ -182,8 +222,69 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** PixelwiseFusionStage interface. Returns false for subclasses: a
+   * subclass whose work is entirely done by its functor can opt in by
+   * overriding CanBeFused() to return IsPixelwiseFusible(). */
+  bool
+  CanBeFused() const override;
+
+  /** True if the image types allow running the functor in a fused chain. */
+  bool
+  IsPixelwiseFusible() const;
+  ProcessObject *
+  GetFusedProcessObject() override
+  {
+    return this;
+  }
+  DataObject *
+  GetFusedInput() override
+  {
+    return this->GetPrimaryInput();
+  }
+  size_t
+  GetFusedOutputPixelSize() const override
+  {
+    return sizeof(OutputImagePixelType);
+  }
+  void
+  FusedBeforeThreadedGenerateData() override
+  {
+    this->BeforeThreadedGenerateData();
+  }
+  const void *
+  GetFusedInputScanline(const IndexValueType * index) const override;
+  void
+  FusedProcessScanline(const void * input, void * output, SizeValueType length) override
+  {
+    m_FusedProcessScanlineFunction(input, output, length);
+  }
+
 private:
+  using FusedProcessScanlineFunctionType = std::function<void(const void *, void *, SizeValueType)>;
+
+  template <typename TFunctor>
+  static FusedProcessScanlineFunctionType
+  MakeFusedProcessScanlineFunction(const TFunctor & functor)
+  {
+    return [functor](const void * input, void * output, SizeValueType length) {
+      const auto * inputLine = static_cast<const InputImagePixelType *>(input);
+      auto *       outputLine = static_cast<OutputImagePixelType *>(output);
+      for (SizeValueType i = 0; i < length; ++i)
+      {
+        outputLine[i] = functor(inputLine[i]);
+      }
+    };
+  }
+
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction;
+  FusedProcessScanlineFunctionType                   m_FusedProcessScanlineFunction;
+
+  bool                     m_PixelwiseFusion;
+  PixelwiseFusionChain     m_FusionChain;
+  std::vector<std::string> m_FusedFilterNames;
 };
 } // end namespace itk
 
@@ -22,6 +22,9 @@
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 #include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <memory>
+#include <typeinfo>
 
 namespace itk
 {
@@ -34,6 +37,7 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::UnaryGeneratorImageFilter(
   this->SetNumberOfRequiredInputs(1);
   this->InPlaceOff();
   this->DynamicMultiThreadingOn();
+  m_PixelwiseFusion = PixelwiseFusionChain::GetGlobalDefaultPixelwiseFusion();
 }
 
 /**
@@ -97,6 +101,29 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if (!m_FusionChain.IsEmpty())
+  {
+    // The input is computed on the fly by the fused upstream filters
+    const SizeValueType                    lineLength = regionSize[0];
+    std::unique_ptr<InputImagePixelType[]> inputLine(new InputImagePixelType[lineLength]);
+    PixelwiseFusionChain::ScanlineBuffer   buffer;
+
+    ImageScanlineIterator<TOutputImage> outputIt(outputPtr, outputRegionForThread);
+    while (!outputIt.IsAtEnd())
+    {
+      const typename TOutputImage::IndexType index = outputIt.GetIndex();
+      m_FusionChain.ProcessScanline(&index[0], lineLength, inputLine.get(), buffer);
+      for (SizeValueType i = 0; i < lineLength; ++i)
+      {
+        outputIt.Set(functor(inputLine[i]));
+        ++outputIt;
+      }
+      outputIt.NextLine();
+      progress.Completed(lineLength);
+    }
+    return;
+  }
+
   // Define the portion of the input to walk for this thread, using
   // the CallCopyOutputRegionToInputRegion method allows for the input
   // and output images to be different dimensions
@@ -123,6 +150,108 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
     outputIt.NextLine();
   }
 }
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * output)
+{
+  if (this->GetFusedIntoDownstream())
+  {
+    // A downstream filter computes our output on the fly: only the input
+    // has to be up to date.
+    this->GetPrimaryInput()->UpdateOutputData();
+    return;
+  }
+
+  m_FusionChain.Clear();
+  m_FusedFilterNames.clear();
+  if (m_PixelwiseFusion && Superclass::InputImageDimension == Superclass::OutputImageDimension)
+  {
+    m_FusionChain.Build(this->GetPrimaryInput());
+  }
+  if (m_FusionChain.IsEmpty())
+  {
+    Superclass::UpdateOutputData(output);
+    return;
+  }
+
+  m_FusedFilterNames = m_FusionChain.GetFusedFilterNames();
+  itkDebugMacro(<< "Fusing " << m_FusedFilterNames.size() << " upstream filters");
+
+  m_FusionChain.SetFusedIntoDownstream(true);
+  try
+  {
+    m_FusionChain.UpdateInput();
+    m_FusionChain.BeforeThreadedGenerateData();
+    Superclass::UpdateOutputData(output);
+    m_FusionChain.AfterThreadedGenerateData();
+  }
+  catch (...)
+  {
+    m_FusionChain.SetFusedIntoDownstream(false);
+    m_FusionChain.Clear();
+    throw;
+  }
+  m_FusionChain.SetFusedIntoDownstream(false);
+  m_FusionChain.Clear();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::CanRunInPlace() const
+{
+  return m_FusionChain.IsEmpty() && Superclass::CanRunInPlace();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::CanBeFused() const
+{
+  // Fusion bypasses GenerateData(), so a subclass may have customized
+  // the execution in a way that would be skipped. Only the generic filter
+  // itself is fused unless a subclass opts in.
+  return typeid(*this) == typeid(Self) && this->IsPixelwiseFusible();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::IsPixelwiseFusible() const
+{
+  return PixelwiseFusionStage::IsFusibleImageType<TInputImage>() &&
+         PixelwiseFusionStage::IsFusibleImageType<TOutputImage>() &&
+         Superclass::InputImageDimension == Superclass::OutputImageDimension && m_FusedProcessScanlineFunction;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+const void *
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::GetFusedInputScanline(const IndexValueType * index) const
+{
+  const TInputImage *             inputPtr = this->GetInput();
+  typename TInputImage::IndexType inputIndex;
+  std::copy(index, index + Superclass::InputImageDimension, inputIndex.begin());
+  return inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(inputIndex);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "PixelwiseFusion: " << m_PixelwiseFusion << std::endl;
+  os << indent << "FusedFilterNames:";
+  for (const auto & name : m_FusedFilterNames)
+  {
+    os << " " << name;
+  }
+  os << std::endl;
+}
 } // end namespace itk
 
 #endif
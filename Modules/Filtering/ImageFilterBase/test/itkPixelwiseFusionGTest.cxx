@@ -0,0 +1,274 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkUnaryGeneratorImageFilter.h"
+#include "itkBinaryGeneratorImageFilter.h"
+#include "itkAbsImageFilter.h"
+#include "itkRescaleIntensityImageFilter.h"
+#include "itkPixelwiseFusionChain.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include "itkGTest.h"
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 3>;
+
+struct AddOneFunctor
+{
+  bool
+  operator!=(const AddOneFunctor &) const
+  {
+    return false;
+  }
+  bool
+  operator==(const AddOneFunctor & other) const
+  {
+    return !(*this != other);
+  }
+  float
+  operator()(const float & p) const
+  {
+    return p + 1.0f;
+  }
+};
+
+using AddOneFilterType = itk::UnaryFunctorImageFilter<ImageType, ImageType, AddOneFunctor>;
+using UnaryFilterType = itk::UnaryGeneratorImageFilter<ImageType, ImageType>;
+using BinaryFilterType = itk::BinaryGeneratorImageFilter<ImageType, ImageType, ImageType>;
+
+ImageType::Pointer
+CreateImage()
+{
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetIndex({ { 2, -3, 1 } });
+  region.SetSize({ { 7, 5, 4 } });
+  image->SetRegions(region);
+  image->Allocate();
+
+  float                               value = 0.0f;
+  itk::ImageRegionIterator<ImageType> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(value);
+    value += 0.5f;
+  }
+  return image;
+}
+
+// image -> (+1) -> (*2) -> [input1]
+//       -> (-3)         -> [input2] -> (a - b)
+struct Pipeline
+{
+  explicit Pipeline(const ImageType * image)
+  {
+    addOne->SetInput(image);
+    twice->SetInput(addOne->GetOutput());
+    twice->SetFunctor([](const float & p) { return 2.0f * p; });
+    minusThree->SetInput(image);
+    minusThree->SetFunctor([](const float & p) { return p - 3.0f; });
+    difference->SetInput1(twice->GetOutput());
+    difference->SetInput2(minusThree->GetOutput());
+    difference->SetFunctor([](const float & a, const float & b) { return a - b; });
+  }
+
+  AddOneFilterType::Pointer addOne = AddOneFilterType::New();
+  UnaryFilterType::Pointer  twice = UnaryFilterType::New();
+  UnaryFilterType::Pointer  minusThree = UnaryFilterType::New();
+  BinaryFilterType::Pointer difference = BinaryFilterType::New();
+};
+
+void
+ExpectSameImage(const ImageType * expected, const ImageType * actual)
+{
+  ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> expectedIt(expected, expected->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> actualIt(actual, actual->GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    EXPECT_EQ(expectedIt.Get(), actualIt.Get());
+  }
+}
+
+} // namespace
+
+
+TEST(PixelwiseFusion, DefaultIsOff)
+{
+  EXPECT_FALSE(itk::PixelwiseFusionChain::GetGlobalDefaultPixelwiseFusion());
+
+  auto filter = UnaryFilterType::New();
+  EXPECT_FALSE(filter->GetPixelwiseFusion());
+
+  itk::PixelwiseFusionChain::SetGlobalDefaultPixelwiseFusion(true);
+  auto fusingFilter = BinaryFilterType::New();
+  itk::PixelwiseFusionChain::SetGlobalDefaultPixelwiseFusion(false);
+  EXPECT_TRUE(fusingFilter->GetPixelwiseFusion());
+  fusingFilter->Print(std::cout);
+}
+
+
+TEST(PixelwiseFusion, BinaryTailMatchesUnfused)
+{
+  auto image = CreateImage();
+
+  Pipeline reference(image);
+  reference.difference->Update();
+  EXPECT_TRUE(reference.difference->GetFusedFilterNames().empty());
+
+  Pipeline fused(image);
+  fused.difference->PixelwiseFusionOn();
+  fused.difference->Update();
+  ExpectSameImage(reference.difference->GetOutput(), fused.difference->GetOutput());
+
+  const std::vector<std::string> expectedNames{ "UnaryFunctorImageFilter",
+                                                "UnaryGeneratorImageFilter",
+                                                "UnaryGeneratorImageFilter" };
+  EXPECT_EQ(expectedNames, fused.difference->GetFusedFilterNames());
+
+  // The intermediate images are not generated
+  EXPECT_EQ(0u, fused.addOne->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+  EXPECT_EQ(0u, fused.twice->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+
+  // Modifying a fused filter re-executes the fused pipeline
+  fused.twice->SetFunctor([](const float & p) { return 3.0f * p; });
+  reference.twice->SetFunctor([](const float & p) { return 3.0f * p; });
+  reference.difference->Update();
+  fused.difference->Update();
+  ExpectSameImage(reference.difference->GetOutput(), fused.difference->GetOutput());
+
+  // A fused filter still produces its own output when updated directly
+  fused.twice->Update();
+  ExpectSameImage(reference.twice->GetOutput(), fused.twice->GetOutput());
+}
+
+
+TEST(PixelwiseFusion, UnaryTailMatchesUnfused)
+{
+  auto image = CreateImage();
+
+  Pipeline reference(image);
+  auto     referenceTail = UnaryFilterType::New();
+  referenceTail->SetInput(reference.twice->GetOutput());
+  referenceTail->SetFunctor([](const float & p) { return p * p; });
+  referenceTail->Update();
+
+  Pipeline fused(image);
+  auto     fusedTail = UnaryFilterType::New();
+  fusedTail->SetInput(fused.twice->GetOutput());
+  fusedTail->SetFunctor([](const float & p) { return p * p; });
+  fusedTail->PixelwiseFusionOn();
+  fusedTail->InPlaceOn();
+  fusedTail->Update();
+
+  ExpectSameImage(referenceTail->GetOutput(), fusedTail->GetOutput());
+  EXPECT_EQ(2u, fusedTail->GetFusedFilterNames().size());
+}
+
+
+TEST(PixelwiseFusion, ConstantOperand)
+{
+  auto image = CreateImage();
+
+  Pipeline reference(image);
+  reference.difference->SetConstant2(4.0f);
+  reference.difference->Update();
+
+  Pipeline fused(image);
+  fused.difference->SetConstant2(4.0f);
+  fused.difference->PixelwiseFusionOn();
+  fused.difference->Update();
+
+  ExpectSameImage(reference.difference->GetOutput(), fused.difference->GetOutput());
+  EXPECT_EQ(2u, fused.difference->GetFusedFilterNames().size());
+}
+
+
+TEST(PixelwiseFusion, SharedStageIsNotFused)
+{
+  auto image = CreateImage();
+
+  Pipeline fused(image);
+  fused.difference->SetInput2(fused.twice->GetOutput());
+  fused.difference->PixelwiseFusionOn();
+  fused.difference->Update();
+
+  EXPECT_TRUE(fused.difference->GetFusedFilterNames().empty());
+
+  Pipeline reference(image);
+  reference.difference->SetInput2(reference.twice->GetOutput());
+  reference.difference->Update();
+  ExpectSameImage(reference.difference->GetOutput(), fused.difference->GetOutput());
+}
+
+
+TEST(PixelwiseFusion, RescaleIntensityIsNotFused)
+{
+  auto image = CreateImage();
+
+  using RescaleFilterType = itk::RescaleIntensityImageFilter<ImageType, ImageType>;
+  using AbsFilterType = itk::AbsImageFilter<ImageType, ImageType>;
+
+  // image -> (+1) -> rescale -> (*2) -> |x|
+  struct RescalePipeline
+  {
+    explicit RescalePipeline(const ImageType * image)
+    {
+      addOne->SetInput(image);
+      rescale->SetInput(addOne->GetOutput());
+      rescale->SetOutputMinimum(-5.0f);
+      rescale->SetOutputMaximum(5.0f);
+      twice->SetInput(rescale->GetOutput());
+      twice->SetFunctor([](const float & p) { return 2.0f * p; });
+      abs->SetInput(twice->GetOutput());
+    }
+
+    AddOneFilterType::Pointer  addOne = AddOneFilterType::New();
+    RescaleFilterType::Pointer rescale = RescaleFilterType::New();
+    UnaryFilterType::Pointer   twice = UnaryFilterType::New();
+    AbsFilterType::Pointer     abs = AbsFilterType::New();
+  };
+
+  RescalePipeline reference(image);
+  reference.abs->Update();
+
+  // The rescaling needs the statistics of its whole input, so the chain
+  // stops at its output, which is generated before the fused filter runs
+  RescalePipeline fused(image);
+  fused.abs->PixelwiseFusionOn();
+  fused.abs->Update();
+  ExpectSameImage(reference.abs->GetOutput(), fused.abs->GetOutput());
+  EXPECT_EQ(std::vector<std::string>{ "UnaryGeneratorImageFilter" }, fused.abs->GetFusedFilterNames());
+  EXPECT_EQ(0u, fused.twice->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+
+  // A subclass which opted in is fused
+  RescalePipeline fusedAbs(image);
+  auto            tail = UnaryFilterType::New();
+  tail->SetInput(fusedAbs.abs->GetOutput());
+  tail->SetFunctor([](const float & p) { return p - 1.0f; });
+  tail->PixelwiseFusionOn();
+  tail->Update();
+  const std::vector<std::string> expectedNames{ "UnaryGeneratorImageFilter", "AbsImageFilter" };
+  EXPECT_EQ(expectedNames, tail->GetFusedFilterNames());
+}
@@ -107,6 +107,13 @@ protected:
   }
 
   ~AbsImageFilter() override = default;
+
+  /** All the work is done by the functor, so the filter can be fused. */
+  bool
+  CanBeFused() const override
+  {
+    return this->IsPixelwiseFusible();
+  }
 };
 } // end namespace itk
 
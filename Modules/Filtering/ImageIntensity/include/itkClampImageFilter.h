@@ -182,8 +182,18 @@ protected:
   void
   GenerateData() override;
 
+  /** All the work is done by the functor, so the filter can be fused,
+   * unless GenerateData() would only graft its input to its output. */
+  bool
+  CanBeFused() const override;
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Whether GenerateData() grafts the input instead of clamping it. */
+  bool
+  IsPassThroughInPlace() const;
 };
 
 } // end namespace itk
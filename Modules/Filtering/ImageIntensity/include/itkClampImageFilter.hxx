@@ -110,9 +110,7 @@ template <typename TInputImage, typename TOutputImage>
 void
 ClampImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
-  if (this->GetInPlace() && this->CanRunInPlace() &&
-      this->GetLowerBound() <= NumericTraits<OutputPixelType>::NonpositiveMin() &&
-      this->GetUpperBound() >= NumericTraits<OutputPixelType>::max())
+  if (this->IsPassThroughInPlace())
   {
     // If the filter is asked to run in-place, is able to run in-place,
     // and the specified bounds are equal to the output-type limits,
@@ -125,6 +123,22 @@ ClampImageFilter<TInputImage, TOutputImage>::GenerateData()
   Superclass::GenerateData();
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+ClampImageFilter<TInputImage, TOutputImage>::CanBeFused() const
+{
+  return this->IsPixelwiseFusible() && !this->IsPassThroughInPlace();
+}
+
+template <typename TInputImage, typename TOutputImage>
+bool
+ClampImageFilter<TInputImage, TOutputImage>::IsPassThroughInPlace() const
+{
+  return this->GetInPlace() && this->CanRunInPlace() &&
+         this->GetLowerBound() <= NumericTraits<OutputPixelType>::NonpositiveMin() &&
+         this->GetUpperBound() >= NumericTraits<OutputPixelType>::max();
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 ClampImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
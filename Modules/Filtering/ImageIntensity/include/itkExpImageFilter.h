@@ -102,6 +102,13 @@ protected:
   }
 
   ~ExpImageFilter() override = default;
+
+  /** All the work is done by the functor, so the filter can be fused. */
+  bool
+  CanBeFused() const override
+  {
+    return this->IsPixelwiseFusible();
+  }
 };
 } // end namespace itk
 
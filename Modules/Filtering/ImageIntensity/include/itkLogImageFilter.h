@@ -99,6 +99,13 @@ protected:
   }
 
   ~LogImageFilter() override = default;
+
+  /** All the work is done by the functor, so the filter can be fused. */
+  bool
+  CanBeFused() const override
+  {
+    return this->IsPixelwiseFusible();
+  }
 };
 } // end namespace itk
 
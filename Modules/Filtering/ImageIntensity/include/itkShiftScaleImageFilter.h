@@ -20,6 +20,9 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkArray.h"
+#include "itkPixelwiseFusionChain.h"
+
+#include <atomic>
 
 namespace itk
 {
@@ -31,12 +34,18 @@ namespace itk
  * are performed in the precision of the input pixel's RealType. Before
  * assigning the computed value to the output pixel, the value is clamped
  * at the NonpositiveMin and max of the pixel type.
+ *
+ * The filter can be fused into a downstream pixel-wise filter, see
+ * PixelwiseFusionChain. The underflow and overflow counts are then
+ * computed by the downstream filter's update.
  * \ingroup IntensityImageFilters
  *
  * \ingroup ITKImageIntensity
  */
 template <typename TInputImage, typename TOutputImage>
-class ITK_TEMPLATE_EXPORT ShiftScaleImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+class ITK_TEMPLATE_EXPORT ShiftScaleImageFilter
+  : public ImageToImageFilter<TInputImage, TOutputImage>
+  , public PixelwiseFusionStage
 {
 public:
   ITK_DISALLOW_COPY_AND_ASSIGN(ShiftScaleImageFilter);
@@ -93,6 +102,11 @@ public:
   itkGetConstMacro(UnderflowCount, long);
   itkGetConstMacro(OverflowCount, long);
 
+  /** Bypass the execution of this filter when it is fused into a downstream
+   * filter. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputImagePixelType>));
@@ -125,6 +139,33 @@ protected:
     itkExceptionMacro("This class requires threadId so it must use classic multi-threading model");
   }
 
+  /** PixelwiseFusionStage interface. Returns false for subclasses. */
+  bool
+  CanBeFused() const override;
+  ProcessObject *
+  GetFusedProcessObject() override
+  {
+    return this;
+  }
+  DataObject *
+  GetFusedInput() override
+  {
+    return this->GetPrimaryInput();
+  }
+  size_t
+  GetFusedOutputPixelSize() const override
+  {
+    return sizeof(OutputImagePixelType);
+  }
+  void
+  FusedBeforeThreadedGenerateData() override;
+  void
+  FusedAfterThreadedGenerateData() override;
+  const void *
+  GetFusedInputScanline(const IndexValueType * index) const override;
+  void
+  FusedProcessScanline(const void * input, void * output, SizeValueType length) override;
+
 private:
   RealType m_Shift;
   RealType m_Scale;
@@ -137,6 +178,10 @@ private:
 
   const TInputImage * m_InputImage;
   TOutputImage *      m_OutputImage;
+
+  /** Counts of the scanlines processed in a fused chain. */
+  std::atomic<long> m_FusedUnderflowCount{ 0 };
+  std::atomic<long> m_FusedOverflowCount{ 0 };
 };
 } // end namespace itk
 
@@ -109,6 +109,87 @@ ShiftScaleImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+ShiftScaleImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * output)
+{
+  if (this->GetFusedIntoDownstream())
+  {
+    // A downstream filter computes our output on the fly: only the input
+    // has to be up to date.
+    this->GetPrimaryInput()->UpdateOutputData();
+    return;
+  }
+  Superclass::UpdateOutputData(output);
+}
+
+template <typename TInputImage, typename TOutputImage>
+bool
+ShiftScaleImageFilter<TInputImage, TOutputImage>::CanBeFused() const
+{
+  return typeid(*this) == typeid(Self) && PixelwiseFusionStage::IsFusibleImageType<TInputImage>() &&
+         PixelwiseFusionStage::IsFusibleImageType<TOutputImage>() &&
+         TInputImage::ImageDimension == TOutputImage::ImageDimension;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ShiftScaleImageFilter<TInputImage, TOutputImage>::FusedBeforeThreadedGenerateData()
+{
+  m_FusedUnderflowCount = 0;
+  m_FusedOverflowCount = 0;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ShiftScaleImageFilter<TInputImage, TOutputImage>::FusedAfterThreadedGenerateData()
+{
+  m_UnderflowCount = m_FusedUnderflowCount;
+  m_OverflowCount = m_FusedOverflowCount;
+}
+
+template <typename TInputImage, typename TOutputImage>
+const void *
+ShiftScaleImageFilter<TInputImage, TOutputImage>::GetFusedInputScanline(const IndexValueType * index) const
+{
+  const TInputImage * inputPtr = this->GetInput();
+  InputImageIndexType inputIndex;
+  std::copy(index, index + TInputImage::ImageDimension, inputIndex.begin());
+  return inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(inputIndex);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ShiftScaleImageFilter<TInputImage, TOutputImage>::FusedProcessScanline(const void *  input,
+                                                                       void *        output,
+                                                                       SizeValueType length)
+{
+  const auto * inputLine = static_cast<const InputImagePixelType *>(input);
+  auto *       outputLine = static_cast<OutputImagePixelType *>(output);
+  long         underflowCount = 0;
+  long         overflowCount = 0;
+  for (SizeValueType i = 0; i < length; ++i)
+  {
+    const RealType value = (static_cast<RealType>(inputLine[i]) + m_Shift) * m_Scale;
+    if (value < NumericTraits<OutputImagePixelType>::NonpositiveMin())
+    {
+      outputLine[i] = NumericTraits<OutputImagePixelType>::NonpositiveMin();
+      ++underflowCount;
+    }
+    else if (value > static_cast<RealType>(NumericTraits<OutputImagePixelType>::max()))
+    {
+      outputLine[i] = NumericTraits<OutputImagePixelType>::max();
+      ++overflowCount;
+    }
+    else
+    {
+      outputLine[i] = static_cast<OutputImagePixelType>(value);
+    }
+  }
+  m_FusedUnderflowCount += underflowCount;
+  m_FusedOverflowCount += overflowCount;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 ShiftScaleImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkMaskImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include "itkGTest.h"
+
+
+namespace
+{
+
+using InputImageType = itk::Image<short, 3>;
+using RealImageType = itk::Image<float, 3>;
+using ImageType = itk::Image<unsigned char, 3>;
+
+using CastFilterType = itk::CastImageFilter<InputImageType, RealImageType>;
+using ShiftScaleFilterType = itk::ShiftScaleImageFilter<RealImageType, ImageType>;
+using ClampFilterType = itk::ClampImageFilter<ImageType, ImageType>;
+using MaskFilterType = itk::MaskImageFilter<ImageType, ImageType>;
+
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(int first, int step)
+{
+  auto                        image = TImage::New();
+  typename TImage::RegionType region;
+  region.SetIndex({ { 2, -3, 1 } });
+  region.SetSize({ { 7, 5, 4 } });
+  image->SetRegions(region);
+  image->Allocate();
+
+  int                              value = first;
+  itk::ImageRegionIterator<TImage> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(value % 256));
+    value += step;
+  }
+  return image;
+}
+
+// image -> Cast -> ShiftScale -> Clamp -> [input1] -> Mask
+//                                 mask -> [input2]
+struct Pipeline
+{
+  Pipeline(const InputImageType * image, const ImageType * mask)
+  {
+    cast->SetInput(image);
+    shiftScale->SetInput(cast->GetOutput());
+    shiftScale->SetShift(-40.0);
+    shiftScale->SetScale(3.0);
+    clamp->SetInput(shiftScale->GetOutput());
+    clamp->SetBounds(20, 200);
+    masking->SetInput(clamp->GetOutput());
+    masking->SetMaskImage(mask);
+  }
+
+  CastFilterType::Pointer       cast = CastFilterType::New();
+  ShiftScaleFilterType::Pointer shiftScale = ShiftScaleFilterType::New();
+  ClampFilterType::Pointer      clamp = ClampFilterType::New();
+  MaskFilterType::Pointer       masking = MaskFilterType::New();
+};
+
+void
+ExpectSameImage(const ImageType * expected, const ImageType * actual)
+{
+  ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> expectedIt(expected, expected->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> actualIt(actual, actual->GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    EXPECT_EQ(expectedIt.Get(), actualIt.Get());
+  }
+}
+
+} // namespace
+
+
+TEST(PixelwiseFusionIntensity, CastShiftScaleClampMask)
+{
+  const auto image = CreateImage<InputImageType>(-30, 3);
+  const auto mask = CreateImage<ImageType>(0, 1);
+
+  Pipeline reference(image, mask);
+  reference.masking->Update();
+  EXPECT_TRUE(reference.masking->GetFusedFilterNames().empty());
+  EXPECT_LT(0, reference.shiftScale->GetUnderflowCount());
+  EXPECT_LT(0, reference.shiftScale->GetOverflowCount());
+
+  Pipeline fused(image, mask);
+  fused.masking->PixelwiseFusionOn();
+  fused.masking->Update();
+  ExpectSameImage(reference.masking->GetOutput(), fused.masking->GetOutput());
+
+  const std::vector<std::string> expectedNames{ "CastImageFilter", "ShiftScaleImageFilter", "ClampImageFilter" };
+  EXPECT_EQ(expectedNames, fused.masking->GetFusedFilterNames());
+
+  // The intermediate images are not generated, but the counts are computed
+  EXPECT_EQ(0u, fused.cast->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+  EXPECT_EQ(0u, fused.shiftScale->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+  EXPECT_EQ(0u, fused.clamp->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+  EXPECT_EQ(reference.shiftScale->GetUnderflowCount(), fused.shiftScale->GetUnderflowCount());
+  EXPECT_EQ(reference.shiftScale->GetOverflowCount(), fused.shiftScale->GetOverflowCount());
+}
+
+
+TEST(PixelwiseFusionIntensity, PassThroughClampIsNotFused)
+{
+  const auto image = CreateImage<InputImageType>(-30, 3);
+  const auto mask = CreateImage<ImageType>(0, 1);
+
+  // With the full output range as bounds, the in-place clamp grafts its input
+  // and its upstream filters cannot be fused through it.
+  Pipeline reference(image, mask);
+  reference.clamp->SetBounds(0, 255);
+  reference.clamp->InPlaceOn();
+  reference.masking->Update();
+
+  Pipeline fused(image, mask);
+  fused.clamp->SetBounds(0, 255);
+  fused.clamp->InPlaceOn();
+  fused.masking->PixelwiseFusionOn();
+  fused.masking->Update();
+  ExpectSameImage(reference.masking->GetOutput(), fused.masking->GetOutput());
+  EXPECT_TRUE(fused.masking->GetFusedFilterNames().empty());
+
+  // Out of place, the clamp is fused as any other functor filter. The output
+  // of the cast is still up to date and is read directly.
+  fused.clamp->InPlaceOff();
+  fused.masking->Update();
+  ExpectSameImage(reference.masking->GetOutput(), fused.masking->GetOutput());
+  const std::vector<std::string> expectedNames{ "ShiftScaleImageFilter", "ClampImageFilter" };
+  EXPECT_EQ(expectedNames, fused.masking->GetFusedFilterNames());
+}
@@ -142,11 +142,18 @@ protected:
   }
 
   void
-  GenerateData() override
+  BeforeThreadedGenerateData() override
   {
     this->GetFunctor().m_ForegroundValue = m_ForegroundValue;
     this->GetFunctor().m_BackgroundValue = m_BackgroundValue;
-    Superclass::GenerateData();
+  }
+
+  /** The functor is set up in BeforeThreadedGenerateData(), so the filter
+   * can be fused. */
+  bool
+  CanBeFused() const override
+  {
+    return this->IsPixelwiseFusible();
   }
 
 private:
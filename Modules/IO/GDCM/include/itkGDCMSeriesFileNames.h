@@ -24,12 +24,6 @@
 #include <vector>
 #include "ITKIOGDCMExport.h"
 
-// forward declaration, to remove compile dependency on GDCM library
-namespace gdcm
-{
-class SerieHelper;
-}
-
 namespace itk
 {
 /**
@@ -185,6 +179,24 @@ public:
   itkGetConstMacro(LoadPrivateTags, bool);
   itkBooleanMacro(LoadPrivateTags);
 
+  /** Scan the input directory by parsing each file only up to its Pixel Data
+   * element, instead of reading each file completely. The files are scanned
+   * in parallel, and only the header elements needed to group and sort the
+   * series are kept (private elements are dropped unless LoadPrivateTags is
+   * set or they are used in a series restriction). Defaults to false.
+   * Must be set before the call to SetInputDirectory(). */
+  itkSetMacro(HeaderOnlyScan, bool);
+  itkGetConstMacro(HeaderOnlyScan, bool);
+  itkBooleanMacro(HeaderOnlyScan);
+
+  /** File in which the headers found by a header-only scan are cached.
+   * Entries are keyed on the file path, modification time and size, so that
+   * unchanged files are not opened again when a directory is scanned a second
+   * time. Only used when HeaderOnlyScan is on; empty (the default) disables
+   * the cache. Must be set before the call to SetInputDirectory(). */
+  itkSetStringMacro(IndexCacheFileName);
+  itkGetStringMacro(IndexCacheFileName);
+
 protected:
   GDCMSeriesFileNames();
   ~GDCMSeriesFileNames() override;
@@ -192,6 +204,15 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Add the headers of the files of a directory to the series helper,
+   * reading them up to the Pixel Data element. */
+  void
+  ScanDirectoryHeaders(const std::string & name);
+
+  /** Series helper that gives access to the addition of a parsed header.
+   * It is declared here to remove the compile dependency on GDCM library. */
+  class SeriesHelper;
+
   /** Contains the input directory where the DICOM serie is found */
   std::string m_InputDirectory = "";
 
@@ -203,15 +224,21 @@ private:
   FileNamesContainerType m_OutputFileNames;
 
   /** Internal structure to order serie from one directory */
-  std::unique_ptr<gdcm::SerieHelper> m_SerieHelper;
+  std::unique_ptr<SeriesHelper> m_SerieHelper;
 
   /** Internal structure to keep the list of series UIDs */
   SeriesUIDContainerType m_SeriesUIDs;
 
+  /** Tags added with AddSeriesRestriction(), kept by the header-only scan */
+  std::vector<std::string> m_SeriesRestrictions;
+
+  std::string m_IndexCacheFileName = "";
+
   bool m_UseSeriesDetails = true;
   bool m_Recursive = false;
   bool m_LoadSequences = false;
   bool m_LoadPrivateTags = false;
+  bool m_HeaderOnlyScan = false;
 };
 } // namespace itk
 
@@ -55,6 +55,7 @@
 #include "gdcmMediaStorage.h"
 
 #include <fstream>
+#include <set>
 #include <sstream>
 
 namespace itk
@@ -260,12 +261,17 @@ GDCMImageIO::CanReadFile(const char * filename)
   if (dicomsig)
   {
     // Check to see if its a valid dicom file gdcm is able to parse:
-    // We are parsing the header one time here:
-    gdcm::ImageReader reader;
+    // We are parsing the header one time here, stopping at the Pixel Data
+    // element so that the pixels are not loaded just to be discarded.
+    gdcm::Reader reader;
     reader.SetFileName(filename);
-    if (reader.Read())
+    const gdcm::Tag           pixelDataTag(0x7fe0, 0x0010);
+    const std::set<gdcm::Tag> skipTags{ pixelDataTag };
+    if (reader.ReadUpToTag(pixelDataTag, skipTags))
     {
-      return true;
+      // Only accept a DICOM file describing an image
+      const gdcm::DataSet & ds = reader.GetFile().GetDataSet();
+      return ds.FindDataElement(gdcm::Tag(0x0028, 0x0010)) && ds.FindDataElement(gdcm::Tag(0x0028, 0x0011));
     }
   }
   return false;
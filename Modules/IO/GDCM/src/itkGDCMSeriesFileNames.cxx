@@ -21,14 +21,189 @@
 #include "itkGDCMSeriesFileNames.h"
 #include "itksys/SystemTools.hxx"
 #include "itkProgressReporter.h"
+#include "itkMultiThreaderBase.h"
 #include "gdcmSerieHelper.h"
+#include "gdcmDirectory.h"
+#include "gdcmReader.h"
+#include "gdcmWriter.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
 
 namespace itk
 {
 
+class GDCMSeriesFileNames::SeriesHelper : public gdcm::SerieHelper
+{
+public:
+  using gdcm::SerieHelper::AddFile;
+};
+
+namespace
+{
+const gdcm::Tag pixelDataTag(0x7fe0, 0x0010);
+
+const char headerIndexSignature[] = "ITK GDCM header index 1\n";
+
+/** Header of one file as stored in the index cache. An empty header marks a
+ * file that is not a DICOM image, so that it is not parsed again either. */
+struct HeaderIndexEntry
+{
+  long int      ModifiedTime{ 0 };
+  unsigned long Length{ 0 };
+  std::string   Header;
+};
+
+using HeaderIndexType = std::map<std::string, HeaderIndexEntry>;
+
+template <typename T>
+bool
+ReadIndexValue(std::istream & is, T & value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+bool
+ReadIndexString(std::istream & is, std::string & value)
+{
+  uint64_t size = 0;
+  if (!ReadIndexValue(is, size))
+  {
+    return false;
+  }
+  value.resize(static_cast<size_t>(size));
+  return size == 0 || static_cast<bool>(is.read(&value[0], static_cast<std::streamsize>(size)));
+}
+
+template <typename T>
+void
+WriteIndexValue(std::ostream & os, const T & value)
+{
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void
+WriteIndexString(std::ostream & os, const std::string & value)
+{
+  WriteIndexValue(os, static_cast<uint64_t>(value.size()));
+  os.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+/** The index is a native endian binary file, it is meant to be a local cache
+ * and not to be exchanged between machines. The headers it holds depend on
+ * which private elements were kept, so an index written with another set of
+ * kept elements is ignored. A truncated index yields the entries read so far. */
+HeaderIndexType
+ReadHeaderIndex(const std::string & fileName, const std::string & keptElements)
+{
+  HeaderIndexType index;
+  std::ifstream   is(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!is)
+  {
+    return index;
+  }
+  std::string signature(sizeof(headerIndexSignature) - 1, '\0');
+  if (!is.read(&signature[0], static_cast<std::streamsize>(signature.size())) || signature != headerIndexSignature)
+  {
+    return index;
+  }
+  std::string path;
+  if (!ReadIndexString(is, path) || path != keptElements)
+  {
+    return index;
+  }
+  HeaderIndexEntry entry;
+  int64_t          modifiedTime = 0;
+  uint64_t         length = 0;
+  while (ReadIndexString(is, path) && ReadIndexValue(is, modifiedTime) && ReadIndexValue(is, length) &&
+         ReadIndexString(is, entry.Header))
+  {
+    entry.ModifiedTime = static_cast<long int>(modifiedTime);
+    entry.Length = static_cast<unsigned long>(length);
+    index[path] = entry;
+  }
+  return index;
+}
+
+/** Write to a temporary file first, so that a concurrent scan never reads a
+ * partially written index. */
+bool
+WriteHeaderIndex(const std::string & fileName, const std::string & keptElements, const HeaderIndexType & index)
+{
+  const std::string temporaryFileName = fileName + ".tmp";
+  {
+    std::ofstream os(temporaryFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os)
+    {
+      return false;
+    }
+    os.write(headerIndexSignature, sizeof(headerIndexSignature) - 1);
+    WriteIndexString(os, keptElements);
+    for (const auto & entry : index)
+    {
+      WriteIndexString(os, entry.first);
+      WriteIndexValue(os, static_cast<int64_t>(entry.second.ModifiedTime));
+      WriteIndexValue(os, static_cast<uint64_t>(entry.second.Length));
+      WriteIndexString(os, entry.second.Header);
+    }
+    if (!os)
+    {
+      return false;
+    }
+  }
+  // rename() does not replace an existing file on every platform
+  if (std::rename(temporaryFileName.c_str(), fileName.c_str()) == 0)
+  {
+    return true;
+  }
+  itksys::SystemTools::RemoveFile(fileName);
+  return std::rename(temporaryFileName.c_str(), fileName.c_str()) == 0;
+}
+
+/** A header describes an image when it holds the dimensions of the pixel
+ * data; the Pixel Data element itself is never read. */
+bool
+IsImageHeader(const gdcm::DataSet & ds)
+{
+  return ds.FindDataElement(gdcm::Tag(0x0028, 0x0010)) && ds.FindDataElement(gdcm::Tag(0x0028, 0x0011));
+}
+
+std::string
+EncodeHeader(const gdcm::File & file)
+{
+  std::ostringstream os(std::ios::out | std::ios::binary);
+  gdcm::Writer       writer;
+  writer.SetStream(os);
+  writer.SetFile(file);
+  writer.SetCheckFileMetaInformation(false);
+  if (!writer.Write())
+  {
+    return std::string{};
+  }
+  return os.str();
+}
+
+gdcm::SmartPointer<gdcm::FileWithName>
+DecodeHeader(const std::string & header, const std::string & fileName)
+{
+  std::istringstream is(header, std::ios::in | std::ios::binary);
+  gdcm::Reader       reader;
+  reader.SetStream(is);
+  if (!reader.Read() || !IsImageHeader(reader.GetFile().GetDataSet()))
+  {
+    return nullptr;
+  }
+  gdcm::SmartPointer<gdcm::FileWithName> file = new gdcm::FileWithName(reader.GetFile());
+  file->filename = fileName;
+  return file;
+}
+} // namespace
 
 GDCMSeriesFileNames::GDCMSeriesFileNames()
-  : m_SerieHelper{ new gdcm::SerieHelper() }
+  : m_SerieHelper{ new SeriesHelper() }
 {}
 
 GDCMSeriesFileNames::~GDCMSeriesFileNames() = default;
@@ -49,6 +224,7 @@ void
 GDCMSeriesFileNames::AddSeriesRestriction(const std::string & tag)
 {
   m_SerieHelper->AddRestriction(tag);
+  m_SeriesRestrictions.push_back(tag);
 }
 
 void
@@ -73,11 +249,144 @@ GDCMSeriesFileNames::SetInputDirectory(std::string const & name)
   m_SerieHelper->Clear();
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode((m_LoadSequences ? 0 : gdcm::LD_NOSEQ) | (m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW));
-  m_SerieHelper->SetDirectory(name, m_Recursive);
+  if (m_HeaderOnlyScan)
+  {
+    this->ScanDirectoryHeaders(name);
+  }
+  else
+  {
+    m_SerieHelper->SetDirectory(name, m_Recursive);
+  }
   // as a side effect it also execute
   this->Modified();
 }
 
+void
+GDCMSeriesFileNames::ScanDirectoryHeaders(const std::string & name)
+{
+  gdcm::Directory directory;
+  directory.Load(name, m_Recursive);
+  const gdcm::Directory::FilenamesType & fileNames = directory.GetFilenames();
+  const SizeValueType                    numberOfFiles = fileNames.size();
+
+  std::set<gdcm::Tag> restrictionTags;
+  for (const auto & restriction : m_SeriesRestrictions)
+  {
+    gdcm::Tag tag;
+    if (tag.ReadFromPipeSeparatedString(restriction.c_str()))
+    {
+      restrictionTags.insert(tag);
+    }
+  }
+
+  // Describes the private elements kept in the scanned headers.
+  std::ostringstream keptElements;
+  keptElements << "LoadPrivateTags:" << m_LoadPrivateTags;
+  for (const auto & tag : restrictionTags)
+  {
+    keptElements << ' ' << tag;
+  }
+
+  const bool      useIndex = !m_IndexCacheFileName.empty();
+  HeaderIndexType index;
+  if (useIndex)
+  {
+    index = ReadHeaderIndex(m_IndexCacheFileName, keptElements.str());
+  }
+
+  std::vector<gdcm::SmartPointer<gdcm::FileWithName>> headers(numberOfFiles);
+  std::vector<HeaderIndexEntry>                       scannedEntries(numberOfFiles);
+  std::vector<char>                                   scanned(numberOfFiles, 0);
+
+  // The index is only searched while the files are scanned, it is updated afterwards.
+  const auto scanFile = [&](SizeValueType i) {
+    const std::string & fileName = fileNames[i];
+    HeaderIndexEntry    entry;
+    if (useIndex)
+    {
+      entry.ModifiedTime = itksys::SystemTools::ModifiedTime(fileName);
+      entry.Length = itksys::SystemTools::FileLength(fileName);
+      const auto cached = index.find(fileName);
+      if (cached != index.end() && cached->second.ModifiedTime == entry.ModifiedTime &&
+          cached->second.Length == entry.Length)
+      {
+        if (cached->second.Header.empty())
+        {
+          return;
+        }
+        headers[i] = DecodeHeader(cached->second.Header, fileName);
+        if (headers[i])
+        {
+          return;
+        }
+      }
+    }
+
+    gdcm::Reader reader;
+    reader.SetFileName(fileName.c_str());
+    const std::set<gdcm::Tag> skipTags{ pixelDataTag };
+    if (reader.ReadUpToTag(pixelDataTag, skipTags) && IsImageHeader(reader.GetFile().GetDataSet()))
+    {
+      gdcm::DataSet &        ds = reader.GetFile().GetDataSet();
+      std::vector<gdcm::Tag> discarded;
+      if (!m_LoadPrivateTags)
+      {
+        for (const auto & de : ds.GetDES())
+        {
+          if (de.GetTag().IsPrivate() && restrictionTags.count(de.GetTag()) == 0)
+          {
+            discarded.push_back(de.GetTag());
+          }
+        }
+      }
+      for (const auto & tag : discarded)
+      {
+        ds.Remove(tag);
+      }
+      headers[i] = new gdcm::FileWithName(reader.GetFile());
+      headers[i]->filename = fileName;
+      if (useIndex)
+      {
+        entry.Header = EncodeHeader(reader.GetFile());
+        if (entry.Header.empty())
+        {
+          return;
+        }
+      }
+    }
+    if (useIndex)
+    {
+      scannedEntries[i] = std::move(entry);
+      scanned[i] = 1;
+    }
+  };
+  MultiThreaderBase::New()->ParallelizeArray(0, numberOfFiles, scanFile, nullptr);
+
+  // Files are added in the order of the directory listing, whatever the order of the scan.
+  for (const auto & header : headers)
+  {
+    if (header)
+    {
+      m_SerieHelper->AddFile(*header);
+    }
+  }
+
+  if (useIndex && std::find(scanned.begin(), scanned.end(), 1) != scanned.end())
+  {
+    for (SizeValueType i = 0; i < numberOfFiles; ++i)
+    {
+      if (scanned[i])
+      {
+        index[fileNames[i]] = std::move(scannedEntries[i]);
+      }
+    }
+    if (!WriteHeaderIndex(m_IndexCacheFileName, keptElements.str(), index))
+    {
+      itkWarningMacro(<< "Could not write the header index " << m_IndexCacheFileName);
+    }
+  }
+}
+
 const GDCMSeriesFileNames::SeriesUIDContainerType &
 GDCMSeriesFileNames::GetSeriesUIDs()
 {
@@ -272,6 +581,8 @@ GDCMSeriesFileNames::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "InputDirectory: " << m_InputDirectory << std::endl;
   os << indent << "LoadSequences:" << m_LoadSequences << std::endl;
   os << indent << "LoadPrivateTags:" << m_LoadPrivateTags << std::endl;
+  os << indent << "HeaderOnlyScan:" << m_HeaderOnlyScan << std::endl;
+  os << indent << "IndexCacheFileName: " << m_IndexCacheFileName << std::endl;
   if (m_Recursive)
   {
     os << indent << "Recursive: True" << std::endl;
@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkMetaDataObject.h"
+#include "itkRandomImageSource.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestingMacros.h"
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+itk::GDCMSeriesFileNames::FileNamesContainerType
+ScanDirectory(const std::string & directory, bool headerOnlyScan, const std::string & indexCacheFileName)
+{
+  itk::GDCMSeriesFileNames::Pointer fileNames = itk::GDCMSeriesFileNames::New();
+  fileNames->SetHeaderOnlyScan(headerOnlyScan);
+  fileNames->SetIndexCacheFileName(indexCacheFileName);
+  fileNames->SetInputDirectory(directory);
+  return fileNames->GetInputFileNames();
+}
+} // namespace
+
+int
+itkGDCMSeriesHeaderOnlyScanTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputTestDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using ImageType = itk::Image<short, 2>;
+  using RandomImageSourceType = itk::RandomImageSource<ImageType>;
+  using WriterType = itk::ImageFileWriter<ImageType>;
+
+  const std::string directory = std::string(argv[1]) + "/itkGDCMSeriesHeaderOnlyScanTest";
+  itksys::SystemTools::RemoveADirectory(directory);
+  itksys::SystemTools::MakeDirectory(directory);
+
+  itk::GDCMSeriesFileNames::Pointer fileNamesObject = itk::GDCMSeriesFileNames::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fileNamesObject, GDCMSeriesFileNames, ProcessObject);
+  ITK_TEST_SET_GET_BOOLEAN(fileNamesObject, HeaderOnlyScan, true);
+
+  // Write a series whose slice positions are not in the order of the file names
+  constexpr unsigned int numberOfSlices = 5;
+  for (unsigned int i = 0; i < numberOfSlices; ++i)
+  {
+    ImageType::SizeType size;
+    size.Fill(8);
+    RandomImageSourceType::Pointer source = RandomImageSourceType::New();
+    source->SetSize(size);
+    source->SetMin(0);
+    source->SetMax(255);
+
+    itk::MetaDataDictionary dictionary;
+    std::ostringstream      value;
+    value << "0\\0\\" << (i * 3) % numberOfSlices;
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0032", value.str());
+    itk::EncapsulateMetaData<std::string>(dictionary, "0008|0060", "CT");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|000d", "1.2.826.0.1.3680043.2.1125.1");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", "1.2.826.0.1.3680043.2.1125.1.1");
+    value.str("");
+    value << "1.2.826.0.1.3680043.2.1125.1.1." << i + 1;
+    itk::EncapsulateMetaData<std::string>(dictionary, "0008|0018", value.str());
+    source->Update();
+    source->GetOutput()->SetMetaDataDictionary(dictionary);
+
+    itk::GDCMImageIO::Pointer gdcmIO = itk::GDCMImageIO::New();
+    gdcmIO->KeepOriginalUIDOn();
+
+    std::ostringstream fileName;
+    fileName << directory << "/slice" << i << ".dcm";
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetInput(source->GetOutput());
+    writer->SetImageIO(gdcmIO);
+    writer->SetFileName(fileName.str());
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+
+  // A file that is not DICOM must be ignored by every scan
+  {
+    std::ofstream notDicom((directory + "/notes.txt").c_str());
+    notDicom << "not a DICOM file" << std::endl;
+  }
+
+  const auto fullScan = ScanDirectory(directory, false, "");
+  ITK_TEST_EXPECT_EQUAL(fullScan.size(), numberOfSlices);
+
+  const auto headerOnlyScan = ScanDirectory(directory, true, "");
+  ITK_TEST_EXPECT_TRUE(headerOnlyScan == fullScan);
+
+  // The first scan fills the index, the second one is answered from it
+  const std::string indexCacheFileName = std::string(argv[1]) + "/itkGDCMSeriesHeaderOnlyScanTest.index";
+  itksys::SystemTools::RemoveFile(indexCacheFileName);
+  const auto indexedScan = ScanDirectory(directory, true, indexCacheFileName);
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(indexCacheFileName, true));
+  ITK_TEST_EXPECT_TRUE(indexedScan == fullScan);
+  const auto cachedScan = ScanDirectory(directory, true, indexCacheFileName);
+  ITK_TEST_EXPECT_TRUE(cachedScan == fullScan);
+
+  // A damaged index is ignored rather than trusted
+  {
+    std::ofstream damaged(indexCacheFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    damaged << "ITK GDCM header index";
+  }
+  ITK_TEST_EXPECT_TRUE(ScanDirectory(directory, true, indexCacheFileName) == fullScan);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHDF5DeflatedChunkIO_h
+#define itkHDF5DeflatedChunkIO_h
+#include "ITKIOHDF5Export.h"
+#include "itkIntTypes.h"
+
+#include <functional>
+#include <vector>
+
+// itk namespace first suppresses
+// kwstyle error for the H5 namespace below
+namespace itk
+{}
+namespace H5
+{
+class DataSet;
+} // namespace H5
+
+namespace itk
+{
+/**
+ *\class HDF5DeflatedChunkIO
+ * \brief Write, or read, the deflated chunks of an HDF5 data set directly.
+ *
+ * The HDF5 library compresses the chunks of a data set one after the
+ * other, and is not thread safe.  These helpers bypass its filter
+ * pipeline: the chunks are deflated, or inflated, in parallel by batches
+ * with zlib, and written with H5Dwrite_chunk(), or read with
+ * H5Dread_chunk(), in turn.  The data set must be chunked with the
+ * deflate filter alone; the callers check its layout, and that the
+ * library is recent enough (H5_VERSION_GE(1, 10, 3)).
+ *
+ * Chunks are numbered from 0; the offset of a chunk is given in the data
+ * set dimension order, in elements.  The helpers throw an exception on
+ * failure.
+ *
+ * \ingroup ITKIOHDF5
+ */
+class ITKIOHDF5_EXPORT HDF5DeflatedChunkIO
+{
+public:
+  /** Offset of a chunk in the data set.  */
+  using ChunkOffsetFunction = std::function<std::vector<SizeValueType>(SizeValueType chunk)>;
+
+  /** Copy the values of a chunk into a zero filled buffer of the chunk
+   *  size in bytes, or copy them out of it.  Called concurrently.  */
+  using FillChunkFunction = std::function<void(SizeValueType chunk, unsigned char * bytes)>;
+  using StoreChunkFunction = std::function<void(SizeValueType chunk, const unsigned char * bytes)>;
+
+  static void
+  WriteChunks(const H5::DataSet &         dataSet,
+              SizeValueType               numberOfChunks,
+              SizeValueType               chunkBytes,
+              int                         compressionLevel,
+              const ChunkOffsetFunction & chunkOffset,
+              const FillChunkFunction &   fillChunk);
+
+  /** Chunks never written are given as zeros.  */
+  static void
+  ReadChunks(const H5::DataSet &         dataSet,
+             SizeValueType               numberOfChunks,
+             SizeValueType               chunkBytes,
+             const ChunkOffsetFunction & chunkOffset,
+             const StoreChunkFunction &  storeChunk);
+};
+} // end namespace itk
+
+#endif // itkHDF5DeflatedChunkIO_h
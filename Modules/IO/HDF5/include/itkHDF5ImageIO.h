@@ -79,6 +79,15 @@ namespace itk
  *                             in the MetaDataDictionary
  * re-arrangement.
  *
+ * The voxel data set is chunked and compressed. By default a chunk holds
+ * a slice along the slowest moving dimension; SetChunkSize() selects
+ * another shape, such as cubic chunks for random sub-volume access.
+ * Any IO region can be read or written: the region is selected as a
+ * hyperslab of the data set. The regions of a streamed write are pasted
+ * into the file this IO created for the first of them, while any other
+ * existing file is overwritten. When a written region is made of
+ * whole chunks, the chunks are compressed in parallel and written
+ * directly, bypassing the HDF5 filter pipeline.
  *
  */
 
@@ -137,6 +146,26 @@ public:
   void
   Write(const void * buffer) override;
 
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the extent of the chunks of the voxel data set, in voxels,
+   * fastest moving dimension first. The extents are clamped to the
+   * dimensions of the image, and the dimensions missing, or set to 0,
+   * are not split. Empty by default, which chunks the data set slice by
+   * slice. Only used when writing. */
+  void
+  SetChunkSize(const ChunkSizeType & chunkSize);
+  itkGetConstReferenceMacro(ChunkSize, ChunkSizeType);
+
+  /** Set/Get the size in bytes of the cache of decompressed chunks of the
+   * voxel data set. 0, the default, keeps the default size of HDF5 (1 MiB),
+   * which cannot hold a single chunk of a large image: set it to at
+   * least the size of the chunks crossed by a row of the streamed
+   * regions. The number of slots of the cache follows from the size of
+   * the chunks of the data set. */
+  itkSetMacro(ChunkCacheSize, SizeValueType);
+  itkGetConstMacro(ChunkCacheSize, SizeValueType);
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -203,6 +232,19 @@ private:
   void
   SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
 
+  /** Whether the IO region can be pasted into the file, which then stays
+   * open for writing. It can when the IO region is not the whole image,
+   * and the file exists and holds an image of the same size, spacing,
+   * origin, direction and voxel type. Other files are overwritten. */
+  bool
+  CanPasteIntoFile();
+
+  /** Compress the chunks of the IO region in parallel, and write them
+   * directly. Returns false when the IO region is not made of whole
+   * chunks. */
+  bool
+  WriteChunks(const void * buffer);
+
   void
   CloseH5File();
   void
@@ -211,6 +253,9 @@ private:
   H5::H5File *  m_H5File{ nullptr };
   H5::DataSet * m_VoxelDataSet{ nullptr };
   bool          m_ImageInformationWritten{ false };
+  std::string   m_StreamedWriteFileName;
+  ChunkSizeType m_ChunkSize;
+  SizeValueType m_ChunkCacheSize{ 0 };
 };
 } // end namespace itk
 
@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHDF5DeflatedChunkIO.h"
+#include "itkMacro.h"
+#include "itkMultiThreaderBase.h"
+#include "itkThreadPool.h"
+#include "itk_H5Cpp.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace itk
+{
+
+namespace
+{
+
+/** Threader of the chunks. A thread of the pool, e.g. when ImageSeriesReader
+ * reads slices in parallel, must not wait for work added to the pool: it
+ * processes the chunks with a single work unit, run by the calling thread. */
+MultiThreaderBase::Pointer
+CreateChunkThreader()
+{
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  if (ThreadPool::IsPoolThread())
+  {
+    threader->SetNumberOfWorkUnits(1);
+  }
+  return threader;
+}
+
+} // namespace
+
+void
+HDF5DeflatedChunkIO::WriteChunks(const H5::DataSet &         dataSet,
+                                 SizeValueType               numberOfChunks,
+                                 SizeValueType               chunkBytes,
+                                 int                         compressionLevel,
+                                 const ChunkOffsetFunction & chunkOffset,
+                                 const FillChunkFunction &   fillChunk)
+{
+#if H5_VERSION_GE(1, 10, 3)
+  MultiThreaderBase::Pointer      threader = CreateChunkThreader();
+  const SizeValueType             batchSize = 4 * threader->GetNumberOfWorkUnits();
+  std::vector<std::vector<Bytef>> compressedChunks(batchSize);
+  std::vector<int>                compressionStatus(batchSize);
+  for (SizeValueType batchStart = 0; batchStart < numberOfChunks; batchStart += batchSize)
+  {
+    const SizeValueType batchEnd = std::min(numberOfChunks, batchStart + batchSize);
+    threader->ParallelizeArray(
+      batchStart,
+      batchEnd,
+      [&](SizeValueType c) {
+        std::vector<unsigned char> chunk(chunkBytes, 0);
+        fillChunk(c, chunk.data());
+
+        std::vector<Bytef> & compressed = compressedChunks[c - batchStart];
+        uLongf               compressedSize = compressBound(static_cast<uLong>(chunkBytes));
+        compressed.resize(compressedSize);
+        compressionStatus[c - batchStart] =
+          compress2(compressed.data(), &compressedSize, chunk.data(), static_cast<uLong>(chunkBytes), compressionLevel);
+        compressed.resize(compressedSize);
+      },
+      nullptr);
+
+    for (SizeValueType c = batchStart; c < batchEnd; ++c)
+    {
+      if (compressionStatus[c - batchStart] != Z_OK)
+      {
+        itkGenericExceptionMacro(<< "Chunk compression failed while writing " << dataSet.getObjName());
+      }
+      const std::vector<SizeValueType> start = chunkOffset(c);
+      const std::vector<hsize_t>       offset(start.begin(), start.end());
+      const std::vector<Bytef> &       compressed = compressedChunks[c - batchStart];
+      if (H5Dwrite_chunk(dataSet.getId(), H5P_DEFAULT, 0, offset.data(), compressed.size(), compressed.data()) < 0)
+      {
+        itkGenericExceptionMacro(<< "Chunk write failed while writing " << dataSet.getObjName());
+      }
+    }
+  }
+#else
+  (void)numberOfChunks;
+  (void)chunkBytes;
+  (void)compressionLevel;
+  (void)chunkOffset;
+  (void)fillChunk;
+  itkGenericExceptionMacro(<< "Writing chunks directly requires HDF5 1.10.3, while writing " << dataSet.getObjName());
+#endif
+}
+
+void
+HDF5DeflatedChunkIO::ReadChunks(const H5::DataSet &         dataSet,
+                                SizeValueType               numberOfChunks,
+                                SizeValueType               chunkBytes,
+                                const ChunkOffsetFunction & chunkOffset,
+                                const StoreChunkFunction &  storeChunk)
+{
+#if H5_VERSION_GE(1, 10, 3)
+  MultiThreaderBase::Pointer      threader = CreateChunkThreader();
+  const SizeValueType             batchSize = 4 * threader->GetNumberOfWorkUnits();
+  std::vector<std::vector<Bytef>> storedChunks(batchSize);
+  std::vector<uint32_t>           filterMasks(batchSize);
+  std::vector<int>                decompressionStatus(batchSize);
+  for (SizeValueType batchStart = 0; batchStart < numberOfChunks; batchStart += batchSize)
+  {
+    const SizeValueType batchEnd = std::min(numberOfChunks, batchStart + batchSize);
+    for (SizeValueType c = batchStart; c < batchEnd; ++c)
+    {
+      const std::vector<SizeValueType> start = chunkOffset(c);
+      const std::vector<hsize_t>       offset(start.begin(), start.end());
+      hsize_t                          storageSize = 0;
+      std::vector<Bytef> &             stored = storedChunks[c - batchStart];
+      if (H5Dget_chunk_storage_size(dataSet.getId(), offset.data(), &storageSize) < 0)
+      {
+        itkGenericExceptionMacro(<< "Chunk read failed while reading " << dataSet.getObjName());
+      }
+      stored.resize(storageSize);
+      filterMasks[c - batchStart] = 0;
+      if (storageSize > 0 &&
+          H5Dread_chunk(dataSet.getId(), H5P_DEFAULT, offset.data(), &filterMasks[c - batchStart], stored.data()) < 0)
+      {
+        itkGenericExceptionMacro(<< "Chunk read failed while reading " << dataSet.getObjName());
+      }
+    }
+
+    threader->ParallelizeArray(
+      batchStart,
+      batchEnd,
+      [&](SizeValueType c) {
+        const std::vector<Bytef> & stored = storedChunks[c - batchStart];
+        int &                      status = decompressionStatus[c - batchStart];
+        std::vector<Bytef>         chunk(chunkBytes);
+        if (stored.empty())
+        {
+          // chunks never written hold the default fill value, zero
+          status = Z_OK;
+        }
+        else if (filterMasks[c - batchStart] != 0)
+        {
+          // the deflate filter was skipped for this chunk
+          status = stored.size() == chunkBytes ? Z_OK : Z_DATA_ERROR;
+          if (status == Z_OK)
+          {
+            std::memcpy(chunk.data(), stored.data(), chunkBytes);
+          }
+        }
+        else
+        {
+          uLongf decompressedSize = static_cast<uLongf>(chunkBytes);
+          status = uncompress(chunk.data(), &decompressedSize, stored.data(), static_cast<uLong>(stored.size()));
+          if (status == Z_OK && decompressedSize != chunkBytes)
+          {
+            status = Z_DATA_ERROR;
+          }
+        }
+        if (status == Z_OK)
+        {
+          storeChunk(c, chunk.data());
+        }
+      },
+      nullptr);
+
+    for (SizeValueType c = batchStart; c < batchEnd; ++c)
+    {
+      if (decompressionStatus[c - batchStart] != Z_OK)
+      {
+        itkGenericExceptionMacro(<< "Chunk decompression failed while reading " << dataSet.getObjName());
+      }
+    }
+  }
+#else
+  (void)numberOfChunks;
+  (void)chunkBytes;
+  (void)chunkOffset;
+  (void)storeChunk;
+  itkGenericExceptionMacro(<< "Reading chunks directly requires HDF5 1.10.3, while reading " << dataSet.getObjName());
+#endif
+}
+
+} // end namespace itk
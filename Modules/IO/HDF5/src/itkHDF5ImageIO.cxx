@@ -17,12 +17,14 @@
  *=========================================================================*/
 #include "itkVersion.h"
 #include "itkHDF5ImageIO.h"
+#include "itkHDF5DeflatedChunkIO.h"
 #include "itkMetaDataObject.h"
 #include "itkArray.h"
 #include "itksys/SystemTools.hxx"
 #include "itk_H5Cpp.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace itk
 {
@@ -55,6 +57,23 @@ HDF5ImageIO ::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << this->m_H5File << std::endl;
+  os << indent << "ChunkSize: [";
+  for (size_t i = 0; i < this->m_ChunkSize.size(); ++i)
+  {
+    os << (i == 0 ? "" : ", ") << this->m_ChunkSize[i];
+  }
+  os << "]" << std::endl;
+  os << indent << "ChunkCacheSize: " << this->m_ChunkCacheSize << std::endl;
+}
+
+void
+HDF5ImageIO ::SetChunkSize(const ChunkSizeType & chunkSize)
+{
+  if (this->m_ChunkSize != chunkSize)
+  {
+    this->m_ChunkSize = chunkSize;
+    this->Modified();
+  }
 }
 
 //
@@ -259,6 +278,87 @@ doesAttrExist(const H5::H5Object & object, const char * const name)
   return (H5Aexists(object.getId(), name) > 0 ? true : false);
 }
 
+// Extent of the chunks of the voxel data set. HDF5 dimensions listed
+// slowest moving first, ITK are fastest moving first.
+std::vector<hsize_t>
+ComputeChunkDimensions(const std::vector<ImageIOBase::SizeValueType> & imageDimensions,
+                       unsigned int                                    numComponents,
+                       const HDF5ImageIO::ChunkSizeType &              chunkSize)
+{
+  const size_t         numDims = imageDimensions.size();
+  std::vector<hsize_t> chunkDims(numDims + (numComponents == 1 ? 0 : 1));
+  for (size_t i = 0; i < numDims; ++i)
+  {
+    hsize_t extent = imageDimensions[i];
+    if (chunkSize.empty())
+    {
+      // one slice per chunk
+      if (i == numDims - 1)
+      {
+        extent = 1;
+      }
+    }
+    else if (i < chunkSize.size() && chunkSize[i] > 0)
+    {
+      extent = std::min<hsize_t>(chunkSize[i], imageDimensions[i]);
+    }
+    chunkDims[numDims - 1 - i] = extent;
+  }
+  if (numComponents > 1)
+  {
+    chunkDims[numDims] = numComponents;
+  }
+  return chunkDims;
+}
+
+// Size in bytes of the chunks of a data set, 0 when it is not chunked
+size_t
+GetChunkBytes(const H5::DataSet & dataSet)
+{
+  const H5::DSetCreatPropList plist = dataSet.getCreatePlist();
+  if (plist.getLayout() != H5D_CHUNKED)
+  {
+    return 0;
+  }
+  std::vector<hsize_t> chunkDims(dataSet.getSpace().getSimpleExtentNdims());
+  plist.getChunk(static_cast<int>(chunkDims.size()), chunkDims.data());
+  size_t chunkBytes = dataSet.getDataType().getSize();
+  for (const hsize_t extent : chunkDims)
+  {
+    chunkBytes *= extent;
+  }
+  return chunkBytes;
+}
+
+// Data set access properties setting the size of the chunk cache
+H5::DSetAccPropList
+CreateDataSetAccessProperties(ImageIOBase::SizeValueType chunkCacheSize, size_t chunkBytes)
+{
+  H5::DSetAccPropList dapl;
+  if (chunkCacheSize > 0 && chunkBytes > 0)
+  {
+    // HDF5 advises a prime number of hash table slots, about 100 per
+    // chunk held in the cache.
+    size_t numberOfSlots = std::max<size_t>(521, 100 * (chunkCacheSize / chunkBytes));
+    const auto isPrime = [](size_t n) {
+      for (size_t d = 2; d * d <= n; ++d)
+      {
+        if (n % d == 0)
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+    while (!isPrime(numberOfSlots))
+    {
+      ++numberOfSlots;
+    }
+    dapl.setChunkCache(numberOfSlots, chunkCacheSize, 0.75);
+  }
+  return dapl;
+}
+
 } // namespace
 
 void
@@ -661,6 +761,8 @@ HDF5ImageIO ::ReadImageInformation()
   {
     this->CloseH5File();
     this->CloseDataSet();
+    this->m_ImageInformationWritten = false;
+    this->m_StreamedWriteFileName.clear();
     this->m_H5File = new H5::H5File(this->GetFileName(), H5F_ACC_RDONLY);
     this->m_VoxelDataSet = new H5::DataSet();
 
@@ -713,6 +815,12 @@ HDF5ImageIO ::ReadImageInformation()
     std::string VoxelDataName(groupName);
     VoxelDataName += VoxelData;
     *(this->m_VoxelDataSet) = this->m_H5File->openDataSet(VoxelDataName);
+    if (this->m_ChunkCacheSize > 0)
+    {
+      // the chunk cache is sized after the chunks of the data set
+      *(this->m_VoxelDataSet) = this->m_H5File->openDataSet(
+        VoxelDataName, CreateDataSetAccessProperties(this->m_ChunkCacheSize, GetChunkBytes(*(this->m_VoxelDataSet))));
+    }
     H5::DataSet   imageSet = *(this->m_VoxelDataSet);
     H5::DataSpace imageSpace = imageSet.getSpace();
     //
@@ -1003,8 +1111,8 @@ void
 HDF5ImageIO ::WriteImageInformation()
 {
   //
-  // guard so that image information
-  if (this->m_ImageInformationWritten)
+  // a streamed region goes into an existing file of the same geometry
+  if (this->CanPasteIntoFile())
   {
     return;
   }
@@ -1072,21 +1180,25 @@ HDF5ImageIO ::WriteImageInformation()
     H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
     H5::DSetCreatPropList plist;
 
     // we have implicit compression enabled here?
     plist.setDeflate(this->GetCompressionLevel());
 
-    dims[0] = 1;
-    plist.setChunk(numDims, dims.get());
+    const std::vector<hsize_t> chunkDims = ComputeChunkDimensions(this->m_Dimensions, numComponents, this->m_ChunkSize);
+    plist.setChunk(numDims, chunkDims.data());
     dims.reset();
 
     std::string VoxelDataName(ImageGroup);
     VoxelDataName += "/0";
     VoxelDataName += VoxelData;
-    *(this->m_VoxelDataSet) = this->m_H5File->createDataSet(VoxelDataName, dataType, imageSpace, plist);
+    size_t chunkBytes = dataType.getSize();
+    for (const hsize_t extent : chunkDims)
+    {
+      chunkBytes *= extent;
+    }
+    *(this->m_VoxelDataSet) = this->m_H5File->createDataSet(
+      VoxelDataName, dataType, imageSpace, plist, CreateDataSetAccessProperties(this->m_ChunkCacheSize, chunkBytes));
     std::string MetaDataGroupName(groupName);
     MetaDataGroupName += MetaDataName;
     this->m_H5File->createGroup(MetaDataGroupName);
@@ -1249,6 +1361,7 @@ HDF5ImageIO ::WriteImageInformation()
   //
   // only write image information once.
   this->m_ImageInformationWritten = true;
+  this->m_StreamedWriteFileName = this->RequestedToStream() ? this->GetFileName() : std::string();
 }
 
 /**
@@ -1258,6 +1371,10 @@ void
 HDF5ImageIO ::Write(const void * buffer)
 {
   this->WriteImageInformation();
+  if (this->WriteChunks(buffer))
+  {
+    return;
+  }
   try
   {
     int numComponents = this->GetNumberOfComponents();
@@ -1303,6 +1420,207 @@ HDF5ImageIO ::Write(const void * buffer)
   }
 }
 
+bool
+HDF5ImageIO ::CanPasteIntoFile()
+{
+  if (!this->RequestedToStream())
+  {
+    return false;
+  }
+
+  std::string groupName(ImageGroup);
+  groupName += "/0";
+  try
+  {
+    // the regions of a streamed write go into the file already opened for
+    // the previous ones, any other existing file is opened for writing
+    if (!this->m_ImageInformationWritten || this->m_StreamedWriteFileName != this->GetFileName())
+    {
+      this->CloseH5File();
+      this->CloseDataSet();
+      this->m_ImageInformationWritten = false;
+      this->m_StreamedWriteFileName.clear();
+      if (!itksys::SystemTools::FileExists(this->GetFileName()) || !H5::H5File::isHdf5(this->GetFileName()))
+      {
+        return false;
+      }
+      this->m_H5File = new H5::H5File(this->GetFileName(), H5F_ACC_RDWR);
+      const std::string VoxelDataName = groupName + VoxelData;
+      this->m_VoxelDataSet = new H5::DataSet(this->m_H5File->openDataSet(VoxelDataName));
+      if (this->m_ChunkCacheSize > 0)
+      {
+        *(this->m_VoxelDataSet) = this->m_H5File->openDataSet(
+          VoxelDataName, CreateDataSetAccessProperties(this->m_ChunkCacheSize, GetChunkBytes(*(this->m_VoxelDataSet))));
+      }
+    }
+
+    // the file must hold an image of the same geometry and voxel type
+    const unsigned int   numDims = this->GetNumberOfDimensions();
+    const unsigned int   numComponents = this->GetNumberOfComponents();
+    std::vector<hsize_t> dims(numDims + (numComponents == 1 ? 0 : 1));
+    for (unsigned int i = 0; i < numDims; ++i)
+    {
+      dims[numDims - 1 - i] = this->m_Dimensions[i];
+    }
+    if (numComponents > 1)
+    {
+      dims[numDims] = numComponents;
+    }
+    const H5::DataSpace  fileSpace = this->m_VoxelDataSet->getSpace();
+    std::vector<hsize_t> fileDims(fileSpace.getSimpleExtentNdims());
+    fileSpace.getSimpleExtentDims(fileDims.data());
+    if (fileDims == dims && this->ReadVector<double>(groupName + Spacing) == this->m_Spacing &&
+        this->ReadVector<double>(groupName + Origin) == this->m_Origin &&
+        this->ReadDirections(groupName + Directions) == this->m_Direction &&
+        this->ReadString(groupName + VoxelType) == ComponentToString(this->GetComponentType()))
+    {
+      this->m_ImageInformationWritten = true;
+      this->m_StreamedWriteFileName = this->GetFileName();
+      return true;
+    }
+  }
+  catch (H5::Exception &)
+  {
+  }
+
+  // the file is overwritten
+  this->CloseH5File();
+  this->CloseDataSet();
+  this->m_ImageInformationWritten = false;
+  this->m_StreamedWriteFileName.clear();
+  return false;
+}
+
+bool
+HDF5ImageIO ::WriteChunks(const void * buffer)
+{
+#if H5_VERSION_GE(1, 10, 3)
+  const unsigned int  numDims = this->GetNumberOfDimensions();
+  const unsigned int  numComponents = this->GetNumberOfComponents();
+  const ImageIORegion region = this->GetIORegion();
+  if (region.GetImageDimension() != numDims)
+  {
+    return false;
+  }
+
+  // only data sets compressed with the deflate filter alone, as created
+  // by WriteImageInformation, can be written directly
+  std::vector<hsize_t> chunkDims(numDims + (numComponents == 1 ? 0 : 1));
+  int                  compressionLevel = 0;
+  try
+  {
+    const H5::DSetCreatPropList plist = this->m_VoxelDataSet->getCreatePlist();
+    if (plist.getLayout() != H5D_CHUNKED || plist.getNfilters() != 1 ||
+        this->m_VoxelDataSet->getSpace().getSimpleExtentNdims() != static_cast<int>(chunkDims.size()))
+    {
+      return false;
+    }
+    plist.getChunk(static_cast<int>(chunkDims.size()), chunkDims.data());
+
+    unsigned int flags = 0;
+    size_t       numberOfValues = 1;
+    unsigned int values[1] = { 0 };
+    unsigned int filterConfig = 0;
+    if (plist.getFilter(0, flags, numberOfValues, values, 0, nullptr, filterConfig) != H5Z_FILTER_DEFLATE)
+    {
+      return false;
+    }
+    compressionLevel = static_cast<int>(values[0]);
+  }
+  catch (H5::Exception &)
+  {
+    return false;
+  }
+  if (numComponents > 1 && chunkDims[numDims] != numComponents)
+  {
+    return false;
+  }
+
+  // the region must be made of whole chunks, or end at the image border
+  std::vector<SizeValueType> chunkExtent(numDims);
+  std::vector<SizeValueType> firstChunk(numDims);
+  std::vector<SizeValueType> numberOfChunks(numDims);
+  std::vector<SizeValueType> regionStride(numDims);
+  SizeValueType              totalNumberOfChunks = 1;
+  SizeValueType              voxelsInChunk = 1;
+  for (unsigned int i = 0; i < numDims; ++i)
+  {
+    chunkExtent[i] = chunkDims[numDims - 1 - i];
+    const auto start = static_cast<SizeValueType>(region.GetIndex(i));
+    const auto end = start + region.GetSize(i);
+    if (start % chunkExtent[i] != 0 || (end % chunkExtent[i] != 0 && end != this->GetDimensions(i)))
+    {
+      return false;
+    }
+    firstChunk[i] = start / chunkExtent[i];
+    numberOfChunks[i] = (region.GetSize(i) + chunkExtent[i] - 1) / chunkExtent[i];
+    regionStride[i] = (i == 0 ? 1 : regionStride[i - 1] * region.GetSize(i - 1));
+    totalNumberOfChunks *= numberOfChunks[i];
+    voxelsInChunk *= chunkExtent[i];
+  }
+
+  const SizeValueType voxelSize = numComponents * this->GetComponentSize();
+  const SizeValueType chunkBytes = voxelsInChunk * voxelSize;
+  const auto *        regionBytes = static_cast<const unsigned char *>(buffer);
+
+  // chunk start, in voxels, of the chunk of linear index c in the region
+  const auto chunkStart = [&](SizeValueType c) {
+    std::vector<SizeValueType> start(numDims);
+    for (unsigned int i = 0; i < numDims; ++i)
+    {
+      start[i] = (firstChunk[i] + c % numberOfChunks[i]) * chunkExtent[i];
+      c /= numberOfChunks[i];
+    }
+    return start;
+  };
+
+  // the chunks are compressed in parallel, and written in turn
+  const SizeValueType linesInChunk = voxelsInChunk / chunkExtent[0];
+  HDF5DeflatedChunkIO::WriteChunks(
+    *this->m_VoxelDataSet,
+    totalNumberOfChunks,
+    chunkBytes,
+    compressionLevel,
+    [&](SizeValueType c) {
+      const std::vector<SizeValueType> start = chunkStart(c);
+      std::vector<SizeValueType>       offset(chunkDims.size(), 0);
+      for (unsigned int i = 0; i < numDims; ++i)
+      {
+        offset[numDims - 1 - i] = start[i];
+      }
+      return offset;
+    },
+    [&](SizeValueType c, unsigned char * chunk) {
+      const std::vector<SizeValueType> start = chunkStart(c);
+
+      // copy the lines of the chunk inside the image, the remainder of
+      // the chunks on the border is left to zero
+      const SizeValueType lineBytes = std::min(chunkExtent[0], this->GetDimensions(0) - start[0]) * voxelSize;
+      for (SizeValueType line = 0; line < linesInChunk; ++line)
+      {
+        SizeValueType regionOffset = start[0] - static_cast<SizeValueType>(region.GetIndex(0));
+        SizeValueType remainder = line;
+        bool          insideImage = true;
+        for (unsigned int i = 1; i < numDims; ++i)
+        {
+          const SizeValueType position = start[i] + remainder % chunkExtent[i];
+          remainder /= chunkExtent[i];
+          insideImage = insideImage && position < this->GetDimensions(i);
+          regionOffset += (position - static_cast<SizeValueType>(region.GetIndex(i))) * regionStride[i];
+        }
+        if (insideImage)
+        {
+          std::memcpy(chunk + line * chunkExtent[0] * voxelSize, regionBytes + regionOffset * voxelSize, lineBytes);
+        }
+      }
+    });
+  return true;
+#else
+  (void)buffer;
+  return false;
+#endif
+}
+
 //
 // GetHeaderSize -- return 0
 ImageIOBase::SizeType
@@ -15,6 +15,7 @@
  *  limitations under the License.
  *
  *=========================================================================*/
+#include "itkHDF5ImageIO.h"
 #include "itkHDF5ImageIOFactory.h"
 #include "itkIOTestHelper.h"
 #include "itkPipelineMonitorImageFilter.h"
@@ -23,6 +24,7 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageDuplicator.h"
 #include "itkMath.h"
+#include "itkTestingMacros.h"
 
 namespace itk
 {
@@ -59,6 +61,9 @@ public:
   /** Set the value to fill the image. */
   itkSetMacro(Value, typename TOutputImage::PixelType);
 
+  /** Set the offset added to the generated pixel values. */
+  itkSetMacro(Offset, int);
+
 protected:
   DemoImageSource() { m_Value = NumericTraits<typename TOutputImage::PixelType>::ZeroValue(); }
   ~DemoImageSource() override = default;
@@ -74,12 +79,13 @@ protected:
     for (it.GoToBegin(); !it.IsAtEnd(); ++it)
     {
       typename TOutputImage::IndexType idx = it.GetIndex();
-      it.Set(idx[2] * 100 + idx[1] * 10 + idx[0]);
+      it.Set(idx[2] * 100 + idx[1] * 10 + idx[0] + m_Offset);
     }
   };
 
 private:
   typename TOutputImage::PixelType m_Value;
+  int                              m_Offset{ 0 };
 };
 
 } // namespace itk
@@ -228,6 +234,151 @@ HDF5ReadWriteTest2(const char * fileName)
   return EXIT_SUCCESS;
 }
 
+template <typename TPixel>
+int
+HDF5ChunkedReadWriteTest(const char * fileName)
+{
+  using ImageType = itk::Image<TPixel, 3>;
+  using IndexType = typename ImageType::IndexType;
+  using RegionType = typename ImageType::RegionType;
+
+  // Pixel value of the written image, and of the images pasted into it
+  const auto value = [](const IndexType & idx, int image) {
+    return static_cast<TPixel>(idx[2] * 100 + idx[1] * 10 + idx[0] + image * 7);
+  };
+  const auto createImageIO = []() {
+    itk::HDF5ImageIO::Pointer imageIO = itk::HDF5ImageIO::New();
+    imageIO->SetChunkSize({ 8, 8, 8 });
+    imageIO->SetChunkCacheSize(4 << 20);
+    return imageIO;
+  };
+  // The writer only pastes the output of a source which can stream
+  const auto write = [fileName](itk::HDF5ImageIO * imageIO, int image, const itk::ImageIORegion * pasteRegion) {
+    typename itk::DemoImageSource<ImageType>::Pointer imageSource = itk::DemoImageSource<ImageType>::New();
+    imageSource->SetSize(typename ImageType::SizeType{ { 37, 29, 23 } });
+    imageSource->SetOffset(image * 7);
+
+    using WriterType = itk::ImageFileWriter<ImageType>;
+    typename WriterType::Pointer writer = WriterType::New();
+    writer->SetImageIO(imageIO);
+    writer->SetFileName(fileName);
+    writer->SetInput(imageSource->GetOutput());
+    if (pasteRegion)
+    {
+      writer->SetIORegion(*pasteRegion);
+    }
+    else
+    {
+      writer->SetNumberOfStreamDivisions(4);
+    }
+    writer->Update();
+  };
+
+  // The first region is made of whole chunks, and written directly; the
+  // second one is not, and written through the HDF5 filter pipeline.
+  itk::ImageIORegion alignedRegion(3);
+  alignedRegion.SetIndex({ 8, 8, 8 });
+  alignedRegion.SetSize({ 16, 21, 15 });
+  itk::ImageIORegion unalignedRegion(3);
+  unalignedRegion.SetIndex({ 3, 3, 3 });
+  unalignedRegion.SetSize({ 5, 5, 5 });
+
+  const auto isInside = [](const itk::ImageIORegion & region, const IndexType & idx) {
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (idx[i] < region.GetIndex(i) || idx[i] >= region.GetIndex(i) + static_cast<long>(region.GetSize(i)))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  const auto expectedValue = [&](const IndexType & idx) {
+    return value(idx, isInside(unalignedRegion, idx) ? 2 : (isInside(alignedRegion, idx) ? 1 : 0));
+  };
+
+  try
+  {
+    itk::HDF5ImageIO::Pointer imageIO = createImageIO();
+    write(imageIO, 0, nullptr);
+    write(imageIO, 1, &alignedRegion);
+    write(imageIO, 2, &unalignedRegion);
+
+    // Read the whole image, and a sub-region
+    using ReaderType = itk::ImageFileReader<ImageType>;
+    RegionType subRegion;
+    subRegion.SetIndex({ { 5, 6, 7 } });
+    subRegion.SetSize({ { 19, 17, 13 } });
+    for (const bool readSubRegion : { false, true })
+    {
+      typename ReaderType::Pointer reader = ReaderType::New();
+      reader->SetFileName(fileName);
+      reader->UpdateOutputInformation();
+      const RegionType expectedRegion = readSubRegion ? subRegion : reader->GetOutput()->GetLargestPossibleRegion();
+      reader->GetOutput()->SetRequestedRegion(expectedRegion);
+      reader->Update();
+      if (reader->GetOutput()->GetBufferedRegion() != expectedRegion)
+      {
+        std::cout << "Read region " << reader->GetOutput()->GetBufferedRegion() << " instead of " << expectedRegion
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+      itk::ImageRegionIteratorWithIndex<ImageType> it(reader->GetOutput(), expectedRegion);
+      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+        if (it.Get() != expectedValue(it.GetIndex()))
+        {
+          std::cout << "Read value at " << it.GetIndex() << " does not match the written one" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    // Another IO pastes into the file as well, once the IO which created
+    // it has closed it
+    imageIO = nullptr;
+    write(createImageIO(), 3, &unalignedRegion);
+    typename ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(fileName);
+    reader->Update();
+    itk::ImageRegionIteratorWithIndex<ImageType> it(reader->GetOutput(), reader->GetOutput()->GetBufferedRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const IndexType & idx = it.GetIndex();
+      if (it.Get() != (isInside(unalignedRegion, idx) ? value(idx, 3) : expectedValue(idx)))
+      {
+        std::cout << "Read value at " << idx << " was not pasted by another IO" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // A file of another geometry is not pasted into
+    reader = nullptr;
+    {
+      typename ImageType::Pointer otherImage = ImageType::New();
+      otherImage->SetRegions(RegionType(typename ImageType::SizeType{ { 4, 4, 4 } }));
+      otherImage->Allocate(true);
+      using WriterType = itk::ImageFileWriter<ImageType>;
+      typename WriterType::Pointer writer = WriterType::New();
+      writer->SetImageIO(createImageIO());
+      writer->SetFileName(fileName);
+      writer->SetInput(otherImage);
+      writer->Update();
+    }
+    ITK_TRY_EXPECT_EXCEPTION(write(createImageIO(), 2, &unalignedRegion));
+  }
+  catch (const itk::ExceptionObject & err)
+  {
+    std::cout << "itkHDF5ImageIOTest" << std::endl << "Exception Object caught: " << std::endl << err << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Clean working directory.
+  itk::IOTestHelper::Remove(fileName);
+
+  return EXIT_SUCCESS;
+}
+
 int
 itkHDF5ImageIOStreamingReadWriteTest(int ac, char * av[])
 {
@@ -244,5 +395,7 @@ itkHDF5ImageIOStreamingReadWriteTest(int ac, char * av[])
   result += HDF5ReadWriteTest2<unsigned char>("StreamingUCharImage.hdf5");
   result += HDF5ReadWriteTest2<float>("StreamingFloatImage.hdf5");
   result += HDF5ReadWriteTest2<itk::RGBPixel<unsigned char>>("StreamingRGBImage.hdf5");
+  result += HDF5ChunkedReadWriteTest<short>("ChunkedShortImage.hdf5");
+  result += HDF5ChunkedReadWriteTest<itk::RGBPixel<unsigned char>>("ChunkedRGBImage.hdf5");
   return result != 0;
 }
@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAsynchronousImageFileWriter_h
+#define itkAsynchronousImageFileWriter_h
+
+#include "itkImageFileWriter.h"
+#include <deque>
+#include <future>
+#include <string>
+
+namespace itk
+{
+/** \class AsynchronousImageFileWriter
+ * \brief Writes image data to a single file on a background thread.
+ *
+ * Write() brings the input up to date, like ImageFileWriter, then
+ * copies it and returns while an ImageFileWriter writes the copy on a
+ * background thread. The pipeline can then run again, for the next
+ * file of a batch job, while the previous output is being written.
+ *
+ * At most MaximumNumberOfPendingWrites writes, holding at most
+ * MemoryBudget bytes of image copies, are in progress: Write() first
+ * waits for the oldest ones to complete. A single write larger than the
+ * budget is still done. The error of a background write is thrown by
+ * the next call to Write() or WaitForPendingWrites(), which must be
+ * called before the files are used. The destructor waits for the pending
+ * writes.
+ *
+ * ImageIO objects are not thread safe: a user-set ImageIO serves as a
+ * prototype, each file is written with an instance from CreateAnother().
+ * The library behind the ImageIO must support files being written
+ * concurrently.
+ *
+ * \sa PrefetchingImageFileReader
+ * \sa ImageFileWriter
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+template <typename TInputImage>
+class ITK_TEMPLATE_EXPORT AsynchronousImageFileWriter : public ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(AsynchronousImageFileWriter);
+
+  /** Standard class type aliases. */
+  using Self = AsynchronousImageFileWriter;
+  using Superclass = ProcessObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AsynchronousImageFileWriter, ProcessObject);
+
+  /** Some convenient type alias. */
+  using InputImageType = TInputImage;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using WriterType = ImageFileWriter<TInputImage>;
+
+  /** Set/Get the image input of this writer.  */
+  using Superclass::SetInput;
+  void
+  SetInput(const InputImageType * input);
+
+  const InputImageType *
+  GetInput();
+
+  /** Specify the name of the output file to write. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Set/Get the prototype of the ImageIO used to write the files. When
+   * not set, the ImageIO is created by the object factory for each file. */
+  itkSetObjectMacro(ImageIO, ImageIOBase);
+  itkGetModifiableObjectMacro(ImageIO, ImageIOBase);
+
+  /** Set the compression On or Off */
+  itkSetMacro(UseCompression, bool);
+  itkGetConstReferenceMacro(UseCompression, bool);
+  itkBooleanMacro(UseCompression);
+
+  /** Set the compression level. \sa ImageIOBase for details.
+   * Set to a negative number to use ImageIO's default compression level. */
+  itkSetMacro(CompressionLevel, int);
+  itkGetConstReferenceMacro(CompressionLevel, int);
+
+  /** Set/Get the maximum number of writes in progress. Zero writes the
+   * files before Write() returns. Default is 2. */
+  itkSetMacro(MaximumNumberOfPendingWrites, unsigned int);
+  itkGetConstMacro(MaximumNumberOfPendingWrites, unsigned int);
+
+  /** Set/Get the maximum memory, in bytes, held by the copies of the
+   * images being written. Zero means no limit, which is the default. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
+  /** Bring the input up to date and start writing it to FileName. */
+  virtual void
+  Write();
+
+  /** Aliased to the Write() method to be consistent with the rest of the
+   * pipeline. */
+  void
+  Update() override
+  {
+    this->Write();
+  }
+
+  /** Wait until all the files are written, and throw the error of the
+   * first write that failed, if any. */
+  void
+  WaitForPendingWrites();
+
+  /** Number of writes in progress. */
+  SizeValueType
+  GetNumberOfPendingWrites() const
+  {
+    return static_cast<SizeValueType>(m_PendingWrites.size());
+  }
+
+protected:
+  AsynchronousImageFileWriter() = default;
+  ~AsynchronousImageFileWriter() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Copy the input and start writing the copy. */
+  void
+  GenerateData() override;
+
+private:
+  struct PendingWrite
+  {
+    std::future<void> m_Done;
+    SizeValueType     m_Size;
+  };
+
+  /** Wait for the oldest write, and throw its error if it failed. */
+  void
+  WaitForOldestWrite();
+
+  std::string          m_FileName;
+  ImageIOBase::Pointer m_ImageIO;
+  bool                 m_UseCompression{ false };
+  int                  m_CompressionLevel{ -1 };
+  unsigned int         m_MaximumNumberOfPendingWrites{ 2 };
+  SizeValueType        m_MemoryBudget{ 0 };
+
+  std::deque<PendingWrite> m_PendingWrites;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkAsynchronousImageFileWriter.hxx"
+#endif
+
+#ifdef ITK_IO_FACTORY_REGISTER_MANAGER
+#  include "itkImageIOFactoryRegisterManager.h"
+#endif
+
+#endif // itkAsynchronousImageFileWriter_h
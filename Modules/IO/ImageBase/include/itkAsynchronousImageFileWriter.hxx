@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAsynchronousImageFileWriter_hxx
+#define itkAsynchronousImageFileWriter_hxx
+
+#include "itkAsynchronousImageFileWriter.h"
+#include <algorithm>
+#include <exception>
+
+namespace itk
+{
+
+template <typename TInputImage>
+AsynchronousImageFileWriter<TInputImage>::~AsynchronousImageFileWriter()
+{
+  try
+  {
+    this->WaitForPendingWrites();
+  }
+  catch (const std::exception & error)
+  {
+    itkWarningMacro(<< "Writing an image in the background failed: " << error.what());
+  }
+}
+
+template <typename TInputImage>
+void
+AsynchronousImageFileWriter<TInputImage>::SetInput(const InputImageType * input)
+{
+  // ProcessObject is not const_correct so this cast is required here.
+  this->ProcessObject::SetNthInput(0, const_cast<TInputImage *>(input));
+}
+
+template <typename TInputImage>
+const typename AsynchronousImageFileWriter<TInputImage>::InputImageType *
+AsynchronousImageFileWriter<TInputImage>::GetInput()
+{
+  return itkDynamicCastInDebugMode<TInputImage *>(this->GetPrimaryInput());
+}
+
+template <typename TInputImage>
+void
+AsynchronousImageFileWriter<TInputImage>::Write()
+{
+  const InputImageType * input = this->GetInput();
+  if (input == nullptr)
+  {
+    itkExceptionMacro(<< "No input to writer!");
+  }
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro(<< "No filename was specified");
+  }
+
+  this->InvokeEvent(StartEvent());
+
+  // NOTE: this const_cast<> is due to the lack of const-correctness
+  // of the ProcessObject.
+  auto * nonConstInput = const_cast<InputImageType *>(input);
+  nonConstInput->UpdateOutputInformation();
+  nonConstInput->SetRequestedRegionToLargestPossibleRegion();
+  nonConstInput->PropagateRequestedRegion();
+  nonConstInput->UpdateOutputData();
+
+  this->GenerateData();
+
+  this->InvokeEvent(EndEvent());
+
+  // Release upstream data if requested
+  this->ReleaseInputs();
+}
+
+template <typename TInputImage>
+void
+AsynchronousImageFileWriter<TInputImage>::GenerateData()
+{
+  const InputImageType * input = this->GetInput();
+  using ElementType = typename InputImageType::PixelContainer::Element;
+  const SizeValueType numberOfElements = input->GetPixelContainer()->Size();
+  const SizeValueType imageSize = numberOfElements * sizeof(ElementType);
+
+  // Make room for this write
+  SizeValueType pendingMemory = 0;
+  for (const PendingWrite & pendingWrite : m_PendingWrites)
+  {
+    pendingMemory += pendingWrite.m_Size;
+  }
+  while (!m_PendingWrites.empty() && (m_PendingWrites.size() >= m_MaximumNumberOfPendingWrites ||
+                                      (m_MemoryBudget > 0 && pendingMemory + imageSize > m_MemoryBudget)))
+  {
+    pendingMemory -= m_PendingWrites.front().m_Size;
+    this->WaitForOldestWrite();
+  }
+
+  // The copy is written, so that the pipeline can run again meanwhile
+  auto pixels = InputImageType::PixelContainer::New();
+  pixels->Reserve(numberOfElements);
+  std::copy_n(input->GetBufferPointer(), numberOfElements, pixels->GetBufferPointer());
+  InputImagePointer copy = InputImageType::New();
+  copy->Graft(input);
+  copy->SetPixelContainer(pixels);
+  copy->SetMetaDataDictionary(input->GetMetaDataDictionary());
+
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(copy);
+  writer->SetFileName(m_FileName);
+  writer->SetUseCompression(m_UseCompression);
+  writer->SetCompressionLevel(m_CompressionLevel);
+  if (m_ImageIO)
+  {
+    writer->SetImageIO(dynamic_cast<ImageIOBase *>(m_ImageIO->CreateAnother().GetPointer()));
+  }
+
+  // The writer runs on its own thread, not on the pool of the
+  // MultiThreader, so that the write overlaps with the filters.
+  std::future<void> done = std::async(std::launch::async, [writer]() { writer->Update(); });
+  m_PendingWrites.push_back(PendingWrite{ std::move(done), imageSize });
+
+  if (m_MaximumNumberOfPendingWrites == 0)
+  {
+    this->WaitForPendingWrites();
+  }
+}
+
+template <typename TInputImage>
+void
+AsynchronousImageFileWriter<TInputImage>::WaitForOldestWrite()
+{
+  std::future<void> done = std::move(m_PendingWrites.front().m_Done);
+  m_PendingWrites.pop_front();
+  done.get();
+}
+
+template <typename TInputImage>
+void
+AsynchronousImageFileWriter<TInputImage>::WaitForPendingWrites()
+{
+  // All the writes complete before the first error is thrown
+  std::exception_ptr firstError;
+  while (!m_PendingWrites.empty())
+  {
+    try
+    {
+      this->WaitForOldestWrite();
+    }
+    catch (...)
+    {
+      if (!firstError)
+      {
+        firstError = std::current_exception();
+      }
+    }
+  }
+  if (firstError)
+  {
+    std::rethrow_exception(firstError);
+  }
+}
+
+template <typename TInputImage>
+void
+AsynchronousImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+
+  itkPrintSelfObjectMacro(ImageIO);
+
+  os << indent << "UseCompression: " << m_UseCompression << std::endl;
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+  os << indent << "MaximumNumberOfPendingWrites: " << m_MaximumNumberOfPendingWrites << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "NumberOfPendingWrites: " << m_PendingWrites.size() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -173,6 +173,28 @@ public:
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
 
+  /** Set/Get whether the slices are decoded in parallel. Off by default.
+   *
+   * When on, the files of the slices inside the requested region are read
+   * concurrently by the work units of the MultiThreader of the reader,
+   * directly into their slab of the output buffer. Each work unit reads a
+   * range of consecutive files, one at a time, so that no more files than
+   * work units are open at once. The meta data dictionaries are still
+   * collected, and the slice spacing still checked, in the order of the
+   * series.
+   *
+   * The ImageIO objects are not thread safe: when an ImageIO is set, it is
+   * used as a prototype, and each range of files is read with a new
+   * instance created by CreateAnother(), with its default settings. */
+  itkSetMacro(ParallelRead, bool);
+  itkGetConstMacro(ParallelRead, bool);
+  itkBooleanMacro(ParallelRead);
+
+  /** Set/Get the maximum number of files open at once by a parallel read.
+   * 0, the default, means the number of work units of the reader. */
+  itkSetMacro(MaximumNumberOfOpenFiles, unsigned int);
+  itkGetConstMacro(MaximumNumberOfOpenFiles, unsigned int);
+
 protected:
   ImageSeriesReader()
     : m_ImageIO(nullptr)
@@ -215,12 +237,43 @@ protected:
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
 
+  bool m_ParallelRead{ false };
+
+  unsigned int m_MaximumNumberOfOpenFiles{ 0 };
+
 private:
   using ReaderType = ImageFileReader<TOutputImage>;
 
   int
   ComputeMovingDimensionIndex(ReaderType * reader);
 
+  /** What is kept from the file of a slice once it is read. */
+  struct SliceInformation
+  {
+    bool                             IsRead{ false };
+    typename TOutputImage::PointType Origin;
+    bool                             HasDictionary{ false };
+    DictionaryType                   Dictionary;
+  };
+
+  /** Read the file of the slice of index sliceIndex along the moving
+   * dimension: its pixels, into the output buffer, when it is inside the
+   * requested region, and only its information otherwise. The ImageIO may
+   * be null, to use the factory mechanism. */
+  void
+  ReadSlice(int                     sliceIndex,
+            ImageIOBase *           imageIO,
+            const ImageRegionType & sliceRegionToRequest,
+            const SizeType &        validSize,
+            bool                    copyDictionary,
+            SliceInformation &      slice);
+
+  /** Read the slices inside the requested region in parallel. */
+  void
+  ReadSlicesInParallel(const ImageRegionType &         sliceRegionToRequest,
+                       const SizeType &                validSize,
+                       std::vector<SliceInformation> & slices);
+
   /** Modified time of the MetaDataDictionaryArray */
   TimeStamp m_MetaDataDictionaryArrayMTime;
 
@@ -25,6 +25,7 @@
 #include "itkVector.h"
 #include "itkMath.h"
 #include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
 #include "itkMetaDataObject.h"
 #include <iomanip>
 
@@ -55,6 +56,8 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "ParallelRead: " << m_ParallelRead << std::endl;
+  os << indent << "MaximumNumberOfOpenFiles: " << m_MaximumNumberOfOpenFiles << std::endl;
 
   itkPrintSelfObjectMacro(ImageIO);
 
@@ -293,9 +296,17 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   bool needToUpdateMetaDataDictionaryArray =
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
-  typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-  const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
+  IndexType  sliceStartIndex = requestedRegion.GetIndex();
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
+
+  // A parallel read decodes the slices inside the requested region first.
+  // Their information is then processed in order, as for a serial read.
+  std::vector<SliceInformation> slices;
+  if (m_ParallelRead && numberOfFiles > 1)
+  {
+    slices.resize(numberOfFiles);
+    this->ReadSlicesInParallel(sliceRegionToRequest, validSize, slices);
+  }
 
   typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
   typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
@@ -310,7 +321,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     }
 
     const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
     bool       nonUniformSampling = false;
     double     spacingDeviation = 0.0;
 
@@ -320,110 +330,21 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       continue;
     }
 
-    // configure reader
-    typename ReaderType::Pointer reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
-
-    TOutputImage * readerOutput = reader->GetOutput();
-
-    if (m_ImageIO)
+    SliceInformation   serialSlice;
+    SliceInformation & slice = slices.empty() ? serialSlice : slices[i];
+    if (!slice.IsRead)
     {
-      reader->SetImageIO(m_ImageIO);
+      this->ReadSlice(i, m_ImageIO, sliceRegionToRequest, validSize, needToUpdateMetaDataDictionaryArray, slice);
     }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
 
-    // update the data or info
-    if (!insideRequestedRegion)
+    if (insideRequestedRegion)
     {
-      reader->UpdateOutputInformation();
-    }
-    else
-    {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
-
-      // propagate the requested region to determin what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
-
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
-      {
-        itkExceptionMacro(<< "Size mismatch! The size of  " << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
-      }
-
-      // get the size of the region to be read
-      SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
-
-      if (readSize == sliceRegionToRequest.GetSize())
-      {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
-
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
-
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
-
-
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
-
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
-
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
-
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
-        }
-        else
-        {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
-        }
-        readerOutput->UpdateOutputData();
-      }
-      else
-      {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
-
-        reader->Update();
-
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
-
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
-
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
-      }
-
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
+        const typename TOutputImage::PointType & sliceOrigin = slice.Origin;
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -450,19 +371,22 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = slice.Origin;
         prevSliceIsValid = true;
       }
 
-      // report progress for read slices
-      progress.CompletedPixel();
+      // report progress for read slices, the parallel read reports its own
+      if (slices.empty())
+      {
+        progress.CompletedPixel();
+      }
     } // end !insidedRequestedRegion
 
     // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    if (slice.HasDictionary && needToUpdateMetaDataDictionaryArray)
     {
       auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      *newDictionary = slice.Dictionary;
       if (nonUniformSampling)
       {
         // slice-specific information
@@ -494,6 +418,197 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   }
 }
 
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::ReadSlice(int                     sliceIndex,
+                                           ImageIOBase *           imageIO,
+                                           const ImageRegionType & sliceRegionToRequest,
+                                           const SizeType &        validSize,
+                                           bool                    copyDictionary,
+                                           SliceInformation &      slice)
+{
+  TOutputImage *        output = this->GetOutput();
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
+
+  IndexType sliceStartIndex = requestedRegion.GetIndex();
+  if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+  {
+    sliceStartIndex[this->m_NumberOfDimensionsInImage] = sliceIndex;
+  }
+
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
+  const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
+  const int  iFileName = (m_ReverseOrder ? numberOfFiles - sliceIndex - 1 : sliceIndex);
+
+  // configure reader
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(m_FileNames[iFileName].c_str());
+
+  TOutputImage * readerOutput = reader->GetOutput();
+
+  if (imageIO)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  reader->SetUseStreaming(m_UseStreaming);
+  readerOutput->SetRequestedRegion(sliceRegionToRequest);
+
+  // update the data or info
+  if (!insideRequestedRegion)
+  {
+    reader->UpdateOutputInformation();
+  }
+  else
+  {
+    // read the meta data information
+    readerOutput->UpdateOutputInformation();
+
+    // propagate the requested region to determin what the region
+    // will actually be read
+    readerOutput->PropagateRequestedRegion();
+
+    // check that the size of each slice is the same
+    if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+    {
+      itkExceptionMacro(<< "Size mismatch! The size of  " << m_FileNames[iFileName].c_str() << " is "
+                        << readerOutput->GetLargestPossibleRegion().GetSize()
+                        << " and does not match the required size " << validSize << " from file "
+                        << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+    }
+
+    // get the size of the region to be read
+    SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+
+    if (readSize == sliceRegionToRequest.GetSize())
+    {
+      // if the buffer of the ImageReader is going to match that of
+      // ourselves, then set the ImageReader's buffer to a section
+      // of ours
+
+      const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+      using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+      const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+
+      const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                      ? (sliceIndex - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                      : 0;
+
+      const ptrdiff_t numberOfPixelComponentsUpToSlice =
+        numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+      const bool bufferDelete = false;
+
+      typename TOutputImage::InternalPixelType * outputSliceBuffer =
+        output->GetBufferPointer() + numberOfPixelComponentsUpToSlice;
+
+      if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+      {
+        // if the input image type is a vector image then the number
+        // of components needs to be set for the size
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer,
+          static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+          bufferDelete);
+      }
+      else
+      {
+        // otherwise the actual number of pixels needs to be passed
+        readerOutput->GetPixelContainer()->SetImportPointer(
+          outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+      }
+      readerOutput->UpdateOutputData();
+    }
+    else
+    {
+      // the read region isn't going to match exactly what we need
+      // to update to buffer created by the reader, then copy
+
+      reader->Update();
+
+      // output of buffer copy
+      ImageRegionType outRegion = requestedRegion;
+      outRegion.SetIndex(sliceStartIndex);
+
+      // set the moving dimension to a size of 1
+      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+      {
+        outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+      }
+
+      ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+    }
+  }
+
+  slice.IsRead = true;
+  slice.Origin = readerOutput->GetOrigin();
+  slice.HasDictionary = copyDictionary && reader->GetImageIO();
+  if (slice.HasDictionary)
+  {
+    slice.Dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+  }
+}
+
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::ReadSlicesInParallel(const ImageRegionType &         sliceRegionToRequest,
+                                                      const SizeType &                validSize,
+                                                      std::vector<SliceInformation> & slices)
+{
+  const ImageRegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
+  IndexType             sliceStartIndex = requestedRegion.GetIndex();
+
+  std::vector<int> slicesToRead;
+  for (int i = 0; i != static_cast<int>(m_FileNames.size()); ++i)
+  {
+    if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+    {
+      sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+    }
+    if (requestedRegion.IsInside(sliceStartIndex))
+    {
+      slicesToRead.push_back(i);
+    }
+  }
+
+  // Each range of consecutive files is read by one work unit, one file at a
+  // time, so at most one file is open per range. The threader of the filter
+  // is left untouched: its number of work units only bounds the number of
+  // ranges.
+  const SizeValueType numberOfSlicesToRead = slicesToRead.size();
+  SizeValueType       numberOfRanges = std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfSlicesToRead);
+  if (m_MaximumNumberOfOpenFiles > 0)
+  {
+    numberOfRanges = std::min<SizeValueType>(numberOfRanges, m_MaximumNumberOfOpenFiles);
+  }
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfRanges,
+    [&](SizeValueType range) {
+      const SizeValueType begin = range * numberOfSlicesToRead / numberOfRanges;
+      const SizeValueType end = (range + 1) * numberOfSlicesToRead / numberOfRanges;
+
+      // The ImageIO objects are not thread safe
+      ImageIOBase::Pointer imageIO;
+      if (m_ImageIO)
+      {
+        imageIO = dynamic_cast<ImageIOBase *>(m_ImageIO->CreateAnother().GetPointer());
+      }
+
+      const bool copyDictionary = true;
+      for (SizeValueType j = begin; j < end; ++j)
+      {
+        this->ReadSlice(
+          slicesToRead[j], imageIO, sliceRegionToRequest, validSize, copyDictionary, slices[slicesToRead[j]]);
+      }
+
+      TotalProgressReporter progress(this, numberOfSlicesToRead, numberOfSlicesToRead);
+      progress.Completed(end - begin);
+    },
+    nullptr);
+}
+
 template <typename TOutputImage>
 typename ImageSeriesReader<TOutputImage>::DictionaryArrayRawPointer
 ImageSeriesReader<TOutputImage>::GetMetaDataDictionaryArray() const
@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPrefetchingImageFileReader_h
+#define itkPrefetchingImageFileReader_h
+
+#include "itkImageFileReader.h"
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class PrefetchingImageFileReader
+ * \brief Reads images from a list of files, one at a time, reading the
+ * next ones in the background.
+ *
+ * This source produces the image of the file at FileIndex in a list of
+ * files. While the pipeline processes it, the next
+ * NumberOfPrefetchedImages files are read on background threads with
+ * ImageFileReader, so a batch job that updates the pipeline for each
+ * FileIndex in turn overlaps its reads with the computation. The
+ * prefetched images are dropped when FileIndex moves past them, or
+ * before them.
+ *
+ * The output is a regular image source output: filters downstream are
+ * unchanged. Each file is read whole; the output requested region is
+ * enlarged to the largest possible region.
+ *
+ * MemoryBudget bounds the memory held by prefetched images, in bytes:
+ * the size of an image not read yet is taken to be the size of the
+ * current one. The image at FileIndex is always read.
+ *
+ * ImageIO objects are not thread safe: a user-set ImageIO serves as a
+ * prototype, each file is read with an instance from CreateAnother().
+ * The library behind the ImageIO must support files being read
+ * concurrently.
+ *
+ * \sa AsynchronousImageFileWriter
+ * \sa ImageFileReader
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+template <typename TOutputImage,
+          typename ConvertPixelTraits = DefaultConvertPixelTraits<typename TOutputImage::IOPixelType>>
+class ITK_TEMPLATE_EXPORT PrefetchingImageFileReader : public ImageSource<TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(PrefetchingImageFileReader);
+
+  /** Standard class type aliases. */
+  using Self = PrefetchingImageFileReader;
+  using Superclass = ImageSource<TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PrefetchingImageFileReader, ImageSource);
+
+  using OutputImageType = TOutputImage;
+  using OutputImagePointer = typename OutputImageType::Pointer;
+  using ReaderType = ImageFileReader<TOutputImage, ConvertPixelTraits>;
+  using FileNamesContainer = std::vector<std::string>;
+
+  /** Set the vector of strings that contains the file names. */
+  void
+  SetFileNames(const FileNamesContainer & names)
+  {
+    if (m_FileNames != names)
+    {
+      m_FileNames = names;
+      this->DiscardPrefetchedImages();
+      this->Modified();
+    }
+  }
+
+  const FileNamesContainer &
+  GetFileNames() const
+  {
+    return m_FileNames;
+  }
+
+  /** Add a single filename to the list of files. */
+  void
+  AddFileName(std::string const & name)
+  {
+    m_FileNames.push_back(name);
+    this->Modified();
+  }
+
+  /** Set/Get the index, in the list of files, of the file to produce. */
+  itkSetMacro(FileIndex, SizeValueType);
+  itkGetConstMacro(FileIndex, SizeValueType);
+
+  /** Set/Get the number of files after FileIndex read in the background.
+   * Zero disables prefetching. Default is 2. */
+  itkSetMacro(NumberOfPrefetchedImages, unsigned int);
+  itkGetConstMacro(NumberOfPrefetchedImages, unsigned int);
+
+  /** Set/Get the maximum memory, in bytes, held by prefetched images.
+   * Zero means no limit, which is the default. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
+  /** Set/Get the prototype of the ImageIO used to read the files. When
+   * not set, the ImageIO is created by the object factory for each file. */
+  itkSetObjectMacro(ImageIO, ImageIOBase);
+  itkGetModifiableObjectMacro(ImageIO, ImageIOBase);
+
+  /** Number of images read, or being read, ahead of FileIndex. */
+  SizeValueType
+  GetNumberOfPendingImages() const;
+
+protected:
+  PrefetchingImageFileReader() = default;
+  ~PrefetchingImageFileReader() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Wait for the image at FileIndex and starts reading the next ones. */
+  void
+  GenerateOutputInformation() override;
+
+  /** The files are read whole. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  /** Graft the image read at FileIndex onto the output. */
+  void
+  GenerateData() override;
+
+private:
+  using FutureImageType = std::shared_future<OutputImagePointer>;
+
+  /** Start reading a file on a background thread. */
+  FutureImageType
+  ReadInBackground(SizeValueType fileIndex) const;
+
+  /** Start reading the files following FileIndex, within the budget. */
+  void
+  PrefetchImages(SizeValueType currentImageSize);
+
+  void
+  DiscardPrefetchedImages();
+
+  /** Memory held by an image, in bytes. */
+  static SizeValueType
+  GetImageSize(const OutputImageType * image);
+
+  FileNamesContainer   m_FileNames;
+  SizeValueType        m_FileIndex{ 0 };
+  unsigned int         m_NumberOfPrefetchedImages{ 2 };
+  SizeValueType        m_MemoryBudget{ 0 };
+  ImageIOBase::Pointer m_ImageIO;
+
+  // Images read, or being read, by file index
+  std::map<SizeValueType, FutureImageType> m_Images;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPrefetchingImageFileReader.hxx"
+#endif
+
+#ifdef ITK_IO_FACTORY_REGISTER_MANAGER
+#  include "itkImageIOFactoryRegisterManager.h"
+#endif
+
+#endif // itkPrefetchingImageFileReader_h
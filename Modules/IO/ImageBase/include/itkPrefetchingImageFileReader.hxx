@@ -0,0 +1,224 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPrefetchingImageFileReader_hxx
+#define itkPrefetchingImageFileReader_hxx
+
+#include "itkPrefetchingImageFileReader.h"
+#include <algorithm>
+#include <chrono>
+
+namespace itk
+{
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileNames: " << m_FileNames.size() << " files" << std::endl;
+  os << indent << "FileIndex: " << m_FileIndex << std::endl;
+  os << indent << "NumberOfPrefetchedImages: " << m_NumberOfPrefetchedImages << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "NumberOfPendingImages: " << this->GetNumberOfPendingImages() << std::endl;
+
+  itkPrintSelfObjectMacro(ImageIO);
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+SizeValueType
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::GetNumberOfPendingImages() const
+{
+  return static_cast<SizeValueType>(std::distance(m_Images.upper_bound(m_FileIndex), m_Images.end()));
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+SizeValueType
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::GetImageSize(const OutputImageType * image)
+{
+  using ElementType = typename OutputImageType::PixelContainer::Element;
+  return static_cast<SizeValueType>(image->GetPixelContainer()->Size() * sizeof(ElementType));
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+typename PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::FutureImageType
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::ReadInBackground(SizeValueType fileIndex) const
+{
+  ImageIOBase::Pointer imageIO;
+  if (m_ImageIO)
+  {
+    imageIO = dynamic_cast<ImageIOBase *>(m_ImageIO->CreateAnother().GetPointer());
+  }
+  const std::string fileName = m_FileNames[fileIndex];
+
+  // The reader runs on its own thread, not on the pool of the
+  // MultiThreader, so that the reads overlap with the filters.
+  return std::async(std::launch::async,
+                    [fileName, imageIO]() {
+                      auto reader = ReaderType::New();
+                      reader->SetFileName(fileName);
+                      if (imageIO)
+                      {
+                        reader->SetImageIO(imageIO);
+                      }
+                      reader->Update();
+                      OutputImagePointer image = reader->GetOutput();
+                      image->DisconnectPipeline();
+                      return image;
+                    })
+    .share();
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::PrefetchImages(SizeValueType currentImageSize)
+{
+  if (m_NumberOfPrefetchedImages == 0)
+  {
+    return;
+  }
+
+  // Memory held by the prefetched images. The images still being read
+  // are assumed to be as large as the current one.
+  SizeValueType heldMemory = 0;
+  for (auto it = m_Images.upper_bound(m_FileIndex); it != m_Images.end(); ++it)
+  {
+    SizeValueType imageSize = currentImageSize;
+    if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      try
+      {
+        imageSize = GetImageSize(it->second.get());
+      }
+      catch (...)
+      {
+        // reported when the file becomes the current one
+        imageSize = 0;
+      }
+    }
+    heldMemory += imageSize;
+  }
+
+  const SizeValueType lastIndex =
+    std::min<SizeValueType>(m_FileIndex + m_NumberOfPrefetchedImages, m_FileNames.size() - 1);
+  for (SizeValueType fileIndex = m_FileIndex + 1; fileIndex <= lastIndex; ++fileIndex)
+  {
+    if (m_Images.count(fileIndex) > 0)
+    {
+      continue;
+    }
+    if (m_MemoryBudget > 0 && heldMemory + currentImageSize > m_MemoryBudget)
+    {
+      break;
+    }
+    m_Images.emplace(fileIndex, this->ReadInBackground(fileIndex));
+    heldMemory += currentImageSize;
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::DiscardPrefetchedImages()
+{
+  // waits for the reads in progress
+  m_Images.clear();
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
+{
+  if (m_FileIndex >= m_FileNames.size())
+  {
+    itkExceptionMacro(<< "FileIndex " << m_FileIndex << " is past the end of the " << m_FileNames.size()
+                      << " file names");
+  }
+
+  // The images before FileIndex, or beyond the prefetched ones, are
+  // no longer needed
+  for (auto it = m_Images.begin(); it != m_Images.end();)
+  {
+    if (it->first < m_FileIndex || it->first > m_FileIndex + m_NumberOfPrefetchedImages)
+    {
+      it = m_Images.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  auto current = m_Images.find(m_FileIndex);
+  if (current == m_Images.end())
+  {
+    current = m_Images.emplace(m_FileIndex, this->ReadInBackground(m_FileIndex)).first;
+  }
+  OutputImagePointer image;
+  try
+  {
+    image = current->second.get();
+  }
+  catch (...)
+  {
+    // read the file again at the next update
+    m_Images.erase(current);
+    throw;
+  }
+
+  OutputImageType * output = this->GetOutput();
+  output->CopyInformation(image);
+  output->SetMetaDataDictionary(image->GetMetaDataDictionary());
+
+  this->PrefetchImages(GetImageSize(image));
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+PrefetchingImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
+{
+  auto current = m_Images.find(m_FileIndex);
+  if (current == m_Images.end())
+  {
+    current = m_Images.emplace(m_FileIndex, this->ReadInBackground(m_FileIndex)).first;
+  }
+  OutputImagePointer image;
+  try
+  {
+    image = current->second.get();
+  }
+  catch (...)
+  {
+    m_Images.erase(current);
+    throw;
+  }
+
+  // The output takes over the buffer of the image read
+  m_Images.erase(current);
+  this->GraftOutput(image);
+}
+
+} // end namespace itk
+
+#endif
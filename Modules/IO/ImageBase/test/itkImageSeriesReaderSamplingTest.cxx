@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include "itkImageSeriesReader.h"
+#include "itkImageRegionConstIterator.h"
 
 int
 itkImageSeriesReaderSamplingTest(int ac, char * av[])
@@ -78,5 +79,60 @@ itkImageSeriesReaderSamplingTest(int ac, char * av[])
     return EXIT_FAILURE;
   }
 
+  std::cout << "testing reading the slices in parallel" << std::endl;
+  try
+  {
+    Reader3DType::Pointer serialReader = Reader3DType::New();
+    serialReader->SetFileNames(fnames);
+    serialReader->Update();
+
+    Reader3DType::Pointer parallelReader = Reader3DType::New();
+    parallelReader->SetFileNames(fnames);
+    parallelReader->ParallelReadOn();
+    parallelReader->SetMaximumNumberOfOpenFiles(2);
+    const itk::ThreadIdType numberOfWorkUnits = parallelReader->GetMultiThreader()->GetNumberOfWorkUnits();
+    parallelReader->Update();
+    if (parallelReader->GetMultiThreader()->GetNumberOfWorkUnits() != numberOfWorkUnits)
+    {
+      std::cout << "Parallel read changed the number of work units of the reader" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    itk::ImageRegionConstIterator<Image3DType> serialIt(serialReader->GetOutput(),
+                                                        serialReader->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<Image3DType> parallelIt(parallelReader->GetOutput(),
+                                                          parallelReader->GetOutput()->GetLargestPossibleRegion());
+    for (; !serialIt.IsAtEnd(); ++serialIt, ++parallelIt)
+    {
+      if (serialIt.Get() != parallelIt.Get())
+      {
+        std::cout << "Parallel read differs at " << serialIt.GetIndex() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    const Reader3DType::DictionaryArrayType & serialDictionaries = *serialReader->GetMetaDataDictionaryArray();
+    const Reader3DType::DictionaryArrayType & parallelDictionaries = *parallelReader->GetMetaDataDictionaryArray();
+    if (serialDictionaries.size() != parallelDictionaries.size())
+    {
+      std::cout << "Parallel read has " << parallelDictionaries.size() << " dictionaries instead of "
+                << serialDictionaries.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < serialDictionaries.size(); ++i)
+    {
+      if (serialDictionaries[i]->GetKeys() != parallelDictionaries[i]->GetKeys())
+      {
+        std::cout << "Parallel read dictionary " << i << " differs" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (const itk::ExceptionObject & ex)
+  {
+    std::cout << ex;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
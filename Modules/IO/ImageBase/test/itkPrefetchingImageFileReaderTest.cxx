@@ -0,0 +1,185 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAsynchronousImageFileWriter.h"
+#include "itkPrefetchingImageFileReader.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIOFactory.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 2>;
+
+PixelType
+ExpectedValue(unsigned int fileIndex, const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(1000 * fileIndex + 7 * index[0] + 3 * index[1]);
+}
+
+void
+FillImage(ImageType * image, unsigned int fileIndex)
+{
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue(fileIndex, it.GetIndex()));
+  }
+}
+
+bool
+CheckImage(const ImageType * image, unsigned int fileIndex)
+{
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedValue(fileIndex, it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in image of file " << fileIndex << " at " << it.GetIndex() << ": expected "
+                << ExpectedValue(fileIndex, it.GetIndex()) << ", got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkPrefetchingImageFileReaderTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  itk::MetaImageIOFactory::RegisterOneFactory();
+
+  constexpr unsigned int numberOfFiles = 6;
+
+  ImageType::SizeType size;
+  size[0] = 64;
+  size[1] = 48;
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  const itk::SizeValueType imageSize = image->GetPixelContainer()->Size() * sizeof(PixelType);
+
+  // Write the files in the background
+  using WriterType = itk::AsynchronousImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(writer, AsynchronousImageFileWriter, ProcessObject);
+
+  ITK_TEST_SET_GET_BOOLEAN(writer, UseCompression, true);
+  writer->SetMaximumNumberOfPendingWrites(2);
+  ITK_TEST_SET_GET_VALUE(2, writer->GetMaximumNumberOfPendingWrites());
+  writer->SetMemoryBudget(2 * imageSize);
+  ITK_TEST_SET_GET_VALUE(2 * imageSize, writer->GetMemoryBudget());
+
+  std::vector<std::string> fileNames;
+  writer->SetInput(image);
+  for (unsigned int fileIndex = 0; fileIndex < numberOfFiles; ++fileIndex)
+  {
+    fileNames.push_back(outputDirectory + "/itkPrefetchingImageFileReaderTest" + std::to_string(fileIndex) + ".mha");
+    FillImage(image, fileIndex);
+    writer->SetFileName(fileNames.back());
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+    ITK_TEST_EXPECT_TRUE(writer->GetNumberOfPendingWrites() <= 2);
+
+    // the file holds the image as it was when Update() was called
+    image->FillBuffer(-1);
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->WaitForPendingWrites());
+  ITK_TEST_EXPECT_EQUAL(writer->GetNumberOfPendingWrites(), 0);
+
+  // Read them back in turn, the next ones in the background
+  using ReaderType = itk::PrefetchingImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(reader, PrefetchingImageFileReader, ImageSource);
+
+  reader->SetNumberOfPrefetchedImages(2);
+  ITK_TEST_SET_GET_VALUE(2, reader->GetNumberOfPrefetchedImages());
+  reader->SetFileNames(fileNames);
+  ITK_TEST_EXPECT_EQUAL(reader->GetFileNames().size(), numberOfFiles);
+
+  for (unsigned int fileIndex = 0; fileIndex < numberOfFiles; ++fileIndex)
+  {
+    reader->SetFileIndex(fileIndex);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetNumberOfPendingImages(), std::min(2u, numberOfFiles - 1 - fileIndex));
+    if (!CheckImage(reader->GetOutput(), fileIndex))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Going back reads the file again
+  reader->SetFileIndex(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  if (!CheckImage(reader->GetOutput(), 1))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The budget holds a single prefetched image
+  reader->SetMemoryBudget(imageSize);
+  ITK_TEST_SET_GET_VALUE(imageSize, reader->GetMemoryBudget());
+  reader->SetFileIndex(2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(reader->GetNumberOfPendingImages(), 1);
+  if (!CheckImage(reader->GetOutput(), 2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The error of a file is reported when it becomes the current one
+  ReaderType::FileNamesContainer withMissingFile = fileNames;
+  withMissingFile[1] = outputDirectory + "/itkPrefetchingImageFileReaderTestMissing.mha";
+  reader->SetFileNames(withMissingFile);
+  reader->SetFileIndex(0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  reader->SetFileIndex(1);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+  reader->SetFileIndex(2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  if (!CheckImage(reader->GetOutput(), 2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  reader->SetFileIndex(numberOfFiles);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+
+  // The error of a background write is reported by the next wait
+  writer->SetFileName(outputDirectory + "/MissingDirectory/itkPrefetchingImageFileReaderTest.mha");
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TRY_EXPECT_EXCEPTION(writer->WaitForPendingWrites());
+
+  // or right away when the files are written synchronously
+  writer->SetMaximumNumberOfPendingWrites(0);
+  ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
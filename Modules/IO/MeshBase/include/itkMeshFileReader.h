@@ -134,6 +134,15 @@ public:
   SetMeshIO(MeshIOBase * meshIO);
   itkGetModifiableObjectMacro(MeshIO, MeshIOBase);
 
+  /** Set/Get whether the cells are stored compactly in the output mesh
+   * (see Mesh::SetCompactCells()) when they all have the same geometry,
+   * instead of as one cell object per cell.  Only applies to itk::Mesh
+   * outputs (see MeshSupportsCompactCells); QuadEdgeMesh and the other
+   * derived meshes are always read cell by cell.  Off by default. */
+  itkSetMacro(UseCompactCells, bool);
+  itkGetConstMacro(UseCompactCells, bool);
+  itkBooleanMacro(UseCompactCells);
+
   /** Prepare the allocation of the output mesh during the first back
    * propagation of the pipeline. */
   void
@@ -147,6 +156,13 @@ public:
   void
   ReadCells(T * buffer);
 
+  /** Store the cells of the buffer compactly in the output mesh.  Returns
+   * false, leaving the mesh unchanged, if the cells do not all have the
+   * same geometry. */
+  template <typename T>
+  bool
+  ReadCompactCells(T * buffer);
+
   void
   ReadPointData();
 
@@ -184,6 +200,7 @@ protected:
   bool                m_UserSpecifiedMeshIO; // keep track whether the MeshIO is
                                              // user specified
   std::string m_FileName;                    // The file to be read
+  bool        m_UseCompactCells{ false };
 
 private:
   std::string m_ExceptionMessage;
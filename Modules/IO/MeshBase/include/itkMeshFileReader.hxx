@@ -21,6 +21,7 @@
 #include "itkConvertPixelBuffer.h"
 #include "itkConvertArrayPixelBuffer.h"
 #include "itkConvertVariableLengthVectorPixelBuffer.h"
+#include "itkMesh.h"
 #include "itkMeshIOFactory.h"
 #include "itkMeshFileReader.h"
 #include "itkMeshRegion.h"
@@ -60,6 +61,7 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Pr
 
   os << indent << "UserSpecifiedMeshIO flag: " << m_UserSpecifiedMeshIO << "\n";
   os << indent << "FileName: " << m_FileName << "\n";
+  os << indent << "UseCompactCells: " << m_UseCompactCells << "\n";
 }
 
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
@@ -132,6 +134,11 @@ template <typename T>
 void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadCells(T * buffer)
 {
+  if (m_UseCompactCells && MeshSupportsCompactCells<OutputMeshType>::value && this->ReadCompactCells(buffer))
+  {
+    return;
+  }
+
   typename TOutputMesh::Pointer output = this->GetOutput();
 
   SizeValueType        index = NumericTraits<SizeValueType>::ZeroValue();
@@ -330,6 +337,114 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
   }
 }
 
+template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
+template <typename T>
+bool
+MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadCompactCells(T * buffer)
+{
+  using ConnectivityContainer = typename OutputMeshType::CellsConnectivityContainer;
+  using OffsetsContainer = typename OutputMeshType::CellsOffsetsContainer;
+
+  // The geometry a cell of the buffer is read as: polygons of three points
+  // are triangles, and polylines are split into lines
+  const auto cellGeometry = [](CellGeometryEnum type, unsigned int numberOfPoints) {
+    if (type == CellGeometryEnum::POLYGON_CELL && numberOfPoints == OutputTriangleCellType::NumberOfPoints)
+    {
+      return CellGeometryEnum::TRIANGLE_CELL;
+    }
+    return type;
+  };
+
+  // First pass: check that all the cells have the same geometry, and
+  // count them
+  const SizeValueType bufferSize = m_MeshIO->GetCellBufferSize();
+  CellGeometryEnum    geometry = CellGeometryEnum::LAST_ITK_CELL;
+  SizeValueType       numberOfCells = 0;
+  SizeValueType       numberOfIds = 0;
+  for (SizeValueType index = 0; index + 1 < bufferSize;)
+  {
+    const auto         type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index]));
+    const auto         numberOfPoints = static_cast<unsigned int>(buffer[index + 1]);
+    const unsigned int expectedNumberOfPoints = OutputMeshType::GetNumberOfPointsOfCellGeometry(type);
+    index += 2 + numberOfPoints;
+
+    const CellGeometryEnum cellType = cellGeometry(type, numberOfPoints);
+    if (type >= CellGeometryEnum::LAST_ITK_CELL)
+    {
+      return false;
+    }
+    if (geometry != CellGeometryEnum::LAST_ITK_CELL && cellType != geometry)
+    {
+      return false;
+    }
+    geometry = cellType;
+
+    if (type == CellGeometryEnum::LINE_CELL)
+    {
+      if (numberOfPoints < 2)
+      {
+        return false;
+      }
+      numberOfCells += numberOfPoints - 1;
+      numberOfIds += 2 * (numberOfPoints - 1);
+    }
+    else
+    {
+      if (expectedNumberOfPoints != 0 && numberOfPoints != expectedNumberOfPoints)
+      {
+        return false;
+      }
+      ++numberOfCells;
+      numberOfIds += numberOfPoints;
+    }
+  }
+  if (geometry == CellGeometryEnum::LAST_ITK_CELL)
+  {
+    return false;
+  }
+
+  // Second pass: copy the point identifiers
+  typename ConnectivityContainer::Pointer connectivity = ConnectivityContainer::New();
+  connectivity->Reserve(numberOfIds);
+  typename OffsetsContainer::Pointer offsets;
+  if (OutputMeshType::GetNumberOfPointsOfCellGeometry(geometry) == 0)
+  {
+    offsets = OffsetsContainer::New();
+    offsets->Reserve(numberOfCells + 1);
+    offsets->SetElement(0, 0);
+  }
+
+  OutputPointIdentifier * ids = connectivity->CastToSTLContainer().data();
+  SizeValueType           id = 0;
+  OutputCellIdentifier    cellId = 0;
+  for (SizeValueType index = 0; index + 1 < bufferSize;)
+  {
+    const auto type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    const auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
+    if (type == CellGeometryEnum::LINE_CELL)
+    {
+      for (unsigned int jj = 1; jj < numberOfPoints; ++jj)
+      {
+        ids[id++] = static_cast<OutputPointIdentifier>(buffer[index + jj - 1]);
+        ids[id++] = static_cast<OutputPointIdentifier>(buffer[index + jj]);
+      }
+      index += numberOfPoints;
+      continue;
+    }
+    for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
+    {
+      ids[id++] = static_cast<OutputPointIdentifier>(buffer[index++]);
+    }
+    if (offsets)
+    {
+      offsets->SetElement(++cellId, id);
+    }
+  }
+
+  this->GetOutput()->SetCompactCells(geometry, connectivity, offsets);
+  return true;
+}
+
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
 void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadPointData()
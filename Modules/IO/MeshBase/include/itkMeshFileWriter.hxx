@@ -167,14 +167,21 @@ MeshFileWriter<TInputMesh>::Write()
   }
 
   // Whether write cells
-  if (input->GetCells() && input->GetNumberOfCells())
+  if (input->GetNumberOfCells())
   {
     SizeValueType cellsBufferSize = 2 * input->GetNumberOfCells();
-    for (typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
-         ct != input->GetCells()->End();
-         ++ct)
+    if (input->HasCompactCells())
     {
-      cellsBufferSize += ct->Value()->GetNumberOfPoints();
+      cellsBufferSize += input->GetCellsConnectivity()->Size();
+    }
+    else
+    {
+      for (typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
+           ct != input->GetCells()->End();
+           ++ct)
+      {
+        cellsBufferSize += ct->Value()->GetNumberOfPoints();
+      }
     }
     m_MeshIO->SetCellBufferSize(cellsBufferSize);
     m_MeshIO->SetUpdateCells(true);
@@ -214,7 +221,7 @@ MeshFileWriter<TInputMesh>::Write()
   }
 
   // Write cells
-  if (input->GetCells() && input->GetNumberOfCells())
+  if (input->GetNumberOfCells())
   {
     WriteCells();
   }
@@ -338,8 +345,29 @@ template <typename Output>
 void
 MeshFileWriter<TInputMesh>::CopyCellsToBuffer(Output * data)
 {
+  const InputMeshType * input = this->GetInput();
+
+  // Compactly stored cells are written from their views, without
+  // creating cell objects
+  if (input->HasCompactCells())
+  {
+    SizeValueType                             index = NumericTraits<SizeValueType>::ZeroValue();
+    const typename TInputMesh::CellIdentifier numberOfCells = input->GetNumberOfCells();
+    for (typename TInputMesh::CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      const typename TInputMesh::CellView view = input->GetCellView(cellId);
+      data[index++] = static_cast<Output>(view.GetType());
+      data[index++] = static_cast<Output>(view.GetNumberOfPoints());
+      for (const auto pointId : view)
+      {
+        data[index++] = static_cast<Output>(pointId);
+      }
+    }
+    return;
+  }
+
   // Get input mesh pointer
-  const typename InputMeshType::CellsContainer * cells = this->GetInput()->GetCells();
+  const typename InputMeshType::CellsContainer * cells = input->GetCells();
 
   // Define required variables
   typename TInputMesh::PointIdentifier const * ptIds;
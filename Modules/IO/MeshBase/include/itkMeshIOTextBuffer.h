@@ -0,0 +1,256 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMeshIOTextBuffer_h
+#define itkMeshIOTextBuffer_h
+#include "ITKIOMeshBaseExport.h"
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/**
+ *\class MeshIOTextBuffer
+ * \brief In-memory copy of a text mesh file with fast, parallel
+ * number parsing.
+ *
+ * The ASCII mesh readers load the file with a single read, split it
+ * into ranges of whole lines, and parse the ranges in parallel:
+ * floating point values are converted with the double-conversion
+ * library instead of stream extraction, and each range writes
+ * directly into its part of the buffer provided by the MeshFileReader.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOMeshBase
+ */
+class ITKIOMeshBase_EXPORT MeshIOTextBuffer
+{
+public:
+  /** A [first, second) range of characters. */
+  using RangeType = std::pair<const char *, const char *>;
+
+  /** Reads the file from offset to its end, throwing an ExceptionObject
+   * on failure. */
+  void
+  Load(const std::string & fileName, std::streamoff offset = 0);
+
+  /** Releases the memory of the file. */
+  void
+  Clear();
+
+  const char *
+  GetBegin() const
+  {
+    return m_Buffer.data();
+  }
+
+  const char *
+  GetEnd() const
+  {
+    return m_Buffer.data() + m_Buffer.size();
+  }
+
+  /** Splits [begin, end) into at most numberOfRanges contiguous ranges
+   * which each end after a line break (or at end). A numberOfRanges of
+   * zero chooses a count suitable for the global number of threads. */
+  static std::vector<RangeType>
+  SplitIntoLines(const char * begin, const char * end, unsigned int numberOfRanges = 0);
+
+  /** Skips spaces, tabs, carriage returns and line feeds. */
+  static const char *
+  SkipWhitespace(const char * p, const char * end)
+  {
+    while (p != end && IsWhitespace(*p))
+    {
+      ++p;
+    }
+    return p;
+  }
+
+  /** Skips spaces, tabs and carriage returns, stopping at line feeds. */
+  static const char *
+  SkipBlanks(const char * p, const char * end)
+  {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    {
+      ++p;
+    }
+    return p;
+  }
+
+  /** Returns the beginning of the line following p. */
+  static const char *
+  NextLine(const char * p, const char * end)
+  {
+    while (p != end && *p != '\n')
+    {
+      ++p;
+    }
+    return p == end ? end : p + 1;
+  }
+
+  /** Returns the end of the token starting at p. */
+  static const char *
+  TokenEnd(const char * p, const char * end)
+  {
+    while (p != end && !IsWhitespace(*p))
+    {
+      ++p;
+    }
+    return p;
+  }
+
+  static bool
+  IsWhitespace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+  }
+
+  /** Parses the floating point number at p and advances p past it.
+   * Returns false if p does not start with a number. */
+  static bool
+  ParseDouble(const char *& p, const char * end, double & value);
+
+  /** Parses the, optionally signed, decimal integer at p and advances
+   * p past it. Returns false if p does not start with a digit. */
+  static bool
+  ParseInteger(const char *& p, const char * end, long long & value)
+  {
+    const bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+      ++p;
+    }
+    if (p == end || *p < '0' || *p > '9')
+    {
+      return false;
+    }
+    long long result = 0;
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+      result = result * 10 + (*p - '0');
+      ++p;
+    }
+    value = negative ? -result : result;
+    return true;
+  }
+
+  /** Counts the whitespace separated tokens in [begin, end). */
+  static SizeValueType
+  CountTokens(const char * begin, const char * end);
+
+  /** Parses count whitespace separated numbers starting at begin into
+   * buffer, in parallel, and returns the position after the last
+   * number. The numbers may be laid out on any number of lines. */
+  template <typename T>
+  static const char *
+  ParseNumbers(const char * begin, const char * end, SizeValueType count, T * buffer)
+  {
+    if (count == 0)
+    {
+      return begin;
+    }
+
+    // the tokens of each range are counted first to find where in the
+    // buffer the range writes
+    const std::vector<RangeType> ranges = SplitIntoLines(begin, end);
+    std::vector<SizeValueType>   firstToken(ranges.size() + 1, 0);
+    MultiThreaderBase::Pointer   threader = MultiThreaderBase::New();
+    threader->ParallelizeArray(
+      0,
+      ranges.size(),
+      [&](SizeValueType i) { firstToken[i + 1] = CountTokens(ranges[i].first, ranges[i].second); },
+      nullptr);
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+      firstToken[i + 1] += firstToken[i];
+    }
+    if (firstToken.back() < count)
+    {
+      itkGenericExceptionMacro("Expected " << count << " values but found " << firstToken.back());
+    }
+
+    const char * sectionEnd = end;
+    threader->ParallelizeArray(
+      0,
+      ranges.size(),
+      [&](SizeValueType i) {
+        if (firstToken[i] >= count)
+        {
+          return;
+        }
+        const char *        p = ranges[i].first;
+        const SizeValueType last = std::min(firstToken[i + 1], count);
+        for (SizeValueType k = firstToken[i]; k < last; ++k)
+        {
+          p = SkipWhitespace(p, ranges[i].second);
+          if (!ParseValue(p, ranges[i].second, buffer[k], std::is_integral<T>()))
+          {
+            itkGenericExceptionMacro("Invalid number \"" << std::string(p, TokenEnd(p, ranges[i].second)) << "\"");
+          }
+        }
+        if (last == count)
+        {
+          sectionEnd = p;
+        }
+      },
+      nullptr);
+    return sectionEnd;
+  }
+
+private:
+  /** Integers, such as the point ids of the cells, are parsed exactly,
+   * without a round trip through double. */
+  template <typename T>
+  static bool
+  ParseValue(const char *& p, const char * end, T & value, std::true_type)
+  {
+    long long integer;
+    if (!ParseInteger(p, end, integer))
+    {
+      return false;
+    }
+    value = static_cast<T>(integer);
+    return true;
+  }
+
+  template <typename T>
+  static bool
+  ParseValue(const char *& p, const char * end, T & value, std::false_type)
+  {
+    double real;
+    if (!ParseDouble(p, end, real))
+    {
+      return false;
+    }
+    value = static_cast<T>(real);
+    return true;
+  }
+
+  std::vector<char> m_Buffer;
+};
+} // end namespace itk
+
+#endif
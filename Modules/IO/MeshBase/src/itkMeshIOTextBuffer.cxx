@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMeshIOTextBuffer.h"
+#include "double-conversion/double-conversion.h"
+
+#include <fstream>
+#include <limits>
+
+namespace itk
+{
+void
+MeshIOTextBuffer::Load(const std::string & fileName, std::streamoff offset)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    itkGenericExceptionMacro("Unable to open file " << fileName);
+  }
+
+  file.seekg(0, std::ios::end);
+  const std::streamoff length = static_cast<std::streamoff>(file.tellg()) - offset;
+  if (length < 0)
+  {
+    itkGenericExceptionMacro("Invalid offset " << offset << " in file " << fileName);
+  }
+  file.seekg(offset, std::ios::beg);
+
+  m_Buffer.resize(static_cast<size_t>(length));
+  if (!file.read(m_Buffer.data(), length))
+  {
+    itkGenericExceptionMacro("Unable to read file " << fileName);
+  }
+}
+
+void
+MeshIOTextBuffer::Clear()
+{
+  std::vector<char>().swap(m_Buffer);
+}
+
+std::vector<MeshIOTextBuffer::RangeType>
+MeshIOTextBuffer::SplitIntoLines(const char * begin, const char * end, unsigned int numberOfRanges)
+{
+  const auto length = static_cast<SizeValueType>(end - begin);
+  if (numberOfRanges == 0)
+  {
+    // a few ranges per thread for load balancing, but no tiny ones
+    constexpr SizeValueType minimumRangeLength = 1 << 16;
+    numberOfRanges = static_cast<unsigned int>(
+      std::min<SizeValueType>(4 * MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), length / minimumRangeLength));
+    numberOfRanges = std::max(numberOfRanges, 1u);
+  }
+
+  std::vector<RangeType> ranges;
+  const char *           first = begin;
+  for (unsigned int i = 1; i <= numberOfRanges && first != end; ++i)
+  {
+    const char * last = i == numberOfRanges ? end : NextLine(begin + length * i / numberOfRanges, end);
+    if (last > first)
+    {
+      ranges.emplace_back(first, last);
+      first = last;
+    }
+  }
+  if (ranges.empty())
+  {
+    ranges.emplace_back(begin, end);
+  }
+  return ranges;
+}
+
+bool
+MeshIOTextBuffer::ParseDouble(const char *& p, const char * end, double & value)
+{
+  static const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::NO_FLAGS,
+    0.0,
+    std::numeric_limits<double>::quiet_NaN(),
+    "inf",
+    "nan");
+
+  const char * tokenEnd = TokenEnd(p, end);
+  int          processed = 0;
+  value = converter.StringToDouble(p, static_cast<int>(tokenEnd - p), &processed);
+  if (processed == 0)
+  {
+    return false;
+  }
+  p += processed;
+  return true;
+}
+
+SizeValueType
+MeshIOTextBuffer::CountTokens(const char * begin, const char * end)
+{
+  SizeValueType count = 0;
+  bool          inToken = false;
+  for (const char * p = begin; p != end; ++p)
+  {
+    const bool whitespace = IsWhitespace(*p);
+    count += !whitespace && !inToken;
+    inToken = !whitespace;
+  }
+  return count;
+}
+
+} // end namespace itk
@@ -21,6 +21,7 @@
 #include "ITKIOMeshOBJExport.h"
 
 #include "itkMeshIOBase.h"
+#include "itkMeshIOTextBuffer.h"
 #include "itkNumberToString.h"
 #include <fstream>
 
@@ -187,9 +188,56 @@ protected:
   CloseFile();
 
 private:
+  /** Kinds of lines the reader uses. */
+  enum class LineEnum : uint8_t
+  {
+    OTHER,
+    VERTEX,
+    NORMAL,
+    FACE
+  };
+
+  /** Number of lines of each kind before a range of the file. */
+  struct LineCounts
+  {
+    const char *  m_Begin{ nullptr };
+    const char *  m_End{ nullptr };
+    SizeValueType m_Vertices{ 0 };
+    SizeValueType m_Normals{ 0 };
+    SizeValueType m_Faces{ 0 };
+    SizeValueType m_FacePoints{ 0 };
+  };
+
+  /** Loads the file and counts its lines, once for all the reads
+   * following ReadMeshInformation(), and returns the counts. */
+  const std::vector<LineCounts> &
+  LoadFile();
+
+  /** Releases the loaded file after the last of the buffers announced by
+   * ReadMeshInformation(), whose lines are of the given type, was read. */
+  void
+  ReleaseFile(LineEnum readType);
+
+  /** Splits the file into ranges of lines, counted in parallel. The
+   * last element holds the totals. */
+  static std::vector<LineCounts>
+  CountLines(const MeshIOTextBuffer & text);
+
+  /** Returns the kind of the line starting at p, and moves p past the
+   * keyword. */
+  static LineEnum
+  ParseLineType(const char *& p, const char * end);
+
+  /** Reads the three coordinates of the "v" or "vn" lines. */
+  void
+  ReadVectors(LineEnum type, float * data);
+
   std::ifstream  m_InputFile;
   std::streampos m_PointsStartPosition; // file position for points rlative to
                                         // std::ios::beg
+
+  MeshIOTextBuffer        m_Text;
+  std::vector<LineCounts> m_LineCounts;
 };
 } // end namespace itk
 
@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include "itkOBJMeshIO.h"
+#include "itkMultiThreaderBase.h"
 #include "itkNumericTraits.h"
 #include <itksys/SystemTools.hxx>
 #include <locale>
@@ -128,43 +129,16 @@ OBJMeshIO ::SplitLine(const std::string & line, std::string & type, std::string
 void
 OBJMeshIO ::ReadMeshInformation()
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Read and analyze the first line in the file
-  SizeValueType numberOfCellPoints = 0;
-  this->m_NumberOfPoints = 0;
-  this->m_NumberOfCells = 0;
-  this->m_NumberOfPointPixels = 0;
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
-      {
-        this->m_NumberOfPoints++;
-      }
-      else if (type == "f")
-      {
-        this->m_NumberOfCells++;
-
-        std::stringstream ss(inputLine);
-        std::string       item;
-        while (ss >> item)
-        {
-          numberOfCellPoints++;
-        }
-      }
-      else if (type == "vn")
-      {
-        this->m_NumberOfPointPixels++;
-        this->m_UpdatePointData = true;
-      }
-    }
+  // the file is loaded and counted once for all the reads which follow
+  this->m_LineCounts.clear();
+  const LineCounts & total = this->LoadFile().back();
+
+  this->m_NumberOfPoints = total.m_Vertices;
+  this->m_NumberOfCells = total.m_Faces;
+  this->m_NumberOfPointPixels = total.m_Normals;
+  if (this->m_NumberOfPointPixels)
+  {
+    this->m_UpdatePointData = true;
   }
 
   this->m_PointDimension = 3;
@@ -194,7 +168,7 @@ OBJMeshIO ::ReadMeshInformation()
 
   // Set default cell component type
   this->m_CellComponentType = IOComponentEnum::LONG;
-  this->m_CellBufferSize = this->m_NumberOfCells * 2 + numberOfCellPoints;
+  this->m_CellBufferSize = this->m_NumberOfCells * 2 + total.m_FacePoints;
 
   // Set default point pixel component and point pixel type
   this->m_PointPixelComponentType = IOComponentEnum::FLOAT;
@@ -207,130 +181,234 @@ OBJMeshIO ::ReadMeshInformation()
   this->m_CellPixelType = IOPixelEnum::VECTOR;
   this->m_NumberOfCellPixelComponents = 3;
   this->m_UpdateCellData = false;
-
-  CloseFile();
 }
 
-void
-OBJMeshIO ::ReadPoints(void * buffer)
+const std::vector<OBJMeshIO::LineCounts> &
+OBJMeshIO ::LoadFile()
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
+  if (!this->m_LineCounts.empty())
+  {
+    return this->m_LineCounts;
+  }
 
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
+  if (this->m_FileName.empty())
+  {
+    itkExceptionMacro("No input FileName");
+  }
 
-  // Read and analyze the first line in the file
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
+  if (!itksys::SystemTools::FileExists(m_FileName.c_str()))
   {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
+    itkExceptionMacro("File " << this->m_FileName << " does not exist");
+  }
+
+  this->m_Text.Load(this->m_FileName);
+  this->m_LineCounts = CountLines(this->m_Text);
+  return this->m_LineCounts;
+}
+
+void
+OBJMeshIO ::ReleaseFile(LineEnum readType)
+{
+  // the reader reads the points, then the cells, then the point data
+  const LineEnum lastType =
+    this->m_UpdatePointData ? LineEnum::NORMAL : (this->m_UpdateCells ? LineEnum::FACE : LineEnum::VERTEX);
+  if (readType == lastType)
+  {
+    this->m_Text.Clear();
+    this->m_LineCounts.clear();
+  }
+}
+
+std::vector<OBJMeshIO::LineCounts>
+OBJMeshIO ::CountLines(const MeshIOTextBuffer & text)
+{
+  // the lines of each range are counted in parallel, then accumulated
+  // so that entry i holds the counts before range i and the last entry
+  // the totals
+  const std::vector<MeshIOTextBuffer::RangeType> ranges =
+    MeshIOTextBuffer::SplitIntoLines(text.GetBegin(), text.GetEnd());
+  std::vector<LineCounts> counts(ranges.size() + 1);
+
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  threader->ParallelizeArray(
+    0,
+    ranges.size(),
+    [&](SizeValueType i) {
+      LineCounts & rangeCounts = counts[i + 1];
+      rangeCounts.m_Begin = ranges[i].first;
+      rangeCounts.m_End = ranges[i].second;
+      const char * end = ranges[i].second;
+      for (const char * line = ranges[i].first; line != end; line = MeshIOTextBuffer::NextLine(line, end))
       {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
+        const char * p = line;
+        switch (ParseLineType(p, end))
         {
-          ss >> data[index++];
+          case LineEnum::VERTEX:
+            ++rangeCounts.m_Vertices;
+            break;
+          case LineEnum::NORMAL:
+            ++rangeCounts.m_Normals;
+            break;
+          case LineEnum::FACE:
+            ++rangeCounts.m_Faces;
+            for (p = MeshIOTextBuffer::SkipBlanks(p, end); p != end && *p != '\n';
+                 p = MeshIOTextBuffer::SkipBlanks(MeshIOTextBuffer::TokenEnd(p, end), end))
+            {
+              ++rangeCounts.m_FacePoints;
+            }
+            break;
+          default:
+            break;
         }
       }
-    }
-  }
+    },
+    nullptr);
 
-  CloseFile();
+  for (size_t i = 1; i < counts.size(); ++i)
+  {
+    counts[i - 1].m_Begin = counts[i].m_Begin;
+    counts[i - 1].m_End = counts[i].m_End;
+    counts[i].m_Vertices += counts[i - 1].m_Vertices;
+    counts[i].m_Normals += counts[i - 1].m_Normals;
+    counts[i].m_Faces += counts[i - 1].m_Faces;
+    counts[i].m_FacePoints += counts[i - 1].m_FacePoints;
+  }
+  return counts;
 }
 
-void
-OBJMeshIO ::ReadCells(void * buffer)
+OBJMeshIO::LineEnum
+OBJMeshIO ::ParseLineType(const char *& p, const char * end)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Read and analyze the first line in the file
-  auto *        data = new long[this->m_CellBufferSize - this->m_NumberOfCells];
-  SizeValueType index = 0;
+  // same rules as SplitLine: the keyword must be followed by content
+  p = MeshIOTextBuffer::SkipBlanks(p, end);
+  const char * keyword = p;
+  p = MeshIOTextBuffer::TokenEnd(p, end);
+  const auto   keywordLength = p - keyword;
+  const char * content = MeshIOTextBuffer::SkipBlanks(p, end);
+  if (keywordLength == 0 || content == end || *content == '\n')
+  {
+    return LineEnum::OTHER;
+  }
 
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
+  if (keywordLength == 1 && keyword[0] == 'v')
   {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "f")
+    return LineEnum::VERTEX;
+  }
+  if (keywordLength == 2 && keyword[0] == 'v' && keyword[1] == 'n')
+  {
+    return LineEnum::NORMAL;
+  }
+  if (keywordLength == 1 && keyword[0] == 'f')
+  {
+    return LineEnum::FACE;
+  }
+  return LineEnum::OTHER;
+}
+
+void
+OBJMeshIO ::ReadVectors(LineEnum type, float * data)
+{
+  const std::vector<LineCounts> & counts = this->LoadFile();
+
+  // every range writes the coordinates of its own lines
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  threader->ParallelizeArray(
+    0,
+    counts.size() - 1,
+    [&](SizeValueType i) {
+      SizeValueType index =
+        (type == LineEnum::VERTEX ? counts[i].m_Vertices : counts[i].m_Normals) * this->m_PointDimension;
+      const char * end = counts[i].m_End;
+      for (const char * line = counts[i].m_Begin; line != end; line = MeshIOTextBuffer::NextLine(line, end))
       {
-        std::stringstream ss(inputLine);
-        std::string       item;
-        std::vector<long> idList;
-        while (ss >> item)
+        const char * p = line;
+        if (ParseLineType(p, end) != type)
         {
-          long                   id;
-          std::string::size_type pos = item.find('/');
-          while (pos != std::string::npos)
-          {
-            item.replace(pos, 1, " ");
-            pos = item.find('/', pos);
-          }
-
-          std::stringstream st(item);
-          st >> id;
-
-          idList.push_back(id);
+          continue;
         }
-
-        data[index++] = static_cast<long>(idList.size());
-        for (long it : idList)
+        for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
         {
-          data[index++] = (it - 1);
+          p = MeshIOTextBuffer::SkipBlanks(p, end);
+          double value = 0.0;
+          if (!MeshIOTextBuffer::ParseDouble(p, end, value))
+          {
+            itkExceptionMacro("Invalid coordinate in line \""
+                              << std::string(line, MeshIOTextBuffer::NextLine(line, end)) << "\" of file "
+                              << this->m_FileName);
+          }
+          data[index++] = static_cast<float>(value);
         }
       }
-    }
-  }
-
-  CloseFile();
-
-  this->WriteCellsBuffer(data, static_cast<long *>(buffer), CellGeometryEnum::POLYGON_CELL, this->m_NumberOfCells);
-  // this->WriteCellsBuffer(data, static_cast<unsigned int *>(buffer),
-  // CellGeometryEnum::TRIANGLE_CELL, 3, this->m_NumberOfCells);
-  delete[] data;
+    },
+    nullptr);
+  this->ReleaseFile(type);
 }
 
 void
-OBJMeshIO ::ReadPointData(void * buffer)
+OBJMeshIO ::ReadPoints(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
+  this->ReadVectors(LineEnum::VERTEX, static_cast<float *>(buffer));
+}
 
-  // Read and analyze the first line in the file
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "vn")
+void
+OBJMeshIO ::ReadCells(void * buffer)
+{
+  const std::vector<LineCounts> & counts = this->LoadFile();
+
+  // the cells are written in their final layout, each range starting
+  // after the cells of the previous ranges
+  auto *                     data = static_cast<long *>(buffer);
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  threader->ParallelizeArray(
+    0,
+    counts.size() - 1,
+    [&](SizeValueType i) {
+      SizeValueType index = counts[i].m_Faces * 2 + counts[i].m_FacePoints;
+      auto          numberOfVertices = static_cast<long>(counts[i].m_Vertices);
+      const char *  end = counts[i].m_End;
+      for (const char * line = counts[i].m_Begin; line != end; line = MeshIOTextBuffer::NextLine(line, end))
       {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
+        const char *   p = line;
+        const LineEnum type = ParseLineType(p, end);
+        if (type == LineEnum::VERTEX)
+        {
+          ++numberOfVertices;
+          continue;
+        }
+        if (type != LineEnum::FACE)
         {
-          ss >> data[index++];
+          continue;
         }
+
+        data[index++] = static_cast<long>(CellGeometryEnum::POLYGON_CELL);
+        const SizeValueType numberOfPointsIndex = index++;
+        long                numberOfPoints = 0;
+        for (p = MeshIOTextBuffer::SkipBlanks(p, end); p != end && *p != '\n';
+             p = MeshIOTextBuffer::SkipBlanks(MeshIOTextBuffer::TokenEnd(p, end), end))
+        {
+          // "v", "v/vt", "v//vn" or "v/vt/vn", negative indices being
+          // relative to the last vertex
+          long long    id = 0;
+          const char * token = p;
+          if (!MeshIOTextBuffer::ParseInteger(token, end, id))
+          {
+            itkExceptionMacro("Invalid face in line \"" << std::string(line, MeshIOTextBuffer::NextLine(line, end))
+                                                         << "\" of file " << this->m_FileName);
+          }
+          data[index++] = id < 0 ? numberOfVertices + static_cast<long>(id) : static_cast<long>(id) - 1;
+          ++numberOfPoints;
+        }
+        data[numberOfPointsIndex] = numberOfPoints;
       }
-    }
-  }
+    },
+    nullptr);
+  this->ReleaseFile(LineEnum::FACE);
+}
 
-  CloseFile();
+void
+OBJMeshIO ::ReadPointData(void * buffer)
+{
+  this->ReadVectors(LineEnum::NORMAL, static_cast<float *>(buffer));
 }
 
 void
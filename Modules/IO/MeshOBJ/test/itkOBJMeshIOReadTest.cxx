@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkOBJMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+// Reads an OBJ file with comments, blank lines, unused records and all
+// the forms of face indices.
+int
+itkOBJMeshIOReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFileName" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  {
+    std::ofstream file(argv[1]);
+    file << "# two triangles\n"
+         << "o square\n"
+         << "\n"
+         << "v 0 0 0\n"
+         << "v 1.5 0 -2e-1\n"
+         << "v 1.5 1.25 0\n"
+         << "vn 0 0 1\n"
+         << "vn 0 0.5 1\n"
+         << "vn 0 0 1\n"
+         << "vt 0.5 0.5\n"
+         << "f 1/1/1 2/1/2 3/1/3\n"
+         << "v 0 1.25 0\n"
+         << "vn 1 0 0\n"
+         << "s off\n"
+         << "f 1//1 3//3 -1//4\n"
+         << "f 2 3 4\n";
+  }
+
+  using MeshType = itk::Mesh<itk::Vector<float, 3>, 3>;
+  auto meshIO = itk::OBJMeshIO::New();
+  auto reader = itk::MeshFileReader<MeshType>::New();
+  reader->SetMeshIO(meshIO);
+  reader->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  const MeshType * mesh = reader->GetOutput();
+
+  const float points[4][3] = {
+    { 0.0f, 0.0f, 0.0f }, { 1.5f, 0.0f, -0.2f }, { 1.5f, 1.25f, 0.0f }, { 0.0f, 1.25f, 0.0f }
+  };
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), 4u);
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      ITK_TEST_EXPECT_EQUAL(mesh->GetPoint(i)[j], points[i][j]);
+    }
+  }
+
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), mesh->GetPointData()->Size());
+  MeshType::PixelType normal;
+  ITK_TEST_EXPECT_TRUE(mesh->GetPointData(1, &normal));
+  ITK_TEST_EXPECT_EQUAL(normal[1], 0.5f);
+  ITK_TEST_EXPECT_TRUE(mesh->GetPointData(3, &normal));
+  ITK_TEST_EXPECT_EQUAL(normal[0], 1.0f);
+
+  // negative indices are relative to the last vertex read before the face
+  const std::vector<std::vector<MeshType::PointIdentifier>> cellPoints = { { 0, 1, 2 }, { 0, 2, 3 }, { 1, 2, 3 } };
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), cellPoints.size());
+  for (unsigned int i = 0; i < cellPoints.size(); ++i)
+  {
+    MeshType::CellAutoPointer cell;
+    if (!mesh->GetCell(i, cell) ||
+        !std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), cellPoints[i].begin(), cellPoints[i].end()))
+    {
+      std::cerr << "Unexpected points of face " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -17,11 +17,92 @@
  *=========================================================================*/
 
 #include "itkOFFMeshIO.h"
+#include "itkMeshIOTextBuffer.h"
+#include "itkMultiThreaderBase.h"
 
 #include <itksys/SystemTools.hxx>
+#include <cstring>
 
 namespace itk
 {
+namespace
+{
+/** A range of lines of the body of an ASCII file, with the index of
+ * its first record, a record being a line which is neither empty nor a
+ * comment. */
+struct RecordRange
+{
+  const char *  m_Begin;
+  const char *  m_End;
+  SizeValueType m_FirstRecord;
+};
+
+bool
+IsRecord(const char * line, const char * end)
+{
+  const char * p = MeshIOTextBuffer::SkipBlanks(line, end);
+  return p != end && *p != '\n' && *p != '#';
+}
+
+/** Splits the text into ranges of lines whose records are counted in
+ * parallel. The last element only holds the total number of records. */
+std::vector<RecordRange>
+SplitIntoRecords(const MeshIOTextBuffer & text)
+{
+  const std::vector<MeshIOTextBuffer::RangeType> ranges =
+    MeshIOTextBuffer::SplitIntoLines(text.GetBegin(), text.GetEnd());
+  std::vector<SizeValueType> counts(ranges.size(), 0);
+
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  threader->ParallelizeArray(
+    0,
+    ranges.size(),
+    [&](SizeValueType i) {
+      for (const char * line = ranges[i].first; line != ranges[i].second;
+           line = MeshIOTextBuffer::NextLine(line, ranges[i].second))
+      {
+        counts[i] += IsRecord(line, ranges[i].second);
+      }
+    },
+    nullptr);
+
+  std::vector<RecordRange> records;
+  records.reserve(ranges.size() + 1);
+  SizeValueType firstRecord = 0;
+  for (size_t i = 0; i < ranges.size(); ++i)
+  {
+    records.push_back(RecordRange{ ranges[i].first, ranges[i].second, firstRecord });
+    firstRecord += counts[i];
+  }
+  records.push_back(RecordRange{ text.GetEnd(), text.GetEnd(), firstRecord });
+  return records;
+}
+
+/** Calls lineFunction(recordIndex, p, end) on every record of the
+ * ranges, in parallel, p being past the leading blanks. */
+template <typename TFunction>
+void
+ForEachRecord(const std::vector<RecordRange> & records, TFunction lineFunction)
+{
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  threader->ParallelizeArray(
+    0,
+    records.size() - 1,
+    [&](SizeValueType i) {
+      SizeValueType record = records[i].m_FirstRecord;
+      const char *  end = records[i].m_End;
+      for (const char * line = records[i].m_Begin; line != end; line = MeshIOTextBuffer::NextLine(line, end))
+      {
+        if (IsRecord(line, end))
+        {
+          lineFunction(i, record++, MeshIOTextBuffer::SkipBlanks(line, end), end);
+        }
+      }
+    },
+    nullptr);
+}
+} // end anonymous namespace
+
 OFFMeshIO ::OFFMeshIO()
 {
   this->AddSupportedWriteExtension(".off");
@@ -161,26 +242,44 @@ OFFMeshIO ::ReadMeshInformation()
     // Read points start position in the file
     m_PointsStartPosition = m_InputFile.tellg();
 
-    for (SizeValueType id = 0; id < this->m_NumberOfPoints; id++)
+    // The body is scanned in memory: the cell records give the size of
+    // the cell buffer
+    MeshIOTextBuffer text;
+    text.Load(this->m_FileName, m_PointsStartPosition);
+    const std::vector<RecordRange> records = SplitIntoRecords(text);
+    if (records.back().m_FirstRecord < this->m_NumberOfPoints + this->m_NumberOfCells)
     {
-      std::getline(m_InputFile, line, '\n');
+      itkExceptionMacro(<< "Error, the file contains " << records.back().m_FirstRecord << " records instead of "
+                        << this->m_NumberOfPoints + this->m_NumberOfCells);
     }
 
-    // Set default cell component type
-    this->m_CellBufferSize = this->m_NumberOfCells * 2;
-
-    // Read each ecll's number of points and put them to cell buffer size
-    unsigned int numberOfCellPoints = 0;
-    for (SizeValueType id = 0; id < this->m_NumberOfCells; id++)
-    {
-      m_InputFile >> numberOfCellPoints;
-      this->m_CellBufferSize += numberOfCellPoints;
-      std::getline(m_InputFile, line, '\n');
-
+    std::vector<SizeValueType> cellPoints(records.size(), 0);
+    std::vector<char>          triangles(records.size(), 1);
+    const SizeValueType        firstCell = this->m_NumberOfPoints;
+    const SizeValueType        lastCell = firstCell + this->m_NumberOfCells;
+    ForEachRecord(records, [&](SizeValueType range, SizeValueType record, const char * p, const char * end) {
+      if (record < firstCell || record >= lastCell)
+      {
+        return;
+      }
+      long long numberOfCellPoints = 0;
+      if (!MeshIOTextBuffer::ParseInteger(p, end, numberOfCellPoints) || numberOfCellPoints < 0)
+      {
+        itkExceptionMacro(<< "Error, invalid cell " << record - firstCell);
+      }
+      cellPoints[range] += static_cast<SizeValueType>(numberOfCellPoints);
       if (numberOfCellPoints != 3)
       {
-        m_TriangleCellType = false;
+        triangles[range] = 0;
       }
+    });
+
+    // Set default cell component type
+    this->m_CellBufferSize = this->m_NumberOfCells * 2;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+      this->m_CellBufferSize += cellPoints[i];
+      m_TriangleCellType = m_TriangleCellType && triangles[i];
     }
   }
   // Read points and cells information from binary mesh
@@ -203,28 +302,35 @@ OFFMeshIO ::ReadMeshInformation()
     // Get points start position
     m_PointsStartPosition = m_InputFile.tellg();
 
-    // Read points
-    auto * pointsBuffer = new float[this->m_NumberOfPoints * this->m_PointDimension];
-    this->ReadBufferAsBinary(pointsBuffer, m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
-    delete[] pointsBuffer;
+    // Skip the points, and walk the cells in memory
+    const StreamOffsetType cellsStartPosition =
+      m_PointsStartPosition +
+      static_cast<StreamOffsetType>(this->m_NumberOfPoints * this->m_PointDimension * sizeof(float));
+    MeshIOTextBuffer cells;
+    cells.Load(this->m_FileName, cellsStartPosition);
 
     // Set default cell component type
     this->m_CellBufferSize = this->m_NumberOfCells * 2;
 
-    // Read cells
-    itk::uint32_t numberOfCellPoints = 0;
-    auto *        cellsBuffer = new itk::uint32_t[this->m_NumberOfCells];
+    const char * p = cells.GetBegin();
     for (unsigned long id = 0; id < this->m_NumberOfCells; id++)
     {
-      this->ReadBufferAsBinary(&numberOfCellPoints, m_InputFile, 1);
+      if (cells.GetEnd() - p < static_cast<std::ptrdiff_t>(sizeof(itk::uint32_t)))
+      {
+        itkExceptionMacro(<< "Error, unexpected end of file in cell " << id);
+      }
+      itk::uint32_t numberOfCellPoints;
+      std::memcpy(&numberOfCellPoints, p, sizeof(itk::uint32_t));
+      itk::ByteSwapper<itk::uint32_t>::SwapFromSystemToBigEndian(&numberOfCellPoints);
+      p += sizeof(itk::uint32_t) * (1 + static_cast<size_t>(numberOfCellPoints));
+
       this->m_CellBufferSize += numberOfCellPoints;
-      this->ReadBufferAsBinary(cellsBuffer, m_InputFile, numberOfCellPoints);
       if (numberOfCellPoints != 3)
       {
         m_TriangleCellType = false;
       }
     }
-    delete[] cellsBuffer;
+    m_InputFile.seekg(cellsStartPosition, std::ios::beg);
   }
 
   // Set default point component type
@@ -267,7 +373,27 @@ OFFMeshIO ::ReadPoints(void * buffer)
   // Read file according to ASCII or BINARY
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    this->ReadBufferAsAscii(static_cast<float *>(buffer), m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
+    MeshIOTextBuffer text;
+    text.Load(this->m_FileName, m_PointsStartPosition);
+    const std::vector<RecordRange> records = SplitIntoRecords(text);
+
+    auto * data = static_cast<float *>(buffer);
+    ForEachRecord(records, [&](SizeValueType, SizeValueType record, const char * p, const char * end) {
+      if (record >= this->m_NumberOfPoints)
+      {
+        return;
+      }
+      for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
+      {
+        p = MeshIOTextBuffer::SkipBlanks(p, end);
+        double value = 0.0;
+        if (!MeshIOTextBuffer::ParseDouble(p, end, value))
+        {
+          itkExceptionMacro(<< "Error, invalid coordinate of point " << record);
+        }
+        data[record * this->m_PointDimension + ii] = static_cast<float>(value);
+      }
+    });
   }
   else if (this->m_FileType == IOFileEnum::BINARY)
   {
@@ -283,13 +409,62 @@ OFFMeshIO ::ReadPoints(void * buffer)
 void
 OFFMeshIO ::ReadCells(void * buffer)
 {
-  auto * data = new itk::uint32_t[this->m_CellBufferSize - this->m_NumberOfCells];
+  const CellGeometryEnum cellType =
+    m_TriangleCellType ? CellGeometryEnum::TRIANGLE_CELL : CellGeometryEnum::POLYGON_CELL;
 
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    this->ReadCellsBufferAsAscii(data, m_InputFile);
+    // The cells are parsed directly into the buffer, at the offsets
+    // given by the number of points of the cells of the previous ranges
+    MeshIOTextBuffer text;
+    text.Load(this->m_FileName, m_PointsStartPosition);
+    const std::vector<RecordRange> records = SplitIntoRecords(text);
+
+    const SizeValueType        firstCell = this->m_NumberOfPoints;
+    const SizeValueType        lastCell = firstCell + this->m_NumberOfCells;
+    std::vector<SizeValueType> offsets(records.size(), 0);
+    ForEachRecord(records, [&](SizeValueType range, SizeValueType record, const char * p, const char * end) {
+      long long numberOfCellPoints = 0;
+      if (record >= firstCell && record < lastCell && MeshIOTextBuffer::ParseInteger(p, end, numberOfCellPoints))
+      {
+        offsets[range + 1] += 2 + static_cast<SizeValueType>(numberOfCellPoints);
+      }
+    });
+    for (size_t i = 1; i < offsets.size(); ++i)
+    {
+      offsets[i] += offsets[i - 1];
+    }
+
+    auto * data = static_cast<unsigned int *>(buffer);
+    ForEachRecord(records, [&](SizeValueType range, SizeValueType record, const char * p, const char * end) {
+      if (record < firstCell || record >= lastCell)
+      {
+        return;
+      }
+      SizeValueType & index = offsets[range];
+      long long       numberOfCellPoints = 0;
+      MeshIOTextBuffer::ParseInteger(p, end, numberOfCellPoints);
+      data[index++] = static_cast<unsigned int>(cellType);
+      data[index++] = static_cast<unsigned int>(numberOfCellPoints);
+      for (long long jj = 0; jj < numberOfCellPoints; jj++)
+      {
+        p = MeshIOTextBuffer::SkipBlanks(p, end);
+        long long id = 0;
+        if (!MeshIOTextBuffer::ParseInteger(p, end, id))
+        {
+          itkExceptionMacro(<< "Error, invalid point identifier in cell " << record - firstCell);
+        }
+        data[index++] = static_cast<unsigned int>(id);
+      }
+    });
+
+    CloseFile();
+    return;
   }
-  else if (this->m_FileType == IOFileEnum::BINARY)
+
+  auto * data = new itk::uint32_t[this->m_CellBufferSize - this->m_NumberOfCells];
+
+  if (this->m_FileType == IOFileEnum::BINARY)
   {
     this->ReadBufferAsBinary(data, m_InputFile, this->m_CellBufferSize - this->m_NumberOfCells);
   }
@@ -300,16 +475,7 @@ OFFMeshIO ::ReadCells(void * buffer)
 
   CloseFile();
 
-  if (m_TriangleCellType)
-  {
-    this->WriteCellsBuffer(
-      data, static_cast<unsigned int *>(buffer), CellGeometryEnum::TRIANGLE_CELL, this->m_NumberOfCells);
-  }
-  else
-  {
-    this->WriteCellsBuffer(
-      data, static_cast<unsigned int *>(buffer), CellGeometryEnum::POLYGON_CELL, this->m_NumberOfCells);
-  }
+  this->WriteCellsBuffer(data, static_cast<unsigned int *>(buffer), cellType, this->m_NumberOfCells);
 
   delete[] data;
 }
@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkOFFMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+// Reads an ASCII OFF file with comments and blank lines between the
+// records, and records laid out on several lines.
+int
+itkOFFMeshIOReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFileName" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  {
+    std::ofstream file(argv[1]);
+    file << "OFF\n"
+         << "# a square and a triangle\n"
+         << "5 2 0\n"
+         << "# the points\n"
+         << "0 0 0\n"
+         << "1.5 0 -2e-1\n"
+         << "\n"
+         << "1.5 1.25 0\n"
+         << "  0 1.25 0\n"
+         << "0.75 2.5 0\n"
+         << "# the faces\n"
+         << "4 0 1 2 3\n"
+         << "\n"
+         << "3 3 2 4\n";
+  }
+
+  using MeshType = itk::Mesh<float, 3>;
+  auto reader = itk::MeshFileReader<MeshType>::New();
+  reader->SetMeshIO(itk::OFFMeshIO::New());
+  reader->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  const MeshType * mesh = reader->GetOutput();
+
+  const float points[5][3] = {
+    { 0.0f, 0.0f, 0.0f }, { 1.5f, 0.0f, -0.2f }, { 1.5f, 1.25f, 0.0f }, { 0.0f, 1.25f, 0.0f }, { 0.75f, 2.5f, 0.0f }
+  };
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), 5u);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      ITK_TEST_EXPECT_EQUAL(mesh->GetPoint(i)[j], points[i][j]);
+    }
+  }
+
+  const std::vector<std::vector<MeshType::PointIdentifier>> cellPoints = { { 0, 1, 2, 3 }, { 3, 2, 4 } };
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), cellPoints.size());
+  for (unsigned int i = 0; i < cellPoints.size(); ++i)
+  {
+    MeshType::CellAutoPointer cell;
+    if (!mesh->GetCell(i, cell) ||
+        !std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), cellPoints[i].begin(), cellPoints[i].end()))
+    {
+      std::cerr << "Unexpected points of face " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
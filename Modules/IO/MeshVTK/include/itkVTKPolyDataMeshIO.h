@@ -22,6 +22,7 @@
 #include "itkByteSwapper.h"
 #include "itkMetaDataObject.h"
 #include "itkMeshIOBase.h"
+#include "itkMeshIOTextBuffer.h"
 #include "itkVectorContainer.h"
 #include "itkNumberToString.h"
 
@@ -200,12 +201,14 @@ protected:
 
       if (line.find("POINTS") != std::string::npos)
       {
-        /**  Load the point coordinates into the itk::Mesh */
-        SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        for (SizeValueType ii = 0; ii < numberOfComponents; ii++)
-        {
-          inputFile >> buffer[ii];
-        }
+        /**  Load the point coordinates into the itk::Mesh, parsing the
+         * file in memory */
+        SizeValueType    numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
+        MeshIOTextBuffer text;
+        text.Load(this->m_FileName);
+        const char * points = FindLineAfter(text.GetBegin(), text.GetEnd(), "POINTS");
+        MeshIOTextBuffer::ParseNumbers(points, text.GetEnd(), numberOfComponents, buffer);
+        return;
       }
     }
   }
@@ -229,10 +232,16 @@ protected:
         {
           itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
         }
+        return;
       }
     }
   }
 
+  /** Returns the beginning of the line following the first line of
+   * [begin, end) which contains keyword, or end. */
+  static const char *
+  FindLineAfter(const char * begin, const char * end, const char * keyword);
+
   void
   ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buffer);
 
@@ -19,6 +19,8 @@
 #include "itkVTKPolyDataMeshIO.h"
 
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
 namespace itk
@@ -295,6 +297,14 @@ VTKPolyDataMeshIO ::ReadMeshInformation()
         itkExceptionMacro(<< "Unknown point component type");
       }
 
+      // Skip the binary coordinates instead of scanning them for keywords
+      if (this->m_FileType == IOFileEnum::BINARY)
+      {
+        inputFile.seekg(static_cast<std::streamoff>(this->m_NumberOfPoints * this->m_PointDimension *
+                                                    this->GetComponentSize(this->m_PointComponentType)),
+                        std::ios::cur);
+      }
+
       this->m_UpdatePoints = true;
     }
     else if (line.find("VERTICES") != std::string::npos)
@@ -330,6 +340,12 @@ VTKPolyDataMeshIO ::ReadMeshInformation()
                           << "numberOfVertices= " << numberOfVertices);
       }
 
+      // Skip the binary indices
+      if (this->m_FileType == IOFileEnum::BINARY)
+      {
+        inputFile.seekg(static_cast<std::streamoff>(numberOfVertexIndices * sizeof(unsigned int)), std::ios::cur);
+      }
+
       // Set cell component type
       this->m_CellComponentType = IOComponentEnum::UINT;
       this->m_UpdateCells = true;
@@ -367,6 +383,12 @@ VTKPolyDataMeshIO ::ReadMeshInformation()
                           << "numberOfLines= " << numberOfLines);
       }
 
+      // Skip the binary indices
+      if (this->m_FileType == IOFileEnum::BINARY)
+      {
+        inputFile.seekg(static_cast<std::streamoff>(numberOfLineIndices * sizeof(unsigned int)), std::ios::cur);
+      }
+
       // Set cell component type
       this->m_CellComponentType = IOComponentEnum::UINT;
       this->m_UpdateCells = true;
@@ -404,6 +426,12 @@ VTKPolyDataMeshIO ::ReadMeshInformation()
                           << "numberOfPolygons= " << numberOfPolygons);
       }
 
+      // Skip the binary indices
+      if (this->m_FileType == IOFileEnum::BINARY)
+      {
+        inputFile.seekg(static_cast<std::streamoff>(numberOfPolygonIndices * sizeof(unsigned int)), std::ios::cur);
+      }
+
       // Set cell component type
       this->m_CellComponentType = IOComponentEnum::UINT;
       this->m_UpdateCells = true;
@@ -845,69 +873,65 @@ VTKPolyDataMeshIO ::ReadCells(void * buffer)
   inputFile.close();
 }
 
-void
-VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buffer)
+const char *
+VTKPolyDataMeshIO::FindLineAfter(const char * begin, const char * end, const char * keyword)
 {
-  std::string   line;
-  SizeValueType index = 0;
-  unsigned int  numPoints; // number of point in each cell
+  const size_t keywordLength = std::strlen(keyword);
+  for (const char * line = begin; line != end;)
+  {
+    const char * next = MeshIOTextBuffer::NextLine(line, end);
+    if (std::search(line, next, keyword, keyword + keywordLength) != next)
+    {
+      return next;
+    }
+    line = next;
+  }
+  return end;
+}
 
+void
+VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & itkNotUsed(inputFile), void * buffer)
+{
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
   using GeometryIntegerType = unsigned int;
   auto * data = static_cast<GeometryIntegerType *>(buffer);
 
-  while (!inputFile.eof())
-  {
-    std::getline(inputFile, line, '\n');
-    if (line.find("VERTICES") != std::string::npos)
+  // The sections are located in memory, and the indices of each one are
+  // parsed in parallel before being laid out as cells in the buffer
+  MeshIOTextBuffer text;
+  text.Load(this->m_FileName);
+
+  const struct
+  {
+    const char *     keyword;
+    const char *     numberOfCellsKey;
+    const char *     numberOfIndicesKey;
+    CellGeometryEnum cellType;
+  } sections[] = { { "VERTICES", "numberOfVertices", "numberOfVertexIndices", CellGeometryEnum::VERTEX_CELL },
+                   { "LINES", "numberOfLines", "numberOfLineIndices", CellGeometryEnum::LINE_CELL },
+                   { "POLYGONS", "numberOfPolygons", "numberOfPolygonIndices", CellGeometryEnum::POLYGON_CELL } };
+
+  SizeValueType             index = 0;
+  std::vector<unsigned int> indices;
+  for (const auto & section : sections)
+  {
+    unsigned int numberOfCells = 0;
+    unsigned int numberOfIndices = 0;
+    if (!ExposeMetaData<unsigned int>(metaDic, section.numberOfCellsKey, numberOfCells) ||
+        !ExposeMetaData<unsigned int>(metaDic, section.numberOfIndicesKey, numberOfIndices))
     {
-      unsigned int numberOfVertices = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfVertices", numberOfVertices);
-
-      for (unsigned int ii = 0; ii < numberOfVertices; ii++)
-      {
-        inputFile >> numPoints;
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::VERTEX_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
+      continue;
     }
-    else if (line.find("LINES") != std::string::npos)
-    {
-      unsigned int numberOfLines = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfLines", numberOfLines);
 
-      for (unsigned int ii = 0; ii < numberOfLines; ii++)
-      {
-        inputFile >> numPoints;
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::LINE_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
-    }
-    else if (line.find("POLYGONS") != std::string::npos)
+    const char * begin = FindLineAfter(text.GetBegin(), text.GetEnd(), section.keyword);
+    if (begin == text.GetEnd())
     {
-      unsigned int numberOfPolygons = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfPolygons", numberOfPolygons);
-
-      for (unsigned int ii = 0; ii < numberOfPolygons; ii++)
-      {
-        inputFile >> numPoints;
-
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::POLYGON_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
+      continue;
     }
+    indices.resize(numberOfIndices);
+    MeshIOTextBuffer::ParseNumbers(begin, text.GetEnd(), numberOfIndices, indices.data());
+    this->WriteCellsBuffer(indices.data(), data + index, section.cellType, numberOfCells);
+    index += numberOfIndices + numberOfCells;
   }
 }
 
@@ -927,7 +951,10 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
   std::string          line;
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
 
-  while (!inputFile.eof())
+  // Stop once all the cells are read, rather than scanning the binary
+  // point and cell data for keywords
+  const unsigned int * outputEnd = outputBuffer + this->m_CellBufferSize;
+  while (!inputFile.eof() && outputBuffer != outputEnd)
   {
     std::getline(inputFile, line, '\n');
     if (line.find("VERTICES") != std::string::npos)
@@ -946,7 +973,7 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
       }
       this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::VERTEX_CELL, numberOfVertices);
       startBuffer += numberOfVertexIndices * sizeof(unsigned int);
-      outputBuffer += (numberOfVertexIndices + numberOfVertices) * sizeof(unsigned int);
+      outputBuffer += numberOfVertexIndices + numberOfVertices;
     }
     else if (line.find("LINES") != std::string::npos)
     {
@@ -964,7 +991,7 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
       }
       this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::LINE_CELL, numberOfLines);
       startBuffer += numberOfLineIndices * sizeof(unsigned int);
-      outputBuffer += (numberOfLineIndices + numberOfLines) * sizeof(unsigned int);
+      outputBuffer += numberOfLineIndices + numberOfLines;
     }
     else if (line.find("POLYGONS") != std::string::npos)
     {
@@ -983,7 +1010,7 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
 
       this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::POLYGON_CELL, numberOfPolygons);
       startBuffer += numberOfPolygonIndices * sizeof(unsigned int);
-      outputBuffer += (numberOfPolygonIndices + numberOfPolygons) * sizeof(unsigned int);
+      outputBuffer += numberOfPolygonIndices + numberOfPolygons;
     }
   }
 
@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkByteSwapper.h"
+#include "itkLineCell.h"
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkPolygonCell.h"
+#include "itkTestingMacros.h"
+#include "itkTriangleCell.h"
+#include "itkVertexCell.h"
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+// Reads a mesh made of vertices, lines and polygons from ASCII and from
+// BINARY polydata: the cells are read from the VERTICES, LINES and
+// POLYGONS sections of the file.
+int
+itkVTKPolyDataMeshReadWriteCellsTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFileName" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using MeshType = itk::Mesh<float, 3>;
+  using CellType = MeshType::CellType;
+  using CellAutoPointer = CellType::CellAutoPointer;
+
+  auto mesh = MeshType::New();
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    MeshType::PointType point;
+    point[0] = i;
+    point[1] = 0.5f * i * i;
+    point[2] = -1.0f * i;
+    mesh->SetPoint(i, point);
+  }
+
+  // the cells are listed in the order of the sections of the file
+  const std::vector<std::vector<MeshType::PointIdentifier>> cellPoints = {
+    { 4 }, { 3 }, { 0, 1 }, { 1, 3 }, { 0, 1, 2 }, { 1, 2, 3, 4 }
+  };
+  for (unsigned int i = 0; i < cellPoints.size(); ++i)
+  {
+    CellAutoPointer cell;
+    switch (cellPoints[i].size())
+    {
+      case 1:
+        cell.TakeOwnership(new itk::VertexCell<CellType>);
+        break;
+      case 2:
+        cell.TakeOwnership(new itk::LineCell<CellType>);
+        break;
+      case 3:
+        cell.TakeOwnership(new itk::TriangleCell<CellType>);
+        break;
+      default:
+        cell.TakeOwnership(new itk::PolygonCell<CellType>(4));
+        break;
+    }
+    cell->SetPointIds(cellPoints[i].data());
+    mesh->SetCell(i, cell);
+  }
+
+  // the mesh is written as ASCII, while the BINARY file is written by
+  // hand: the binary writer only writes meshes of a single kind of cells
+  {
+    auto writer = itk::MeshFileWriter<MeshType>::New();
+    writer->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+    writer->SetFileName(argv[1]);
+    writer->SetInput(mesh);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+  const std::string binaryFileName = std::string(argv[1]) + ".binary.vtk";
+  {
+    std::ofstream file(binaryFileName.c_str(), std::ios::binary);
+    file << "# vtk DataFile Version 2.0\n"
+         << "Vertices, lines and polygons\n"
+         << "BINARY\n"
+         << "DATASET POLYDATA\n"
+         << "POINTS 5 float\n";
+    std::vector<float> coordinates;
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      const MeshType::PointType point = mesh->GetPoint(i);
+      coordinates.insert(coordinates.end(), point.Begin(), point.End());
+    }
+    itk::ByteSwapper<float>::SwapWriteRangeFromSystemToBigEndian(coordinates.data(), coordinates.size(), &file);
+    const auto writeSection = [&file](const char * header, std::vector<unsigned int> indices) {
+      file << "\n" << header << "\n";
+      itk::ByteSwapper<unsigned int>::SwapWriteRangeFromSystemToBigEndian(indices.data(), indices.size(), &file);
+    };
+    writeSection("VERTICES 2 4", { 1, 4, 1, 3 });
+    writeSection("LINES 1 4", { 3, 0, 1, 3 });
+    writeSection("POLYGONS 2 9", { 3, 0, 1, 2, 4, 1, 2, 3, 4 });
+    file << "\n";
+  }
+
+  for (const bool binary : { false, true })
+  {
+    auto reader = itk::MeshFileReader<MeshType>::New();
+    reader->SetMeshIO(itk::VTKPolyDataMeshIO::New());
+    reader->SetFileName(binary ? binaryFileName : std::string(argv[1]));
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    const MeshType * output = reader->GetOutput();
+
+    ITK_TEST_EXPECT_EQUAL(output->GetNumberOfPoints(), mesh->GetNumberOfPoints());
+    ITK_TEST_EXPECT_EQUAL(output->GetNumberOfCells(), mesh->GetNumberOfCells());
+    for (unsigned int i = 0; i < cellPoints.size(); ++i)
+    {
+      CellAutoPointer expectedCell;
+      CellAutoPointer cell;
+      mesh->GetCell(i, expectedCell);
+      if (!output->GetCell(i, cell) || cell->GetType() != expectedCell->GetType() ||
+          !std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), cellPoints[i].begin(), cellPoints[i].end()))
+      {
+        std::cerr << "Cell " << i << " of the " << (binary ? "BINARY" : "ASCII") << " file was not read back"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      ITK_TEST_EXPECT_EQUAL(output->GetPoint(i), mesh->GetPoint(i));
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 
 
 #include <fstream>
+#include <memory>
 #include "itkImageIOBase.h"
 #include "itkSingletonMacro.h"
 #include "itkMetaDataObject.h"
@@ -78,7 +79,13 @@ public:
   void
   ReadImageInformation() override;
 
-  /** Reads the data from disk into the memory buffer provided. */
+  /** Reads the data from disk into the memory buffer provided.
+   *
+   * Binary data stored as one file per slice (`ElementDataFile = LIST` or a
+   * slice file name pattern) are read in parallel, and compressed data are
+   * inflated directly into the buffer. When streaming compressed data, the
+   * points at which inflation can be resumed are remembered so that later
+   * regions do not need to inflate the data from its beginning. */
   void
   Read(void * buffer) override;
 
@@ -195,8 +202,29 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
+  /** Read all the binary element data of the image into buffer when they are
+   * stored as slice files or as a compressed stream. Returns false when the
+   * data layout is left to MetaIO. */
+  bool
+  ReadElementData(void * buffer);
+
+  /** Read the slice files listed by a `LIST` or a file name pattern in parallel. */
+  bool
+  ReadSliceFiles(void * buffer);
+
+  /** Read the current IO region of a compressed stream through the seek
+   * index. Returns false when the data layout is left to MetaIO. */
+  bool
+  ReadCompressedRegion(void * buffer);
+
+  /** Offset table of a compressed data stream, together with the state of the
+   * inflation in progress, kept between streamed reads. */
+  struct CompressedDataSeekIndex;
+
   MetaImage m_MetaImage;
 
+  std::unique_ptr<CompressedDataSeekIndex> m_CompressedDataSeekIndex;
+
   unsigned int m_SubSamplingFactor;
 
   static unsigned int * m_DefaultDoublePrecision;
@@ -21,10 +21,334 @@
 #include "itkIOCommon.h"
 #include "itksys/SystemTools.hxx"
 #include "itkMath.h"
+#include "itkMultiThreaderBase.h"
 #include "itkSingleton.h"
+#include "itkThreadPool.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <sstream>
 
 namespace itk
 {
+namespace
+{
+// Number of bytes of compressed data read from a file at a time.
+constexpr std::streamoff compressedChunkSize = 1 << 20;
+
+// Minimal number of uncompressed bytes between two points of a seek index.
+constexpr std::streamoff seekPointSpacing = 1 << 20;
+
+// Size of the deflate history needed to resume inflation at a seek point.
+constexpr unsigned int deflateWindowSize = 32768;
+
+bool
+IsLocalDataFile(const std::string & dataFileName)
+{
+  return dataFileName == "Local" || dataFileName == "LOCAL" || dataFileName == "local";
+}
+
+// Data file names are relative to the directory of the header, unless absolute.
+std::string
+GetDataFilePath(const std::string & headerFileName, const std::string & dataFileName)
+{
+  const std::string headerPath = itksys::SystemTools::GetFilenamePath(headerFileName);
+  if (headerPath.empty() || itksys::SystemTools::FileIsFullPath(dataFileName))
+  {
+    return dataFileName;
+  }
+  return headerPath + '/' + dataFileName;
+}
+
+// Position the stream after the ElementDataFile line of a MetaImage header,
+// which is where the list of slice files or the local data start.
+bool
+SkipHeader(std::ifstream & stream)
+{
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    const std::string::size_type first = line.find_first_not_of(" \t");
+    if (first != std::string::npos && line.compare(first, 15, "ElementDataFile") == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Inflate a zlib or gzip stream, starting at the current position of the
+// file, directly into buffer.
+bool
+InflateFile(std::ifstream & file, unsigned char * buffer, std::streamoff size)
+{
+  z_stream stream{};
+  if (inflateInit2(&stream, 47) != Z_OK) // accept both zlib and gzip headers
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> input(static_cast<size_t>(compressedChunkSize));
+  std::streamoff             remaining = size;
+  int                        status = Z_OK;
+  stream.next_out = buffer;
+  while (status != Z_STREAM_END && (remaining > 0 || stream.avail_out > 0))
+  {
+    if (stream.avail_in == 0)
+    {
+      file.read(reinterpret_cast<char *>(input.data()), compressedChunkSize);
+      if (file.gcount() <= 0)
+      {
+        break;
+      }
+      stream.next_in = input.data();
+      stream.avail_in = static_cast<uInt>(file.gcount());
+    }
+    if (stream.avail_out == 0)
+    {
+      const auto available = static_cast<uInt>(std::min<std::streamoff>(remaining, 1 << 30));
+      stream.avail_out = available;
+      remaining -= available;
+    }
+    status = inflate(&stream, Z_NO_FLUSH);
+    if (status != Z_OK && status != Z_STREAM_END && !(status == Z_BUF_ERROR && stream.avail_in == 0))
+    {
+      break;
+    }
+  }
+  const bool complete = remaining == 0 && stream.avail_out == 0;
+  inflateEnd(&stream);
+  return complete;
+}
+
+// Read the element data of one slice file, which may start with a header of
+// headerSize bytes (-1 meaning that the data are at the end of the file).
+bool
+ReadDataFile(const std::string & fileName,
+             int                 headerSize,
+             bool                compressed,
+             unsigned char *     buffer,
+             std::streamoff      size)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+  if (headerSize > 0)
+  {
+    file.seekg(headerSize, std::ios::beg);
+  }
+  else if (headerSize == -1 && !compressed)
+  {
+    file.seekg(-size, std::ios::end);
+  }
+  if (compressed)
+  {
+    return InflateFile(file, buffer, size);
+  }
+  file.read(reinterpret_cast<char *>(buffer), size);
+  return file.gcount() == size;
+}
+} // namespace
+
+/** The seek index records, at deflate block boundaries spaced by at least
+ * seekPointSpacing uncompressed bytes, the offsets in the compressed and
+ * uncompressed data together with the history window needed to resume
+ * inflation there, as described in zlib's examples/zran.c. It grows as the
+ * stream is inflated, so a read only inflates from the closest preceding seek
+ * point, or continues from where the previous read stopped. */
+struct MetaImageIO::CompressedDataSeekIndex
+{
+  struct SeekPoint
+  {
+    std::streamoff             m_UncompressedOffset;
+    std::streamoff             m_CompressedOffset;
+    int                        m_Bits;
+    std::vector<unsigned char> m_Window;
+  };
+
+  CompressedDataSeekIndex(std::string fileName, std::streamoff dataOffset)
+    : m_FileName(std::move(fileName))
+    , m_DataOffset(dataOffset)
+    , m_Window(deflateWindowSize)
+    , m_Input(static_cast<size_t>(compressedChunkSize))
+  {}
+
+  ~CompressedDataSeekIndex()
+  {
+    if (m_Inflating)
+    {
+      inflateEnd(&m_Stream);
+    }
+  }
+
+  /** Inflate the size bytes found at offset in the uncompressed data. */
+  bool
+  Read(std::streamoff offset, std::streamoff size, unsigned char * buffer);
+
+  std::string    m_FileName;
+  std::streamoff m_DataOffset;
+
+private:
+  bool
+  StartAt(const SeekPoint * point);
+
+  std::vector<SeekPoint>     m_SeekPoints;
+  std::ifstream              m_File;
+  z_stream                   m_Stream{};
+  bool                       m_Inflating{ false };
+  std::streamoff             m_UncompressedPosition{ 0 };
+  std::streamoff             m_CompressedPosition{ 0 };
+  std::vector<unsigned char> m_Window;
+  unsigned int               m_WindowFill{ 0 };
+  std::vector<unsigned char> m_Input;
+};
+
+bool
+MetaImageIO::CompressedDataSeekIndex::StartAt(const SeekPoint * point)
+{
+  if (m_Inflating)
+  {
+    inflateEnd(&m_Stream);
+    m_Inflating = false;
+  }
+  if (!m_File.is_open())
+  {
+    m_File.open(m_FileName.c_str(), std::ios::in | std::ios::binary);
+    if (!m_File.is_open())
+    {
+      return false;
+    }
+  }
+  m_File.clear();
+  m_Stream = z_stream{};
+
+  if (point == nullptr)
+  {
+    if (inflateInit2(&m_Stream, 47) != Z_OK)
+    {
+      return false;
+    }
+    m_Inflating = true;
+    m_File.seekg(m_DataOffset, std::ios::beg);
+    m_CompressedPosition = m_DataOffset;
+    m_UncompressedPosition = 0;
+    std::fill(m_Window.begin(), m_Window.end(), 0);
+  }
+  else
+  {
+    // Seek points are inside the deflate data, past the zlib or gzip header
+    if (inflateInit2(&m_Stream, -15) != Z_OK)
+    {
+      return false;
+    }
+    m_Inflating = true;
+    m_CompressedPosition = point->m_CompressedOffset;
+    m_File.seekg(m_CompressedPosition - (point->m_Bits ? 1 : 0), std::ios::beg);
+    if (point->m_Bits)
+    {
+      const int byte = m_File.get();
+      if (byte == std::char_traits<char>::eof())
+      {
+        return false;
+      }
+      inflatePrime(&m_Stream, point->m_Bits, byte >> (8 - point->m_Bits));
+    }
+    inflateSetDictionary(&m_Stream, point->m_Window.data(), deflateWindowSize);
+    m_UncompressedPosition = point->m_UncompressedOffset;
+    m_Window = point->m_Window;
+  }
+  m_WindowFill = 0;
+  return m_File.good();
+}
+
+bool
+MetaImageIO::CompressedDataSeekIndex::Read(std::streamoff offset, std::streamoff size, unsigned char * buffer)
+{
+  const auto next = std::upper_bound(
+    m_SeekPoints.cbegin(), m_SeekPoints.cend(), offset, [](std::streamoff value, const SeekPoint & point) {
+      return value < point.m_UncompressedOffset;
+    });
+  const SeekPoint * closest = next == m_SeekPoints.cbegin() ? nullptr : &*(next - 1);
+
+  if (!m_Inflating || offset < m_UncompressedPosition ||
+      (closest != nullptr && closest->m_UncompressedOffset > m_UncompressedPosition))
+  {
+    if (!this->StartAt(closest))
+    {
+      return false;
+    }
+  }
+
+  const std::streamoff end = offset + size;
+  while (m_UncompressedPosition < end)
+  {
+    if (m_Stream.avail_in == 0)
+    {
+      m_File.read(reinterpret_cast<char *>(m_Input.data()), compressedChunkSize);
+      if (m_File.gcount() <= 0)
+      {
+        return false;
+      }
+      m_Stream.next_in = m_Input.data();
+      m_Stream.avail_in = static_cast<uInt>(m_File.gcount());
+      m_CompressedPosition += m_File.gcount();
+    }
+
+    // The output cycles through the history window; stop at the end of the
+    // requested data so that the next read can continue from there.
+    if (m_WindowFill == deflateWindowSize)
+    {
+      m_WindowFill = 0;
+    }
+    const auto available = static_cast<unsigned int>(
+      std::min<std::streamoff>(deflateWindowSize - m_WindowFill, end - m_UncompressedPosition));
+    m_Stream.next_out = m_Window.data() + m_WindowFill;
+    m_Stream.avail_out = available;
+
+    const int status = inflate(&m_Stream, Z_BLOCK);
+    if (status != Z_OK && status != Z_STREAM_END && !(status == Z_BUF_ERROR && m_Stream.avail_in == 0))
+    {
+      return false;
+    }
+
+    const std::streamoff produced = available - m_Stream.avail_out;
+    const std::streamoff first = std::max(offset, m_UncompressedPosition);
+    const std::streamoff last = std::min(end, m_UncompressedPosition + produced);
+    if (first < last)
+    {
+      std::copy_n(
+        m_Window.data() + m_WindowFill + (first - m_UncompressedPosition), last - first, buffer + (first - offset));
+    }
+    m_WindowFill += static_cast<unsigned int>(produced);
+    m_UncompressedPosition += produced;
+
+    if (status == Z_STREAM_END)
+    {
+      inflateEnd(&m_Stream);
+      m_Inflating = false;
+      break;
+    }
+
+    // Bit 7 of data_type flags the end of a deflate block, bit 6 the last one.
+    const std::streamoff lastSeekPoint = m_SeekPoints.empty() ? 0 : m_SeekPoints.back().m_UncompressedOffset;
+    if ((m_Stream.data_type & 128) && !(m_Stream.data_type & 64) &&
+        m_UncompressedPosition >= lastSeekPoint + seekPointSpacing)
+    {
+      SeekPoint point;
+      point.m_UncompressedOffset = m_UncompressedPosition;
+      point.m_CompressedOffset = m_CompressedPosition - m_Stream.avail_in;
+      point.m_Bits = m_Stream.data_type & 7;
+      point.m_Window.reserve(deflateWindowSize);
+      point.m_Window.insert(point.m_Window.end(), m_Window.cbegin() + m_WindowFill, m_Window.cend());
+      point.m_Window.insert(point.m_Window.end(), m_Window.cbegin(), m_Window.cbegin() + m_WindowFill);
+      m_SeekPoints.push_back(std::move(point));
+    }
+  }
+  return m_UncompressedPosition >= end;
+}
+
 // Explicitly set std::numeric_limits<double>::max_digits10 this will provide
 // better accuracy when writing out floating point number in MetaImage header.
 itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
@@ -95,6 +419,8 @@ MetaImageIO::CanReadFile(const char * filename)
 void
 MetaImageIO::ReadImageInformation()
 {
+  m_CompressedDataSeekIndex.reset();
+
   if (!m_MetaImage.Read(m_FileName.c_str(), false))
   {
     itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
@@ -448,7 +774,15 @@ MetaImageIO::Read(void * buffer)
     largestRegion.SetSize(i, this->GetDimensions(i));
   }
 
-  if (largestRegion != m_IORegion)
+  if (largestRegion != m_IORegion && this->ReadCompressedRegion(buffer))
+  {
+    // the swap flips the byte order of the header, which is not read again
+    const bool byteOrderMSB = m_MetaImage.BinaryDataByteOrderMSB();
+    m_MetaImage.ElementData(buffer, false);
+    m_MetaImage.ElementByteOrderFix(m_IORegion.GetNumberOfPixels());
+    m_MetaImage.BinaryDataByteOrderMSB(byteOrderMSB);
+  }
+  else if (largestRegion != m_IORegion)
   {
     auto * indexMin = new int[nDims];
     auto * indexMax = new int[nDims];
@@ -480,6 +814,14 @@ MetaImageIO::Read(void * buffer)
 
     m_MetaImage.ElementByteOrderFix(m_IORegion.GetNumberOfPixels());
   }
+  else if (this->ReadElementData(buffer))
+  {
+    // the swap flips the byte order of the header, which is not read again
+    const bool byteOrderMSB = m_MetaImage.BinaryDataByteOrderMSB();
+    m_MetaImage.ElementData(buffer, false);
+    m_MetaImage.ElementByteOrderFix(this->GetImageSizeInPixels());
+    m_MetaImage.BinaryDataByteOrderMSB(byteOrderMSB);
+  }
   else
   {
     if (!m_MetaImage.Read(m_FileName.c_str(), true, buffer))
@@ -493,6 +835,275 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::ReadElementData(void * buffer)
+{
+  if (!m_MetaImage.BinaryData())
+  {
+    return false;
+  }
+
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  if (dataFileName.compare(0, 4, "LIST") == 0 || dataFileName.find('%') != std::string::npos)
+  {
+    return this->ReadSliceFiles(buffer);
+  }
+  if (!m_MetaImage.CompressedData() || m_MetaImage.HeaderSize() == -1)
+  {
+    return false;
+  }
+
+  // Inflate from the file instead of reading all the compressed data first
+  std::ifstream file;
+  if (IsLocalDataFile(dataFileName))
+  {
+    file.open(m_FileName.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open() || !SkipHeader(file))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    file.open(GetDataFilePath(m_FileName, dataFileName).c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+      return false;
+    }
+  }
+  if (m_MetaImage.HeaderSize() > 0)
+  {
+    file.seekg(m_MetaImage.HeaderSize(), std::ios::beg);
+  }
+  if (!InflateFile(file, static_cast<unsigned char *>(buffer), this->GetImageSizeInBytes()))
+  {
+    itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
+                                              << "Reason: the compressed data is invalid or truncated");
+  }
+  return true;
+}
+
+bool
+MetaImageIO::ReadSliceFiles(void * buffer)
+{
+  const unsigned int nDims = this->GetNumberOfDimensions();
+  const std::string  dataFileName = m_MetaImage.ElementDataFileName();
+
+  std::vector<std::string> words;
+  std::istringstream       wordStream(dataFileName);
+  for (std::string word; wordStream >> word;)
+  {
+    words.push_back(word);
+  }
+
+  std::vector<std::string> sliceFileNames;
+  SizeValueType            numberOfSlices = 1;
+  if (dataFileName.compare(0, 4, "LIST") == 0)
+  {
+    // The files of the slices, of dimension fileImageDim, follow the header
+    unsigned int fileImageDim = nDims - 1;
+    if (words.size() > 1)
+    {
+      const int dim = std::atoi(words[1].c_str());
+      if (dim > 0 && static_cast<unsigned int>(dim) <= nDims)
+      {
+        fileImageDim = static_cast<unsigned int>(dim);
+      }
+    }
+    for (unsigned int i = fileImageDim; i < nDims; ++i)
+    {
+      numberOfSlices *= this->GetDimensions(i);
+    }
+
+    std::ifstream header(m_FileName.c_str());
+    if (!header.is_open() || !SkipHeader(header))
+    {
+      return false;
+    }
+    std::string line;
+    while (sliceFileNames.size() < numberOfSlices && std::getline(header, line))
+    {
+      const std::string::size_type last = line.find_last_not_of(" \t\r\n");
+      if (last == std::string::npos)
+      {
+        continue;
+      }
+      sliceFileNames.push_back(GetDataFilePath(m_FileName, line.substr(0, last + 1)));
+    }
+  }
+  else
+  {
+    // A printf pattern, optionally followed by the first index, the last
+    // index and the step; the pattern itself may contain spaces.
+    numberOfSlices = this->GetDimensions(nDims - 1);
+    std::string pattern = words.empty() ? dataFileName : words[0];
+    int         minV = 1;
+    int         maxV = static_cast<int>(numberOfSlices);
+    int         stepV = 1;
+    if (words.size() >= 5)
+    {
+      for (size_t i = 1; i < words.size() - 3; ++i)
+      {
+        pattern += ' ' + words[i];
+      }
+      minV = std::atoi(words[words.size() - 3].c_str());
+      maxV = std::atoi(words[words.size() - 2].c_str());
+      stepV = std::atoi(words[words.size() - 1].c_str());
+    }
+    else
+    {
+      if (words.size() >= 2)
+      {
+        minV = std::atoi(words[1].c_str());
+        maxV = minV + static_cast<int>(numberOfSlices) - 1;
+      }
+      if (words.size() >= 3)
+      {
+        maxV = std::atoi(words[2].c_str());
+        stepV = (maxV - minV) / static_cast<int>(numberOfSlices);
+      }
+      if (words.size() >= 4)
+      {
+        stepV = std::atoi(words[3].c_str());
+      }
+    }
+    if (stepV <= 0)
+    {
+      return false;
+    }
+    for (int i = minV; i <= maxV && sliceFileNames.size() < numberOfSlices; i += stepV)
+    {
+      sliceFileNames.push_back(GetDataFilePath(m_FileName, string_format(pattern, i)));
+    }
+  }
+  if (sliceFileNames.size() < numberOfSlices)
+  {
+    itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
+                                              << "Reason: " << sliceFileNames.size() << " slice files are listed for "
+                                              << numberOfSlices << " slices");
+  }
+
+  // Each slice file is read by its own work unit directly into its part of
+  // the buffer. A thread of the pool, e.g. when ImageSeriesReader reads
+  // slices in parallel, must not wait for work added to the pool: it reads
+  // the files with a single work unit, run by the calling thread.
+  const auto                 sliceSize = static_cast<std::streamoff>(this->GetImageSizeInBytes() / numberOfSlices);
+  const int                  headerSize = m_MetaImage.HeaderSize();
+  const bool                 compressed = m_MetaImage.CompressedData();
+  auto *                     data = static_cast<unsigned char *>(buffer);
+  std::vector<unsigned char> succeeded(sliceFileNames.size(), 0);
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  if (ThreadPool::IsPoolThread())
+  {
+    threader->SetNumberOfWorkUnits(1);
+  }
+  threader->ParallelizeArray(
+    0,
+    static_cast<SizeValueType>(sliceFileNames.size()),
+    [&](SizeValueType i) {
+      succeeded[i] = ReadDataFile(sliceFileNames[i], headerSize, compressed, data + i * sliceSize, sliceSize);
+    },
+    nullptr);
+
+  for (size_t i = 0; i < sliceFileNames.size(); ++i)
+  {
+    if (!succeeded[i])
+    {
+      itkExceptionMacro("File cannot be read: " << sliceFileNames[i] << " for reading." << std::endl
+                                                << "Reason: " << itksys::SystemTools::GetLastSystemError());
+    }
+  }
+  return true;
+}
+
+bool
+MetaImageIO::ReadCompressedRegion(void * buffer)
+{
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  if (!m_MetaImage.BinaryData() || !m_MetaImage.CompressedData() || m_MetaImage.HeaderSize() == -1 ||
+      m_SubSamplingFactor != 1 || dataFileName.compare(0, 4, "LIST") == 0 ||
+      dataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+
+  if (!m_CompressedDataSeekIndex)
+  {
+    std::string    fileName = m_FileName;
+    std::streamoff dataOffset = m_MetaImage.HeaderSize();
+    if (!IsLocalDataFile(dataFileName))
+    {
+      fileName = GetDataFilePath(m_FileName, dataFileName);
+    }
+    else if (dataOffset == 0)
+    {
+      std::ifstream header(fileName.c_str(), std::ios::in | std::ios::binary);
+      if (!header.is_open() || !SkipHeader(header))
+      {
+        return false;
+      }
+      dataOffset = header.tellg();
+    }
+    m_CompressedDataSeekIndex = std::make_unique<CompressedDataSeekIndex>(fileName, dataOffset);
+  }
+
+  // Read the region as runs of pixels that are contiguous in the file
+  const unsigned int nDims = this->GetNumberOfDimensions();
+  const auto         pixelSize = static_cast<std::streamoff>(this->GetComponentSize() * this->GetNumberOfComponents());
+  std::vector<ImageIORegion::IndexValueType> start(nDims, 0);
+  std::vector<ImageIORegion::SizeValueType>  size(nDims, 1);
+  std::vector<std::streamoff>                stride(nDims, pixelSize);
+  for (unsigned int i = 0; i < nDims; ++i)
+  {
+    if (i < m_IORegion.GetImageDimension())
+    {
+      start[i] = m_IORegion.GetIndex(i);
+      size[i] = m_IORegion.GetSize(i);
+    }
+    if (i > 0)
+    {
+      stride[i] = stride[i - 1] * this->GetDimensions(i - 1);
+    }
+  }
+  unsigned int   runDims = 1;
+  std::streamoff runSize = size[0] * pixelSize;
+  while (runDims < nDims && size[runDims - 1] == this->GetDimensions(runDims - 1))
+  {
+    runSize *= size[runDims];
+    ++runDims;
+  }
+
+  auto *                                     data = static_cast<unsigned char *>(buffer);
+  std::vector<ImageIORegion::IndexValueType> index(start);
+  for (bool done = false; !done; data += runSize)
+  {
+    std::streamoff offset = 0;
+    for (unsigned int i = 0; i < nDims; ++i)
+    {
+      offset += index[i] * stride[i];
+    }
+    if (!m_CompressedDataSeekIndex->Read(offset, runSize, data))
+    {
+      m_CompressedDataSeekIndex.reset();
+      itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
+                                                << "Reason: the compressed data is invalid or truncated");
+    }
+    done = true;
+    for (unsigned int i = runDims; i < nDims && done; ++i)
+    {
+      if (++index[i] < start[i] + static_cast<ImageIORegion::IndexValueType>(size[i]))
+      {
+        done = false;
+      }
+      else
+      {
+        index[i] = start[i];
+      }
+    }
+  }
+  return true;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
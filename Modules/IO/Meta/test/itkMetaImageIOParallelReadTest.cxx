@@ -0,0 +1,234 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <fstream>
+#include "itkByteSwapper.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+#include "itk_zlib.h"
+
+// Read slice files listed by LIST or a file name pattern, compressed local
+// data, and streamed regions of compressed data in an arbitrary order.
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PixelType = unsigned short;
+using ImageType = itk::Image<PixelType, Dimension>;
+
+PixelType
+ExpectedValue(const ImageType::IndexType & index)
+{
+  const auto seed = static_cast<unsigned int>(index[0] * 7919 + index[1] * 104729 + index[2] * 1299709);
+  return static_cast<PixelType>((seed ^ (seed >> 7)) % 4093 + index[2]);
+}
+
+bool
+CheckRegion(const ImageType * image, const ImageType::RegionType & region)
+{
+  if (!image->GetBufferedRegion().IsInside(region))
+  {
+    std::cerr << "Region " << region << " is not buffered" << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedValue(it.GetIndex()))
+    {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << it.Get() << " instead of "
+                << ExpectedValue(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+ReadAndCheck(const std::string & fileName, const ImageType::RegionType & region, bool streaming)
+{
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::MetaImageIO::New());
+  reader->SetUseStreaming(streaming);
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+  return CheckRegion(reader->GetOutput(), region);
+}
+
+void
+WriteSlice(const std::string & fileName, const std::vector<PixelType> & slice, bool compressed)
+{
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary);
+  if (!compressed)
+  {
+    file.write(reinterpret_cast<const char *>(slice.data()), slice.size() * sizeof(PixelType));
+    return;
+  }
+  const auto           sourceSize = static_cast<uLong>(slice.size() * sizeof(PixelType));
+  std::vector<Bytef>   compressedData(compressBound(sourceSize));
+  uLongf               compressedSize = compressedData.size();
+  compress2(compressedData.data(), &compressedSize, reinterpret_cast<const Bytef *>(slice.data()), sourceSize, 1);
+  file.write(reinterpret_cast<const char *>(compressedData.data()), compressedSize);
+}
+
+std::ofstream
+WriteHeader(const std::string & fileName, const ImageType::SizeType & size, bool compressed)
+{
+  std::ofstream header(fileName.c_str());
+  header << "ObjectType = Image" << std::endl
+         << "NDims = 3" << std::endl
+         << "DimSize = " << size[0] << ' ' << size[1] << ' ' << size[2] << std::endl
+         << "ElementType = MET_USHORT" << std::endl
+         << "ElementByteOrderMSB = " << (itk::ByteSwapper<int>::SystemIsBigEndian() ? "True" : "False") << std::endl
+         << "CompressedData = " << (compressed ? "True" : "False") << std::endl;
+  return header;
+}
+} // namespace
+
+int
+itkMetaImageIOParallelReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  // Large enough for the compressed data to span several seek points
+  ImageType::SizeType size;
+  size[0] = 160;
+  size[1] = 128;
+  size[2] = 96;
+  const ImageType::RegionType largestRegion(size);
+
+  auto image = ImageType::New();
+  image->SetRegions(largestRegion);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, largestRegion); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue(it.GetIndex()));
+  }
+  const itk::SizeValueType sliceSize = size[0] * size[1];
+
+  int status = EXIT_SUCCESS;
+  for (const bool compressed : { false, true })
+  {
+    // One file per slice
+    const std::string suffix = compressed ? "z" : "raw";
+    std::ofstream     list = WriteHeader(directory + "/ParallelReadList.mhd", size, compressed);
+    list << "ElementDataFile = LIST" << std::endl;
+    for (itk::SizeValueType z = 0; z < size[2]; ++z)
+    {
+      const std::vector<PixelType> slice(image->GetBufferPointer() + z * sliceSize,
+                                         image->GetBufferPointer() + (z + 1) * sliceSize);
+      std::ostringstream           sliceName;
+      sliceName << "ParallelReadSlice" << z + 1 << '.' << suffix;
+      WriteSlice(directory + '/' + sliceName.str(), slice, compressed);
+      list << sliceName.str() << std::endl;
+    }
+    list.close();
+
+    std::ofstream pattern = WriteHeader(directory + "/ParallelReadPattern.mhd", size, compressed);
+    pattern << "ElementDataFile = ParallelReadSlice%d." << suffix << " 1 " << size[2] << " 1" << std::endl;
+    pattern.close();
+
+    std::cout << "Reading " << (compressed ? "compressed" : "uncompressed") << " slice files" << std::endl;
+    ITK_TRY_EXPECT_NO_EXCEPTION(status |= !ReadAndCheck(directory + "/ParallelReadList.mhd", largestRegion, false));
+    ITK_TRY_EXPECT_NO_EXCEPTION(status |= !ReadAndCheck(directory + "/ParallelReadPattern.mhd", largestRegion, false));
+  }
+
+  // A missing slice file is an error
+  std::ofstream missing = WriteHeader(directory + "/ParallelReadMissing.mhd", size, false);
+  missing << "ElementDataFile = ParallelReadMissing%d.raw 1 " << size[2] << " 1" << std::endl;
+  missing.close();
+  ITK_TRY_EXPECT_EXCEPTION(ReadAndCheck(directory + "/ParallelReadMissing.mhd", largestRegion, false));
+
+  // So is a list, or a pattern range, with fewer files than slices
+  std::ofstream shortList = WriteHeader(directory + "/ParallelReadShortList.mhd", size, false);
+  shortList << "ElementDataFile = LIST" << std::endl;
+  for (itk::SizeValueType z = 0; z + 1 < size[2]; ++z)
+  {
+    shortList << "ParallelReadSlice" << z + 1 << ".raw" << std::endl;
+  }
+  shortList.close();
+  ITK_TRY_EXPECT_EXCEPTION(ReadAndCheck(directory + "/ParallelReadShortList.mhd", largestRegion, false));
+
+  std::ofstream shortPattern = WriteHeader(directory + "/ParallelReadShortPattern.mhd", size, false);
+  shortPattern << "ElementDataFile = ParallelReadSlice%d.raw 1 " << size[2] - 1 << " 1" << std::endl;
+  shortPattern.close();
+  ITK_TRY_EXPECT_EXCEPTION(ReadAndCheck(directory + "/ParallelReadShortPattern.mhd", largestRegion, false));
+
+  // Compressed local data, read at once and streamed
+  const std::string compressedFileName = directory + "/ParallelReadCompressed.mha";
+  auto              writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(compressedFileName);
+  writer->SetImageIO(itk::MetaImageIO::New());
+  writer->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  std::cout << "Reading compressed data" << std::endl;
+  ITK_TRY_EXPECT_NO_EXCEPTION(status |= !ReadAndCheck(compressedFileName, largestRegion, false));
+
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(compressedFileName);
+  reader->SetImageIO(itk::MetaImageIO::New());
+  reader->UseStreamingOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->UpdateOutputInformation());
+
+  // Slabs read backward and forward, then regions that are not contiguous in
+  // the file, all through the same ImageIO.
+  std::vector<ImageType::RegionType> regions;
+  for (const itk::IndexValueType z : { 80, 3, 40, 41, 0, 90 })
+  {
+    ImageType::RegionType region = largestRegion;
+    region.SetIndex(2, z);
+    region.SetSize(2, 4);
+    regions.push_back(region);
+  }
+  ImageType::RegionType partial;
+  partial.SetIndex({ { 21, 5, 70 } });
+  partial.SetSize({ { 100, 117, 7 } });
+  regions.push_back(partial);
+  partial.SetIndex({ { 0, 40, 2 } });
+  partial.SetSize({ { 160, 30, 11 } });
+  regions.push_back(partial);
+
+  for (const auto & region : regions)
+  {
+    std::cout << "Streaming region " << region.GetIndex() << " " << region.GetSize() << std::endl;
+    reader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    if (!CheckRegion(reader->GetOutput(), region))
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test " << (status == EXIT_SUCCESS ? "finished." : "failed!") << std::endl;
+  return status;
+}
@@ -79,10 +79,22 @@ public:
   void
   Read(void * buffer) override;
 
-  /** Reads 3D data from multi-pages tiff. */
+  /** Reads 3D data from multi-pages tiff. The pages are decoded
+   * concurrently. */
   virtual void
   ReadVolume(void * buffer);
 
+  /** The strips and tiles of a page are decoded concurrently, and only those
+   * overlapping the requested region are decoded. Returns true, once the
+   * information of the file has been read, unless its pages are converted to
+   * RGBA by libtiff, in which case they are read whole. */
+  bool
+  CanStreamRead() override;
+
+  /** Returns the requested region when the file can be streamed. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -252,12 +264,24 @@ private:
   void
   AllocateTiffPalette(uint16_t bps);
 
+  /** Region of a page to read, from the IO region. */
+  ImageIORegion
+  GetPageRegion() const;
+
+  /** Reads a region of the current page of reader into out. When
+   * multithreaded is true, the strips or tiles of the page are decoded
+   * concurrently, each thread with its own handle on the file. */
   void
-  ReadCurrentPage(void * out, size_t pixelOffset);
+  ReadCurrentPage(TIFFReaderInternal & reader, void * out, const ImageIORegion & region, bool multithreaded);
 
   template <typename TComponent>
   void
-  ReadGenericImage(void * out, unsigned int width, unsigned int height);
+  ReadGenericImage(TIFFReaderInternal & reader, void * out, const ImageIORegion & region, bool multithreaded);
+
+  /** Converts width decoded pixels of buf to the output pixels. */
+  template <typename TComponent>
+  void
+  PutRow(TComponent * image, void * buf, unsigned int width);
 
   template <typename TComponent>
   void
@@ -309,6 +333,7 @@ private:
   uint16_t *   m_ColorBlue;
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+  bool         m_CanStreamRead{ false };
 };
 } // end namespace itk
 
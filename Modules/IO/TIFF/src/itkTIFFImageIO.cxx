@@ -20,12 +20,88 @@
 #include "itkTIFFReaderInternal.h"
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
+#include "itkThreadPool.h"
 
 #include "itk_tiff.h"
 
 namespace itk
 {
 
+namespace
+{
+/** Run body(first, last) over consecutive ranges of [0, count) on the threads
+ * of the pool. An exception thrown for a range is thrown again by the calling
+ * thread once all the ranges are done. The ranges are run serially by a
+ * thread of the pool, e.g. when ImageSeriesReader reads slices in parallel,
+ * since it must not wait for work added to the pool. */
+template <typename TBody>
+void
+ParallelizeRanges(SizeValueType count, const TBody & body)
+{
+  const SizeValueType numberOfRanges =
+    std::min<SizeValueType>(count, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  if (numberOfRanges <= 1 || ThreadPool::IsPoolThread())
+  {
+    body(0, count);
+    return;
+  }
+
+  std::vector<std::string> errors(numberOfRanges);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfRanges,
+    [&](SizeValueType range) {
+      try
+      {
+        body(count * range / numberOfRanges, count * (range + 1) / numberOfRanges);
+      }
+      catch (const std::exception & e)
+      {
+        errors[range] = e.what();
+      }
+    },
+    nullptr);
+  for (const auto & error : errors)
+  {
+    if (!error.empty())
+    {
+      itkGenericExceptionMacro(<< error);
+    }
+  }
+}
+
+/** Reader owning its own handle on the file, since a libtiff handle cannot be
+ * shared between threads. Only the handle of the internal reader is set, the
+ * description of the image is taken from the reader of the ImageIO. */
+class ThreadReader
+{
+public:
+  ThreadReader(const std::string & fileName, tdir_t directory)
+  {
+    m_Reader.m_Image = TIFFOpen(fileName.c_str(), "r");
+    if (m_Reader.m_Image == nullptr || !TIFFSetDirectory(m_Reader.m_Image, directory))
+    {
+      m_Reader.Clean();
+      itkGenericExceptionMacro(<< "Cannot open file " << fileName << "!");
+    }
+  }
+
+  ~ThreadReader() { m_Reader.Clean(); }
+
+  ITK_DISALLOW_COPY_AND_ASSIGN(ThreadReader);
+
+  TIFFReaderInternal &
+  Get()
+  {
+    return m_Reader;
+  }
+
+private:
+  TIFFReaderInternal m_Reader;
+};
+} // namespace
+
 bool
 TIFFImageIO::CanReadFile(const char * file)
 {
@@ -54,26 +130,29 @@ TIFFImageIO::CanReadFile(const char * file)
 void
 TIFFImageIO::ReadGenericImage(void * out, unsigned int width, unsigned int height)
 {
+  ImageIORegion region(2);
+  region.SetSize(0, width);
+  region.SetSize(1, height);
 
   if (m_ComponentType == IOComponentEnum::UCHAR)
   {
-    this->ReadGenericImage<unsigned char>(out, width, height);
+    this->ReadGenericImage<unsigned char>(*m_InternalImage, out, region, true);
   }
   else if (m_ComponentType == IOComponentEnum::CHAR)
   {
-    this->ReadGenericImage<char>(out, width, height);
+    this->ReadGenericImage<char>(*m_InternalImage, out, region, true);
   }
   else if (m_ComponentType == IOComponentEnum::USHORT)
   {
-    this->ReadGenericImage<unsigned short>(out, width, height);
+    this->ReadGenericImage<unsigned short>(*m_InternalImage, out, region, true);
   }
   else if (m_ComponentType == IOComponentEnum::SHORT)
   {
-    this->ReadGenericImage<short>(out, width, height);
+    this->ReadGenericImage<short>(*m_InternalImage, out, region, true);
   }
   else if (m_ComponentType == IOComponentEnum::FLOAT)
   {
-    this->ReadGenericImage<float>(out, width, height);
+    this->ReadGenericImage<float>(*m_InternalImage, out, region, true);
   }
 }
 
@@ -148,32 +227,82 @@ TIFFImageIO::GetFormat()
 void
 TIFFImageIO::ReadVolume(void * buffer)
 {
-  const size_t width{ m_InternalImage->m_Width };
-  const size_t height{ m_InternalImage->m_Height };
+  const ImageIORegion pageRegion = this->GetPageRegion();
+  const size_t        sliceBytes = pageRegion.GetNumberOfPixels() * this->GetPixelSize();
+
+  SizeValueType firstSlice = 0;
+  SizeValueType numberOfSlices = m_NumberOfDimensions > 2 ? m_Dimensions[2] : 1;
+  if (m_IORegion.GetImageDimension() > 2)
+  {
+    firstSlice = m_IORegion.GetIndex(2);
+    numberOfSlices = m_IORegion.GetSize(2);
+  }
 
-  for (uint16 page = 0; page < m_InternalImage->m_NumberOfPages; page++)
+  // Directories of the pages forming the slices, reduced images and masks are skipped
+  std::vector<tdir_t> directories;
+  TIFFSetDirectory(m_InternalImage->m_Image, 0);
+  for (uint16 page = 0;
+       page < m_InternalImage->m_NumberOfPages && directories.size() < firstSlice + numberOfSlices;
+       page++)
   {
+    bool ignored = false;
     if (m_InternalImage->m_IgnoredSubFiles > 0)
     {
       int32 subfiletype = 6;
       if (TIFFGetField(m_InternalImage->m_Image, TIFFTAG_SUBFILETYPE, &subfiletype))
       {
-        if (subfiletype & FILETYPE_REDUCEDIMAGE || subfiletype & FILETYPE_MASK)
-        {
-          // skip subfile
-          TIFFReadDirectory(m_InternalImage->m_Image);
-          continue;
-        }
+        ignored = (subfiletype & FILETYPE_REDUCEDIMAGE || subfiletype & FILETYPE_MASK);
       }
     }
+    if (!ignored)
+    {
+      directories.push_back(page);
+    }
+    TIFFReadDirectory(m_InternalImage->m_Image);
+  }
+  if (directories.size() < firstSlice + numberOfSlices)
+  {
+    itkExceptionMacro(<< "Cannot read page " << directories.size() << " of " << m_FileName);
+  }
 
+  auto * const out = static_cast<char *>(buffer);
 
-    const size_t pixelOffset = width * height * this->GetNumberOfComponents() * page;
-
-    ReadCurrentPage(buffer, pixelOffset);
-
-    TIFFReadDirectory(m_InternalImage->m_Image);
+  TIFFSetDirectory(m_InternalImage->m_Image, directories[firstSlice]);
+  this->InitializeColors();
+  const unsigned int format = this->GetFormat();
+  if (format == TIFFImageIO::PALETTE_RGB || format == TIFFImageIO::PALETTE_GRAYSCALE)
+  {
+    // The palette is read again for each page
+    for (SizeValueType slice = 0; slice < numberOfSlices; ++slice)
+    {
+      TIFFSetDirectory(m_InternalImage->m_Image, directories[firstSlice + slice]);
+      this->InitializeColors();
+      this->ReadCurrentPage(*m_InternalImage, out + slice * sliceBytes, pageRegion, true);
+    }
+    return;
   }
+
+  // Decode the pages concurrently, each range of pages with its own handle on
+  // the file. The strips or tiles of a page are decoded concurrently instead
+  // when there is a single range.
+  ParallelizeRanges(numberOfSlices, [&](SizeValueType first, SizeValueType last) {
+    const bool singleRange = (first == 0 && last == numberOfSlices);
+    if (singleRange)
+    {
+      for (SizeValueType slice = first; slice < last; ++slice)
+      {
+        TIFFSetDirectory(m_InternalImage->m_Image, directories[firstSlice + slice]);
+        this->ReadCurrentPage(*m_InternalImage, out + slice * sliceBytes, pageRegion, true);
+      }
+      return;
+    }
+    ThreadReader reader(m_FileName, directories[firstSlice + first]);
+    for (SizeValueType slice = first; slice < last; ++slice)
+    {
+      TIFFSetDirectory(reader.Get().m_Image, directories[firstSlice + slice]);
+      this->ReadCurrentPage(reader.Get(), out + slice * sliceBytes, pageRegion, false);
+    }
+  });
 }
 
 void
@@ -197,12 +326,65 @@ TIFFImageIO::Read(void * buffer)
   }
   else
   {
-    this->ReadCurrentPage(buffer, 0);
+    this->InitializeColors();
+    this->ReadCurrentPage(*m_InternalImage, buffer, this->GetPageRegion(), true);
   }
 
   m_InternalImage->Clean();
 }
 
+bool
+TIFFImageIO::CanStreamRead()
+{
+  return m_CanStreamRead;
+}
+
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if (!m_CanStreamRead || !m_UseStreamedReading)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+
+  // Only the strips or tiles of the pages overlapping the requested region are decoded
+  ImageIORegion streamableRegion(requested.GetImageDimension());
+  for (unsigned int i = 0; i < requested.GetImageDimension(); ++i)
+  {
+    if (i < m_NumberOfDimensions)
+    {
+      streamableRegion.SetIndex(i, requested.GetIndex(i));
+      streamableRegion.SetSize(i, requested.GetSize(i));
+    }
+    else
+    {
+      streamableRegion.SetIndex(i, 0);
+      streamableRegion.SetSize(i, 1);
+    }
+  }
+  return streamableRegion;
+}
+
+ImageIORegion
+TIFFImageIO::GetPageRegion() const
+{
+  ImageIORegion region(2);
+  if (m_IORegion.GetImageDimension() >= 2)
+  {
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      region.SetIndex(i, m_IORegion.GetIndex(i));
+      region.SetSize(i, m_IORegion.GetSize(i));
+    }
+  }
+  else
+  {
+    region.SetSize(0, m_InternalImage->m_Width);
+    region.SetSize(1, m_InternalImage->m_Height);
+  }
+  return region;
+}
+
 TIFFImageIO::TIFFImageIO()
   : m_ColorPalette(0)
 
@@ -520,6 +702,9 @@ TIFFImageIO::ReadImageInformation()
     // make sure the palette is empty
     m_ColorPalette.resize(0);
   }
+
+  // Pages converted to RGBA by libtiff are read whole
+  m_CanStreamRead = (m_InternalImage->CanRead() != 0);
 }
 
 bool
@@ -1271,7 +1456,10 @@ TIFFImageIO::ReadTIFFTags()
 
 
 void
-TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
+TIFFImageIO::ReadCurrentPage(TIFFReaderInternal &  reader,
+                             void *                buffer,
+                             const ImageIORegion & region,
+                             bool                  multithreaded)
 {
   const uint32 width = m_InternalImage->m_Width;
   const uint32 height = m_InternalImage->m_Height;
@@ -1279,82 +1467,60 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
 
   if (!m_InternalImage->CanRead())
   {
+    // The whole page is read, such images cannot be streamed
     uint32 * tempImage = nullptr;
 
     if (this->GetNumberOfComponents() == 4 && m_ComponentType == IOComponentEnum::UCHAR)
     {
-      tempImage = static_cast<uint32 *>(buffer) + (pixelOffset / 4);
+      tempImage = static_cast<uint32 *>(buffer);
     }
     else
     {
       itkExceptionMacro("Logic Error: Unexpected buffer type!")
     }
 
-    if (!TIFFReadRGBAImageOriented(m_InternalImage->m_Image, width, height, tempImage, ORIENTATION_TOPLEFT, 1))
+    if (!TIFFReadRGBAImageOriented(reader.m_Image, width, height, tempImage, ORIENTATION_TOPLEFT, 1))
     {
       itkExceptionMacro(<< "Cannot read TIFF image as a TIFF RGBA image");
     }
 
-    unsigned char * out = static_cast<unsigned char *>(buffer) + pixelOffset;
-    RGBAImageToBuffer<unsigned char>(out, tempImage);
+    RGBAImageToBuffer<unsigned char>(buffer, tempImage);
   }
   else
   {
-
-    this->InitializeColors();
-
-
     if (m_ComponentType == IOComponentEnum::USHORT)
     {
-      auto * volume = static_cast<unsigned short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      this->ReadGenericImage<unsigned short>(reader, buffer, region, multithreaded);
     }
     else if (m_ComponentType == IOComponentEnum::SHORT)
     {
-      auto * volume = static_cast<short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      this->ReadGenericImage<short>(reader, buffer, region, multithreaded);
     }
     else if (m_ComponentType == IOComponentEnum::CHAR)
     {
-      auto * volume = static_cast<char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      this->ReadGenericImage<char>(reader, buffer, region, multithreaded);
     }
     else if (m_ComponentType == IOComponentEnum::FLOAT)
     {
-      auto * volume = static_cast<float *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      this->ReadGenericImage<float>(reader, buffer, region, multithreaded);
     }
     else
     {
-      auto * volume = static_cast<unsigned char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
+      this->ReadGenericImage<unsigned char>(reader, buffer, region, multithreaded);
     }
   }
 }
 
 template <typename TComponent>
 void
-TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int height)
+TIFFImageIO::ReadGenericImage(TIFFReaderInternal &  reader,
+                              void *                _out,
+                              const ImageIORegion & region,
+                              bool                  multithreaded)
 {
   using ComponentType = TComponent;
 
-#ifdef TIFF_INT64_T // detect if libtiff4
-  uint64_t isize = TIFFScanlineSize64(m_InternalImage->m_Image);
-#else
-  tsize_t isize = TIFFScanlineSize(m_InternalImage->m_Image);
-#endif
-
-  size_t  inc;
-  tdata_t buf = _TIFFmalloc(static_cast<tmsize_t>(isize));
-  isize /= sizeof(ComponentType);
-
-  auto *          out = static_cast<ComponentType *>(_out);
-  ComponentType * image;
+  size_t inc;
 
   if (m_InternalImage->m_PlanarConfig != PLANARCONFIG_CONTIG && m_InternalImage->m_SamplesPerPixel != 1)
   {
@@ -1393,87 +1559,173 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       break;
   }
 
-  for (uint32 row = 0; row < height; ++row)
+  // The page is stored in strips of rows, or in tiles
+  TIFF * const tiff = reader.m_Image;
+  const uint32 width = m_InternalImage->m_Width;
+  const uint32 height = m_InternalImage->m_Height;
+  const bool   tiled = (TIFFIsTiled(tiff) != 0);
+  uint32       chunkWidth = width;
+  uint32       chunkHeight = height;
+  if (tiled)
   {
-    if (TIFFReadScanline(m_InternalImage->m_Image, buf, row, 0) <= 0)
-    {
-      itkExceptionMacro(<< "Problem reading the row: " << row);
-    }
+    TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &chunkWidth);
+    TIFFGetField(tiff, TIFFTAG_TILELENGTH, &chunkHeight);
+  }
+  else
+  {
+    TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &chunkHeight);
+    chunkHeight = std::min(chunkHeight, height);
+  }
+  if (chunkWidth == 0 || chunkHeight == 0)
+  {
+    itkExceptionMacro(<< "Invalid " << (tiled ? "tile" : "strip") << " size in " << m_FileName);
+  }
+  const uint32 chunksAcross = (width + chunkWidth - 1) / chunkWidth;
 
-    if (m_InternalImage->m_Orientation == ORIENTATION_TOPLEFT)
+  // Rows and columns of the page covered by the region, the rows of a bottom
+  // left image are stored from the bottom up
+  const auto   regionColumn = static_cast<uint32>(region.GetIndex(0));
+  const auto   regionRow = static_cast<uint32>(region.GetIndex(1));
+  const auto   regionWidth = static_cast<uint32>(region.GetSize(0));
+  const auto   regionHeight = static_cast<uint32>(region.GetSize(1));
+  const bool   topLeft = (m_InternalImage->m_Orientation == ORIENTATION_TOPLEFT);
+  const uint32 firstRow = topLeft ? regionRow : height - regionRow - regionHeight;
+  const uint32 endRow = firstRow + regionHeight;
+  const uint32 endColumn = regionColumn + regionWidth;
+  if (regionWidth == 0 || regionHeight == 0 || endRow > height || endColumn > width)
+  {
+    itkExceptionMacro(<< "Invalid region to read: " << region);
+  }
+
+  // Only the strips or tiles overlapping the region are decoded
+  const uint32        firstChunkRow = firstRow / chunkHeight;
+  const uint32        firstChunkColumn = regionColumn / chunkWidth;
+  const uint32        chunkColumns = (endColumn - 1) / chunkWidth - firstChunkColumn + 1;
+  const SizeValueType numberOfChunks = SizeValueType{ (endRow - 1) / chunkHeight - firstChunkRow + 1 } * chunkColumns;
+  const size_t        pixelBytes = size_t{ m_InternalImage->m_SamplesPerPixel } * m_InternalImage->m_BitsPerSample / 8;
+
+  auto * out = static_cast<ComponentType *>(_out);
+
+  const auto decodeChunks = [&](TIFF * decoder, SizeValueType first, SizeValueType last) {
+    const tmsize_t             chunkSize = tiled ? TIFFTileSize(decoder) : TIFFStripSize(decoder);
+    const tmsize_t             rowSize = tiled ? TIFFTileRowSize(decoder) : TIFFScanlineSize(decoder);
+    std::vector<unsigned char> chunkBuffer(static_cast<size_t>(chunkSize));
+
+    for (SizeValueType i = first; i < last; ++i)
     {
-      image = out + inc * row * width;
+      const uint32 chunkRow = firstChunkRow + static_cast<uint32>(i / chunkColumns);
+      const uint32 chunkColumn = firstChunkColumn + static_cast<uint32>(i % chunkColumns);
+      const uint32 chunk = chunkRow * chunksAcross + chunkColumn;
+      const tmsize_t decoded = tiled ? TIFFReadEncodedTile(decoder, chunk, chunkBuffer.data(), chunkSize)
+                                     : TIFFReadEncodedStrip(decoder, chunk, chunkBuffer.data(), chunkSize);
+      if (decoded < 0)
+      {
+        itkExceptionMacro(<< "Problem reading the " << (tiled ? "tile: " : "strip: ") << chunk);
+      }
+
+      const uint32 rowStart = chunkRow * chunkHeight;
+      const uint32 columnStart = chunkColumn * chunkWidth;
+      const uint32 fromRow = std::max(rowStart, firstRow);
+      const uint32 toRow = std::min(rowStart + chunkHeight, endRow);
+      const uint32 fromColumn = std::max(columnStart, regionColumn);
+      const uint32 toColumn = std::min(columnStart + chunkWidth, endColumn);
+      for (uint32 row = fromRow; row < toRow; ++row)
+      {
+        const size_t    chunkOffset = (row - rowStart) * static_cast<size_t>(rowSize);
+        unsigned char * from = chunkBuffer.data() + chunkOffset + (fromColumn - columnStart) * pixelBytes;
+        const uint32    outputRow = topLeft ? row : height - (row + 1);
+        const size_t    outputOffset = (outputRow - regionRow) * size_t{ regionWidth } + (fromColumn - regionColumn);
+        ComponentType * image = out + inc * outputOffset;
+        this->PutRow<ComponentType>(image, from, toColumn - fromColumn);
+      }
     }
-    else // bottom left
+  };
+
+  if (!multithreaded)
+  {
+    decodeChunks(tiff, 0, numberOfChunks);
+    return;
+  }
+
+  // Each range of strips or tiles is decoded with its own handle on the file
+  const tdir_t directory = TIFFCurrentDirectory(tiff);
+  ParallelizeRanges(numberOfChunks, [&](SizeValueType first, SizeValueType last) {
+    if (first == 0 && last == numberOfChunks)
     {
-      image = out + inc * width * (height - (row + 1));
+      decodeChunks(tiff, first, last);
+      return;
     }
+    ThreadReader threadReader(m_FileName, directory);
+    decodeChunks(threadReader.Get().m_Image, first, last);
+  });
+}
 
-    switch (this->GetFormat())
-    {
-      case TIFFImageIO::GRAYSCALE:
-        // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
-      case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
+template <typename TComponent>
+void
+TIFFImageIO::PutRow(TComponent * image, void * buf, unsigned int width)
+{
+  using ComponentType = TComponent;
 
-      case TIFFImageIO::PALETTE_GRAYSCALE:
+  switch (this->GetFormat())
+  {
+    case TIFFImageIO::GRAYSCALE:
+      // check inverted
+      PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
+      break;
+    case TIFFImageIO::RGB_:
+      PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
+      break;
+
+    case TIFFImageIO::PALETTE_GRAYSCALE:
+      switch (m_InternalImage->m_BitsPerSample)
+      {
+        case 8:
+          PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+          break;
+        case 16:
+          PutPaletteGrayscale<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+          break;
+        default:
+          itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                            << "-bit samples with palette.");
+      }
+      break;
+    case TIFFImageIO::PALETTE_RGB:
+      if (!this->GetIsReadAsScalarPlusPalette())
+      {
         switch (m_InternalImage->m_BitsPerSample)
         {
           case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
             break;
           case 16:
-            PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
             break;
           default:
             itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
                               << "-bit samples with palette.");
         }
-        break;
-      case TIFFImageIO::PALETTE_RGB:
-        if (!this->GetIsReadAsScalarPlusPalette())
-        {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
-        }
-        else
+      }
+      else
+      {
+        switch (m_InternalImage->m_BitsPerSample)
         {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
+          case 8:
+            PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            break;
+          case 16:
+            PutPaletteScalar<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+            break;
+          default:
+            itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                              << "-bit samples with palette.");
         }
-        break;
+      }
+      break;
 
-      default:
-        itkExceptionMacro("Logic Error: Unexpected format!");
-    }
+    default:
+      itkExceptionMacro("Logic Error: Unexpected format!");
   }
-
-  _TIFFfree(buf);
 }
 
 // iso component scalar
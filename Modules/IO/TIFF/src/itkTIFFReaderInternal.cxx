@@ -195,9 +195,7 @@ TIFFReaderInternal::CanRead()
 {
   const bool compressionSupported = (TIFFIsCODECConfigured(this->m_Compression) == 1);
   return (this->m_Image && (this->m_Width > 0) && (this->m_Height > 0) && (this->m_SamplesPerPixel > 0) &&
-          compressionSupported && (m_NumberOfTiles == 0) // just use TIFFReadRGBAImage, an
-                                                         // native optimized version would be nice
-          && (this->m_HasValidPhotometricInterpretation) &&
+          compressionSupported && (this->m_HasValidPhotometricInterpretation) &&
           (this->m_Photometrics == PHOTOMETRIC_RGB || this->m_Photometrics == PHOTOMETRIC_MINISWHITE ||
            this->m_Photometrics == PHOTOMETRIC_MINISBLACK ||
            (this->m_Photometrics == PHOTOMETRIC_PALETTE && this->m_BitsPerSample != 32)) &&
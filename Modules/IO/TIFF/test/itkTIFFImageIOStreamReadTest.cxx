@@ -0,0 +1,259 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTIFFImageIO.h"
+#include "itkTestingMacros.h"
+#include "itk_tiff.h"
+
+// Reads a multi-strip, multi-page TIFF whole and by regions, then tiled and
+// bottom-left oriented files written directly with libtiff
+
+namespace
+{
+
+using PixelType = unsigned short;
+using ImageType = itk::Image<PixelType, 3>;
+
+using SliceType = itk::Image<unsigned char, 2>;
+
+PixelType
+ExpectedValue(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(index[0] * 7 + index[1] * 13 + index[2] * 101);
+}
+
+unsigned char
+ExpectedSliceValue(const SliceType::IndexType & index)
+{
+  return static_cast<unsigned char>(index[0] * 3 + index[1] * 5);
+}
+
+template <typename TImage, typename TExpectedValue>
+bool
+CheckRegion(const TImage * image, const typename TImage::RegionType & region, TExpectedValue expectedValue)
+{
+  itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expectedValue(it.GetIndex()))
+    {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << +it.Get() << " != " << +expectedValue(it.GetIndex())
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Write an 8-bit grayscale page with libtiff, in tiles of tileWidth x
+ * tileLength pixels or, when tileWidth is 0, in strips of tileLength rows.
+ * The rows are stored from the bottom up for ORIENTATION_BOTLEFT, so that the
+ * image read by ITK holds ExpectedSliceValue() in both cases. */
+bool
+WriteSlice(const char * fileName, uint32 width, uint32 height, uint32 tileWidth, uint32 tileLength, uint16 orientation)
+{
+  TIFF * tiff = TIFFOpen(fileName, "w");
+  if (tiff == nullptr)
+  {
+    std::cerr << "Cannot open " << fileName << std::endl;
+    return false;
+  }
+  TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, width);
+  TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, height);
+  TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, 8);
+  TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, 1);
+  TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+  TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+  TIFFSetField(tiff, TIFFTAG_ORIENTATION, orientation);
+
+  const auto fileValue = [=](uint32 column, uint32 row) {
+    SliceType::IndexType index;
+    index[0] = column;
+    index[1] = orientation == ORIENTATION_BOTLEFT ? height - 1 - row : row;
+    return ExpectedSliceValue(index);
+  };
+
+  if (tileWidth > 0)
+  {
+    // The tiles on the right and bottom edges are only partly in the image
+    TIFFSetField(tiff, TIFFTAG_TILEWIDTH, tileWidth);
+    TIFFSetField(tiff, TIFFTAG_TILELENGTH, tileLength);
+    std::vector<unsigned char> tile(tileWidth * tileLength);
+    for (uint32 tileRow = 0; tileRow < height; tileRow += tileLength)
+    {
+      for (uint32 tileColumn = 0; tileColumn < width; tileColumn += tileWidth)
+      {
+        for (uint32 row = 0; row < tileLength; ++row)
+        {
+          for (uint32 column = 0; column < tileWidth; ++column)
+          {
+            const bool inside = tileColumn + column < width && tileRow + row < height;
+            tile[row * tileWidth + column] = inside ? fileValue(tileColumn + column, tileRow + row) : 0;
+          }
+        }
+        TIFFWriteTile(tiff, tile.data(), tileColumn, tileRow, 0, 0);
+      }
+    }
+  }
+  else
+  {
+    TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP, tileLength);
+    std::vector<unsigned char> scanline(width);
+    for (uint32 row = 0; row < height; ++row)
+    {
+      for (uint32 column = 0; column < width; ++column)
+      {
+        scanline[column] = fileValue(column, row);
+      }
+      TIFFWriteScanline(tiff, scanline.data(), row, 0);
+    }
+  }
+  TIFFClose(tiff);
+  return true;
+}
+
+/** Read the slice whole, then the given regions. */
+bool
+CheckSlice(const char * fileName, const std::vector<SliceType::RegionType> & regions)
+{
+  using SliceReaderType = itk::ImageFileReader<SliceType>;
+  bool ok = true;
+
+  SliceReaderType::Pointer reader = SliceReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::TIFFImageIO::New());
+  reader->Update();
+  ok &= CheckRegion(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion(), ExpectedSliceValue);
+
+  for (const auto & region : regions)
+  {
+    reader = SliceReaderType::New();
+    reader->SetFileName(fileName);
+    reader->SetImageIO(itk::TIFFImageIO::New());
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Update();
+    if (reader->GetOutput()->GetBufferedRegion() != region)
+    {
+      std::cerr << "Buffered region " << reader->GetOutput()->GetBufferedRegion() << " instead of " << region
+                << std::endl;
+      ok = false;
+    }
+    ok &= CheckRegion(reader->GetOutput(), region, ExpectedSliceValue);
+  }
+  return ok;
+}
+
+} // namespace
+
+int
+itkTIFFImageIOStreamReadTest(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv)
+              << " outputFileName tiledOutputFileName bottomLeftOutputFileName" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Rows of 1200 bytes, so that each page is written in several strips
+  ImageType::SizeType size;
+  size[0] = 600;
+  size[1] = 1000;
+  size[2] = 5;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue(it.GetIndex()));
+  }
+
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetFileName(argv[1]);
+  writer->SetImageIO(itk::TIFFImageIO::New());
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  using ReaderType = itk::ImageFileReader<ImageType>;
+
+  // Whole volume, the pages are decoded concurrently
+  {
+    itk::TIFFImageIO::Pointer io = itk::TIFFImageIO::New();
+    ReaderType::Pointer       reader = ReaderType::New();
+    reader->SetFileName(argv[1]);
+    reader->SetImageIO(io);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_TRUE(io->CanStreamRead());
+    ITK_TEST_EXPECT_TRUE(
+      CheckRegion(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion(), ExpectedValue));
+  }
+
+  // Regions crossing strip boundaries, only the requested region is read
+  ImageType::RegionType regions[2];
+  regions[0].SetIndex({ { 17, 450, 1 } });
+  regions[0].SetSize({ { 300, 500, 3 } });
+  regions[1].SetIndex({ { 0, 999, 4 } });
+  regions[1].SetSize({ { 600, 1, 1 } });
+  for (const auto & region : regions)
+  {
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(argv[1]);
+    reader->SetImageIO(itk::TIFFImageIO::New());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->UpdateOutputInformation());
+    reader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), region);
+    ITK_TEST_EXPECT_TRUE(CheckRegion(reader->GetOutput(), region, ExpectedValue));
+  }
+
+  // 100 x 70 pixels in tiles of 32 x 16: the last column of tiles and the
+  // last row of tiles are partial
+  std::vector<SliceType::RegionType> tiledRegions(3);
+  tiledRegions[0].SetIndex({ { 20, 10 } });
+  tiledRegions[0].SetSize({ { 60, 30 } });
+  tiledRegions[1].SetIndex({ { 90, 60 } });
+  tiledRegions[1].SetSize({ { 10, 10 } });
+  tiledRegions[2].SetIndex({ { 0, 69 } });
+  tiledRegions[2].SetSize({ { 100, 1 } });
+  bool tiledOk = false;
+  ITK_TEST_EXPECT_TRUE(WriteSlice(argv[2], 100, 70, 32, 16, ORIENTATION_TOPLEFT));
+  ITK_TRY_EXPECT_NO_EXCEPTION(tiledOk = CheckSlice(argv[2], tiledRegions));
+  ITK_TEST_EXPECT_TRUE(tiledOk);
+
+  // 64 x 40 pixels in strips of 7 rows stored from the bottom up
+  std::vector<SliceType::RegionType> bottomLeftRegions(2);
+  bottomLeftRegions[0].SetIndex({ { 5, 3 } });
+  bottomLeftRegions[0].SetSize({ { 50, 20 } });
+  bottomLeftRegions[1].SetIndex({ { 0, 39 } });
+  bottomLeftRegions[1].SetSize({ { 64, 1 } });
+  bool bottomLeftOk = false;
+  ITK_TEST_EXPECT_TRUE(WriteSlice(argv[3], 64, 40, 0, 7, ORIENTATION_BOTLEFT));
+  ITK_TRY_EXPECT_NO_EXCEPTION(bottomLeftOk = CheckSlice(argv[3], bottomLeftRegions));
+  ITK_TEST_EXPECT_TRUE(bottomLeftOk);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkImageSeriesReader.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkThreadPool.h"
+#include "itkTIFFImageIO.h"
+#include "itkTestingMacros.h"
+
+#include <sstream>
+
+// Reads multi-strip TIFF slices in parallel with more work units than threads
+// in the pool. The slices are read by the threads of the pool, which decode
+// the strips of their slice without waiting for the pool.
+
+namespace
+{
+
+using PixelType = unsigned char;
+using ImageType = itk::Image<PixelType, 3>;
+using SliceType = itk::Image<PixelType, 2>;
+
+PixelType
+ExpectedValue(itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z)
+{
+  return static_cast<PixelType>(x * 3 + y * 5 + z * 11);
+}
+
+} // namespace
+
+int
+itkTIFFImageSeriesParallelReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // At least two threads, so that the strips of a slice are decoded in parallel
+  itk::MultiThreaderBase::SetGlobalDefaultThreader(itk::MultiThreaderBase::ThreaderEnum::Pool);
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(
+    std::max(2u, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  const itk::ThreadIdType  numberOfPoolThreads = itk::ThreadPool::GetInstance()->GetMaximumNumberOfThreads();
+  const itk::SizeValueType numberOfSlices = 2 * numberOfPoolThreads + 2;
+
+  // Strips of 1 MiB are written, so that each slice is written in 3 strips
+  SliceType::SizeType size;
+  size[0] = 1024;
+  size[1] = 2500;
+
+  std::vector<std::string> fileNames;
+  for (itk::SizeValueType z = 0; z < numberOfSlices; ++z)
+  {
+    SliceType::Pointer slice = SliceType::New();
+    slice->SetRegions(size);
+    slice->Allocate();
+    itk::ImageRegionIteratorWithIndex<SliceType> it(slice, slice->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      it.Set(ExpectedValue(it.GetIndex()[0], it.GetIndex()[1], z));
+    }
+
+    std::ostringstream fileName;
+    fileName << argv[1] << "/itkTIFFImageSeriesParallelReadTest" << z << ".tif";
+    fileNames.push_back(fileName.str());
+
+    auto writer = itk::ImageFileWriter<SliceType>::New();
+    writer->SetInput(slice);
+    writer->SetFileName(fileNames.back());
+    writer->SetImageIO(itk::TIFFImageIO::New());
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+
+  using ReaderType = itk::ImageSeriesReader<ImageType>;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileNames(fileNames);
+  reader->SetImageIO(itk::TIFFImageIO::New());
+  reader->ParallelReadOn();
+  reader->SetNumberOfWorkUnits(numberOfSlices);
+  ITK_TEST_EXPECT_TRUE(reader->GetNumberOfWorkUnits() > numberOfPoolThreads);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(reader->GetOutput(),
+                                                       reader->GetOutput()->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    if (it.Get() != ExpectedValue(index[0], index[1], index[2]))
+    {
+      std::cerr << "Wrong value at " << index << ": " << static_cast<int>(it.Get())
+                << " != " << static_cast<int>(ExpectedValue(index[0], index[1], index[2])) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -130,9 +130,10 @@ protected:
   ~HDF5TransformIOTemplate() override;
 
 private:
-  /** Read a parameter array from the file location name */
-  ParametersType
-  ReadParameters(const std::string & DataSetName) const;
+  /** Read a parameter array from the file location name into the
+   * transform. Dense transforms are read in place, without copies. */
+  void
+  ReadParameters(const std::string & DataSetName, TransformType * transform) const;
   FixedParametersType
   ReadFixedParameters(const std::string & DataSetName) const;
 
@@ -7,6 +7,7 @@ itk_module(ITKIOTransformHDF5
     ITKIOTransformBase
   PRIVATE_DEPENDS
     ITKHDF5
+    ITKIOHDF5
   TEST_DEPENDS
     ITKTestKernel
   FACTORY_NAMES
@@ -23,11 +23,126 @@
 #include "itksys/SystemInformation.hxx"
 #include "itkCompositeTransform.h"
 #include "itkCompositeTransformIOHelper.h"
+#include "itkHDF5DeflatedChunkIO.h"
 #include "itkVersion.h"
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 namespace itk
 {
+namespace
+{
+// Deflate level of compressed parameter data sets
+constexpr int parametersCompressionLevel = 5;
+
+// The parameters of dense transforms, displacement fields and B-spline
+// grids, hold millions of values. The chunks of their one dimensional
+// data set are compressed, or decompressed, in parallel.
+// Both return false when the data set does not have a layout they
+// handle, the caller then uses the regular HDF5 path.
+bool
+WriteDeflatedChunks(const H5::DataSet & dataSet,
+                    const void *        buffer,
+                    hsize_t             numberOfValues,
+                    size_t              valueSize,
+                    hsize_t             chunkSize)
+{
+#if H5_VERSION_GE(1, 10, 3)
+  const hsize_t numberOfChunks = (numberOfValues + chunkSize - 1) / chunkSize;
+  if (numberOfChunks < 2)
+  {
+    return false;
+  }
+
+  // the last chunk is padded with zeros
+  const size_t totalBytes = numberOfValues * valueSize;
+  const size_t chunkBytes = chunkSize * valueSize;
+  const auto * bytes = static_cast<const unsigned char *>(buffer);
+  HDF5DeflatedChunkIO::WriteChunks(
+    dataSet,
+    numberOfChunks,
+    chunkBytes,
+    parametersCompressionLevel,
+    [chunkSize](SizeValueType c) { return std::vector<SizeValueType>{ c * chunkSize }; },
+    [&](SizeValueType c, unsigned char * chunk) {
+      const size_t chunkOffset = c * chunkBytes;
+      std::memcpy(chunk, bytes + chunkOffset, std::min(chunkBytes, totalBytes - chunkOffset));
+    });
+  return true;
+#else
+  (void)dataSet;
+  (void)buffer;
+  (void)numberOfValues;
+  (void)valueSize;
+  (void)chunkSize;
+  return false;
+#endif
+}
+
+bool
+ReadDeflatedChunks(const H5::DataSet & dataSet, const H5::DataType & memoryType, void * buffer, hsize_t numberOfValues)
+{
+#if H5_VERSION_GE(1, 10, 3)
+  // the stored values must not need a conversion
+  hsize_t chunkSize = 0;
+  try
+  {
+    if (!(dataSet.getDataType() == memoryType))
+    {
+      return false;
+    }
+    const H5::DSetCreatPropList plist = dataSet.getCreatePlist();
+    if (plist.getLayout() != H5D_CHUNKED || plist.getNfilters() != 1)
+    {
+      return false;
+    }
+    plist.getChunk(1, &chunkSize);
+
+    unsigned int flags = 0;
+    size_t       numberOfFilterValues = 1;
+    unsigned int filterValues[1] = { 0 };
+    unsigned int filterConfig = 0;
+    if (plist.getFilter(0, flags, numberOfFilterValues, filterValues, 0, nullptr, filterConfig) != H5Z_FILTER_DEFLATE)
+    {
+      return false;
+    }
+  }
+  catch (H5::Exception &)
+  {
+    return false;
+  }
+  const hsize_t numberOfChunks = chunkSize > 0 ? (numberOfValues + chunkSize - 1) / chunkSize : 0;
+  if (numberOfChunks < 2)
+  {
+    return false;
+  }
+
+  // the padding of the last chunk is dropped
+  const size_t totalBytes = numberOfValues * memoryType.getSize();
+  const size_t chunkBytes = chunkSize * memoryType.getSize();
+  auto *       bytes = static_cast<unsigned char *>(buffer);
+  HDF5DeflatedChunkIO::ReadChunks(
+    dataSet,
+    numberOfChunks,
+    chunkBytes,
+    [chunkSize](SizeValueType c) { return std::vector<SizeValueType>{ c * chunkSize }; },
+    [&](SizeValueType c, const unsigned char * chunk) {
+      const size_t chunkOffset = c * chunkBytes;
+      std::memcpy(bytes + chunkOffset, chunk, std::min(chunkBytes, totalBytes - chunkOffset));
+    });
+  return true;
+#else
+  (void)dataSet;
+  (void)memoryType;
+  (void)buffer;
+  (void)numberOfValues;
+  return false;
+#endif
+}
+} // namespace
+
 template <typename TParametersValueType>
 HDF5TransformIOTemplate<TParametersValueType>::HDF5TransformIOTemplate() = default;
 
@@ -130,12 +245,17 @@ HDF5TransformIOTemplate<TParametersValueType>::WriteParameters(const std::string
     // in this case, set the chunk size to be the N-1 dimension
     // region
     H5::DSetCreatPropList plist;
-    plist.setDeflate(5); // Set intermediate compression level
+    plist.setDeflate(parametersCompressionLevel); // Set intermediate compression level
     constexpr hsize_t oneMegabyte = 1024 * 1024;
     const hsize_t     chunksize = (dim > oneMegabyte) ? oneMegabyte : dim; // Use chunks of 1 MB if large, else use dim
     plist.setChunk(1, &chunksize);
 
     paramSet = this->m_H5File->createDataSet(name, h5StorageIdentifier, paramSpace, plist);
+    if (WriteDeflatedChunks(paramSet, parameters.data_block(), dim, sizeof(ParametersValueType), chunksize))
+    {
+      paramSet.close();
+      return;
+    }
   }
   else
   {
@@ -157,10 +277,11 @@ HDF5TransformIOTemplate<TParametersValueType>::WriteFixedParameters(const std::s
   paramSet.close();
 }
 
-/** read a parameter array from the location specified by name */
+/** read a parameter array from the location specified by name into the transform */
 template <typename TParametersValueType>
-typename HDF5TransformIOTemplate<TParametersValueType>::ParametersType
-HDF5TransformIOTemplate<TParametersValueType>::ReadParameters(const std::string & DataSetName) const
+void
+HDF5TransformIOTemplate<TParametersValueType>::ReadParameters(const std::string & DataSetName,
+                                                              TransformType *     transform) const
 {
 
   H5::DataSet       paramSet = this->m_H5File->openDataSet(DataSetName);
@@ -177,30 +298,36 @@ HDF5TransformIOTemplate<TParametersValueType>::ReadParameters(const std::string
   }
   hsize_t dim;
   Space.getSimpleExtentDims(&dim, nullptr);
-  ParametersType ParameterArray;
-  ParameterArray.SetSize(dim);
-  H5::FloatType ParamType = paramSet.getFloatType();
 
-  if (ParamType.getSize() == sizeof(double))
-  {
-    const std::unique_ptr<double[]> buf(new double[dim]);
-    paramSet.read(buf.get(), H5::PredType::NATIVE_DOUBLE);
-    for (unsigned i = 0; i < dim; i++)
+  // HDF5 converts the stored values to the parameters precision
+  const H5::PredType h5StorageIdentifier{ GetH5TypeFromString() };
+  const auto         readValues = [&](ParametersValueType * values) {
+    if (!ReadDeflatedChunks(paramSet, h5StorageIdentifier, values, dim))
     {
-      ParameterArray.SetElement(i, static_cast<ParametersValueType>(buf[i]));
+      paramSet.read(values, h5StorageIdentifier);
     }
+  };
+
+  // Once sized by their fixed parameters, displacement field and B-spline
+  // transforms expose the buffer of their field, or coefficient images, as
+  // parameters: the values are read straight into it.
+  const ParametersType &                               transformParameters = transform->GetParameters();
+  const typename TransformType::TransformCategoryEnum category = transform->GetTransformCategory();
+  if ((category == TransformType::TransformCategoryEnum::DisplacementField ||
+       category == TransformType::TransformCategoryEnum::BSpline) &&
+      transformParameters.Size() == dim)
+  {
+    readValues(const_cast<ParametersValueType *>(transformParameters.data_block()));
+    transform->SetParameters(transformParameters);
+    transform->Modified();
   }
   else
   {
-    const std::unique_ptr<float[]> buf(new float[dim]);
-    paramSet.read(buf.get(), H5::PredType::NATIVE_FLOAT);
-    for (unsigned i = 0; i < dim; i++)
-    {
-      ParameterArray.SetElement(i, static_cast<ParametersValueType>(buf[i]));
-    }
+    ParametersType ParameterArray(dim);
+    readValues(ParameterArray.data_block());
+    transform->SetParametersByValue(ParameterArray);
   }
   paramSet.close();
-  return ParameterArray;
 }
 
 /** read a parameter array from the location specified by name */
@@ -349,8 +476,7 @@ HDF5TransformIOTemplate<TParametersValueType>::Read()
 #endif
           paramsName = transformName + transformParamsNameMisspelled;
         }
-        ParametersType params = this->ReadParameters(paramsName);
-        transform->SetParametersByValue(params);
+        this->ReadParameters(paramsName, transform);
       }
       currentTransformGroup.close();
     }
@@ -392,12 +518,13 @@ HDF5TransformIOTemplate<TParametersValueType>::WriteOneTransform(const int
   {
     //
     // write out Fixed Parameters
-    FixedParametersType FixedtmpArray = curTransform->GetFixedParameters();
-    const std::string   fixedParamsName(transformName + transformFixedName);
+    const FixedParametersType & FixedtmpArray = curTransform->GetFixedParameters();
+    const std::string           fixedParamsName(transformName + transformFixedName);
     this->WriteFixedParameters(fixedParamsName, FixedtmpArray);
-    // parameters
-    ParametersType    tmpArray = curTransform->GetParameters();
-    const std::string paramsName(transformName + transformParamsName);
+    // parameters, written from the storage of the transform: for dense
+    // transforms, the buffer of their field or coefficient images
+    const ParametersType & tmpArray = curTransform->GetParameters();
+    const std::string      paramsName(transformName + transformParamsName);
     this->WriteParameters(paramsName, tmpArray);
   }
 }
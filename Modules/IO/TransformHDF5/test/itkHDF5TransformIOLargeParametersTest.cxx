@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBSplineTransform.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkHDF5TransformIO.h"
+#include "itkTransformFileReader.h"
+#include "itkTransformFileWriter.h"
+#include "itkTestingMacros.h"
+#include <cmath>
+
+// Dense transforms with more parameters than a compressed chunk holds go
+// through the parallel chunk compression, and are read back in place.
+
+namespace
+{
+template <typename TParametersValueType>
+typename itk::TransformBaseTemplate<TParametersValueType>::Pointer
+WriteAndRead(const itk::TransformBaseTemplate<double> * transform, const std::string & fileName, bool useCompression)
+{
+  auto writer = itk::TransformFileWriterTemplate<double>::New();
+  writer->SetTransformIO(itk::HDF5TransformIOTemplate<double>::New());
+  writer->SetInput(transform);
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(useCompression);
+  writer->Update();
+
+  auto reader = itk::TransformFileReaderTemplate<TParametersValueType>::New();
+  reader->SetTransformIO(itk::HDF5TransformIOTemplate<TParametersValueType>::New());
+  reader->SetFileName(fileName);
+  reader->Update();
+  return reader->GetTransformList()->front();
+}
+
+template <typename TParametersValueType>
+int
+CheckParameters(const itk::TransformBaseTemplate<double> *               written,
+                const itk::TransformBaseTemplate<TParametersValueType> * read,
+                const std::string &                                      fileName)
+{
+  ITK_TEST_EXPECT_EQUAL(read->GetNameOfClass(), std::string(written->GetNameOfClass()));
+  ITK_TEST_EXPECT_EQUAL(read->GetFixedParameters(), written->GetFixedParameters());
+
+  const auto & writtenParameters = written->GetParameters();
+  const auto & readParameters = read->GetParameters();
+  ITK_TEST_EXPECT_EQUAL(readParameters.Size(), writtenParameters.Size());
+  for (itk::SizeValueType i = 0; i < writtenParameters.Size(); ++i)
+  {
+    if (readParameters[i] != static_cast<TParametersValueType>(writtenParameters[i]))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error reading " << fileName << ": parameter " << i << " is " << readParameters[i] << " instead of "
+                << static_cast<TParametersValueType>(writtenParameters[i]) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkHDF5TransformIOLargeParametersTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  constexpr unsigned int Dimension = 3;
+
+  // A displacement field of about 1.2 million values
+  using DisplacementFieldTransformType = itk::DisplacementFieldTransform<double, Dimension>;
+  using DisplacementFieldType = DisplacementFieldTransformType::DisplacementFieldType;
+
+  DisplacementFieldType::SizeType size;
+  size[0] = 64;
+  size[1] = 64;
+  size[2] = 96;
+  auto field = DisplacementFieldType::New();
+  field->SetRegions(size);
+  DisplacementFieldType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 0.8;
+  spacing[2] = 1.5;
+  field->SetSpacing(spacing);
+  field->Allocate();
+  DisplacementFieldType::PixelType * displacements = field->GetBufferPointer();
+  const itk::SizeValueType           numberOfPixels = field->GetBufferedRegion().GetNumberOfPixels();
+  for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      displacements[i][d] = std::sin(0.001 * i + d) * (d + 1.25);
+    }
+  }
+  auto displacementFieldTransform = DisplacementFieldTransformType::New();
+  displacementFieldTransform->SetDisplacementField(field);
+
+  // A dense B-spline grid of about 1 million coefficients
+  using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+  auto                                        bsplineTransform = BSplineTransformType::New();
+  BSplineTransformType::PhysicalDimensionsType physicalDimensions;
+  physicalDimensions.Fill(100.0);
+  bsplineTransform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize.Fill(67);
+  bsplineTransform->SetTransformDomainMeshSize(meshSize);
+  BSplineTransformType::ParametersType coefficients(bsplineTransform->GetNumberOfParameters());
+  for (itk::SizeValueType i = 0; i < coefficients.Size(); ++i)
+  {
+    coefficients[i] = std::cos(0.003 * i) * 2.5;
+  }
+  bsplineTransform->SetParametersByValue(coefficients);
+
+  for (const bool useCompression : { true, false })
+  {
+    const std::string suffix = useCompression ? "Compressed.h5" : ".h5";
+
+    const std::string fieldFileName = outputDirectory + "/itkHDF5TransformIOLargeDisplacementField" + suffix;
+    itk::TransformBaseTemplate<double>::Pointer readField;
+    ITK_TRY_EXPECT_NO_EXCEPTION(
+      readField = WriteAndRead<double>(displacementFieldTransform, fieldFileName, useCompression));
+    if (CheckParameters<double>(displacementFieldTransform, readField, fieldFileName) == EXIT_FAILURE)
+    {
+      return EXIT_FAILURE;
+    }
+
+    // the parameters of the read transform are its displacement field
+    const auto * readFieldTransform = dynamic_cast<const DisplacementFieldTransformType *>(readField.GetPointer());
+    ITK_TEST_EXPECT_TRUE(readFieldTransform != nullptr);
+    ITK_TEST_EXPECT_TRUE(readFieldTransform->GetParameters().data_block() ==
+                         &readFieldTransform->GetDisplacementField()->GetBufferPointer()[0][0]);
+    ITK_TEST_EXPECT_EQUAL(readFieldTransform->GetDisplacementField()->GetSpacing(), spacing);
+
+    // read at a lower precision, HDF5 converts the values
+    itk::TransformBaseTemplate<float>::Pointer readFloatField;
+    ITK_TRY_EXPECT_NO_EXCEPTION(
+      readFloatField = WriteAndRead<float>(displacementFieldTransform, fieldFileName, useCompression));
+    if (CheckParameters<float>(displacementFieldTransform, readFloatField, fieldFileName) == EXIT_FAILURE)
+    {
+      return EXIT_FAILURE;
+    }
+
+    const std::string bsplineFileName = outputDirectory + "/itkHDF5TransformIOLargeBSpline" + suffix;
+    itk::TransformBaseTemplate<double>::Pointer readBSpline;
+    ITK_TRY_EXPECT_NO_EXCEPTION(readBSpline = WriteAndRead<double>(bsplineTransform, bsplineFileName, useCompression));
+    if (CheckParameters<double>(bsplineTransform, readBSpline, bsplineFileName) == EXIT_FAILURE)
+    {
+      return EXIT_FAILURE;
+    }
+
+    BSplineTransformType::InputPointType point;
+    point[0] = 12.5;
+    point[1] = 47.25;
+    point[2] = 80.0;
+    const auto * readBSplineTransform = dynamic_cast<const BSplineTransformType *>(readBSpline.GetPointer());
+    ITK_TEST_EXPECT_TRUE(readBSplineTransform != nullptr);
+    ITK_TEST_EXPECT_EQUAL(readBSplineTransform->TransformPoint(point), bsplineTransform->TransformPoint(point));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIO_h
+#define itkZarrImageIO_h
+#include "ITKIOZarrExport.h"
+
+#include "itkStreamingImageIOBase.h"
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/**
+ *\class ZarrImageIO
+ *
+ * \brief ImageIO for chunked N-dimensional arrays stored in a Zarr
+ * (version 2) directory store, including OME-NGFF multiscale pyramids.
+ *
+ * A store is a directory, conventionally with the ".zarr" extension.
+ * Each array of the store is a directory holding a ".zarray" JSON
+ * header and one file per chunk, every chunk being compressed
+ * independently. When the store is a group whose ".zattrs" follows the
+ * OME-NGFF "multiscales" convention, each dataset of the pyramid is a
+ * resolution level which can be selected with SetResolutionLevel()
+ * before reading; level 0 is the full resolution image. A directory
+ * with a ".zarray" header is read as a single level.
+ *
+ * Arrays are stored in C order, so the last Zarr axis is the fastest
+ * varying and maps to the first image dimension. Multi-component
+ * pixels are stored as an extra, fastest varying, "channel" axis. The
+ * spacing and origin are given by the "scale" and "translation"
+ * coordinate transformations of each dataset; the direction cosines,
+ * which OME-NGFF does not represent, are kept in the "itk" member of
+ * the group attributes.
+ *
+ * Reading and writing support streaming of arbitrary regions: only the
+ * chunks overlapping the IORegion are decoded or encoded, and they are
+ * processed in parallel. When writing in pieces, the splits are aligned
+ * with the chunk grid so that no chunk is compressed more than once.
+ * A region which partially covers a chunk of an existing array is
+ * merged with the chunk's previous content.
+ *
+ * Chunks are uncompressed unless UseCompression is enabled, in which
+ * case the "zlib" codec is used, or "gzip" when set as the
+ * Compressor. Setting ResolutionLevel to N > 0 when writing adds (or
+ * replaces) level N of an existing multiscale group, which allows a
+ * pyramid to be written one level at a time.
+ *
+ * \sa ImageFileWriter ImageFileReader StreamingImageIOBase
+ * \ingroup IOFilters
+ * \ingroup ITKIOZarr
+ */
+class ITKIOZarr_EXPORT ZarrImageIO : public StreamingImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(ZarrImageIO);
+
+  /** Standard class type aliases. */
+  using Self = ZarrImageIO;
+  using Superclass = StreamingImageIOBase;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ZarrImageIO, StreamingImageIOBase);
+
+  /** Number of pixels of a chunk along each image dimension. */
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the resolution level, that is the index of the dataset in
+   * the multiscale pyramid, read or written. Defaults to 0. */
+  itkSetMacro(ResolutionLevel, unsigned int);
+  itkGetConstMacro(ResolutionLevel, unsigned int);
+
+  /** Number of resolution levels of the store, available after
+   * ReadImageInformation(). */
+  itkGetConstMacro(NumberOfResolutionLevels, unsigned int);
+
+  /** Set/Get the chunk size used to create new arrays, fastest
+   * dimension first. Missing or zero entries use a default giving
+   * chunks of about 256K pixels, and entries are clamped to the image
+   * size. Pasting into an existing array keeps its chunking. After
+   * ReadImageInformation() this is the chunking of the file. */
+  void
+  SetChunkSize(const ChunkSizeType & chunkSize);
+  itkGetConstReferenceMacro(ChunkSize, ChunkSizeType);
+
+  //-------- This part of the interface deals with reading data. ------
+
+  // See super class for documentation
+  bool
+  CanReadFile(const char *) override;
+
+  // See super class for documentation
+  void
+  ReadImageInformation() override;
+
+  // See super class for documentation
+  void
+  Read(void * buffer) override;
+
+  // -------- This part of the interfaces deals with writing data. -----
+
+  // See super class for documentation
+  bool
+  CanWriteFile(const char *) override;
+
+  /** Creates the metadata of the store, unless the IORegion is to be
+   * pasted into a compatible existing array. */
+  void
+  WriteImageInformation() override;
+
+  // See super class for documentation
+  void
+  Write(const void * buffer) override;
+
+  /** Limits the number of splits to the number of chunk slabs along
+   * the slowest varying dimension of the paste region. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Returns splits aligned with the chunk grid. */
+  ImageIORegion
+  GetSplitRegionForWriting(unsigned int          ithPiece,
+                           unsigned int          numberOfActualSplits,
+                           const ImageIORegion & pasteRegion,
+                           const ImageIORegion & largestPossibleRegion) override;
+
+protected:
+  ZarrImageIO();
+  ~ZarrImageIO() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The pixel data is not part of a single file, so there is no
+   * header to skip. */
+  SizeType
+  GetHeaderSize() const override;
+
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
+private:
+  /** Reads the ".zarray" of the array at arrayPath into the pixel type
+   * and chunk layout members, and returns its shape in Zarr (C) order. */
+  std::vector<SizeValueType>
+  ReadArrayHeader(const std::string & arrayPath);
+
+  /** Returns the directory of the array for the current resolution
+   * level, creating nothing. */
+  std::string
+  GetArrayPath(unsigned int level) const;
+
+  /** Returns true if the IORegion is to be pasted into an existing
+   * array with the same dimensions, spacing, origin, direction and pixel
+   * type. Any other existing array is rewritten with its metadata. */
+  bool
+  CanPasteIntoArray();
+
+  /** Chunk size used for a new array of the current dimensions. */
+  ChunkSizeType
+  ComputeChunkSizeForWriting() const;
+
+  /** Reads, decodes and byte swaps the chunk at chunkIndex, returning
+   * false if the chunk file does not exist. */
+  bool
+  ReadChunk(const std::vector<SizeValueType> & chunkIndex, std::vector<char> & chunk) const;
+
+  void
+  WriteChunk(const std::vector<SizeValueType> & chunkIndex, std::vector<char> & chunk) const;
+
+  std::string
+  GetChunkFileName(const std::vector<SizeValueType> & chunkIndex) const;
+
+  /** Fills the chunk with the array's fill value. Chunks are kept in
+   * the byte order of the system in memory. */
+  void
+  FillChunk(std::vector<char> & chunk) const;
+
+  unsigned int  m_ResolutionLevel{ 0 };
+  unsigned int  m_NumberOfResolutionLevels{ 0 };
+  ChunkSizeType m_ChunkSize;
+  std::string   m_CompressorId{ "zlib" };
+
+  // layout of the array being read or written, m_ArrayChunkSize being
+  // in image order and without the channel axis
+  ChunkSizeType            m_ArrayChunkSize;
+  std::vector<std::string> m_DatasetPaths;
+  std::string              m_ArrayPath;
+  std::string              m_ArrayCompressor;
+  char                     m_DimensionSeparator{ '.' };
+  bool                     m_ByteSwap{ false };
+  double                   m_FillValue{ 0.0 };
+};
+} // end namespace itk
+
+#endif // itkZarrImageIO_h
@@ -0,0 +1,19 @@
+set(DOCUMENTATION "This module contains classes for reading and writing chunked
+N-dimensional images stored in a Zarr (version 2) directory store, including
+the multiscale pyramids of the OME-NGFF convention. https://zarr.readthedocs.io
+https://ngff.openmicroscopy.org")
+
+itk_module(ITKIOZarr
+  ENABLE_SHARED
+  DEPENDS
+    ITKIOImageBase
+  PRIVATE_DEPENDS
+    ITKDoubleConversion
+    ITKZLIB
+  TEST_DEPENDS
+    ITKTestKernel
+  FACTORY_NAMES
+    ImageIO::Zarr
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
@@ -0,0 +1,1375 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrImageIO.h"
+#include "itkZarrImageIOPrivate.h"
+#include "itkByteSwapper.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+#include "itkThreadPool.h"
+#include "itksys/SystemTools.hxx"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+
+/** Threader of the chunks. A thread of the pool, e.g. when ImageSeriesReader
+ * reads slices in parallel, must not wait for work added to the pool: it
+ * processes the chunks with a single work unit, run by the calling thread. */
+MultiThreaderBase::Pointer
+CreateChunkThreader()
+{
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  if (ThreadPool::IsPoolThread())
+  {
+    threader->SetNumberOfWorkUnits(1);
+  }
+  return threader;
+}
+
+std::string
+StripTrailingSeparator(std::string path)
+{
+  while (path.size() > 1 && (path.back() == '/' || path.back() == '\\'))
+  {
+    path.pop_back();
+  }
+  return path;
+}
+
+bool
+ReadFileIntoBuffer(const std::string & fileName, std::vector<char> & buffer)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  const std::streamoff length = file.tellg();
+  file.seekg(0, std::ios::beg);
+  buffer.resize(static_cast<size_t>(length));
+  file.read(buffer.data(), length);
+  return !file.fail();
+}
+
+ZarrJSONValue
+ReadJSONFile(const std::string & fileName)
+{
+  std::vector<char> text;
+  if (!ReadFileIntoBuffer(fileName, text))
+  {
+    itkGenericExceptionMacro("Unable to read " << fileName);
+  }
+  try
+  {
+    return ZarrJSONValue::Parse(std::string(text.begin(), text.end()));
+  }
+  catch (ExceptionObject & e)
+  {
+    itkGenericExceptionMacro("Unable to parse " << fileName << ": " << e.GetDescription());
+  }
+}
+
+void
+WriteJSONFile(const std::string & fileName, const ZarrJSONValue & value)
+{
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::trunc);
+  value.Write(file);
+  file << '\n';
+  if (file.fail())
+  {
+    itkGenericExceptionMacro("Unable to write " << fileName);
+  }
+}
+
+bool
+IsZarrStore(const std::string & path)
+{
+  return itksys::SystemTools::FileIsDirectory(path) &&
+         (itksys::SystemTools::FileExists(path + "/.zarray", true) ||
+          itksys::SystemTools::FileExists(path + "/.zgroup", true));
+}
+
+/** Returns the "multiscales" array of the group attributes at path, or
+ * nullptr. */
+const ZarrJSONValue *
+FindMultiscales(const ZarrJSONValue & attributes)
+{
+  const ZarrJSONValue * multiscales = attributes.Find("multiscales");
+  if (multiscales == nullptr || !multiscales->IsArray() || multiscales->GetArray().empty() ||
+      !multiscales->GetArray().front().IsObject())
+  {
+    return nullptr;
+  }
+  return multiscales;
+}
+
+const ZarrJSONValue *
+FindCoordinateTransformation(const ZarrJSONValue & dataset, const std::string & type)
+{
+  const ZarrJSONValue * transformations = dataset.Find("coordinateTransformations");
+  if (transformations == nullptr || !transformations->IsArray())
+  {
+    return nullptr;
+  }
+  for (const auto & transformation : transformations->GetArray())
+  {
+    const ZarrJSONValue * transformationType = transformation.Find("type");
+    const ZarrJSONValue * values = transformation.Find(type);
+    if (transformationType != nullptr && transformationType->IsString() && transformationType->GetString() == type &&
+        values != nullptr && values->IsArray())
+    {
+      return values;
+    }
+  }
+  return nullptr;
+}
+
+ZarrJSONValue
+MakeNumberArray(const std::vector<double> & values)
+{
+  ZarrJSONValue array = ZarrJSONValue::MakeArray();
+  for (const double value : values)
+  {
+    array.Append(ZarrJSONValue(value));
+  }
+  return array;
+}
+
+std::string
+ComponentTypeToDType(IOComponentEnum componentType, unsigned int componentSize)
+{
+  char kind;
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+    case IOComponentEnum::USHORT:
+    case IOComponentEnum::UINT:
+    case IOComponentEnum::ULONG:
+    case IOComponentEnum::ULONGLONG:
+      kind = 'u';
+      break;
+    case IOComponentEnum::CHAR:
+    case IOComponentEnum::SHORT:
+    case IOComponentEnum::INT:
+    case IOComponentEnum::LONG:
+    case IOComponentEnum::LONGLONG:
+      kind = 'i';
+      break;
+    case IOComponentEnum::FLOAT:
+    case IOComponentEnum::DOUBLE:
+      kind = 'f';
+      break;
+    default:
+      itkGenericExceptionMacro("Unsupported component type: " << ImageIOBase::GetComponentTypeAsString(componentType));
+  }
+
+  std::ostringstream dtype;
+  if (componentSize == 1)
+  {
+    dtype << '|';
+  }
+  else
+  {
+    dtype << (ByteSwapper<int>::SystemIsBigEndian() ? '>' : '<');
+  }
+  dtype << kind << componentSize;
+  return dtype.str();
+}
+
+IOComponentEnum
+DTypeToComponentType(const std::string & dtype, bool & byteSwap)
+{
+  if (dtype.size() < 3)
+  {
+    itkGenericExceptionMacro("Invalid Zarr dtype: \"" << dtype << "\"");
+  }
+
+  const char        byteOrder = dtype[0];
+  const char        kind = dtype[1];
+  const std::string size = dtype.substr(2);
+
+  byteSwap = (byteOrder == '<' && ByteSwapper<int>::SystemIsBigEndian()) ||
+             (byteOrder == '>' && ByteSwapper<int>::SystemIsLittleEndian());
+
+  if ((kind == 'u' || kind == 'b') && size == "1")
+  {
+    return IOComponentEnum::UCHAR;
+  }
+  if (kind == 'i' && size == "1")
+  {
+    return IOComponentEnum::CHAR;
+  }
+  if (kind == 'u' && size == "2")
+  {
+    return IOComponentEnum::USHORT;
+  }
+  if (kind == 'i' && size == "2")
+  {
+    return IOComponentEnum::SHORT;
+  }
+  if (kind == 'u' && size == "4")
+  {
+    return IOComponentEnum::UINT;
+  }
+  if (kind == 'i' && size == "4")
+  {
+    return IOComponentEnum::INT;
+  }
+  if (kind == 'u' && size == "8")
+  {
+    return IOComponentEnum::ULONGLONG;
+  }
+  if (kind == 'i' && size == "8")
+  {
+    return IOComponentEnum::LONGLONG;
+  }
+  if (kind == 'f' && size == "4")
+  {
+    return IOComponentEnum::FLOAT;
+  }
+  if (kind == 'f' && size == "8")
+  {
+    return IOComponentEnum::DOUBLE;
+  }
+  itkGenericExceptionMacro("Unsupported Zarr dtype: \"" << dtype << "\"");
+}
+
+template <typename TComponent>
+void
+FillComponents(char * buffer, size_t numberOfComponents, double value)
+{
+  const auto component = static_cast<TComponent>(value);
+  std::fill_n(reinterpret_cast<TComponent *>(buffer), numberOfComponents, component);
+}
+
+void
+SwapComponents(char * buffer, size_t numberOfComponents, unsigned int componentSize)
+{
+  for (size_t i = 0; i < numberOfComponents; ++i, buffer += componentSize)
+  {
+    std::reverse(buffer, buffer + componentSize);
+  }
+}
+
+/** Inflates a zlib or gzip stream, returning false if it does not
+ * decompress to exactly length bytes. */
+bool
+Inflate(const std::vector<char> & compressed, char * output, size_t length)
+{
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  // automatic detection of the zlib and gzip headers
+  if (inflateInit2(&stream, 15 + 32) != Z_OK)
+  {
+    return false;
+  }
+
+  // zlib counts the input and output in uInt, so chunks of 4 GiB or more
+  // are passed in pieces
+  constexpr size_t maximumPieceLength = std::numeric_limits<uInt>::max();
+  size_t           inputLeft = compressed.size();
+  size_t           outputLeft = length;
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()));
+  stream.next_out = reinterpret_cast<Bytef *>(output);
+  int status = Z_OK;
+  while (status == Z_OK)
+  {
+    if (stream.avail_in == 0)
+    {
+      stream.avail_in = static_cast<uInt>(std::min(inputLeft, maximumPieceLength));
+      inputLeft -= stream.avail_in;
+    }
+    if (stream.avail_out == 0)
+    {
+      stream.avail_out = static_cast<uInt>(std::min(outputLeft, maximumPieceLength));
+      outputLeft -= stream.avail_out;
+    }
+    status = inflate(&stream, Z_NO_FLUSH);
+  }
+  const bool success = status == Z_STREAM_END && outputLeft == 0 && stream.avail_out == 0;
+  inflateEnd(&stream);
+  return success;
+}
+
+bool
+Deflate(const char * input, size_t length, int level, bool gzip, std::vector<char> & compressed)
+{
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  if (deflateInit2(&stream, level, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+
+  // zlib counts the input and output in uInt, so chunks of 4 GiB or more
+  // are passed in pieces, and the output grows when the bound of the
+  // first piece, with room for the gzip header, is exceeded
+  constexpr size_t maximumPieceLength = std::numeric_limits<uInt>::max();
+  compressed.resize(deflateBound(&stream, static_cast<uLong>(std::min(length, maximumPieceLength))) + 32);
+  size_t inputLeft = length;
+  size_t outputLength = 0;
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input));
+  int status = Z_OK;
+  while (status == Z_OK)
+  {
+    if (stream.avail_in == 0)
+    {
+      stream.avail_in = static_cast<uInt>(std::min(inputLeft, maximumPieceLength));
+      inputLeft -= stream.avail_in;
+    }
+    if (outputLength == compressed.size())
+    {
+      compressed.resize(outputLength + outputLength / 2);
+    }
+    stream.next_out = reinterpret_cast<Bytef *>(compressed.data() + outputLength);
+    stream.avail_out = static_cast<uInt>(std::min(compressed.size() - outputLength, maximumPieceLength));
+    const uInt availableOutput = stream.avail_out;
+    status = deflate(&stream, inputLeft == 0 ? Z_FINISH : Z_NO_FLUSH);
+    outputLength += availableOutput - stream.avail_out;
+  }
+  compressed.resize(outputLength);
+  deflateEnd(&stream);
+  return status == Z_STREAM_END;
+}
+
+/** The chunks of a chunk grid overlapping a region, enumerated with the
+ * first dimension varying fastest. */
+class ChunkRange
+{
+public:
+  ChunkRange(const ImageIORegion & region, const std::vector<SizeValueType> & chunkSize)
+    : m_First(chunkSize.size())
+    , m_Count(chunkSize.size())
+  {
+    for (unsigned int d = 0; d < chunkSize.size(); ++d)
+    {
+      const auto start = static_cast<SizeValueType>(region.GetIndex(d));
+      m_First[d] = start / chunkSize[d];
+      m_Count[d] = (start + region.GetSize(d) - 1) / chunkSize[d] - m_First[d] + 1;
+      m_NumberOfChunks *= m_Count[d];
+    }
+  }
+
+  SizeValueType
+  GetNumberOfChunks() const
+  {
+    return m_NumberOfChunks;
+  }
+
+  std::vector<SizeValueType>
+  GetChunkIndex(SizeValueType n) const
+  {
+    std::vector<SizeValueType> chunkIndex(m_First.size());
+    for (unsigned int d = 0; d < m_First.size(); ++d)
+    {
+      chunkIndex[d] = m_First[d] + n % m_Count[d];
+      n /= m_Count[d];
+    }
+    return chunkIndex;
+  }
+
+private:
+  std::vector<SizeValueType> m_First;
+  std::vector<SizeValueType> m_Count;
+  SizeValueType              m_NumberOfChunks{ 1 };
+};
+
+/** Copies a block of copySize pixels between two N-D buffers, the
+ * block starting at sourceStart and destinationStart respectively. */
+void
+CopyBlock(const char *                       source,
+          const std::vector<SizeValueType> & sourceSize,
+          const std::vector<SizeValueType> & sourceStart,
+          char *                             destination,
+          const std::vector<SizeValueType> & destinationSize,
+          const std::vector<SizeValueType> & destinationStart,
+          const std::vector<SizeValueType> & copySize,
+          size_t                             pixelSize)
+{
+  const auto                 dimension = static_cast<unsigned int>(copySize.size());
+  const size_t               rowLength = copySize[0] * pixelSize;
+  std::vector<SizeValueType> position(dimension, 0);
+
+  while (true)
+  {
+    size_t sourceOffset = 0;
+    size_t destinationOffset = 0;
+    size_t sourceStride = 1;
+    size_t destinationStride = 1;
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      sourceOffset += (sourceStart[d] + position[d]) * sourceStride;
+      destinationOffset += (destinationStart[d] + position[d]) * destinationStride;
+      sourceStride *= sourceSize[d];
+      destinationStride *= destinationSize[d];
+    }
+    std::memcpy(destination + destinationOffset * pixelSize, source + sourceOffset * pixelSize, rowLength);
+
+    unsigned int d = 1;
+    for (; d < dimension; ++d)
+    {
+      if (++position[d] < copySize[d])
+      {
+        break;
+      }
+      position[d] = 0;
+    }
+    if (d >= dimension)
+    {
+      return;
+    }
+  }
+}
+
+} // end anonymous namespace
+
+ZarrImageIO::ZarrImageIO()
+  : StreamingImageIOBase()
+{
+  this->SetNumberOfComponents(1);
+  this->SetNumberOfDimensions(3);
+  this->SetFileTypeToBinary();
+
+  this->AddSupportedWriteExtension(".zarr");
+  this->AddSupportedReadExtension(".zarr");
+
+  this->Self::SetCompressor("");
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(1);
+}
+
+ZarrImageIO::~ZarrImageIO() = default;
+
+void
+ZarrImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ResolutionLevel: " << m_ResolutionLevel << std::endl;
+  os << indent << "NumberOfResolutionLevels: " << m_NumberOfResolutionLevels << std::endl;
+  os << indent << "ChunkSize: [";
+  for (size_t i = 0; i < m_ChunkSize.size(); ++i)
+  {
+    os << (i ? ", " : "") << m_ChunkSize[i];
+  }
+  os << "]" << std::endl;
+}
+
+void
+ZarrImageIO::SetChunkSize(const ChunkSizeType & chunkSize)
+{
+  if (m_ChunkSize != chunkSize)
+  {
+    m_ChunkSize = chunkSize;
+    this->Modified();
+  }
+}
+
+ImageIOBase::SizeType
+ZarrImageIO::GetHeaderSize() const
+{
+  return 0;
+}
+
+void
+ZarrImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "ZLIB")
+  {
+    m_CompressorId = "zlib";
+  }
+  else if (_compressor == "GZIP")
+  {
+    m_CompressorId = "gzip";
+  }
+  else
+  {
+    this->Superclass::InternalSetCompressor(_compressor);
+  }
+}
+
+bool
+ZarrImageIO::CanReadFile(const char * filename)
+{
+  const std::string path = StripTrailingSeparator(filename);
+  if (path.empty() || !IsZarrStore(path))
+  {
+    return false;
+  }
+  if (itksys::SystemTools::FileExists(path + "/.zarray", true))
+  {
+    return true;
+  }
+  try
+  {
+    return FindMultiscales(ReadJSONFile(path + "/.zattrs")) != nullptr;
+  }
+  catch (ExceptionObject &)
+  {
+    return false;
+  }
+}
+
+bool
+ZarrImageIO::CanWriteFile(const char * filename)
+{
+  return this->HasSupportedWriteExtension(StripTrailingSeparator(filename).c_str());
+}
+
+std::string
+ZarrImageIO::GetArrayPath(unsigned int level) const
+{
+  const std::string storePath = StripTrailingSeparator(m_FileName);
+  if (level >= m_DatasetPaths.size() || m_DatasetPaths[level].empty())
+  {
+    return storePath;
+  }
+  return storePath + "/" + m_DatasetPaths[level];
+}
+
+std::vector<SizeValueType>
+ZarrImageIO::ReadArrayHeader(const std::string & arrayPath)
+{
+  const ZarrJSONValue header = ReadJSONFile(arrayPath + "/.zarray");
+
+  const ZarrJSONValue * format = header.Find("zarr_format");
+  if (format == nullptr || !format->IsNumber() || format->GetNumber() != 2.0)
+  {
+    itkExceptionMacro("Only version 2 of the Zarr format is supported: " << arrayPath);
+  }
+
+  const ZarrJSONValue * shape = header.Find("shape");
+  const ZarrJSONValue * chunks = header.Find("chunks");
+  if (shape == nullptr || chunks == nullptr || !shape->IsArray() || !chunks->IsArray() || shape->GetArray().empty() ||
+      shape->GetArray().size() != chunks->GetArray().size())
+  {
+    itkExceptionMacro("Invalid shape or chunks in " << arrayPath);
+  }
+
+  const auto                 numberOfAxes = static_cast<unsigned int>(shape->GetArray().size());
+  std::vector<SizeValueType> arrayShape(numberOfAxes);
+  m_ArrayChunkSize.resize(numberOfAxes);
+  for (unsigned int i = 0; i < numberOfAxes; ++i)
+  {
+    arrayShape[i] = static_cast<SizeValueType>(shape->GetArray()[i].GetNumber());
+    // image order, the last Zarr axis being the fastest
+    m_ArrayChunkSize[numberOfAxes - 1 - i] = static_cast<SizeValueType>(chunks->GetArray()[i].GetNumber());
+    if (arrayShape[i] == 0 || m_ArrayChunkSize[numberOfAxes - 1 - i] == 0)
+    {
+      itkExceptionMacro("Empty arrays are not supported: " << arrayPath);
+    }
+  }
+
+  const ZarrJSONValue * order = header.Find("order");
+  if (order != nullptr && order->IsString() && order->GetString() != "C")
+  {
+    itkExceptionMacro("Only arrays in C order are supported: " << arrayPath);
+  }
+
+  const ZarrJSONValue * filters = header.Find("filters");
+  if (filters != nullptr && !filters->IsNull() && !(filters->IsArray() && filters->GetArray().empty()))
+  {
+    itkExceptionMacro("Zarr filters are not supported: " << arrayPath);
+  }
+
+  const ZarrJSONValue * dtype = header.Find("dtype");
+  if (dtype == nullptr || !dtype->IsString())
+  {
+    itkExceptionMacro("Structured Zarr dtypes are not supported: " << arrayPath);
+  }
+  this->SetComponentType(DTypeToComponentType(dtype->GetString(), m_ByteSwap));
+
+  m_ArrayCompressor.clear();
+  const ZarrJSONValue * compressor = header.Find("compressor");
+  if (compressor != nullptr && !compressor->IsNull())
+  {
+    const ZarrJSONValue * id = compressor->Find("id");
+    if (id == nullptr || !id->IsString() || (id->GetString() != "zlib" && id->GetString() != "gzip"))
+    {
+      itkExceptionMacro("Unsupported Zarr compressor in " << arrayPath << ", only zlib and gzip are supported");
+    }
+    m_ArrayCompressor = id->GetString();
+  }
+
+  m_FillValue = 0.0;
+  const ZarrJSONValue * fillValue = header.Find("fill_value");
+  if (fillValue != nullptr && fillValue->IsNumber())
+  {
+    m_FillValue = fillValue->GetNumber();
+  }
+  else if (fillValue != nullptr && fillValue->IsString() && fillValue->GetString() == "NaN")
+  {
+    m_FillValue = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  m_DimensionSeparator = '.';
+  const ZarrJSONValue * separator = header.Find("dimension_separator");
+  if (separator != nullptr && separator->IsString() && separator->GetString() == "/")
+  {
+    m_DimensionSeparator = '/';
+  }
+
+  m_ArrayPath = arrayPath;
+  return arrayShape;
+}
+
+void
+ZarrImageIO::ReadImageInformation()
+{
+  const std::string storePath = StripTrailingSeparator(m_FileName);
+
+  ZarrJSONValue         attributes = ZarrJSONValue::MakeObject();
+  const ZarrJSONValue * multiscale = nullptr;
+  if (itksys::SystemTools::FileExists(storePath + "/.zattrs", true))
+  {
+    attributes = ReadJSONFile(storePath + "/.zattrs");
+    const ZarrJSONValue * multiscales = FindMultiscales(attributes);
+    if (multiscales != nullptr)
+    {
+      multiscale = &multiscales->GetArray().front();
+    }
+  }
+
+  m_DatasetPaths.clear();
+  const ZarrJSONValue * datasets = multiscale != nullptr ? multiscale->Find("datasets") : nullptr;
+  if (datasets != nullptr && datasets->IsArray())
+  {
+    for (const auto & dataset : datasets->GetArray())
+    {
+      const ZarrJSONValue * path = dataset.Find("path");
+      if (path == nullptr || !path->IsString())
+      {
+        itkExceptionMacro("Multiscale dataset without path in " << storePath);
+      }
+      m_DatasetPaths.push_back(path->GetString());
+    }
+  }
+  else if (itksys::SystemTools::FileExists(storePath + "/.zarray", true))
+  {
+    m_DatasetPaths.emplace_back();
+  }
+
+  m_NumberOfResolutionLevels = static_cast<unsigned int>(m_DatasetPaths.size());
+  if (m_NumberOfResolutionLevels == 0)
+  {
+    itkExceptionMacro("No Zarr array or multiscale group found in " << storePath);
+  }
+  if (m_ResolutionLevel >= m_NumberOfResolutionLevels)
+  {
+    itkExceptionMacro("Resolution level " << m_ResolutionLevel << " requested but " << storePath << " only has "
+                                          << m_NumberOfResolutionLevels << " level(s)");
+  }
+
+  const std::vector<SizeValueType> shape = this->ReadArrayHeader(this->GetArrayPath(m_ResolutionLevel));
+  auto                             numberOfAxes = static_cast<unsigned int>(shape.size());
+
+  // a trailing channel axis holds the components of the pixels
+  bool                  hasChannelAxis = false;
+  const ZarrJSONValue * axes = multiscale != nullptr ? multiscale->Find("axes") : nullptr;
+  if (axes != nullptr && axes->IsArray() && axes->GetArray().size() == numberOfAxes && numberOfAxes > 1)
+  {
+    const ZarrJSONValue & lastAxis = axes->GetArray().back();
+    if (lastAxis.IsString())
+    {
+      hasChannelAxis = lastAxis.GetString() == "c";
+    }
+    else
+    {
+      const ZarrJSONValue * type = lastAxis.Find("type");
+      hasChannelAxis = type != nullptr && type->IsString() && type->GetString() == "channel";
+    }
+  }
+
+  unsigned int numberOfComponents = 1;
+  if (hasChannelAxis)
+  {
+    numberOfComponents = static_cast<unsigned int>(shape.back());
+    if (m_ArrayChunkSize.front() != numberOfComponents)
+    {
+      itkExceptionMacro("Arrays chunked along the channel axis are not supported: " << m_ArrayPath);
+    }
+    m_ArrayChunkSize.erase(m_ArrayChunkSize.begin());
+    --numberOfAxes;
+  }
+  m_ChunkSize = m_ArrayChunkSize;
+
+  this->SetNumberOfComponents(numberOfComponents);
+  this->SetPixelType(numberOfComponents == 1 ? IOPixelEnum::SCALAR : IOPixelEnum::VECTOR);
+  const ZarrJSONValue * itkAttributes = attributes.Find("itk");
+  const ZarrJSONValue * pixelType = itkAttributes != nullptr ? itkAttributes->Find("pixelType") : nullptr;
+  if (pixelType != nullptr && pixelType->IsString())
+  {
+    this->SetPixelType(ImageIOBase::GetPixelTypeFromString(pixelType->GetString()));
+  }
+
+  this->SetNumberOfDimensions(numberOfAxes);
+  const ZarrJSONValue * dataset =
+    datasets != nullptr && datasets->IsArray() ? &datasets->GetArray()[m_ResolutionLevel] : nullptr;
+  const ZarrJSONValue * scale = dataset != nullptr ? FindCoordinateTransformation(*dataset, "scale") : nullptr;
+  const ZarrJSONValue * translation =
+    dataset != nullptr ? FindCoordinateTransformation(*dataset, "translation") : nullptr;
+  for (unsigned int d = 0; d < numberOfAxes; ++d)
+  {
+    const unsigned int axis = numberOfAxes - 1 - d;
+    this->SetDimensions(d, shape[axis]);
+    this->SetSpacing(d, 1.0);
+    this->SetOrigin(d, 0.0);
+    if (scale != nullptr && scale->GetArray().size() == shape.size())
+    {
+      this->SetSpacing(d, scale->GetArray()[axis].GetNumber());
+    }
+    if (translation != nullptr && translation->GetArray().size() == shape.size())
+    {
+      this->SetOrigin(d, translation->GetArray()[axis].GetNumber());
+    }
+  }
+
+  const ZarrJSONValue * direction = itkAttributes != nullptr ? itkAttributes->Find("direction") : nullptr;
+  for (unsigned int j = 0; j < numberOfAxes; ++j)
+  {
+    std::vector<double> axisDirection(numberOfAxes, 0.0);
+    axisDirection[j] = 1.0;
+    if (direction != nullptr && direction->IsArray() && direction->GetArray().size() == numberOfAxes * numberOfAxes)
+    {
+      for (unsigned int i = 0; i < numberOfAxes; ++i)
+      {
+        axisDirection[i] = direction->GetArray()[i * numberOfAxes + j].GetNumber();
+      }
+    }
+    this->SetDirection(j, axisDirection);
+  }
+}
+
+std::string
+ZarrImageIO::GetChunkFileName(const std::vector<SizeValueType> & chunkIndex) const
+{
+  std::ostringstream fileName;
+  fileName << m_ArrayPath << '/';
+  // the key lists the chunk indices in Zarr (C) order
+  for (size_t i = chunkIndex.size(); i > 0; --i)
+  {
+    fileName << chunkIndex[i - 1];
+    if (i > 1)
+    {
+      fileName << m_DimensionSeparator;
+    }
+  }
+  if (this->GetNumberOfComponents() > 1)
+  {
+    fileName << m_DimensionSeparator << 0;
+  }
+  return fileName.str();
+}
+
+void
+ZarrImageIO::FillChunk(std::vector<char> & chunk) const
+{
+  const size_t numberOfComponents = chunk.size() / this->GetComponentSize();
+  const double value = std::isnan(m_FillValue) && this->GetComponentType() != IOComponentEnum::FLOAT &&
+                           this->GetComponentType() != IOComponentEnum::DOUBLE
+                         ? 0.0
+                         : m_FillValue;
+  switch (this->GetComponentType())
+  {
+    case IOComponentEnum::UCHAR:
+      FillComponents<unsigned char>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::CHAR:
+      FillComponents<signed char>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::USHORT:
+      FillComponents<unsigned short>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::SHORT:
+      FillComponents<short>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::UINT:
+      FillComponents<unsigned int>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::INT:
+      FillComponents<int>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::ULONG:
+      FillComponents<unsigned long>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::LONG:
+      FillComponents<long>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::ULONGLONG:
+      FillComponents<unsigned long long>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::LONGLONG:
+      FillComponents<long long>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::FLOAT:
+      FillComponents<float>(chunk.data(), numberOfComponents, value);
+      break;
+    case IOComponentEnum::DOUBLE:
+      FillComponents<double>(chunk.data(), numberOfComponents, value);
+      break;
+    default:
+      itkExceptionMacro("Unsupported component type");
+  }
+}
+
+bool
+ZarrImageIO::ReadChunk(const std::vector<SizeValueType> & chunkIndex, std::vector<char> & chunk) const
+{
+  const std::string fileName = this->GetChunkFileName(chunkIndex);
+  std::vector<char> data;
+  if (!ReadFileIntoBuffer(fileName, data))
+  {
+    // chunks which were never written hold the fill value
+    return false;
+  }
+
+  if (m_ArrayCompressor.empty())
+  {
+    if (data.size() != chunk.size())
+    {
+      itkExceptionMacro("Unexpected size of chunk " << fileName);
+    }
+    std::memcpy(chunk.data(), data.data(), chunk.size());
+  }
+  else if (!Inflate(data, chunk.data(), chunk.size()))
+  {
+    itkExceptionMacro("Unable to decompress chunk " << fileName);
+  }
+
+  if (m_ByteSwap)
+  {
+    SwapComponents(chunk.data(), chunk.size() / this->GetComponentSize(), this->GetComponentSize());
+  }
+  return true;
+}
+
+void
+ZarrImageIO::WriteChunk(const std::vector<SizeValueType> & chunkIndex, std::vector<char> & chunk) const
+{
+  if (m_ByteSwap)
+  {
+    SwapComponents(chunk.data(), chunk.size() / this->GetComponentSize(), this->GetComponentSize());
+  }
+
+  const std::string fileName = this->GetChunkFileName(chunkIndex);
+  std::vector<char> compressed;
+  const char *      data = chunk.data();
+  size_t            length = chunk.size();
+  if (!m_ArrayCompressor.empty())
+  {
+    if (!Deflate(chunk.data(), chunk.size(), m_CompressionLevel, m_ArrayCompressor == "gzip", compressed))
+    {
+      itkExceptionMacro("Unable to compress chunk " << fileName);
+    }
+    data = compressed.data();
+    length = compressed.size();
+  }
+
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(data, static_cast<std::streamsize>(length));
+  if (file.fail())
+  {
+    itkExceptionMacro("Unable to write chunk " << fileName);
+  }
+}
+
+void
+ZarrImageIO::Read(void * buffer)
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+
+  // the IORegion may have fewer dimensions than the file
+  ImageIORegion              region(numberOfDimensions);
+  std::vector<SizeValueType> regionStart(numberOfDimensions);
+  std::vector<SizeValueType> regionSize(numberOfDimensions);
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    const bool inRegion = d < m_IORegion.GetImageDimension();
+    region.SetIndex(d, inRegion ? m_IORegion.GetIndex(d) : 0);
+    region.SetSize(d, inRegion ? m_IORegion.GetSize(d) : 1);
+    regionStart[d] = static_cast<SizeValueType>(region.GetIndex(d));
+    regionSize[d] = region.GetSize(d);
+    if (region.GetIndex(d) < 0 || regionStart[d] + regionSize[d] > this->GetDimensions(d))
+    {
+      itkExceptionMacro("Requested region " << m_IORegion << " is outside of the image");
+    }
+  }
+
+  const size_t pixelSize = this->GetPixelSize();
+  size_t       chunkLength = pixelSize;
+  for (const SizeValueType size : m_ArrayChunkSize)
+  {
+    chunkLength *= size;
+  }
+
+  const ChunkRange chunks(region, m_ArrayChunkSize);
+  auto *           output = static_cast<char *>(buffer);
+
+  // each chunk is decoded into a private buffer then copied into its
+  // own, disjoint, part of the output
+  MultiThreaderBase::Pointer threader = CreateChunkThreader();
+  threader->ParallelizeArray(
+    0,
+    chunks.GetNumberOfChunks(),
+    [&](SizeValueType n) {
+      const std::vector<SizeValueType> chunkIndex = chunks.GetChunkIndex(n);
+      std::vector<char>                chunk(chunkLength);
+      if (!this->ReadChunk(chunkIndex, chunk))
+      {
+        this->FillChunk(chunk);
+      }
+
+      std::vector<SizeValueType> sourceStart(numberOfDimensions);
+      std::vector<SizeValueType> destinationStart(numberOfDimensions);
+      std::vector<SizeValueType> copySize(numberOfDimensions);
+      for (unsigned int d = 0; d < numberOfDimensions; ++d)
+      {
+        const SizeValueType chunkStart = chunkIndex[d] * m_ArrayChunkSize[d];
+        const SizeValueType first = std::max(chunkStart, regionStart[d]);
+        const SizeValueType last = std::min(chunkStart + m_ArrayChunkSize[d], regionStart[d] + regionSize[d]);
+        sourceStart[d] = first - chunkStart;
+        destinationStart[d] = first - regionStart[d];
+        copySize[d] = last - first;
+      }
+      CopyBlock(chunk.data(),
+                m_ArrayChunkSize,
+                sourceStart,
+                output,
+                regionSize,
+                destinationStart,
+                copySize,
+                pixelSize);
+    },
+    nullptr);
+}
+
+ZarrImageIO::ChunkSizeType
+ZarrImageIO::ComputeChunkSizeForWriting() const
+{
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  // about 2^18 pixels per chunk, that is 512x512 or 64x64x64
+  const auto defaultSize =
+    static_cast<SizeValueType>(std::floor(std::pow(262144.0, 1.0 / numberOfDimensions) + 1e-6));
+
+  ChunkSizeType chunkSize(numberOfDimensions);
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    chunkSize[d] = d < m_ChunkSize.size() && m_ChunkSize[d] > 0 ? m_ChunkSize[d] : defaultSize;
+    chunkSize[d] = std::max<SizeValueType>(1, std::min<SizeValueType>(chunkSize[d], this->GetDimensions(d)));
+  }
+  return chunkSize;
+}
+
+bool
+ZarrImageIO::CanPasteIntoArray()
+{
+  if (!this->RequestedToStream())
+  {
+    return false;
+  }
+
+  Pointer reader = Self::New();
+  reader->SetFileName(m_FileName);
+  reader->SetResolutionLevel(m_ResolutionLevel);
+  try
+  {
+    if (!reader->CanReadFile(m_FileName.c_str()))
+    {
+      return false;
+    }
+    reader->ReadImageInformation();
+  }
+  catch (ExceptionObject &)
+  {
+    return false;
+  }
+
+  if (reader->GetNumberOfDimensions() != this->GetNumberOfDimensions() ||
+      reader->GetComponentType() != this->GetComponentType() ||
+      reader->GetNumberOfComponents() != this->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (unsigned int d = 0; d < this->GetNumberOfDimensions(); ++d)
+  {
+    if (reader->GetDimensions(d) != this->GetDimensions(d) ||
+        Math::NotExactlyEquals(reader->GetSpacing(d), this->GetSpacing(d)) ||
+        Math::NotExactlyEquals(reader->GetOrigin(d), this->GetOrigin(d)) ||
+        reader->GetDirection(d) != this->GetDirection(d))
+    {
+      return false;
+    }
+  }
+  // the "itk" attributes of the store
+  if (reader->GetPixelType() != this->GetPixelType())
+  {
+    return false;
+  }
+
+  // keep the layout of the existing array
+  m_DatasetPaths = reader->m_DatasetPaths;
+  m_ArrayChunkSize = reader->m_ArrayChunkSize;
+  m_ArrayPath = reader->m_ArrayPath;
+  m_ArrayCompressor = reader->m_ArrayCompressor;
+  m_DimensionSeparator = reader->m_DimensionSeparator;
+  m_ByteSwap = reader->m_ByteSwap;
+  m_FillValue = reader->m_FillValue;
+  return true;
+}
+
+void
+ZarrImageIO::WriteImageInformation()
+{
+  if (this->CanPasteIntoArray())
+  {
+    return;
+  }
+
+  const std::string  storePath = StripTrailingSeparator(m_FileName);
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  const unsigned int numberOfAxes = numberOfDimensions + (numberOfComponents > 1 ? 1 : 0);
+
+  ZarrJSONValue attributes = ZarrJSONValue::MakeObject();
+  ZarrJSONValue multiscale = ZarrJSONValue::MakeObject();
+  ZarrJSONValue datasets = ZarrJSONValue::MakeArray();
+  if (m_ResolutionLevel == 0)
+  {
+    // a new store replaces any previous one, with all its levels
+    if (IsZarrStore(storePath) && !itksys::SystemTools::RemoveADirectory(storePath))
+    {
+      itkExceptionMacro("Unable to remove existing Zarr store " << storePath);
+    }
+
+    ZarrJSONValue axes = ZarrJSONValue::MakeArray();
+    const char *  names[] = { "x", "y", "z", "t" };
+    for (unsigned int d = numberOfDimensions; d > 0; --d)
+    {
+      ZarrJSONValue axis = ZarrJSONValue::MakeObject();
+      axis.Set("name", d <= 4 ? std::string(names[d - 1]) : "d" + std::to_string(d - 1));
+      axis.Set("type", d == 4 ? "time" : "space");
+      axes.Append(axis);
+    }
+    if (numberOfComponents > 1)
+    {
+      ZarrJSONValue axis = ZarrJSONValue::MakeObject();
+      axis.Set("name", "c");
+      axis.Set("type", "channel");
+      axes.Append(axis);
+    }
+    multiscale.Set("version", "0.4");
+    multiscale.Set("name", itksys::SystemTools::GetFilenameWithoutExtension(storePath));
+    multiscale.Set("axes", axes);
+
+    std::vector<double> direction(numberOfDimensions * numberOfDimensions);
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      for (unsigned int j = 0; j < numberOfDimensions; ++j)
+      {
+        direction[i * numberOfDimensions + j] = this->GetDirection(j)[i];
+      }
+    }
+    ZarrJSONValue itkAttributes = ZarrJSONValue::MakeObject();
+    itkAttributes.Set("direction", MakeNumberArray(direction));
+    itkAttributes.Set("pixelType", ImageIOBase::GetPixelTypeAsString(this->GetPixelType()));
+    attributes.Set("itk", itkAttributes);
+  }
+  else
+  {
+    // add a level to an existing pyramid
+    if (itksys::SystemTools::FileExists(storePath + "/.zattrs", true))
+    {
+      attributes = ReadJSONFile(storePath + "/.zattrs");
+    }
+    const ZarrJSONValue * multiscales = FindMultiscales(attributes);
+    const ZarrJSONValue * existingDatasets =
+      multiscales != nullptr ? multiscales->GetArray().front().Find("datasets") : nullptr;
+    const ZarrJSONValue * axes = multiscales != nullptr ? multiscales->GetArray().front().Find("axes") : nullptr;
+    if (existingDatasets == nullptr || !existingDatasets->IsArray() ||
+        existingDatasets->GetArray().size() < m_ResolutionLevel)
+    {
+      itkExceptionMacro("Resolution level " << m_ResolutionLevel
+                                            << " can only be written after the previous levels of " << storePath);
+    }
+    if (axes == nullptr || !axes->IsArray() || axes->GetArray().size() != numberOfAxes)
+    {
+      itkExceptionMacro("The dimension of resolution level " << m_ResolutionLevel << " does not match " << storePath);
+    }
+    multiscale = multiscales->GetArray().front();
+    datasets = *existingDatasets;
+  }
+
+  m_DatasetPaths.clear();
+  for (const auto & dataset : datasets.GetArray())
+  {
+    const ZarrJSONValue * path = dataset.Find("path");
+    m_DatasetPaths.push_back(path != nullptr && path->IsString() ? path->GetString() : "");
+  }
+  if (m_ResolutionLevel == m_DatasetPaths.size())
+  {
+    m_DatasetPaths.push_back(std::to_string(m_ResolutionLevel));
+    datasets.Append(ZarrJSONValue::MakeObject());
+  }
+  m_ArrayPath = this->GetArrayPath(m_ResolutionLevel);
+  if (m_ArrayPath == storePath)
+  {
+    itkExceptionMacro("Resolution level " << m_ResolutionLevel << " of " << storePath << " has no dataset path");
+  }
+
+  // the array metadata, in Zarr (C) order
+  m_ArrayChunkSize = this->ComputeChunkSizeForWriting();
+  m_ArrayCompressor = m_UseCompression ? m_CompressorId : "";
+  m_DimensionSeparator = '.';
+  m_ByteSwap = false;
+  m_FillValue = 0.0;
+
+  std::vector<double> shape;
+  std::vector<double> chunks;
+  std::vector<double> scale;
+  std::vector<double> translation;
+  for (unsigned int d = numberOfDimensions; d > 0; --d)
+  {
+    shape.push_back(static_cast<double>(this->GetDimensions(d - 1)));
+    chunks.push_back(static_cast<double>(m_ArrayChunkSize[d - 1]));
+    scale.push_back(this->GetSpacing(d - 1));
+    translation.push_back(this->GetOrigin(d - 1));
+  }
+  if (numberOfComponents > 1)
+  {
+    shape.push_back(static_cast<double>(numberOfComponents));
+    chunks.push_back(static_cast<double>(numberOfComponents));
+    scale.push_back(1.0);
+    translation.push_back(0.0);
+  }
+
+  ZarrJSONValue header = ZarrJSONValue::MakeObject();
+  header.Set("zarr_format", 2.0);
+  header.Set("shape", MakeNumberArray(shape));
+  header.Set("chunks", MakeNumberArray(chunks));
+  header.Set("dtype", ComponentTypeToDType(this->GetComponentType(), this->GetComponentSize()));
+  if (m_ArrayCompressor.empty())
+  {
+    header.Set("compressor", ZarrJSONValue());
+  }
+  else
+  {
+    ZarrJSONValue compressor = ZarrJSONValue::MakeObject();
+    compressor.Set("id", m_ArrayCompressor);
+    compressor.Set("level", static_cast<double>(m_CompressionLevel));
+    header.Set("compressor", compressor);
+  }
+  header.Set("fill_value", m_FillValue);
+  header.Set("order", "C");
+  header.Set("filters", ZarrJSONValue());
+  header.Set("dimension_separator", ".");
+
+  ZarrJSONValue scaleTransformation = ZarrJSONValue::MakeObject();
+  scaleTransformation.Set("type", "scale");
+  scaleTransformation.Set("scale", MakeNumberArray(scale));
+  ZarrJSONValue translationTransformation = ZarrJSONValue::MakeObject();
+  translationTransformation.Set("type", "translation");
+  translationTransformation.Set("translation", MakeNumberArray(translation));
+  ZarrJSONValue transformations = ZarrJSONValue::MakeArray();
+  transformations.Append(scaleTransformation);
+  transformations.Append(translationTransformation);
+
+  ZarrJSONValue & dataset = datasets.GetArray()[m_ResolutionLevel];
+  dataset = ZarrJSONValue::MakeObject();
+  dataset.Set("path", m_DatasetPaths[m_ResolutionLevel]);
+  dataset.Set("coordinateTransformations", transformations);
+  multiscale.Set("datasets", datasets);
+  ZarrJSONValue multiscales = ZarrJSONValue::MakeArray();
+  multiscales.Append(multiscale);
+  attributes.Set("multiscales", multiscales);
+
+  ZarrJSONValue group = ZarrJSONValue::MakeObject();
+  group.Set("zarr_format", 2.0);
+
+  // the previous content of a replaced level is removed with it
+  if (itksys::SystemTools::FileIsDirectory(m_ArrayPath) && !itksys::SystemTools::RemoveADirectory(m_ArrayPath))
+  {
+    itkExceptionMacro("Unable to remove existing Zarr array " << m_ArrayPath);
+  }
+  if (!itksys::SystemTools::MakeDirectory(m_ArrayPath))
+  {
+    itkExceptionMacro("Unable to create directory " << m_ArrayPath);
+  }
+  WriteJSONFile(storePath + "/.zgroup", group);
+  WriteJSONFile(storePath + "/.zattrs", attributes);
+  WriteJSONFile(m_ArrayPath + "/.zarray", header);
+}
+
+void
+ZarrImageIO::Write(const void * buffer)
+{
+  this->WriteImageInformation();
+
+  const unsigned int         numberOfDimensions = this->GetNumberOfDimensions();
+  std::vector<SizeValueType> regionStart(numberOfDimensions);
+  std::vector<SizeValueType> regionSize(numberOfDimensions);
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    regionStart[d] = static_cast<SizeValueType>(m_IORegion.GetIndex(d));
+    regionSize[d] = m_IORegion.GetSize(d);
+  }
+
+  const size_t pixelSize = this->GetPixelSize();
+  size_t       chunkLength = pixelSize;
+  for (const SizeValueType size : m_ArrayChunkSize)
+  {
+    chunkLength *= size;
+  }
+
+  const ChunkRange chunks(m_IORegion, m_ArrayChunkSize);
+  if (m_DimensionSeparator == '/')
+  {
+    // nested chunk keys need their directories before the parallel section
+    for (SizeValueType n = 0; n < chunks.GetNumberOfChunks(); ++n)
+    {
+      itksys::SystemTools::MakeDirectory(
+        itksys::SystemTools::GetFilenamePath(this->GetChunkFileName(chunks.GetChunkIndex(n))));
+    }
+  }
+
+  const auto * input = static_cast<const char *>(buffer);
+
+  MultiThreaderBase::Pointer threader = CreateChunkThreader();
+  threader->ParallelizeArray(
+    0,
+    chunks.GetNumberOfChunks(),
+    [&](SizeValueType n) {
+      const std::vector<SizeValueType> chunkIndex = chunks.GetChunkIndex(n);
+
+      std::vector<SizeValueType> sourceStart(numberOfDimensions);
+      std::vector<SizeValueType> destinationStart(numberOfDimensions);
+      std::vector<SizeValueType> copySize(numberOfDimensions);
+      bool                       covered = true;
+      for (unsigned int d = 0; d < numberOfDimensions; ++d)
+      {
+        const SizeValueType chunkStart = chunkIndex[d] * m_ArrayChunkSize[d];
+        const SizeValueType chunkEnd = std::min(chunkStart + m_ArrayChunkSize[d], this->GetDimensions(d));
+        const SizeValueType first = std::max(chunkStart, regionStart[d]);
+        const SizeValueType last = std::min(chunkEnd, regionStart[d] + regionSize[d]);
+        sourceStart[d] = first - regionStart[d];
+        destinationStart[d] = first - chunkStart;
+        copySize[d] = last - first;
+        covered = covered && first == chunkStart && last == chunkEnd;
+      }
+
+      // a partially written chunk is merged with its previous content,
+      // edge chunks are padded with the fill value
+      std::vector<char> chunk(chunkLength);
+      if (covered || !this->ReadChunk(chunkIndex, chunk))
+      {
+        this->FillChunk(chunk);
+      }
+      CopyBlock(input, regionSize, sourceStart, chunk.data(), m_ArrayChunkSize, destinationStart, copySize, pixelSize);
+      this->WriteChunk(chunkIndex, chunk);
+    },
+    nullptr);
+}
+
+unsigned int
+ZarrImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  // the superclass removes an existing file before a streamed write,
+  // which fails for the directory of a store: WriteImageInformation()
+  // replaces the store, or the level, instead
+  const unsigned int numberOfSplits =
+    pasteRegion == largestPossibleRegion
+      ? this->GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion)
+      : Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+
+  m_ArrayChunkSize = this->ComputeChunkSizeForWriting();
+  const Pointer reader = Self::New();
+  reader->SetFileName(m_FileName);
+  reader->SetResolutionLevel(m_ResolutionLevel);
+  try
+  {
+    if (pasteRegion != largestPossibleRegion && reader->CanReadFile(m_FileName.c_str()))
+    {
+      reader->ReadImageInformation();
+      if (reader->m_ArrayChunkSize.size() == m_ArrayChunkSize.size())
+      {
+        m_ArrayChunkSize = reader->m_ArrayChunkSize;
+      }
+    }
+  }
+  catch (ExceptionObject &)
+  {
+    // the file is replaced, keep the chunking of a new array
+  }
+
+  // the number of chunk slabs along the slowest dimension of the region
+  for (unsigned int d = pasteRegion.GetImageDimension(); d > 0; --d)
+  {
+    if (pasteRegion.GetSize(d - 1) > 1 && d - 1 < m_ArrayChunkSize.size())
+    {
+      const SizeValueType chunkSize = m_ArrayChunkSize[d - 1];
+      const auto          start = static_cast<SizeValueType>(pasteRegion.GetIndex(d - 1));
+      const SizeValueType slabs = (start + pasteRegion.GetSize(d - 1) - 1) / chunkSize - start / chunkSize + 1;
+      return static_cast<unsigned int>(std::min<SizeValueType>(numberOfSplits, slabs));
+    }
+  }
+  return 1;
+}
+
+ImageIORegion
+ZarrImageIO::GetSplitRegionForWriting(unsigned int          ithPiece,
+                                      unsigned int          numberOfActualSplits,
+                                      const ImageIORegion & pasteRegion,
+                                      const ImageIORegion & itkNotUsed(largestPossibleRegion))
+{
+  ImageIORegion splitRegion = pasteRegion;
+  for (unsigned int d = pasteRegion.GetImageDimension(); d > 0; --d)
+  {
+    if (pasteRegion.GetSize(d - 1) > 1 && d - 1 < m_ArrayChunkSize.size())
+    {
+      // distribute the chunk slabs evenly among the pieces
+      const SizeValueType chunkSize = m_ArrayChunkSize[d - 1];
+      const auto          start = static_cast<SizeValueType>(pasteRegion.GetIndex(d - 1));
+      const SizeValueType end = start + pasteRegion.GetSize(d - 1);
+      const SizeValueType firstSlab = start / chunkSize;
+      const SizeValueType slabs = (end - 1) / chunkSize - firstSlab + 1;
+      const SizeValueType beginSlab = firstSlab + ithPiece * slabs / numberOfActualSplits;
+      const SizeValueType endSlab = firstSlab + (ithPiece + 1) * slabs / numberOfActualSplits;
+
+      const SizeValueType first = std::max(start, beginSlab * chunkSize);
+      const SizeValueType last = std::min(end, endSlab * chunkSize);
+      splitRegion.SetIndex(d - 1, static_cast<ImageIORegion::IndexValueType>(first));
+      splitRegion.SetSize(d - 1, last - first);
+      break;
+    }
+  }
+  return splitRegion;
+}
+
+} // end namespace itk
@@ -0,0 +1,498 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIOPrivate_h
+#define itkZarrImageIOPrivate_h
+
+#include "itkMacro.h"
+#include "itkNumberToString.h"
+#include "double-conversion/double-conversion.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+/** \class ZarrJSONValue
+ * \brief Minimal JSON document model used for the Zarr metadata files.
+ *
+ * Only what is needed for the ".zarray", ".zattrs" and ".zgroup"
+ * documents is supported: objects keep their insertion order, numbers
+ * are stored as double, and strings are limited to the escapes
+ * emitted by the common Zarr implementations.
+ *
+ * \ingroup ITKIOZarr
+ */
+class ZarrJSONValue
+{
+public:
+  enum class Type
+  {
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  using ArrayType = std::vector<ZarrJSONValue>;
+  using ObjectType = std::vector<std::pair<std::string, ZarrJSONValue>>;
+
+  ZarrJSONValue() = default;
+  ZarrJSONValue(double number)
+    : m_Type(Type::Number)
+    , m_Number(number)
+  {}
+  ZarrJSONValue(bool value)
+    : m_Type(Type::Bool)
+    , m_Bool(value)
+  {}
+  ZarrJSONValue(std::string value)
+    : m_Type(Type::String)
+    , m_String(std::move(value))
+  {}
+  ZarrJSONValue(const char * value)
+    : m_Type(Type::String)
+    , m_String(value)
+  {}
+
+  static ZarrJSONValue
+  MakeArray()
+  {
+    ZarrJSONValue value;
+    value.m_Type = Type::Array;
+    return value;
+  }
+
+  static ZarrJSONValue
+  MakeObject()
+  {
+    ZarrJSONValue value;
+    value.m_Type = Type::Object;
+    return value;
+  }
+
+  Type
+  GetType() const
+  {
+    return m_Type;
+  }
+  bool
+  IsNull() const
+  {
+    return m_Type == Type::Null;
+  }
+  bool
+  IsNumber() const
+  {
+    return m_Type == Type::Number;
+  }
+  bool
+  IsString() const
+  {
+    return m_Type == Type::String;
+  }
+  bool
+  IsArray() const
+  {
+    return m_Type == Type::Array;
+  }
+  bool
+  IsObject() const
+  {
+    return m_Type == Type::Object;
+  }
+
+  double
+  GetNumber() const
+  {
+    return m_Number;
+  }
+  bool
+  GetBool() const
+  {
+    return m_Bool;
+  }
+  const std::string &
+  GetString() const
+  {
+    return m_String;
+  }
+  const ArrayType &
+  GetArray() const
+  {
+    return m_Array;
+  }
+  ArrayType &
+  GetArray()
+  {
+    return m_Array;
+  }
+
+  /** Append to an array value. */
+  void
+  Append(ZarrJSONValue value)
+  {
+    m_Array.push_back(std::move(value));
+  }
+
+  /** Return the member named key, or nullptr if this is not an object
+   * or the member does not exist. */
+  const ZarrJSONValue *
+  Find(const std::string & key) const
+  {
+    for (const auto & member : m_Object)
+    {
+      if (member.first == key)
+      {
+        return &member.second;
+      }
+    }
+    return nullptr;
+  }
+
+  /** Add or replace the member named key. */
+  void
+  Set(const std::string & key, ZarrJSONValue value)
+  {
+    for (auto & member : m_Object)
+    {
+      if (member.first == key)
+      {
+        member.second = std::move(value);
+        return;
+      }
+    }
+    m_Object.emplace_back(key, std::move(value));
+  }
+
+  /** Parse a complete document, throwing an ExceptionObject on
+   * malformed input. */
+  static ZarrJSONValue
+  Parse(const std::string & text)
+  {
+    std::string::size_type pos = 0;
+    ZarrJSONValue          value = ParseValue(text, pos);
+    SkipWhitespace(text, pos);
+    if (pos != text.size())
+    {
+      itkGenericExceptionMacro("Unexpected trailing characters in JSON document at offset " << pos);
+    }
+    return value;
+  }
+
+  /** Serialize with two space indentation. */
+  void
+  Write(std::ostream & os, unsigned int indent = 0) const
+  {
+    switch (m_Type)
+    {
+      case Type::Null:
+        os << "null";
+        break;
+      case Type::Bool:
+        os << (m_Bool ? "true" : "false");
+        break;
+      case Type::Number:
+        WriteNumber(os, m_Number);
+        break;
+      case Type::String:
+        WriteString(os, m_String);
+        break;
+      case Type::Array:
+      {
+        // arrays of scalars are kept on one line
+        bool nested = false;
+        for (const auto & element : m_Array)
+        {
+          nested = nested || element.IsArray() || element.IsObject();
+        }
+        os << '[';
+        for (size_t i = 0; i < m_Array.size(); ++i)
+        {
+          if (nested)
+          {
+            os << '\n' << std::string(indent + 2, ' ');
+          }
+          m_Array[i].Write(os, indent + 2);
+          if (i + 1 < m_Array.size())
+          {
+            os << (nested ? "," : ", ");
+          }
+        }
+        if (nested)
+        {
+          os << '\n' << std::string(indent, ' ');
+        }
+        os << ']';
+        break;
+      }
+      case Type::Object:
+        os << '{';
+        for (size_t i = 0; i < m_Object.size(); ++i)
+        {
+          os << '\n' << std::string(indent + 2, ' ');
+          WriteString(os, m_Object[i].first);
+          os << ": ";
+          m_Object[i].second.Write(os, indent + 2);
+          if (i + 1 < m_Object.size())
+          {
+            os << ',';
+          }
+        }
+        os << '\n' << std::string(indent, ' ') << '}';
+        break;
+    }
+  }
+
+private:
+  static void
+  SkipWhitespace(const std::string & text, std::string::size_type & pos)
+  {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+    {
+      ++pos;
+    }
+  }
+
+  static void
+  Expect(const std::string & text, std::string::size_type & pos, const char * literal)
+  {
+    const std::string::size_type length = std::char_traits<char>::length(literal);
+    if (text.compare(pos, length, literal) != 0)
+    {
+      itkGenericExceptionMacro("Expected \"" << literal << "\" in JSON document at offset " << pos);
+    }
+    pos += length;
+  }
+
+  static std::string
+  ParseString(const std::string & text, std::string::size_type & pos)
+  {
+    // the caller has verified the opening quote
+    ++pos;
+    std::string result;
+    while (pos < text.size() && text[pos] != '"')
+    {
+      char c = text[pos++];
+      if (c == '\\' && pos < text.size())
+      {
+        c = text[pos++];
+        switch (c)
+        {
+          case 'n':
+            c = '\n';
+            break;
+          case 't':
+            c = '\t';
+            break;
+          case 'r':
+            c = '\r';
+            break;
+          case 'b':
+            c = '\b';
+            break;
+          case 'f':
+            c = '\f';
+            break;
+          case 'u':
+          {
+            // only code points in the Latin-1 range are kept as is
+            const unsigned long codePoint = std::strtoul(text.substr(pos, 4).c_str(), nullptr, 16);
+            pos += 4;
+            c = codePoint < 256 ? static_cast<char>(codePoint) : '?';
+            break;
+          }
+          default:
+            break;
+        }
+      }
+      result += c;
+    }
+    if (pos >= text.size())
+    {
+      itkGenericExceptionMacro("Unterminated string in JSON document");
+    }
+    ++pos;
+    return result;
+  }
+
+  static ZarrJSONValue
+  ParseValue(const std::string & text, std::string::size_type & pos)
+  {
+    SkipWhitespace(text, pos);
+    if (pos >= text.size())
+    {
+      itkGenericExceptionMacro("Unexpected end of JSON document");
+    }
+
+    const char c = text[pos];
+    if (c == '{')
+    {
+      ZarrJSONValue value = MakeObject();
+      ++pos;
+      SkipWhitespace(text, pos);
+      if (pos < text.size() && text[pos] == '}')
+      {
+        ++pos;
+        return value;
+      }
+      while (true)
+      {
+        SkipWhitespace(text, pos);
+        if (pos >= text.size() || text[pos] != '"')
+        {
+          itkGenericExceptionMacro("Expected a member name in JSON document at offset " << pos);
+        }
+        std::string key = ParseString(text, pos);
+        SkipWhitespace(text, pos);
+        Expect(text, pos, ":");
+        value.m_Object.emplace_back(std::move(key), ParseValue(text, pos));
+        SkipWhitespace(text, pos);
+        if (pos < text.size() && text[pos] == ',')
+        {
+          ++pos;
+          continue;
+        }
+        Expect(text, pos, "}");
+        return value;
+      }
+    }
+    if (c == '[')
+    {
+      ZarrJSONValue value = MakeArray();
+      ++pos;
+      SkipWhitespace(text, pos);
+      if (pos < text.size() && text[pos] == ']')
+      {
+        ++pos;
+        return value;
+      }
+      while (true)
+      {
+        value.m_Array.push_back(ParseValue(text, pos));
+        SkipWhitespace(text, pos);
+        if (pos < text.size() && text[pos] == ',')
+        {
+          ++pos;
+          continue;
+        }
+        Expect(text, pos, "]");
+        return value;
+      }
+    }
+    if (c == '"')
+    {
+      return ZarrJSONValue(ParseString(text, pos));
+    }
+    if (text.compare(pos, 4, "null") == 0)
+    {
+      pos += 4;
+      return ZarrJSONValue();
+    }
+    if (text.compare(pos, 4, "true") == 0)
+    {
+      pos += 4;
+      return ZarrJSONValue(true);
+    }
+    if (text.compare(pos, 5, "false") == 0)
+    {
+      pos += 5;
+      return ZarrJSONValue(false);
+    }
+
+    // independent of the locale, unlike strtod
+    static const double_conversion::StringToDoubleConverter converter(
+      double_conversion::StringToDoubleConverter::ALLOW_TRAILING_JUNK,
+      0.0,
+      std::numeric_limits<double>::quiet_NaN(),
+      nullptr,
+      nullptr);
+    int          processed = 0;
+    const double number =
+      converter.StringToDouble(text.c_str() + pos, static_cast<int>(text.size() - pos), &processed);
+    if (processed == 0)
+    {
+      itkGenericExceptionMacro("Unexpected character '" << c << "' in JSON document at offset " << pos);
+    }
+    pos += static_cast<std::string::size_type>(processed);
+    return ZarrJSONValue(number);
+  }
+
+  static void
+  WriteNumber(std::ostream & os, double number)
+  {
+    if (std::isnan(number))
+    {
+      // Zarr encodes non-finite fill values as strings
+      os << "\"NaN\"";
+    }
+    else if (std::isinf(number))
+    {
+      os << (number > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+    }
+    else
+    {
+      os << NumberToString<double>()(number);
+    }
+  }
+
+  static void
+  WriteString(std::ostream & os, const std::string & value)
+  {
+    os << '"';
+    for (const char c : value)
+    {
+      switch (c)
+      {
+        case '"':
+          os << "\\\"";
+          break;
+        case '\\':
+          os << "\\\\";
+          break;
+        case '\n':
+          os << "\\n";
+          break;
+        case '\t':
+          os << "\\t";
+          break;
+        default:
+          os << c;
+      }
+    }
+    os << '"';
+  }
+
+  Type        m_Type{ Type::Null };
+  double      m_Number{ 0.0 };
+  bool        m_Bool{ false };
+  std::string m_String;
+  ArrayType   m_Array;
+  ObjectType  m_Object;
+};
+
+} // end namespace itk
+
+#endif // itkZarrImageIOPrivate_h
@@ -0,0 +1,404 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkZarrImageIO.h"
+#include "itkZarrImageIOFactory.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::PixelType
+ExpectedValue(const typename TImage::IndexType & index, int offset)
+{
+  int value = offset;
+  for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+  {
+    value = value * 7 + static_cast<int>(index[d]) * (d + 1);
+  }
+  typename TImage::PixelType pixel;
+  itk::NumericTraits<typename TImage::PixelType>::SetLength(pixel, 1);
+  pixel = static_cast<typename itk::NumericTraits<typename TImage::PixelType>::ValueType>(value % 113);
+  return pixel;
+}
+
+template <>
+itk::RGBPixel<unsigned char>
+ExpectedValue<itk::Image<itk::RGBPixel<unsigned char>, 2>>(const itk::Index<2> & index, int offset)
+{
+  itk::RGBPixel<unsigned char> pixel;
+  pixel[0] = static_cast<unsigned char>(index[0] + offset);
+  pixel[1] = static_cast<unsigned char>(index[1]);
+  pixel[2] = static_cast<unsigned char>(index[0] ^ index[1]);
+  return pixel;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, int offset)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  typename TImage::SpacingType spacing;
+  typename TImage::PointType   origin;
+  for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+  {
+    spacing[d] = 0.5 + d;
+    origin[d] = -3.25 * d;
+  }
+  typename TImage::DirectionType direction;
+  direction.SetIdentity();
+  direction(0, 0) = 0.0;
+  direction(0, 1) = -1.0;
+  direction(1, 0) = 1.0;
+  direction(1, 1) = 0.0;
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetDirection(direction);
+
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue<TImage>(it.GetIndex(), offset));
+  }
+  return image;
+}
+
+template <typename TImage>
+int
+CompareToExpected(const TImage * image, const typename TImage::RegionType & region, int offset)
+{
+  itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedValue<TImage>(it.GetIndex(), offset))
+    {
+      std::cerr << "Unexpected pixel value at " << it.GetIndex() << ": " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename TImage>
+int
+ZarrReadWriteTest(const std::string & fileName, const typename TImage::SizeType & size, const std::string & compressor)
+{
+  using ImageType = TImage;
+
+  typename ImageType::Pointer image = MakeImage<ImageType>(size, 0);
+
+  auto io = itk::ZarrImageIO::New();
+  io->SetCompressor(compressor);
+  io->SetChunkSize(itk::ZarrImageIO::ChunkSizeType(ImageType::ImageDimension, 8));
+
+  // the pieces are aligned with the chunks
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetImageIO(io);
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(!compressor.empty());
+  writer->SetNumberOfStreamDivisions(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto readerIO = itk::ZarrImageIO::New();
+  ITK_TEST_EXPECT_TRUE(readerIO->CanReadFile(fileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(!readerIO->CanReadFile((fileName + "/missing.zarr").c_str()));
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(readerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  const ImageType * output = reader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(output->GetLargestPossibleRegion().GetSize(), size);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetNumberOfResolutionLevels(), 1u);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetChunkSize()[0], 8u);
+  ITK_TEST_EXPECT_TRUE(output->GetSpacing() == image->GetSpacing());
+  ITK_TEST_EXPECT_TRUE(output->GetOrigin() == image->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(output->GetDirection() == image->GetDirection());
+  if (CompareToExpected<ImageType>(output, output->GetLargestPossibleRegion(), 0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // only the chunks overlapping the requested region are read
+  typename ImageType::RegionType requestedRegion;
+  for (unsigned int d = 0; d < ImageType::ImageDimension; ++d)
+  {
+    requestedRegion.SetIndex(d, 3 + d);
+    requestedRegion.SetSize(d, size[d] - 7 - d);
+  }
+  auto streamingReader = itk::ImageFileReader<ImageType>::New();
+  streamingReader->SetFileName(fileName);
+  streamingReader->SetImageIO(itk::ZarrImageIO::New());
+  streamingReader->UseStreamingOn();
+  streamingReader->GetOutput()->SetRequestedRegion(requestedRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+  ITK_TEST_EXPECT_EQUAL(streamingReader->GetOutput()->GetBufferedRegion(), requestedRegion);
+  if (CompareToExpected<ImageType>(streamingReader->GetOutput(), requestedRegion, 0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // a second resolution level, made of every other pixel
+  typename ImageType::SizeType halfSize;
+  for (unsigned int d = 0; d < ImageType::ImageDimension; ++d)
+  {
+    halfSize[d] = size[d] / 2;
+  }
+  typename ImageType::Pointer level1 = MakeImage<ImageType>(halfSize, 5);
+  auto                        levelIO = itk::ZarrImageIO::New();
+  levelIO->SetResolutionLevel(1);
+  writer->SetInput(level1);
+  writer->SetImageIO(levelIO);
+  writer->SetNumberOfStreamDivisions(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // level 3 cannot be written before level 2
+  auto gapIO = itk::ZarrImageIO::New();
+  gapIO->SetResolutionLevel(3);
+  writer->SetImageIO(gapIO);
+  ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+
+  auto levelReaderIO = itk::ZarrImageIO::New();
+  levelReaderIO->SetResolutionLevel(1);
+  reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(levelReaderIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(levelReaderIO->GetNumberOfResolutionLevels(), 2u);
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetLargestPossibleRegion().GetSize(), halfSize);
+  if (CompareToExpected<ImageType>(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion(), 5) !=
+      EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // level 0 is left unchanged
+  readerIO = itk::ZarrImageIO::New();
+  reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(readerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  return CompareToExpected<ImageType>(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion(), 0);
+}
+
+int
+ZarrPasteTest(const std::string & fileName)
+{
+  using ImageType = itk::Image<short, 3>;
+
+  // paste a region which is not aligned with the chunks directly
+  // through the ImageIO
+  auto io = itk::ZarrImageIO::New();
+  io->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(io->ReadImageInformation());
+
+  itk::ImageIORegion pasteRegion(3);
+  ImageType::RegionType region;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    pasteRegion.SetIndex(d, 5);
+    pasteRegion.SetSize(d, 6);
+    region.SetIndex(d, 5);
+    region.SetSize(d, 6);
+  }
+  std::vector<short> pasted(pasteRegion.GetNumberOfPixels(), -1);
+  io->SetIORegion(pasteRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(io->Write(pasted.data()));
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::ZarrImageIO::New());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(reader->GetOutput(),
+                                                      reader->GetOutput()->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const short expected = region.IsInside(it.GetIndex()) ? -1 : ExpectedValue<ImageType>(it.GetIndex(), 0);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Unexpected pasted value at " << it.GetIndex() << ": " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a region of an image whose spacing differs from the one of the store
+  // is not pasted into it: the store is rewritten, with the new spacing
+  io = itk::ZarrImageIO::New();
+  io->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(io->ReadImageInformation());
+  const double spacing = 2.0 * io->GetSpacing(1);
+  io->SetSpacing(1, spacing);
+  io->SetIORegion(pasteRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(io->Write(pasted.data()));
+
+  reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::ZarrImageIO::New());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetSpacing()[1], spacing);
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> rewrittenIt(reader->GetOutput(),
+                                                               reader->GetOutput()->GetLargestPossibleRegion());
+  for (; !rewrittenIt.IsAtEnd(); ++rewrittenIt)
+  {
+    const short expected = region.IsInside(rewrittenIt.GetIndex()) ? -1 : 0;
+    if (rewrittenIt.Get() != expected)
+    {
+      std::cerr << "Unexpected rewritten value at " << rewrittenIt.GetIndex() << ": " << rewrittenIt.Get()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int
+ZarrExternalArrayTest(const std::string & fileName)
+{
+  // a 5x4 big endian array without group, chunked by 3x2, whose last
+  // chunk was never written
+  itksys::SystemTools::RemoveADirectory(fileName);
+  itksys::SystemTools::MakeDirectory(fileName);
+  {
+    std::ofstream header((fileName + "/.zarray").c_str());
+    header << R"({"zarr_format": 2, "shape": [4, 5], "chunks": [2, 3], "dtype": ">i2", "compressor": null,)"
+           << R"( "fill_value": 7, "order": "C", "filters": null, "dimension_separator": "/"})";
+  }
+  for (unsigned int cy = 0; cy < 2; ++cy)
+  {
+    for (unsigned int cx = 0; cx < 2; ++cx)
+    {
+      if (cy == 1 && cx == 1)
+      {
+        continue;
+      }
+      itksys::SystemTools::MakeDirectory(fileName + "/" + std::to_string(cy));
+      std::ofstream chunk((fileName + "/" + std::to_string(cy) + "/" + std::to_string(cx)).c_str(),
+                          std::ios::binary);
+      for (unsigned int y = 0; y < 2; ++y)
+      {
+        for (unsigned int x = 0; x < 3; ++x)
+        {
+          const int  value = 100 * static_cast<int>(cy * 2 + y) + static_cast<int>(cx * 3 + x);
+          const char bytes[2] = { static_cast<char>(value >> 8), static_cast<char>(value & 0xff) };
+          chunk.write(bytes, 2);
+        }
+      }
+    }
+  }
+
+  using ImageType = itk::Image<short, 2>;
+  auto io = itk::ZarrImageIO::New();
+  ITK_TEST_EXPECT_TRUE(io->CanReadFile(fileName.c_str()));
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(io);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(io->GetComponentType(), itk::IOComponentEnum::SHORT);
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(reader->GetOutput(),
+                                                      reader->GetOutput()->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const short expected = index[0] >= 3 && index[1] >= 2 ? 7 : static_cast<short>(100 * index[1] + index[0]);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Unexpected value at " << index << ": " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkZarrImageIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto io = itk::ZarrImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(io, ZarrImageIO, StreamingImageIOBase);
+  ITK_TEST_SET_GET_VALUE(0u, io->GetResolutionLevel());
+  ITK_TEST_EXPECT_TRUE(io->CanWriteFile("image.zarr"));
+  ITK_TEST_EXPECT_TRUE(io->CanWriteFile("image.zarr/"));
+  ITK_TEST_EXPECT_TRUE(!io->CanWriteFile("image.mha"));
+
+  itk::ObjectFactoryBase::RegisterFactory(itk::ZarrImageIOFactory::New());
+
+  using ShortImageType = itk::Image<short, 3>;
+  ShortImageType::SizeType size3D = { { 37, 29, 23 } };
+  const std::string        shortFileName = outputDirectory + "/itkZarrImageIOTestShort.zarr";
+  if (ZarrReadWriteTest<ShortImageType>(shortFileName, size3D, "zlib") != EXIT_SUCCESS)
+  {
+    std::cerr << "Test failed for short images" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (ZarrPasteTest(shortFileName) != EXIT_SUCCESS)
+  {
+    std::cerr << "Test failed for pasting" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using FloatImageType = itk::Image<float, 2>;
+  FloatImageType::SizeType size2D = { { 61, 43 } };
+  if (ZarrReadWriteTest<FloatImageType>(outputDirectory + "/itkZarrImageIOTestFloat.zarr", size2D, "") !=
+      EXIT_SUCCESS)
+  {
+    std::cerr << "Test failed for float images" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 2>;
+  if (ZarrReadWriteTest<RGBImageType>(outputDirectory + "/itkZarrImageIOTestRGB.zarr", size2D, "gzip") !=
+      EXIT_SUCCESS)
+  {
+    std::cerr << "Test failed for RGB images" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (ZarrExternalArrayTest(outputDirectory + "/itkZarrImageIOTestExternal.zarr") != EXIT_SUCCESS)
+  {
+    std::cerr << "Test failed for external array" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,8 @@
 #include "itkIntTypes.h"
 #include "itkObjectToObjectOptimizerBase.h"
 
+#include <exception>
+
 namespace itk
 {
 /**
@@ -73,6 +75,13 @@ namespace itk
  * the number of steps along each dimension, a side of the region is
  * stepLength*(2*numberOfSteps[d]+1)*scaling[d].
  *
+ * The grid positions may be evaluated concurrently by setting
+ * NumberOfConcurrentEvaluations to more than one. The metric is then cloned
+ * once per concurrent evaluation, each clone runs on a share of the work units,
+ * and the values are visited in grid order so that the events, the extrema and
+ * their positions are identical to the serial walk. The metric must support
+ * cloning, as the image to image metrics do.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
@@ -106,6 +115,9 @@ public:
   /** Scales type */
   using ScalesType = typename Superclass::ScalesType;
 
+  /** Metric type */
+  using MetricTypePointer = typename Superclass::MetricTypePointer;
+
   void
   StartOptimization(bool doOnlyInitialization = false) override;
 
@@ -132,6 +144,12 @@ public:
   itkGetConstReferenceMacro(MaximumMetricValuePosition, ParametersType);
   itkGetConstReferenceMacro(CurrentIndex, ParametersType);
 
+  /** Set/Get the number of grid positions that are evaluated concurrently,
+   * each on its own clone of the metric. Defaults to 1, which evaluates the
+   * grid positions one after the other on the metric itself. */
+  itkSetClampMacro(NumberOfConcurrentEvaluations, ThreadIdType, 1, NumericTraits<ThreadIdType>::max());
+  itkGetConstMacro(NumberOfConcurrentEvaluations, ThreadIdType);
+
   /** Get the reason for termination */
   const std::string
   GetStopConditionDescription() const override;
@@ -160,6 +178,14 @@ protected:
   void
   IncrementIndex(ParametersType & param);
 
+  /** Evaluate the metric clones on the grid positions that follow the
+   * current index, in grid order, and return the values. The exception thrown
+   * by an evaluation, if any, is returned in place of its value. */
+  void
+  EvaluateNextPositions(const std::vector<MetricTypePointer> & clones,
+                        std::vector<MeasureType> &             values,
+                        std::vector<std::exception_ptr> &      exceptions) const;
+
 protected:
   ParametersType m_InitialPosition;
   MeasureType    m_CurrentValue;
@@ -171,6 +197,7 @@ protected:
   MeasureType    m_MinimumMetricValue;
   ParametersType m_MinimumMetricValuePosition;
   ParametersType m_MaximumMetricValuePosition;
+  ThreadIdType   m_NumberOfConcurrentEvaluations{ 1 };
 
 private:
   std::ostringstream m_StopConditionDescription;
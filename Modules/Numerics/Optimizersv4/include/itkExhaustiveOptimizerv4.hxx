@@ -19,6 +19,7 @@
 #define itkExhaustiveOptimizerv4_hxx
 
 #include "itkExhaustiveOptimizerv4.h"
+#include "itkPlatformMultiThreader.h"
 
 namespace itk
 {
@@ -102,6 +103,16 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
   itkDebugMacro("ResumeWalk");
   m_Stop = false;
 
+  // The values of the next grid positions, when they are computed ahead on metric clones.
+  std::vector<MetricTypePointer>  clones;
+  std::vector<MeasureType>        values;
+  std::vector<std::exception_ptr> exceptions;
+  size_t                          nextValue = 0;
+  if (m_NumberOfConcurrentEvaluations > 1)
+  {
+    clones = this->CloneMetric(m_NumberOfConcurrentEvaluations);
+  }
+
   while (!m_Stop)
   {
     ParametersType currentPosition = this->GetCurrentPosition();
@@ -112,7 +123,23 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
       break;
     }
 
-    m_CurrentValue = this->m_Metric->GetValue();
+    if (clones.empty())
+    {
+      m_CurrentValue = this->m_Metric->GetValue();
+    }
+    else
+    {
+      if (nextValue == values.size())
+      {
+        this->EvaluateNextPositions(clones, values, exceptions);
+        nextValue = 0;
+      }
+      if (exceptions[nextValue])
+      {
+        std::rethrow_exception(exceptions[nextValue]);
+      }
+      m_CurrentValue = values[nextValue++];
+    }
 
     if (m_CurrentValue > m_MaximumMetricValue)
     {
@@ -205,6 +232,79 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::IncrementIndex(ParametersT
   }
 }
 
+template <typename TInternalComputationValueType>
+void
+ExhaustiveOptimizerv4<TInternalComputationValueType>::EvaluateNextPositions(
+  const std::vector<MetricTypePointer> & clones,
+  std::vector<MeasureType> &             values,
+  std::vector<std::exception_ptr> &      exceptions) const
+{
+  // Evaluate a few positions per clone at a time, so that a walk stopped by an
+  // observer does not pay for the rest of the grid.
+  constexpr SizeValueType positionsPerClone = 8;
+
+  const auto                  numberOfClones = static_cast<ThreadIdType>(clones.size());
+  const unsigned int          spaceDimension = m_CurrentIndex.GetSize();
+  const ScalesType &          scales = this->GetScales();
+  ParametersType              index = m_CurrentIndex;
+  std::vector<ParametersType> positions;
+
+  bool done = false;
+  while (!done && positions.size() < numberOfClones * positionsPerClone)
+  {
+    ParametersType position(spaceDimension);
+    for (unsigned int i = 0; i < spaceDimension; i++)
+    {
+      position[i] = (index[i] - m_NumberOfSteps[i]) * m_StepLength * scales[i] + m_InitialPosition[i];
+    }
+    positions.push_back(position);
+
+    // Same traversal order as IncrementIndex().
+    unsigned int idx = 0;
+    while (idx < spaceDimension)
+    {
+      index[idx]++;
+      if (index[idx] > (2 * m_NumberOfSteps[idx]))
+      {
+        index[idx] = 0;
+        idx++;
+      }
+      else
+      {
+        break;
+      }
+    }
+    done = (idx == spaceDimension);
+  }
+
+  values.assign(positions.size(), MeasureType{});
+  exceptions.assign(positions.size(), nullptr);
+
+  // The clones run on their own threads. The thread pool cannot be used here
+  // because each clone dispatches its own work to the pool and waits on it.
+  auto threader = PlatformMultiThreader::New();
+  threader->SetMaximumNumberOfThreads(numberOfClones);
+  threader->SetNumberOfWorkUnits(numberOfClones);
+  threader->ParallelizeArray(
+    0,
+    numberOfClones,
+    [&](SizeValueType c) {
+      for (size_t i = c; i < positions.size(); i += numberOfClones)
+      {
+        try
+        {
+          clones[c]->SetParameters(positions[i]);
+          values[i] = clones[c]->GetValue();
+        }
+        catch (...)
+        {
+          exceptions[i] = std::current_exception();
+        }
+      }
+    },
+    nullptr);
+}
+
 template <typename TInternalComputationValueType>
 const std::string
 ExhaustiveOptimizerv4<TInternalComputationValueType>::GetStopConditionDescription() const
@@ -236,6 +336,7 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::PrintSelf(std::ostream & o
   os << indent << "MinimumMetricValue = " << m_MinimumMetricValue << std::endl;
   os << indent << "MinimumMetricValuePosition = " << m_MinimumMetricValuePosition << std::endl;
   os << indent << "MaximumMetricValuePosition = " << m_MaximumMetricValuePosition << std::endl;
+  os << indent << "NumberOfConcurrentEvaluations = " << m_NumberOfConcurrentEvaluations << std::endl;
 }
 } // end namespace itk
 
@@ -236,6 +236,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 private:
 };
 
@@ -224,6 +224,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 
   TInternalComputationValueType m_LearningRate;
   TInternalComputationValueType m_MinimumConvergenceValue;
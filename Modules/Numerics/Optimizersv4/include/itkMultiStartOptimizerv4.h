@@ -21,6 +21,8 @@
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkGradientDescentOptimizerv4.h"
 
+#include <exception>
+
 namespace itk
 {
 
@@ -150,6 +152,19 @@ public:
   itkSetObjectMacro(LocalOptimizer, OptimizerType);
   itkGetModifiableObjectMacro(LocalOptimizer, OptimizerType);
 
+  /** Set/Get the number of starting points that are evaluated concurrently.
+   * When greater than one, the metric and the local optimizer are cloned once
+   * per concurrent evaluation and the results are merged in the order of the
+   * parameters list, so that the best parameters, the metric values and the
+   * events are identical to the serial search. The metric must support
+   * cloning, and the local optimizer must not use a scales estimator.
+   * The observers of the local optimizer are not forwarded to its clones:
+   * they receive no events from the concurrent evaluations, while the
+   * observers of this optimizer still receive one IterationEvent per
+   * starting point. Defaults to 1. */
+  itkSetClampMacro(NumberOfConcurrentEvaluations, ThreadIdType, 1, NumericTraits<ThreadIdType>::max());
+  itkGetConstMacro(NumberOfConcurrentEvaluations, ThreadIdType);
+
   inline ParameterListSizeType
   GetBestParametersIndex()
   {
@@ -164,6 +179,17 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Run the starting points that follow the current iteration on the metric
+   * clones, one starting point per clone, and return the parameters and values they
+   * reach. The exception thrown by a starting point, if any, is returned in
+   * place of its results. */
+  void
+  EvaluateNextStartingPoints(const std::vector<MetricTypePointer> & clones,
+                             const std::vector<OptimizerPointer> &  localOptimizers,
+                             ParametersListType &                   parameters,
+                             MetricValuesListType &                 values,
+                             std::vector<std::exception_ptr> &      exceptions) const;
+
   /* Common variables for optimization control and reporting */
   bool                                     m_Stop{ false };
   StopConditionObjectToObjectOptimizerEnum m_StopCondition;
@@ -174,6 +200,7 @@ protected:
   MeasureType                              m_MaximumMetricValue;
   ParameterListSizeType                    m_BestParametersIndex;
   OptimizerPointer                         m_LocalOptimizer;
+  ThreadIdType                             m_NumberOfConcurrentEvaluations{ 1 };
 };
 
 /** This helps to meet backward compatibility */
@@ -19,6 +19,9 @@
 #define itkMultiStartOptimizerv4_hxx
 
 #include "itkMultiStartOptimizerv4.h"
+#include "itkPlatformMultiThreader.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -46,6 +49,7 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::PrintSelf(std::ost
   Superclass::PrintSelf(os, indent);
   os << indent << "Stop condition:" << this->m_StopCondition << std::endl;
   os << indent << "Stop condition description: " << this->m_StopConditionDescription.str() << std::endl;
+  os << indent << "Number of concurrent evaluations: " << this->m_NumberOfConcurrentEvaluations << std::endl;
 }
 
 //-------------------------------------------------------------------
@@ -160,20 +164,68 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
   this->InvokeEvent(StartEvent());
 
+  /* Results of the next starting points, when they are run ahead on clones */
+  std::vector<MetricTypePointer>  clones;
+  std::vector<OptimizerPointer>   localOptimizers;
+  ParametersListType              parameters;
+  MetricValuesListType            values;
+  std::vector<std::exception_ptr> exceptions;
+  size_t                          nextResult = 0;
+  if (this->m_NumberOfConcurrentEvaluations > 1)
+  {
+    clones = this->CloneMetric(this->m_NumberOfConcurrentEvaluations);
+    if (this->m_LocalOptimizer)
+    {
+      const ThreadIdType workUnitsPerClone =
+        std::max(this->GetNumberOfWorkUnits() / this->m_NumberOfConcurrentEvaluations, ThreadIdType{ 1 });
+      for (size_t c = 0; c < clones.size(); ++c)
+      {
+        OptimizerPointer localOptimizer = this->m_LocalOptimizer->Clone();
+        localOptimizer->SetNumberOfWorkUnits(workUnitsPerClone);
+        localOptimizer->SetMetric(clones[c]);
+        localOptimizers.push_back(localOptimizer);
+      }
+    }
+  }
+
   this->m_Stop = false;
   while (!this->m_Stop)
   {
     /* Compute metric value */
     try
     {
-      this->m_Metric->SetParameters(this->m_ParametersList[this->m_CurrentIteration]);
-      if (this->m_LocalOptimizer)
+      if (clones.empty())
       {
-        this->m_LocalOptimizer->SetMetric(this->m_Metric);
-        this->m_LocalOptimizer->StartOptimization();
-        this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        this->m_Metric->SetParameters(this->m_ParametersList[this->m_CurrentIteration]);
+        if (this->m_LocalOptimizer)
+        {
+          this->m_LocalOptimizer->SetMetric(this->m_Metric);
+          this->m_LocalOptimizer->StartOptimization();
+          this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        }
+        this->m_CurrentMetricValue = this->m_Metric->GetValue();
+      }
+      else
+      {
+        if (nextResult == values.size())
+        {
+          this->EvaluateNextStartingPoints(clones, localOptimizers, parameters, values, exceptions);
+          nextResult = 0;
+        }
+        const size_t k = nextResult++;
+        if (this->m_LocalOptimizer && !exceptions[k])
+        {
+          this->m_ParametersList[this->m_CurrentIteration] = parameters[k];
+        }
+        // as in the serial search, the observers of the iteration see the
+        // metric at the parameters of this starting point
+        this->m_Metric->SetParameters(this->m_ParametersList[this->m_CurrentIteration]);
+        if (exceptions[k])
+        {
+          std::rethrow_exception(exceptions[k]);
+        }
+        this->m_CurrentMetricValue = values[k];
       }
-      this->m_CurrentMetricValue = this->m_Metric->GetValue();
       this->m_MetricValuesList.push_back(this->m_CurrentMetricValue);
     }
     catch (ExceptionObject &)
@@ -214,6 +266,52 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   } // while (!m_Stop)
 }
 
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+void
+MultiStartOptimizerv4Template<TInternalComputationValueType>::EvaluateNextStartingPoints(
+  const std::vector<MetricTypePointer> & clones,
+  const std::vector<OptimizerPointer> &  localOptimizers,
+  ParametersListType &                   parameters,
+  MetricValuesListType &                 values,
+  std::vector<std::exception_ptr> &      exceptions) const
+{
+  const auto   numberOfClones = static_cast<ThreadIdType>(clones.size());
+  const size_t count =
+    std::min(static_cast<size_t>(numberOfClones), this->m_ParametersList.size() - this->m_CurrentIteration);
+
+  parameters.assign(count, ParametersType());
+  values.assign(count, MeasureType{});
+  exceptions.assign(count, nullptr);
+
+  // The clones run on their own threads. The thread pool cannot be used here
+  // because each clone dispatches its own work to the pool and waits on it.
+  auto threader = PlatformMultiThreader::New();
+  threader->SetMaximumNumberOfThreads(numberOfClones);
+  threader->SetNumberOfWorkUnits(numberOfClones);
+  threader->ParallelizeArray(
+    0,
+    count,
+    [&](SizeValueType k) {
+      try
+      {
+        ParametersType start = this->m_ParametersList[this->m_CurrentIteration + k];
+        clones[k]->SetParameters(start);
+        if (!localOptimizers.empty())
+        {
+          localOptimizers[k]->StartOptimization();
+          parameters[k] = clones[k]->GetParameters();
+        }
+        values[k] = clones[k]->GetValue();
+      }
+      catch (...)
+      {
+        exceptions[k] = std::current_exception();
+      }
+    },
+    nullptr);
+}
+
 } // namespace itk
 
 #endif
@@ -313,6 +313,18 @@ public:
   bool
   IsInsideVirtualDomain(const VirtualIndexType & index) const;
 
+  /** Reuse the moving space samples of the virtual domain that \c source
+   * computes while it is evaluated, instead of computing them again. The
+   * source must be evaluated first, with the same transform parameters.
+   * This is used by ObjectToObjectMultiMetricv4 to share work between its
+   * component metrics. Returns true if the samples can be shared; the default
+   * implementation never shares. Passing nullptr stops the sharing. */
+  virtual bool
+  SetMovingSampleSource(const Self * itkNotUsed(source))
+  {
+    return false;
+  }
+
   using MetricCategoryType = typename Superclass::MetricCategoryEnum;
 
   /** Get metric category */
@@ -329,6 +341,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** The clone has its own copies of the transforms, and the virtual domain
+   * if it was set by the user. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   /** Verify that virtual domain and displacement field are the same size
    * and in the same physical space. */
   virtual void
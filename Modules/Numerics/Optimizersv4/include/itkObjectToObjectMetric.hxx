@@ -582,6 +582,38 @@ ObjectToObjectMetric<TFixedDimension, TMovingDimension, TVirtualImage, TParamete
   return true;
 }
 
+template <unsigned int TFixedDimension,
+          unsigned int TMovingDimension,
+          typename TVirtualImage,
+          typename TParametersValueType>
+typename LightObject::Pointer
+ObjectToObjectMetric<TFixedDimension, TMovingDimension, TVirtualImage, TParametersValueType>::InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  if (this->m_FixedTransform)
+  {
+    rval->SetFixedTransform(this->m_FixedTransform->Clone());
+  }
+  if (this->m_MovingTransform)
+  {
+    rval->SetMovingTransform(this->m_MovingTransform->Clone());
+  }
+  if (this->m_UserHasSetVirtualDomain)
+  {
+    rval->SetVirtualDomain(this->GetVirtualSpacing(),
+                           this->GetVirtualOrigin(),
+                           this->GetVirtualDirection(),
+                           this->GetVirtualRegion());
+  }
+  return loPtr;
+}
+
 template <unsigned int TFixedDimension,
           unsigned int TMovingDimension,
           typename TVirtualImage,
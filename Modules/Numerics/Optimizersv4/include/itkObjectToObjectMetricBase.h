@@ -101,6 +101,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(ObjectToObjectMetricBaseTemplate, SingleValuedCostFunctionv4Template);
 
+  /** Clone the metric settings. See InternalClone(). */
+  itkCloneMacro(Self);
+
   /** Type used for representing object components  */
   using CoordinateRepresentationType = TInternalComputationValueType;
 
@@ -245,6 +248,12 @@ public:
     return MetricCategoryEnum::UNKNOWN_METRIC;
   }
 
+  /** Set the maximum number of work units an evaluation may be split into.
+   * Metrics that evaluate in parallel override this. It is ignored by default. */
+  virtual void
+  SetMaximumNumberOfWorkUnits(const ThreadIdType itkNotUsed(workUnits))
+  {}
+
 protected:
   ObjectToObjectMetricBaseTemplate();
   ~ObjectToObjectMetricBaseTemplate() override = default;
@@ -252,6 +261,13 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copy the settings of the metric to a new instance, so that the clone can
+   * be initialized and evaluated independently of this metric, e.g. to
+   * evaluate several parameter sets at once. Derived metrics extend this with
+   * their own settings. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   /** Fixed and Moving Objects */
   ObjectConstPointer m_FixedObject;
   ObjectConstPointer m_MovingObject;
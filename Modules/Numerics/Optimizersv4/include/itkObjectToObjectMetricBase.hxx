@@ -58,6 +58,24 @@ ObjectToObjectMetricBaseTemplate<TInternalComputationValueType>::GetCurrentValue
   return m_Value;
 }
 
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+typename LightObject::Pointer
+ObjectToObjectMetricBaseTemplate<TInternalComputationValueType>::InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_FixedObject = this->m_FixedObject;
+  rval->m_MovingObject = this->m_MovingObject;
+  rval->m_GradientSource = this->m_GradientSource;
+  return loPtr;
+}
+
 //-------------------------------------------------------------------
 template <typename TInternalComputationValueType>
 void
@@ -25,6 +25,8 @@
 #include "itkObjectToObjectMetricBase.h"
 #include "itkIntTypes.h"
 
+#include <vector>
+
 namespace itk
 {
 /**\class ObjectToObjectOptimizerBaseTemplateEnums
@@ -124,6 +126,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(ObjectToObjectOptimizerBaseTemplate, Object);
 
+  /** Clone the optimizer settings. See InternalClone(). */
+  itkCloneMacro(Self);
+
   /**  Scale type. */
   using ScalesType = OptimizerParameters<TInternalComputationValueType>;
   using ScalesEstimatorType = OptimizerParameterScalesEstimatorTemplate<TInternalComputationValueType>;
@@ -267,6 +272,18 @@ protected:
   ObjectToObjectOptimizerBaseTemplate();
   ~ObjectToObjectOptimizerBaseTemplate() override;
 
+  /** Copy the settings of the optimizer to a new instance. The metric and
+   * the scales estimator, which is bound to a metric, are not copied. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
+  /** Create \c numberOfClones clones of the metric, to evaluate several
+   * parameter sets at once. Each clone is initialized at the current position
+   * and may use an equal share of the work units of the optimizer. The metric
+   * must support cloning, as the image-to-image metrics do. */
+  std::vector<MetricTypePointer>
+  CloneMetric(ThreadIdType numberOfClones) const;
+
   MetricTypePointer m_Metric;
   ThreadIdType      m_NumberOfWorkUnits;
   SizeValueType     m_CurrentIteration;
@@ -144,6 +144,7 @@ public:
 
   /** Type of Jacobian of transform. */
   using JacobianType = typename TMetric::JacobianType;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
 
   /** SetMetric sets the metric used in the estimation process.
    *  The transforms from the metric will be used for estimation, along
@@ -238,6 +239,14 @@ protected:
   void
   ComputeSquaredJacobianNorms(const VirtualPointType & p, ParametersType & squareNorms);
 
+  /** Compute the transform Jacobian at a physical point in sparse form,
+   * restricted to the parameters the point depends on.
+   * \sa Transform::ComputeSparseJacobianWithRespectToParameters */
+  void
+  ComputeSparseJacobian(const VirtualPointType &     p,
+                        JacobianType &               jacobian,
+                        NonZeroJacobianIndicesType & nonZeroJacobianIndices);
+
   /** Check if the transform being optimized has local support. */
   bool
   TransformHasLocalSupportForScalesEstimation();
@@ -324,6 +324,26 @@ RegistrationParameterScalesEstimator<TMetric>::ComputeSquaredJacobianNorms(const
   }
 }
 
+/** Get the transform Jacobian w.r.t parameters at a point, in sparse form */
+template <typename TMetric>
+void
+RegistrationParameterScalesEstimator<TMetric>::ComputeSparseJacobian(
+  const VirtualPointType &     point,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices)
+{
+  if (this->GetTransformForward())
+  {
+    this->m_Metric->GetMovingTransform()->ComputeSparseJacobianWithRespectToParameters(
+      point, jacobian, nonZeroJacobianIndices);
+  }
+  else
+  {
+    this->m_Metric->GetFixedTransform()->ComputeSparseJacobianWithRespectToParameters(
+      point, jacobian, nonZeroJacobianIndices);
+  }
+}
+
 /** Sample the virtual domain with phyical points
  *  and store the results into this->m_SamplePoints.
  */
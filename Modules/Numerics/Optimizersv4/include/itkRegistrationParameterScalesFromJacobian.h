@@ -68,6 +68,7 @@ public:
   using MovingTransformType = typename Superclass::MovingTransformType;
   using FixedTransformType = typename Superclass::FixedTransformType;
   using JacobianType = typename Superclass::JacobianType;
+  using NonZeroJacobianIndicesType = typename Superclass::NonZeroJacobianIndicesType;
   using VirtualImageConstPointer = typename Superclass::VirtualImageConstPointer;
 
   /** Estimate parameter scales. */
@@ -47,15 +47,26 @@ RegistrationParameterScalesFromJacobian<TMetric>::EstimateScales(ScalesType & pa
   norms.Fill(NumericTraits<typename ParametersType::ValueType>::ZeroValue());
   parameterScales.Fill(NumericTraits<typename ScalesType::ValueType>::OneValue());
 
-  // checking each sample point
+  const SizeValueType        dim = this->GetDimension();
+  JacobianType               jacobian;
+  NonZeroJacobianIndicesType nonZeroJacobianIndices;
+
+  // checking each sample point, accumulating only the parameters it depends on
   for (SizeValueType c = 0; c < numSamples; c++)
   {
     const VirtualPointType point = this->m_SamplePoints[c];
 
-    ParametersType squaredNorms(numPara);
-    this->ComputeSquaredJacobianNorms(point, squaredNorms);
+    this->ComputeSparseJacobian(point, jacobian, nonZeroJacobianIndices);
 
-    norms = norms + squaredNorms;
+    for (SizeValueType k = 0; k < nonZeroJacobianIndices.size(); k++)
+    {
+      typename ParametersType::ValueType squaredNorm = NumericTraits<typename ParametersType::ValueType>::ZeroValue();
+      for (SizeValueType d = 0; d < dim; d++)
+      {
+        squaredNorm += jacobian[d][k] * jacobian[d][k];
+      }
+      norms[nonZeroJacobianIndices[k]] += squaredNorm;
+    }
   } // for numSamples
 
   if (numSamples > 0)
@@ -150,42 +161,27 @@ RegistrationParameterScalesFromJacobian<TMetric>::ComputeSampleStepScales(const
 
   itk::Array<FloatType> dTdt(dim);
 
-  JacobianType jacobianCache;
-  JacobianType jacobian(dim,
-                        (this->GetTransformForward() ? this->m_Metric->GetMovingTransform()->GetNumberOfParameters()
-                                                     : this->m_Metric->GetFixedTransform()->GetNumberOfParameters()));
-
+  JacobianType               jacobian;
+  NonZeroJacobianIndicesType nonZeroJacobianIndices;
 
   // checking each sample point
   for (SizeValueType c = 0; c < numSamples; c++)
   {
     const VirtualPointType & point = this->m_SamplePoints[c];
 
-    if (this->GetTransformForward())
-    {
-      this->m_Metric->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-        point, jacobian, jacobianCache);
-    }
-    else
-    {
-      this->m_Metric->GetFixedTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-        point, jacobian, jacobianCache);
-    }
+    this->ComputeSparseJacobian(point, jacobian, nonZeroJacobianIndices);
 
-    if (!this->IsDisplacementFieldTransform())
-    {
-      dTdt = jacobian * step;
-    }
-    else
-    {
-      SizeValueType offset = this->m_Metric->ComputeParameterOffsetFromVirtualPoint(point, numPara);
+    // For displacement fields the indices refer to the local parameters of the point
+    const SizeValueType offset =
+      this->IsDisplacementFieldTransform() ? this->m_Metric->ComputeParameterOffsetFromVirtualPoint(point, numPara) : 0;
 
-      ParametersType localStep(numPara);
-      for (SizeValueType p = 0; p < numPara; p++)
+    dTdt.Fill(NumericTraits<FloatType>::ZeroValue());
+    for (SizeValueType d = 0; d < dim; d++)
+    {
+      for (SizeValueType k = 0; k < nonZeroJacobianIndices.size(); k++)
       {
-        localStep[p] = step[offset + p];
+        dTdt[d] += jacobian[d][k] * step[offset + nonZeroJacobianIndices[k]];
       }
-      dTdt = jacobian * localStep;
     }
 
     sampleScales[c] = dTdt.two_norm();
@@ -19,6 +19,8 @@
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkMultiThreaderBase.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -219,6 +221,68 @@ ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::GetScalesIni
   return m_Scales.Size() > 0;
 }
 
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+typename LightObject::Pointer
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  if (this->m_ScalesEstimator.IsNotNull())
+  {
+    itkExceptionMacro(<< "An optimizer with a scales estimator cannot be cloned, the estimator is bound to a metric.");
+  }
+  rval->m_NumberOfWorkUnits = this->m_NumberOfWorkUnits;
+  rval->m_NumberOfIterations = this->m_NumberOfIterations;
+  rval->m_Scales = this->m_Scales;
+  rval->m_Weights = this->m_Weights;
+  rval->m_DoEstimateScales = this->m_DoEstimateScales;
+  return loPtr;
+}
+
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+auto
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::CloneMetric(ThreadIdType numberOfClones) const
+  -> std::vector<MetricTypePointer>
+{
+  if (this->m_Metric.IsNull())
+  {
+    itkExceptionMacro("m_Metric must be set.");
+  }
+
+  const ThreadIdType workUnitsPerClone = std::max(this->m_NumberOfWorkUnits / numberOfClones, ThreadIdType{ 1 });
+  ParametersType     position = this->m_Metric->GetParameters();
+
+  std::vector<MetricTypePointer> clones;
+  for (ThreadIdType i = 0; i < numberOfClones; ++i)
+  {
+    MetricTypePointer clone = this->m_Metric->Clone();
+    try
+    {
+      clone->SetMaximumNumberOfWorkUnits(workUnitsPerClone);
+      clone->Initialize();
+    }
+    catch (ExceptionObject & exc)
+    {
+      itkExceptionMacro("A clone of the metric " << this->m_Metric->GetNameOfClass()
+                                                 << " could not be initialized: " << exc.GetDescription());
+    }
+    if (clone->GetNumberOfParameters() != this->m_Metric->GetNumberOfParameters())
+    {
+      itkExceptionMacro("The metric " << this->m_Metric->GetNameOfClass() << " does not support cloning.");
+    }
+    clone->SetParameters(position);
+    clones.push_back(clone);
+  }
+  return clones;
+}
+
 template class ITKOptimizersv4_EXPORT ObjectToObjectOptimizerBaseTemplate<double>;
 template class ITKOptimizersv4_EXPORT ObjectToObjectOptimizerBaseTemplate<float>;
 
@@ -22,6 +22,7 @@
 #include "itkExhaustiveOptimizerv4.h"
 
 #include "itkMath.h"
+#include "itkTestingMacros.h"
 
 /**
  *  The objectif function is the quadratic form:
@@ -320,6 +321,35 @@ itkExhaustiveOptimizerv4Test(int, char *[])
   }
 
 
+  // Evaluate the same grid concurrently on clones of the metric: the walk
+  // must visit the same indices in the same order and find the same extrema.
+  OptimizerType::Pointer concurrentOptimizer = OptimizerType::New();
+  ITK_TEST_SET_GET_VALUE(1, concurrentOptimizer->GetNumberOfConcurrentEvaluations());
+  concurrentOptimizer->SetNumberOfConcurrentEvaluations(3);
+  ITK_TEST_SET_GET_VALUE(3, concurrentOptimizer->GetNumberOfConcurrentEvaluations());
+
+  IndexObserver::Pointer concurrentIdxObserver = IndexObserver::New();
+  concurrentOptimizer->AddObserver(itk::IterationEvent(), concurrentIdxObserver);
+  concurrentOptimizer->SetMetric(metric);
+  concurrentOptimizer->SetScales(parametersScale);
+  concurrentOptimizer->SetStepLength(1.0);
+  concurrentOptimizer->SetNumberOfSteps(steps);
+  metric->SetParameters(initialPosition);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(concurrentOptimizer->StartOptimization());
+
+  if (concurrentIdxObserver->m_VisitedIndices != idxObserver->m_VisitedIndices ||
+      concurrentOptimizer->GetMinimumMetricValue() != itkOptimizer->GetMinimumMetricValue() ||
+      concurrentOptimizer->GetMaximumMetricValue() != itkOptimizer->GetMaximumMetricValue() ||
+      concurrentOptimizer->GetMinimumMetricValuePosition() != itkOptimizer->GetMinimumMetricValuePosition() ||
+      concurrentOptimizer->GetMaximumMetricValuePosition() != itkOptimizer->GetMaximumMetricValuePosition())
+  {
+    std::cout << "The concurrent evaluation differs from the serial one." << std::endl;
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+
   std::cout << "Testing PrintSelf " << std::endl;
   itkOptimizer->Print(std::cout);
 
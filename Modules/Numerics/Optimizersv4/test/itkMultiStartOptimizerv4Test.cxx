@@ -15,7 +15,9 @@
  *  limitations under the License.
  *
  *=========================================================================*/
+#include "itkCommand.h"
 #include "itkMultiStartOptimizerv4.h"
+#include "itkTestingMacros.h"
 
 /**
  *  \class MultiStartOptimizerv4TestMetric for test
@@ -149,6 +151,35 @@ private:
   ParametersType m_Parameters;
 };
 
+/** Record the parameters of the metric at each iteration of the
+ * multi-start optimizer. */
+class MultiStartOptimizerv4TestObserver : public itk::Command
+{
+public:
+  using Self = MultiStartOptimizerv4TestObserver;
+  using Superclass = itk::Command;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+
+  void
+  Execute(itk::Object * caller, const itk::EventObject & event) override
+  {
+    Execute((const itk::Object *)caller, event);
+  }
+
+  void
+  Execute(const itk::Object * caller, const itk::EventObject & event) override
+  {
+    if (itk::IterationEvent().CheckEvent(&event))
+    {
+      const auto * optimizer = static_cast<const itk::MultiStartOptimizerv4 *>(caller);
+      m_Parameters.push_back(optimizer->GetMetric()->GetParameters());
+    }
+  }
+
+  std::vector<itk::MultiStartOptimizerv4::ParametersType> m_Parameters;
+};
+
 ///////////////////////////////////////////////////////////
 int
 MultiStartOptimizerv4RunTest(itk::MultiStartOptimizerv4::Pointer & itkOptimizer)
@@ -295,5 +326,55 @@ itkMultiStartOptimizerv4Test(int, char *[])
     return EXIT_FAILURE;
   }
   std::cout << "Test 3 passed." << std::endl;
+
+  /*
+   * Test 4
+   */
+  std::cout << "Test optimization 4: with local optimizer, evaluated concurrently" << std::endl;
+  parametersList.clear();
+  for (int i = -3; i < 3; i++)
+  {
+    for (int j = -3; j < 3; j++)
+    {
+      ParametersType testPosition(spaceDimension);
+      testPosition[0] = 10.0 * i;
+      testPosition[1] = 10.0 * j;
+      parametersList.push_back(testPosition);
+    }
+  }
+  OptimizerType::ParametersListType serialParametersList = parametersList;
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(serialParametersList);
+  auto serialObserver = MultiStartOptimizerv4TestObserver::New();
+  auto observerTag = itkOptimizer->AddObserver(itk::IterationEvent(), serialObserver);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  itkOptimizer->RemoveObserver(observerTag);
+  serialParametersList = itkOptimizer->GetParametersList();
+  const OptimizerType::MetricValuesListType serialValues = itkOptimizer->GetMetricValuesList();
+  const auto                                serialBestIndex = itkOptimizer->GetBestParametersIndex();
+
+  ITK_TEST_SET_GET_VALUE(1, itkOptimizer->GetNumberOfConcurrentEvaluations());
+  itkOptimizer->SetNumberOfConcurrentEvaluations(4);
+  ITK_TEST_SET_GET_VALUE(4, itkOptimizer->GetNumberOfConcurrentEvaluations());
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  auto concurrentObserver = MultiStartOptimizerv4TestObserver::New();
+  itkOptimizer->AddObserver(itk::IterationEvent(), concurrentObserver);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (itkOptimizer->GetParametersList() != serialParametersList ||
+      itkOptimizer->GetMetricValuesList() != serialValues ||
+      itkOptimizer->GetBestParametersIndex() != serialBestIndex ||
+      concurrentObserver->m_Parameters != serialObserver->m_Parameters)
+  {
+    std::cerr << "The concurrent evaluation differs from the serial one." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test 4 passed." << std::endl;
   return EXIT_SUCCESS;
 }
@@ -19,23 +19,39 @@
 #define itkPointsLocator_h
 
 #include "itkObject.h"
-
 #include "itkPoint.h"
 #include "itkIntTypes.h"
-#include "itkKdTree.h"
-#include "itkKdTreeGenerator.h"
 #include "itkVectorContainer.h"
-#include "itkVectorContainerToListSampleAdaptor.h"
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+#  include "itkKdTreeGenerator.h"
+#  include "itkVectorContainerToListSampleAdaptor.h"
+#endif
+
+#include <vector>
 
 namespace itk
 {
-
 /** \class PointsLocator
  * \brief Accelerate geometric searches for points.
  *
  * This class accelerates the search for the closest point to a user-provided
  * point, by using constructing a Kd-Tree structure for the PointSetContainer.
  *
+ * The tree is balanced by splitting each node at the median of its widest
+ * dimension. It is stored implicitly in flat arrays which hold a copy of the
+ * point coordinates, so searches do not go through the points container.
+ * Initialize() builds the subtrees below the first few levels concurrently,
+ * and FindClosestPoints() distributes a batch of queries over the work units
+ * of the multi-threader. The search methods are const and may be called from
+ * several threads at once.
+ *
+ * When the points move by small amounts, e.g. between iterations of a
+ * point set registration, Refit() updates the coordinates without rebuilding
+ * the tree as long as no point has moved farther than
+ * MaximumRefitDisplacement from where it was when the tree was built.
+ * Searches then widen their pruning bounds by the largest displacement,
+ * which keeps their results exact.
+ *
  * \ingroup ITKRegistrationCommon
  */
 template <typename TPointsContainer = VectorContainer<IdentifierType, Point<float, 3>>>
@@ -70,16 +86,19 @@ public:
   using PointsContainerConstIterator = typename PointsContainer::ConstIterator;
   using PointsContainerIterator = typename PointsContainer::Iterator;
 
-  /** Type of the PointsContainer to List Adaptor. */
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+  /** Types of the Statistics::KdTree the locator was previously built on.
+   * \deprecated The locator stores its own tree and no longer uses them. */
   using SampleAdaptorType = Statistics::VectorContainerToListSampleAdaptor<PointsContainer>;
   using SampleAdaptorPointer = typename SampleAdaptorType::Pointer;
-
-  /** Types fo the KdTreeGenerator */
   using TreeGeneratorType = Statistics::KdTreeGenerator<SampleAdaptorType>;
   using TreeGeneratorPointer = typename TreeGeneratorType::Pointer;
   using TreeType = typename TreeGeneratorType::KdTreeType;
   using TreeConstPointer = typename TreeType::ConstPointer;
-  using NeighborsIdentifierType = typename TreeType::InstanceIdentifierVectorType;
+#endif
+
+  using NeighborsIdentifierType = std::vector<IdentifierType>;
+  using PointIdentifierVectorType = std::vector<PointIdentifier>;
 
   /** Set/Get the points from which the bounding box should be computed. */
   itkSetObjectMacro(Points, PointsContainer);
@@ -87,14 +106,43 @@ public:
   /** Set/Get the points from which the bounding box should be computed. */
   itkGetModifiableObjectMacro(Points, PointsContainer);
 
+  /** Set/Get the maximum number of points in a leaf of the tree. Takes effect
+   * at the next build. Default = 16. */
+  itkSetClampMacro(BucketSize, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(BucketSize, unsigned int);
+
+  /** Set/Get the largest displacement of a point, since the tree was built,
+   * which Refit() absorbs without rebuilding the tree. Default = 0, i.e. the
+   * tree is rebuilt as soon as any point has moved. */
+  itkSetMacro(MaximumRefitDisplacement, double);
+  itkGetConstMacro(MaximumRefitDisplacement, double);
+
+  /** Get the largest displacement of a point since the tree was last built.
+   * It is zero after Initialize() and is updated by Refit(). */
+  itkGetConstMacro(RefitDisplacement, double);
+
   /** Compute the kd-tree that will facilitate the querying the points. */
   void
   Initialize();
 
+  /** Update the locator after the points have moved. The points container
+   * may be replaced by one holding the same point identifiers, in the same
+   * order. The tree is kept if no point moved farther than
+   * MaximumRefitDisplacement since it was built, otherwise it is rebuilt as
+   * in Initialize(). */
+  void
+  Refit();
+
   /** Find the closest point */
   PointIdentifier
   FindClosestPoint(const PointType & query) const;
 
+  /** Find the closest point to each of the query points. The queries are
+   * distributed over the work units of the multi-threader, and the result
+   * follows the iteration order of the query container. */
+  void
+  FindClosestPoints(const PointsContainer * queries, PointIdentifierVectorType & closestPoints) const;
+
   /** Find the k-nearest neighbors.  Returns the point ids. */
   void
   Search(const PointType &, unsigned int, NeighborsIdentifierType &) const;
@@ -112,16 +160,85 @@ public:
   FindPointsWithinRadius(const PointType &, double, NeighborsIdentifierType &) const;
 
 protected:
-  PointsLocator();
+  PointsLocator() = default;
   ~PointsLocator() override = default;
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  using TreeIndexType = SizeValueType;
+  using DistanceNeighborType = std::pair<double, TreeIndexType>;
+
+  /** Split the range of the tree at its median along its widest dimension,
+   * ordering m_TreeToContainer accordingly. Returns false for a leaf. */
+  bool
+  SplitRange(TreeIndexType begin, TreeIndexType end, const std::vector<PointType> & points);
+
+  /** Recursively build the subtree over a range of the tree. */
+  void
+  BuildSubtree(TreeIndexType begin, TreeIndexType end, const std::vector<PointType> & points);
+
+  /** Recursive closest point search. */
+  void
+  ClosestPointSearch(TreeIndexType     begin,
+                     TreeIndexType     end,
+                     const PointType & query,
+                     double &          closestSquaredDistance,
+                     TreeIndexType &   closestPoint) const;
+
+  /** Recursive k-nearest neighbor search. The neighbors are kept as a max-heap of squared distances. */
+  void
+  NearestNeighborSearch(TreeIndexType                       begin,
+                        TreeIndexType                       end,
+                        const PointType &                   query,
+                        unsigned int                        numberOfNeighbors,
+                        std::vector<DistanceNeighborType> & neighbors) const;
+
+  /** Recursive search of the points within a radius. */
+  void
+  RadiusSearch(TreeIndexType             begin,
+               TreeIndexType             end,
+               const PointType &         query,
+               double                    radius,
+               NeighborsIdentifierType & neighbors) const;
+
+  /** The point coordinates when the tree was built, which define its
+   * splitting planes. They are only copied when the tree may be refitted. */
+  const std::vector<PointType> &
+  GetBuildTreePoints() const
+  {
+    return this->m_InitialTreePoints.empty() ? this->m_TreePoints : this->m_InitialTreePoints;
+  }
+
+  static double
+  SquaredDistance(const PointType & point1, const PointType & point2)
+  {
+    double squaredDistance = 0.0;
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      const double difference = static_cast<double>(point1[d]) - static_cast<double>(point2[d]);
+      squaredDistance += difference * difference;
+    }
+    return squaredDistance;
+  }
+
   PointsContainerPointer m_Points;
-  SampleAdaptorPointer   m_SampleAdaptor;
-  TreeGeneratorPointer   m_KdTreeGenerator;
-  TreeConstPointer       m_Tree;
+
+  unsigned int m_BucketSize{ 16 };
+  double       m_MaximumRefitDisplacement{ 0.0 };
+  double       m_RefitDisplacement{ 0.0 };
+
+  /** The tree, stored implicitly: the node of the range [begin, end) is the
+   * median begin + (end - begin) / 2, and ranges of at most m_TreeBucketSize
+   * points are leaves. */
+  unsigned int                 m_TreeBucketSize{ 16 };
+  std::vector<PointType>       m_TreePoints;
+  std::vector<PointType>       m_InitialTreePoints;
+  std::vector<PointIdentifier> m_TreeIdentifiers;
+  std::vector<unsigned char>   m_SplitDimensions;
+  std::vector<TreeIndexType>   m_TreeToContainer;
+  std::vector<TreeIndexType>   m_ContainerToTree;
 };
 
 } // end namespace itk
@@ -18,54 +18,402 @@
 #ifndef itkPointsLocator_hxx
 #define itkPointsLocator_hxx
 #include "itkPointsLocator.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <numeric>
 
 namespace itk
 {
 
 template <typename TPointsContainer>
-PointsLocator<TPointsContainer>::PointsLocator()
+void
+PointsLocator<TPointsContainer>::Initialize()
 {
-  this->m_SampleAdaptor = SampleAdaptorType::New();
-  this->m_KdTreeGenerator = TreeGeneratorType::New();
+  if (!this->m_Points)
+  {
+    itkExceptionMacro("The points have not been set (m_Points == nullptr)");
+  }
+
+  if (this->m_Points->Size() == 0)
+  {
+    itkExceptionMacro("The number of points is 0.");
+  }
+
+  const TreeIndexType numberOfPoints = this->m_Points->Size();
+
+  std::vector<PointType>       points;
+  std::vector<PointIdentifier> identifiers;
+  points.reserve(numberOfPoints);
+  identifiers.reserve(numberOfPoints);
+  for (PointsContainerConstIterator It = this->m_Points->Begin(); It != this->m_Points->End(); ++It)
+  {
+    points.push_back(It.Value());
+    identifiers.push_back(It.Index());
+  }
+
+  this->m_TreeBucketSize = this->m_BucketSize;
+  this->m_TreeToContainer.resize(numberOfPoints);
+  std::iota(this->m_TreeToContainer.begin(), this->m_TreeToContainer.end(), TreeIndexType{ 0 });
+  this->m_SplitDimensions.assign(numberOfPoints, 0);
+
+  // Split the top levels of the tree until there are enough independent
+  // subtrees to keep the work units busy, then build the subtrees concurrently.
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  const SizeValueType        numberOfWorkUnits = multiThreader->GetNumberOfWorkUnits();
+  const SizeValueType        numberOfSubtrees = (numberOfWorkUnits > 1) ? 4 * numberOfWorkUnits : 1;
+
+  using RangeType = std::pair<TreeIndexType, TreeIndexType>;
+  std::vector<RangeType> subtrees(1, RangeType(0, numberOfPoints));
+  while (!subtrees.empty() && subtrees.size() < numberOfSubtrees)
+  {
+    std::vector<RangeType> splitSubtrees;
+    for (const RangeType & range : subtrees)
+    {
+      if (this->SplitRange(range.first, range.second, points))
+      {
+        const TreeIndexType median = range.first + (range.second - range.first) / 2;
+        splitSubtrees.emplace_back(range.first, median);
+        splitSubtrees.emplace_back(median + 1, range.second);
+      }
+    }
+    subtrees.swap(splitSubtrees);
+  }
+
+  multiThreader->ParallelizeArray(
+    0,
+    subtrees.size(),
+    [this, &subtrees, &points](SizeValueType i) { this->BuildSubtree(subtrees[i].first, subtrees[i].second, points); },
+    nullptr);
+
+  // Store the points in tree order so that the searches traverse contiguous memory.
+  this->m_TreePoints.resize(numberOfPoints);
+  this->m_TreeIdentifiers.resize(numberOfPoints);
+  this->m_ContainerToTree.resize(numberOfPoints);
+  for (TreeIndexType i = 0; i < numberOfPoints; ++i)
+  {
+    const TreeIndexType containerIndex = this->m_TreeToContainer[i];
+    this->m_TreePoints[i] = points[containerIndex];
+    this->m_TreeIdentifiers[i] = identifiers[containerIndex];
+    this->m_ContainerToTree[containerIndex] = i;
+  }
+  // The build positions are only needed to measure the displacements of a refit.
+  if (this->m_MaximumRefitDisplacement > 0.0)
+  {
+    this->m_InitialTreePoints = this->m_TreePoints;
+  }
+  else
+  {
+    std::vector<PointType>().swap(this->m_InitialTreePoints);
+  }
+  this->m_RefitDisplacement = 0.0;
 }
 
 template <typename TPointsContainer>
 void
-PointsLocator<TPointsContainer>::Initialize()
+PointsLocator<TPointsContainer>::Refit()
 {
   if (!this->m_Points)
   {
     itkExceptionMacro("The points have not been set (m_Points == nullptr)");
   }
-  if (this->m_Points->Size() == 0)
+
+  if (this->m_TreePoints.empty() || this->m_Points->Size() != this->m_TreePoints.size())
   {
-    itkExceptionMacro("The number of points is 0.");
+    this->Initialize();
+    return;
   }
 
-  this->m_SampleAdaptor = SampleAdaptorType::New();
-  this->m_KdTreeGenerator = TreeGeneratorType::New();
+  // Until a refit keeps the tree, the tree points are still the build positions.
+  if (this->m_MaximumRefitDisplacement > 0.0 && this->m_InitialTreePoints.empty())
+  {
+    this->m_InitialTreePoints = this->m_TreePoints;
+  }
+  const std::vector<PointType> & buildTreePoints = this->GetBuildTreePoints();
 
-  // Lack of const-correctness in the PointSetAdaptor should be fixed.
-  this->m_SampleAdaptor->SetVectorContainer(const_cast<PointsContainer *>(this->m_Points.GetPointer()));
+  double        maximumSquaredDisplacement = 0.0;
+  TreeIndexType containerIndex = 0;
+  for (PointsContainerConstIterator It = this->m_Points->Begin(); It != this->m_Points->End(); ++It, ++containerIndex)
+  {
+    const TreeIndexType treeIndex = this->m_ContainerToTree[containerIndex];
+    if (It.Index() != this->m_TreeIdentifiers[treeIndex])
+    {
+      this->Initialize();
+      return;
+    }
+    maximumSquaredDisplacement =
+      std::max(maximumSquaredDisplacement, Self::SquaredDistance(It.Value(), buildTreePoints[treeIndex]));
+    this->m_TreePoints[treeIndex] = It.Value();
+  }
 
-  this->m_SampleAdaptor->SetMeasurementVectorSize(PointDimension);
+  const double displacement = std::sqrt(maximumSquaredDisplacement);
+  if (displacement > this->m_MaximumRefitDisplacement)
+  {
+    this->Initialize();
+  }
+  else
+  {
+    this->m_RefitDisplacement = displacement;
+  }
+}
+
+template <typename TPointsContainer>
+bool
+PointsLocator<TPointsContainer>::SplitRange(TreeIndexType                  begin,
+                                            TreeIndexType                  end,
+                                            const std::vector<PointType> & points)
+{
+  if (end - begin <= this->m_TreeBucketSize)
+  {
+    return false;
+  }
+
+  PointType lowerBound = points[this->m_TreeToContainer[begin]];
+  PointType upperBound = lowerBound;
+  for (TreeIndexType i = begin + 1; i < end; ++i)
+  {
+    const PointType & point = points[this->m_TreeToContainer[i]];
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      lowerBound[d] = std::min(lowerBound[d], point[d]);
+      upperBound[d] = std::max(upperBound[d], point[d]);
+    }
+  }
+
+  unsigned int splitDimension = 0;
+  for (unsigned int d = 1; d < PointDimension; ++d)
+  {
+    if (upperBound[d] - lowerBound[d] > upperBound[splitDimension] - lowerBound[splitDimension])
+    {
+      splitDimension = d;
+    }
+  }
 
-  this->m_KdTreeGenerator->SetSample(this->m_SampleAdaptor);
-  this->m_KdTreeGenerator->SetBucketSize(16);
+  const TreeIndexType median = begin + (end - begin) / 2;
+  std::nth_element(this->m_TreeToContainer.begin() + begin,
+                   this->m_TreeToContainer.begin() + median,
+                   this->m_TreeToContainer.begin() + end,
+                   [&points, splitDimension](TreeIndexType index1, TreeIndexType index2) {
+                     return points[index1][splitDimension] < points[index2][splitDimension];
+                   });
+  this->m_SplitDimensions[median] = static_cast<unsigned char>(splitDimension);
 
-  this->m_KdTreeGenerator->Update();
+  return true;
+}
 
-  this->m_Tree = this->m_KdTreeGenerator->GetOutput();
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::BuildSubtree(TreeIndexType                  begin,
+                                              TreeIndexType                  end,
+                                              const std::vector<PointType> & points)
+{
+  if (this->SplitRange(begin, end, points))
+  {
+    const TreeIndexType median = begin + (end - begin) / 2;
+    this->BuildSubtree(begin, median, points);
+    this->BuildSubtree(median + 1, end, points);
+  }
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::ClosestPointSearch(TreeIndexType     begin,
+                                                    TreeIndexType     end,
+                                                    const PointType & query,
+                                                    double &          closestSquaredDistance,
+                                                    TreeIndexType &   closestPoint) const
+{
+  if (end - begin <= this->m_TreeBucketSize)
+  {
+    for (TreeIndexType i = begin; i < end; ++i)
+    {
+      const double squaredDistance = Self::SquaredDistance(query, this->m_TreePoints[i]);
+      if (squaredDistance < closestSquaredDistance)
+      {
+        closestSquaredDistance = squaredDistance;
+        closestPoint = i;
+      }
+    }
+    return;
+  }
+
+  const TreeIndexType median = begin + (end - begin) / 2;
+  const double        squaredDistance = Self::SquaredDistance(query, this->m_TreePoints[median]);
+  if (squaredDistance < closestSquaredDistance)
+  {
+    closestSquaredDistance = squaredDistance;
+    closestPoint = median;
+  }
+
+  // The splitting plane is where the median point was when the tree was
+  // built; the points may since have crossed it by up to m_RefitDisplacement.
+  const unsigned int splitDimension = this->m_SplitDimensions[median];
+  const double       difference =
+    static_cast<double>(query[splitDimension]) - this->GetBuildTreePoints()[median][splitDimension];
+  const double planeDistance = std::max(std::abs(difference) - this->m_RefitDisplacement, 0.0);
+
+  if (difference <= 0.0)
+  {
+    this->ClosestPointSearch(begin, median, query, closestSquaredDistance, closestPoint);
+    if (planeDistance * planeDistance < closestSquaredDistance)
+    {
+      this->ClosestPointSearch(median + 1, end, query, closestSquaredDistance, closestPoint);
+    }
+  }
+  else
+  {
+    this->ClosestPointSearch(median + 1, end, query, closestSquaredDistance, closestPoint);
+    if (planeDistance * planeDistance < closestSquaredDistance)
+    {
+      this->ClosestPointSearch(begin, median, query, closestSquaredDistance, closestPoint);
+    }
+  }
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::NearestNeighborSearch(TreeIndexType                       begin,
+                                                       TreeIndexType                       end,
+                                                       const PointType &                   query,
+                                                       unsigned int                        numberOfNeighbors,
+                                                       std::vector<DistanceNeighborType> & neighbors) const
+{
+  auto addCandidate = [this, &query, numberOfNeighbors, &neighbors](TreeIndexType i) {
+    const double squaredDistance = Self::SquaredDistance(query, this->m_TreePoints[i]);
+    if (neighbors.size() < numberOfNeighbors)
+    {
+      neighbors.emplace_back(squaredDistance, i);
+      std::push_heap(neighbors.begin(), neighbors.end());
+    }
+    else if (squaredDistance < neighbors.front().first)
+    {
+      std::pop_heap(neighbors.begin(), neighbors.end());
+      neighbors.back() = DistanceNeighborType(squaredDistance, i);
+      std::push_heap(neighbors.begin(), neighbors.end());
+    }
+  };
+
+  if (end - begin <= this->m_TreeBucketSize)
+  {
+    for (TreeIndexType i = begin; i < end; ++i)
+    {
+      addCandidate(i);
+    }
+    return;
+  }
+
+  const TreeIndexType median = begin + (end - begin) / 2;
+  addCandidate(median);
+
+  const unsigned int splitDimension = this->m_SplitDimensions[median];
+  const double       difference =
+    static_cast<double>(query[splitDimension]) - this->GetBuildTreePoints()[median][splitDimension];
+  const double planeDistance = std::max(std::abs(difference) - this->m_RefitDisplacement, 0.0);
+
+  if (difference <= 0.0)
+  {
+    this->NearestNeighborSearch(begin, median, query, numberOfNeighbors, neighbors);
+    if (neighbors.size() < numberOfNeighbors || planeDistance * planeDistance < neighbors.front().first)
+    {
+      this->NearestNeighborSearch(median + 1, end, query, numberOfNeighbors, neighbors);
+    }
+  }
+  else
+  {
+    this->NearestNeighborSearch(median + 1, end, query, numberOfNeighbors, neighbors);
+    if (neighbors.size() < numberOfNeighbors || planeDistance * planeDistance < neighbors.front().first)
+    {
+      this->NearestNeighborSearch(begin, median, query, numberOfNeighbors, neighbors);
+    }
+  }
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::RadiusSearch(TreeIndexType             begin,
+                                              TreeIndexType             end,
+                                              const PointType &         query,
+                                              double                    radius,
+                                              NeighborsIdentifierType & neighbors) const
+{
+  const double squaredRadius = radius * radius;
+
+  if (end - begin <= this->m_TreeBucketSize)
+  {
+    for (TreeIndexType i = begin; i < end; ++i)
+    {
+      if (Self::SquaredDistance(query, this->m_TreePoints[i]) <= squaredRadius)
+      {
+        neighbors.push_back(this->m_TreeIdentifiers[i]);
+      }
+    }
+    return;
+  }
+
+  const TreeIndexType median = begin + (end - begin) / 2;
+  if (Self::SquaredDistance(query, this->m_TreePoints[median]) <= squaredRadius)
+  {
+    neighbors.push_back(this->m_TreeIdentifiers[median]);
+  }
+
+  const unsigned int splitDimension = this->m_SplitDimensions[median];
+  const double       difference =
+    static_cast<double>(query[splitDimension]) - this->GetBuildTreePoints()[median][splitDimension];
+  const double planeDistance = std::max(std::abs(difference) - this->m_RefitDisplacement, 0.0);
+
+  if (difference <= 0.0 || planeDistance <= radius)
+  {
+    this->RadiusSearch(begin, median, query, radius, neighbors);
+  }
+  if (difference > 0.0 || planeDistance <= radius)
+  {
+    this->RadiusSearch(median + 1, end, query, radius, neighbors);
+  }
 }
 
 template <typename TPointsContainer>
 typename PointsLocator<TPointsContainer>::PointIdentifier
 PointsLocator<TPointsContainer>::FindClosestPoint(const PointType & query) const
 {
-  NeighborsIdentifierType identifiers;
-  this->m_Tree->Search(query, 1u, identifiers);
+  if (this->m_TreePoints.empty())
+  {
+    itkExceptionMacro("The locator has not been initialized.");
+  }
+
+  double        closestSquaredDistance = NumericTraits<double>::max();
+  TreeIndexType closestPoint = 0;
+  this->ClosestPointSearch(0, this->m_TreePoints.size(), query, closestSquaredDistance, closestPoint);
+  return this->m_TreeIdentifiers[closestPoint];
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::FindClosestPoints(const PointsContainer *     queries,
+                                                   PointIdentifierVectorType & closestPoints) const
+{
+  if (this->m_TreePoints.empty())
+  {
+    itkExceptionMacro("The locator has not been initialized.");
+  }
+
+  std::vector<PointType> queryPoints;
+  queryPoints.reserve(queries->Size());
+  for (PointsContainerConstIterator It = queries->Begin(); It != queries->End(); ++It)
+  {
+    queryPoints.push_back(It.Value());
+  }
+  closestPoints.resize(queryPoints.size());
 
-  return identifiers[0];
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    queryPoints.size(),
+    [this, &queryPoints, &closestPoints](SizeValueType i) {
+      double        closestSquaredDistance = NumericTraits<double>::max();
+      TreeIndexType closestPoint = 0;
+      this->ClosestPointSearch(0, this->m_TreePoints.size(), queryPoints[i], closestSquaredDistance, closestPoint);
+      closestPoints[i] = this->m_TreeIdentifiers[closestPoint];
+    },
+    nullptr);
 }
 
 template <typename TPointsContainer>
@@ -75,14 +423,29 @@ PointsLocator<TPointsContainer>::Search(const PointType &         query,
                                         NeighborsIdentifierType & identifiers) const
 {
   unsigned int N = numberOfNeighborsRequested;
-  if (N > this->m_Points->Size())
+
+  if (N > this->m_TreePoints.size())
   {
-    N = this->m_Points->Size();
+    N = this->m_TreePoints.size();
 
     itkWarningMacro("The number of requested neighbors is greater than the "
                     << "total number of points.  Only returning " << N << " points.");
   }
-  this->m_Tree->Search(query, N, identifiers);
+
+  // The neighbors are returned from the closest to the farthest.
+  std::vector<DistanceNeighborType> neighbors;
+  neighbors.reserve(N);
+  if (N > 0)
+  {
+    this->NearestNeighborSearch(0, this->m_TreePoints.size(), query, N, neighbors);
+  }
+  std::sort_heap(neighbors.begin(), neighbors.end());
+
+  identifiers.resize(neighbors.size());
+  for (unsigned int i = 0; i < neighbors.size(); ++i)
+  {
+    identifiers[i] = this->m_TreeIdentifiers[neighbors[i].second];
+  }
 }
 
 template <typename TPointsContainer>
@@ -91,15 +454,7 @@ PointsLocator<TPointsContainer>::FindClosestNPoints(const PointType &         qu
                                                     unsigned int              numberOfNeighborsRequested,
                                                     NeighborsIdentifierType & identifiers) const
 {
-  unsigned int N = numberOfNeighborsRequested;
-  if (N > this->m_Points->Size())
-  {
-    N = this->m_Points->Size();
-
-    itkWarningMacro("The number of requested neighbors is greater than the "
-                    << "total number of points.  Only returning " << N << " points.");
-  }
-  this->m_Tree->Search(query, N, identifiers);
+  this->Search(query, numberOfNeighborsRequested, identifiers);
 }
 
 template <typename TPointsContainer>
@@ -108,7 +463,11 @@ PointsLocator<TPointsContainer>::Search(const PointType &         query,
                                         double                    radius,
                                         NeighborsIdentifierType & identifiers) const
 {
-  this->m_Tree->Search(query, radius, identifiers);
+  identifiers.clear();
+  if (!this->m_TreePoints.empty())
+  {
+    this->RadiusSearch(0, this->m_TreePoints.size(), query, radius, identifiers);
+  }
 }
 
 template <typename TPointsContainer>
@@ -117,7 +476,7 @@ PointsLocator<TPointsContainer>::FindPointsWithinRadius(const PointType &
                                                         double                    radius,
                                                         NeighborsIdentifierType & identifiers) const
 {
-  this->m_Tree->Search(query, radius, identifiers);
+  this->Search(query, radius, identifiers);
 }
 
 /**
@@ -128,8 +487,12 @@ void
 PointsLocator<TPointsContainer>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
-}
 
+  os << indent << "Bucket size: " << this->m_BucketSize << std::endl;
+  os << indent << "Maximum refit displacement: " << this->m_MaximumRefitDisplacement << std::endl;
+  os << indent << "Refit displacement: " << this->m_RefitDisplacement << std::endl;
+  os << indent << "Number of points in the tree: " << this->m_TreePoints.size() << std::endl;
+}
 } // end namespace itk
 
 #endif
@@ -45,4 +45,5 @@ itk_module(ITKRegistrationCommon
 )
 
 # Extra test dependency on ITKDistanceMap is introduced by itkPointSetToPointSetRegistrationTest.
-# Dependency on ITKStatistics is introduced by itkPointsLocator.
+# Dependency on ITKStatistics is introduced by itkHistogramImageToImageMetric and the deprecated
+# itkPointsLocator tree types.
@@ -18,6 +18,7 @@
 
 #include "itkPointsLocator.h"
 #include "itkMapContainer.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
 
 template <typename TPointsContainer>
 int
@@ -113,6 +114,176 @@ testPointsLocatorTest()
   return EXIT_SUCCESS;
 }
 
+/**
+ * Compare the closest point, k nearest neighbors and radius queries of the
+ * locator against an exhaustive search of the points.
+ */
+template <typename TPointsLocator, typename TPointsContainer, typename TPoint>
+bool
+checkPointsLocatorAgainstBruteForce(const TPointsLocator *   pointsLocator,
+                                    const TPointsContainer * points,
+                                    const TPoint &           query)
+{
+  std::vector<double> squaredDistances;
+  for (auto It = points->Begin(); It != points->End(); ++It)
+  {
+    squaredDistances.push_back(query.SquaredEuclideanDistanceTo(It.Value()));
+  }
+  std::sort(squaredDistances.begin(), squaredDistances.end());
+
+  const auto closestPoint = pointsLocator->FindClosestPoint(query);
+  if (query.SquaredEuclideanDistanceTo(points->ElementAt(closestPoint)) != squaredDistances[0])
+  {
+    std::cerr << "Error with FindClosestPoint() for query " << query << std::endl;
+    return false;
+  }
+
+  constexpr unsigned int                           numberOfNeighbors = 7;
+  typename TPointsLocator::NeighborsIdentifierType neighborhood;
+  pointsLocator->FindClosestNPoints(query, numberOfNeighbors, neighborhood);
+  if (neighborhood.size() != numberOfNeighbors)
+  {
+    std::cerr << "Error with FindClosestNPoints() for query " << query << std::endl;
+    return false;
+  }
+  for (unsigned int n = 0; n < numberOfNeighbors; ++n)
+  {
+    if (query.SquaredEuclideanDistanceTo(points->ElementAt(neighborhood[n])) != squaredDistances[n])
+    {
+      std::cerr << "Error with FindClosestNPoints() for query " << query << ": neighbor " << n
+                << " is not in order." << std::endl;
+      return false;
+    }
+  }
+
+  const double radius = 7.5;
+  pointsLocator->FindPointsWithinRadius(query, radius, neighborhood);
+  const auto numberWithinRadius =
+    std::upper_bound(squaredDistances.begin(), squaredDistances.end(), radius * radius) - squaredDistances.begin();
+  if (static_cast<std::ptrdiff_t>(neighborhood.size()) != numberWithinRadius)
+  {
+    std::cerr << "Error with FindPointsWithinRadius() for query " << query << ": found " << neighborhood.size()
+              << " points instead of " << numberWithinRadius << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+template <typename TPointsContainer>
+int
+testPointsLocatorRefitTest()
+{
+  constexpr unsigned int PointDimension = 3;
+  using PointType = itk::Point<float, PointDimension>;
+
+  using PointsContainerType = TPointsContainer;
+  using PointsLocatorType = itk::PointsLocator<PointsContainerType>;
+
+  using RandomGeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  RandomGeneratorType::Pointer randomGenerator = RandomGeneratorType::New();
+  randomGenerator->Initialize(1234);
+
+  typename PointsContainerType::Pointer points = PointsContainerType::New();
+  for (unsigned int i = 0; i < 2000; ++i)
+  {
+    PointType point;
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      point[d] = static_cast<float>(randomGenerator->GetUniformVariate(0.0, 100.0));
+    }
+    points->InsertElement(i, point);
+  }
+
+  std::vector<PointType>                queries;
+  typename PointsContainerType::Pointer queryPoints = PointsContainerType::New();
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    PointType query;
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      query[d] = static_cast<float>(randomGenerator->GetUniformVariate(-10.0, 110.0));
+    }
+    queries.push_back(query);
+    queryPoints->InsertElement(i, query);
+  }
+
+  typename PointsLocatorType::Pointer pointsLocator = PointsLocatorType::New();
+  pointsLocator->SetBucketSize(4);
+  pointsLocator->SetMaximumRefitDisplacement(10.0);
+  pointsLocator->SetPoints(points);
+  pointsLocator->Initialize();
+
+  std::cout << "Test:  queries against an exhaustive search" << std::endl;
+  for (const PointType & query : queries)
+  {
+    if (!checkPointsLocatorAgainstBruteForce(pointsLocator.GetPointer(), points.GetPointer(), query))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test:  FindClosestPoints()" << std::endl;
+  typename PointsLocatorType::PointIdentifierVectorType closestPoints;
+  pointsLocator->FindClosestPoints(queryPoints, closestPoints);
+  if (closestPoints.size() != queries.size())
+  {
+    std::cerr << "Error with FindClosestPoints(): wrong number of results." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < queries.size(); ++i)
+  {
+    if (closestPoints[i] != pointsLocator->FindClosestPoint(queries[i]))
+    {
+      std::cerr << "Error with FindClosestPoints() for query " << queries[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test:  Refit() after a small displacement" << std::endl;
+  for (auto It = points->Begin(); It != points->End(); ++It)
+  {
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      It.Value()[d] += static_cast<float>(randomGenerator->GetUniformVariate(-4.0, 4.0));
+    }
+  }
+  pointsLocator->Refit();
+  if (pointsLocator->GetRefitDisplacement() <= 0.0 || pointsLocator->GetRefitDisplacement() > 10.0)
+  {
+    std::cerr << "Error with Refit(): the tree should have been refit, not rebuilt." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (const PointType & query : queries)
+  {
+    if (!checkPointsLocatorAgainstBruteForce(pointsLocator.GetPointer(), points.GetPointer(), query))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test:  Refit() after a large displacement" << std::endl;
+  for (auto It = points->Begin(); It != points->End(); ++It)
+  {
+    It.Value()[0] = 100.0f - It.Value()[0];
+  }
+  pointsLocator->Refit();
+  if (itk::Math::NotExactlyEquals(pointsLocator->GetRefitDisplacement(), 0.0))
+  {
+    std::cerr << "Error with Refit(): the tree should have been rebuilt." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (const PointType & query : queries)
+  {
+    if (!checkPointsLocatorAgainstBruteForce(pointsLocator.GetPointer(), points.GetPointer(), query))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 int
 itkPointsLocatorTest(int, char *[])
 {
@@ -123,7 +294,8 @@ itkPointsLocatorTest(int, char *[])
   using MapContainerType = itk::MapContainer<unsigned int, PointType>;
 
   std::cout << "VectorContainerType" << std::endl;
-  if (testPointsLocatorTest<VectorContainerType>() == EXIT_FAILURE)
+  if (testPointsLocatorTest<VectorContainerType>() == EXIT_FAILURE ||
+      testPointsLocatorRefitTest<VectorContainerType>() == EXIT_FAILURE)
   {
     std::cerr << "### FAILURE" << std::endl;
     return EXIT_FAILURE;
@@ -132,7 +304,8 @@ itkPointsLocatorTest(int, char *[])
   std::cout << std::endl;
 
   std::cout << "MapContainerType" << std::endl;
-  if (testPointsLocatorTest<MapContainerType>() == EXIT_FAILURE)
+  if (testPointsLocatorTest<MapContainerType>() == EXIT_FAILURE ||
+      testPointsLocatorRefitTest<MapContainerType>() == EXIT_FAILURE)
   {
     std::cerr << "### FAILURE" << std::endl;
     return EXIT_FAILURE;
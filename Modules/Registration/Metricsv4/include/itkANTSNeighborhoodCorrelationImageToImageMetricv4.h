@@ -56,6 +56,12 @@ namespace itk
  * neighborhood window. This is described in the above paper and specifically
  * optimized for dense registration.
  *
+ * Alternatively, with UseIntegralImages on, the local sums are taken from
+ * summed-area tables of the fixed and moving intensities that are built in
+ * parallel over the virtual domain once per iteration. The cost per voxel is
+ * then independent of the radius, and sampled points no longer rescan their
+ * whole neighborhood.
+ *
  *  Example of usage:
  *
  *  using MetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4
@@ -84,10 +90,9 @@ namespace itk
  * derived classes, operate on meshes, images, etc.  This class computes a
  * value that measures the similarity between the two objects.
  *
- * \note Sparse sampling is not supported by this metric. An exception will be
- * thrown if m_UseSampledPointSet is set. Support for sparse sampling
- * will require a parallel implementation of the neighborhood scanning, which
- * currently caches information as the neighborhood window moves.
+ * \note With sparse sampling and the queues, the neighborhood of each sampled
+ * point is scanned in full. Use the integral images when sampling densely
+ * with a large radius.
  *
  * \ingroup ITKMetricsv4
  */
@@ -152,6 +157,8 @@ public:
   using RadiusType = typename VirtualImageType::SizeType;
   using IndexType = typename VirtualImageType::IndexType;
 
+  using InternalComputationValueType = typename Superclass::InternalComputationValueType;
+
   /* Image dimension accessors */
   static constexpr ImageDimensionType FixedImageDimension = FixedImageType::ImageDimension;
 
@@ -159,6 +166,14 @@ public:
 
   static constexpr ImageDimensionType VirtualImageDimension = VirtualImageType::ImageDimension;
 
+  /** Summed-area tables used with UseIntegralImages. Each pixel holds the sums,
+   * up to and including that pixel, of the number of valid points and of the
+   * fixed, moving, fixed squared, moving squared and fixed times moving values.
+   * The intensities are centered on their means over the virtual domain. */
+  using SumRealType = typename NumericTraits<InternalComputationValueType>::AccumulateType;
+  using IntegralImagePixelType = FixedArray<SumRealType, 6>;
+  using IntegralImageType = Image<IntegralImagePixelType, VirtualImageDimension>;
+
   // Set the radius of the neighborhood window centered at each pixel.
   // See the note above about using a radius less than 2.
   itkSetMacro(Radius, RadiusType);
@@ -167,6 +182,13 @@ public:
   itkGetMacro(Radius, RadiusType);
   itkGetConstMacro(Radius, RadiusType);
 
+  /** Compute the local sums from summed-area tables instead of the sliding
+   * queues. The tables are rebuilt in parallel before each evaluation and
+   * take six sums per virtual voxel. Off by default. */
+  itkSetMacro(UseIntegralImages, bool);
+  itkGetConstMacro(UseIntegralImages, bool);
+  itkBooleanMacro(UseIntegralImages);
+
   void
   Initialize() override;
 
@@ -193,12 +215,27 @@ protected:
                                                                                  Superclass,
                                                                                  Self>;
 
+  /** Build the summed-area tables when UseIntegralImages is on. */
+  void
+  InitializeForIteration() const override;
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 private:
   // Radius of the neighborhood window centered at each pixel
   RadiusType m_Radius;
+
+  bool m_UseIntegralImages{ false };
+
+  /* These are built during InitializeForIteration(), which is const, and used
+   * by the threaders. */
+  mutable typename IntegralImageType::Pointer m_IntegralImage;
+  mutable SumRealType                         m_IntegralImageFixedMean{ 0 };
+  mutable SumRealType                         m_IntegralImageMovingMean{ 0 };
 };
 
 } // end namespace itk
@@ -20,6 +20,11 @@
 
 #include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
 #include "itkNumericTraits.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+
+#include <mutex>
 
 namespace itk
 {
@@ -61,6 +66,166 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4<TFixedImage,
   Superclass::Initialize();
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ANTSNeighborhoodCorrelationImageToImageMetricv4<TFixedImage,
+                                                TMovingImage,
+                                                TVirtualImage,
+                                                TInternalComputationValueType,
+                                                TMetricTraits>::InitializeForIteration() const
+{
+  Superclass::InitializeForIteration();
+
+  if (!this->m_UseIntegralImages)
+  {
+    this->m_IntegralImage = nullptr;
+    return;
+  }
+
+  // The tables have one more layer of zeros on the low side of each dimension,
+  // so that the sum over any window is read without boundary tests.
+  const ImageRegionType & virtualRegion = this->GetVirtualRegion();
+  ImageRegionType         integralRegion = virtualRegion;
+  for (ImageDimensionType d = 0; d < VirtualImageDimension; ++d)
+  {
+    integralRegion.SetIndex(d, virtualRegion.GetIndex(d) - 1);
+    integralRegion.SetSize(d, virtualRegion.GetSize(d) + 1);
+  }
+  if (this->m_IntegralImage.IsNull() || this->m_IntegralImage->GetBufferedRegion() != integralRegion)
+  {
+    this->m_IntegralImage = IntegralImageType::New();
+    this->m_IntegralImage->SetRegions(integralRegion);
+    this->m_IntegralImage->Allocate(true);
+  }
+  IntegralImageType * const integralImage = this->m_IntegralImage.GetPointer();
+
+  const SumRealType zero = NumericTraits<SumRealType>::ZeroValue();
+  const SumRealType one = NumericTraits<SumRealType>::OneValue();
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(this->GetMaximumNumberOfWorkUnits());
+
+  // Evaluate the images once at each virtual voxel. Only the layers of zeros
+  // are left untouched, and they are never written.
+  std::mutex  sumMutex;
+  SumRealType numberOfValidPoints = zero;
+  SumRealType fixedSum = zero;
+  SumRealType movingSum = zero;
+  multiThreader->template ParallelizeImageRegion<VirtualImageDimension>(
+    virtualRegion,
+    [&](const ImageRegionType & region) {
+      SumRealType localNumberOfValidPoints = zero;
+      SumRealType localFixedSum = zero;
+      SumRealType localMovingSum = zero;
+
+      ImageRegionIteratorWithIndex<IntegralImageType> it(integralImage, region);
+      for (; !it.IsAtEnd(); ++it)
+      {
+        IntegralImagePixelType value;
+        value.Fill(zero);
+
+        VirtualPointType     virtualPoint;
+        FixedImagePointType  mappedFixedPoint;
+        FixedImagePixelType  fixedImageValue;
+        MovingImagePointType mappedMovingPoint;
+        MovingImagePixelType movingImageValue;
+        this->TransformVirtualIndexToPhysicalPoint(it.GetIndex(), virtualPoint);
+        if (this->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue) &&
+            this->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue))
+        {
+          value[0] = one;
+          value[1] = fixedImageValue;
+          value[2] = movingImageValue;
+          localNumberOfValidPoints += one;
+          localFixedSum += value[1];
+          localMovingSum += value[2];
+        }
+        it.Set(value);
+      }
+
+      const std::lock_guard<std::mutex> lock(sumMutex);
+      numberOfValidPoints += localNumberOfValidPoints;
+      fixedSum += localFixedSum;
+      movingSum += localMovingSum;
+    },
+    nullptr);
+
+  // Correlation does not depend on the mean, and centering the intensities
+  // keeps the sums over large domains from losing the precision of the
+  // local sums.
+  this->m_IntegralImageFixedMean = zero;
+  this->m_IntegralImageMovingMean = zero;
+  if (numberOfValidPoints > zero)
+  {
+    this->m_IntegralImageFixedMean = fixedSum / numberOfValidPoints;
+    this->m_IntegralImageMovingMean = movingSum / numberOfValidPoints;
+  }
+  const SumRealType fixedMean = this->m_IntegralImageFixedMean;
+  const SumRealType movingMean = this->m_IntegralImageMovingMean;
+
+  // Accumulate along one dimension at a time. Each chunk spans the whole
+  // dimension, and is visited in memory order, so the preceding pixel along
+  // that dimension is always final when it is added.
+  for (ImageDimensionType d = 0; d < VirtualImageDimension; ++d)
+  {
+    const OffsetValueType stride = integralImage->GetOffsetTable()[d];
+    multiThreader->template ParallelizeImageRegionRestrictDirection<VirtualImageDimension>(
+      d,
+      virtualRegion,
+      [&](const ImageRegionType & region) {
+        ImageRegionIterator<IntegralImageType> it(integralImage, region);
+        for (; !it.IsAtEnd(); ++it)
+        {
+          IntegralImagePixelType & value = it.Value();
+          if (d == 0 && value[0] > zero)
+          {
+            const SumRealType fixedValue = value[1] - fixedMean;
+            const SumRealType movingValue = value[2] - movingMean;
+            value[1] = fixedValue;
+            value[2] = movingValue;
+            value[3] = fixedValue * fixedValue;
+            value[4] = movingValue * movingValue;
+            value[5] = fixedValue * movingValue;
+          }
+          const IntegralImagePixelType & previous = *(&value - stride);
+          for (unsigned int k = 0; k < IntegralImagePixelType::Length; ++k)
+          {
+            value[k] += previous[k];
+          }
+        }
+      },
+      nullptr);
+  }
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+typename LightObject::Pointer
+ANTSNeighborhoodCorrelationImageToImageMetricv4<TFixedImage,
+                                                TMovingImage,
+                                                TVirtualImage,
+                                                TInternalComputationValueType,
+                                                TMetricTraits>::InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->SetRadius(this->m_Radius);
+  rval->SetUseIntegralImages(this->m_UseIntegralImages);
+  return loPtr;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -75,6 +240,7 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4<TFixedImage,
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Correlation window radius: " << m_Radius << std::endl;
+  os << indent << "Use integral images: " << m_UseIntegralImages << std::endl;
 }
 
 } // end namespace itk
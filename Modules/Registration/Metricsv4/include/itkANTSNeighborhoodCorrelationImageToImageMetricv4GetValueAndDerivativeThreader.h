@@ -86,6 +86,7 @@ public:
   using MeasureType = typename Superclass::MeasureType;
   using DerivativeType = typename Superclass::DerivativeType;
   using DerivativeValueType = typename Superclass::DerivativeValueType;
+  using CompensatedMeasureType = typename Superclass::CompensatedMeasureType;
 
   using NeighborhoodCorrelationMetricType = TNeighborhoodCorrelationMetric;
 
@@ -103,6 +104,10 @@ public:
   using SumQueueType = std::deque<QueueRealType>;
   using ScanIteratorType = ConstNeighborhoodIterator<VirtualImageType>;
 
+  // sums over a window, in the order of the metric's summed-area tables: the number of
+  // valid points, fixed, moving, fixed squared, moving squared and fixed times moving
+  using WindowSumsType = FixedArray<QueueRealType, 6>;
+
   // one ScanMemType for each thread
   using ScanMemType = struct
   {
@@ -287,6 +292,22 @@ protected:
                                const ScanParametersType & scanParameters,
                                const ThreadIdType         threadId) const;
 
+  /** Take the sums over the window centered at \c virtualIndex from the summed-area
+   * tables of the metric, and compute the same information as \c ComputeInformationFromQueues. */
+  bool
+  ComputeInformationFromIntegralImage(const VirtualIndexType & virtualIndex,
+                                      ScanMemType &            scanMem,
+                                      const ThreadIdType       threadId) const;
+
+  /** Compute the centered sums of the window and evaluate the images at its center.
+   * The fixed and moving sums are of the values minus \c fixedOffset and \c movingOffset. */
+  bool
+  ComputeInformationFromSums(const VirtualIndexType & virtualIndex,
+                             const WindowSumsType &   sums,
+                             const QueueRealType      fixedOffset,
+                             const QueueRealType      movingOffset,
+                             ScanMemType &            scanMem) const;
+
   void
   ComputeMovingTransformDerivative(const ScanIteratorType &   scanIt,
                                    ScanMemType &              scanMem,
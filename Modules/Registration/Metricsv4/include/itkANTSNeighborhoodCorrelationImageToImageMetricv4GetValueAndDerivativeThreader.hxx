@@ -20,6 +20,8 @@
 
 #include "itkANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -40,13 +42,13 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
     itkExceptionMacro("Dynamic casting of associate pointer failed.");
   }
 
-  VirtualPointType   virtualPoint;
-  MeasureType        metricValueResult = NumericTraits<MeasureType>::ZeroValue();
-  MeasureType        metricValueSum = NumericTraits<MeasureType>::ZeroValue();
-  bool               pointIsValid;
-  ScanIteratorType   scanIt;
-  ScanParametersType scanParameters;
-  ScanMemType        scanMem;
+  VirtualPointType       virtualPoint;
+  MeasureType            metricValueResult = NumericTraits<MeasureType>::ZeroValue();
+  CompensatedMeasureType metricValueSum;
+  bool                   pointIsValid;
+  ScanIteratorType       scanIt;
+  ScanParametersType     scanParameters;
+  ScanMemType            scanMem;
 
   DerivativeType & localDerivativeResult = this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives;
 
@@ -65,8 +67,15 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
      * calculations for value and derivative. */
     try
     {
-      this->UpdateQueues(scanIt, scanMem, scanParameters, threadId);
-      pointIsValid = this->ComputeInformationFromQueues(scanIt, scanMem, scanParameters, threadId);
+      if (this->m_ANTSAssociate->m_UseIntegralImages)
+      {
+        pointIsValid = this->ComputeInformationFromIntegralImage(scanIt.GetIndex(), scanMem, threadId);
+      }
+      else
+      {
+        this->UpdateQueues(scanIt, scanMem, scanParameters, threadId);
+        pointIsValid = this->ComputeInformationFromQueues(scanIt, scanMem, scanParameters, threadId);
+      }
       if (pointIsValid)
       {
         this->ComputeMovingTransformDerivative(
@@ -335,7 +344,13 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
 
   scanParameters.numberOfFillZero = numberOfFillZero;
 
-  scanIt = ScanIteratorType(scanParameters.radius, scanParameters.virtualImage, scanRegion);
+  // The summed-area tables hold the sums over the windows, so only the centers are visited.
+  RadiusType scanRadius = scanParameters.radius;
+  if (this->m_ANTSAssociate->m_UseIntegralImages)
+  {
+    scanRadius.Fill(0);
+  }
+  scanIt = ScanIteratorType(scanRadius, scanParameters.virtualImage, scanRegion);
   scanParameters.windowLength = scanIt.Size();
   scanParameters.scanRegionBeginIndexDim0 = scanIt.GetBeginIndex()[0];
 
@@ -427,6 +442,112 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
     ++itFixedMoving;
   }
 
+  WindowSumsType sums;
+  sums[0] = count;
+  sums[1] = sumFixed;
+  sums[2] = sumMoving;
+  sums[3] = sumFixed2;
+  sums[4] = sumMoving2;
+  sums[5] = sumFixedMoving;
+
+  return this->ComputeInformationFromSums(scanIt.GetIndex(), sums, localZero, localZero, scanMem);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+bool
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TNeighborhoodCorrelationMetric>::ComputeInformationFromIntegralImage(const VirtualIndexType & virtualIndex,
+                                                                       ScanMemType &            scanMem,
+                                                                       const ThreadIdType) const
+{
+  using IntegralImageType = typename NeighborhoodCorrelationMetricType::IntegralImageType;
+  using IntegralImagePixelType = typename NeighborhoodCorrelationMetricType::IntegralImagePixelType;
+  using SumRealType = typename NeighborhoodCorrelationMetricType::SumRealType;
+  constexpr unsigned int Dimension = TImageToImageMetric::VirtualImageDimension;
+
+  const IntegralImageType * const integralImage = this->m_ANTSAssociate->m_IntegralImage.GetPointer();
+  const ImageRegionType &         virtualRegion = this->m_ANTSAssociate->GetVirtualRegion();
+  const RadiusType &              radius = this->m_ANTSAssociate->GetRadius();
+
+  // Clip the window to the virtual region. The low corner is taken just
+  // outside the window, where the tables have a layer of zeros.
+  VirtualIndexType lowerIndex;
+  VirtualIndexType upperIndex;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    const IndexValueType regionBegin = virtualRegion.GetIndex(d);
+    const IndexValueType regionEnd = regionBegin + static_cast<IndexValueType>(virtualRegion.GetSize(d)) - 1;
+    const auto           radiusValue = static_cast<IndexValueType>(radius[d]);
+    lowerIndex[d] = std::max(virtualIndex[d] - radiusValue, regionBegin) - 1;
+    upperIndex[d] = std::min(virtualIndex[d] + radiusValue, regionEnd);
+  }
+
+  IntegralImagePixelType integralSums;
+  integralSums.Fill(NumericTraits<SumRealType>::ZeroValue());
+  for (unsigned int corner = 0; corner < (1u << Dimension); ++corner)
+  {
+    VirtualIndexType cornerIndex;
+    unsigned int     numberOfLowerIndices = 0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      if (corner & (1u << d))
+      {
+        cornerIndex[d] = upperIndex[d];
+      }
+      else
+      {
+        cornerIndex[d] = lowerIndex[d];
+        ++numberOfLowerIndices;
+      }
+    }
+    const IntegralImagePixelType & cornerSums = integralImage->GetPixel(cornerIndex);
+    const SumRealType              sign = (numberOfLowerIndices % 2) ? -1 : 1;
+    for (unsigned int k = 0; k < IntegralImagePixelType::Length; ++k)
+    {
+      integralSums[k] += sign * cornerSums[k];
+    }
+  }
+
+  WindowSumsType sums;
+  for (unsigned int k = 0; k < WindowSumsType::Length; ++k)
+  {
+    sums[k] = static_cast<QueueRealType>(integralSums[k]);
+  }
+  return this->ComputeInformationFromSums(virtualIndex,
+                                          sums,
+                                          static_cast<QueueRealType>(this->m_ANTSAssociate->m_IntegralImageFixedMean),
+                                          static_cast<QueueRealType>(this->m_ANTSAssociate->m_IntegralImageMovingMean),
+                                          scanMem);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+bool
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TNeighborhoodCorrelationMetric>::ComputeInformationFromSums(const VirtualIndexType & virtualIndex,
+                                                              const WindowSumsType &   sums,
+                                                              const QueueRealType      fixedOffset,
+                                                              const QueueRealType      movingOffset,
+                                                              ScanMemType &            scanMem) const
+{
+  using LocalRealType = InternalComputationValueType;
+
+  const LocalRealType count = sums[0];
+  if (count <= NumericTraits<LocalRealType>::ZeroValue())
+  {
+    // no points available in the window, perhaps out of image region
+    return false;
+  }
+
+  const LocalRealType sumFixed = sums[1];
+  const LocalRealType sumMoving = sums[2];
+  const LocalRealType sumFixed2 = sums[3];
+  const LocalRealType sumMoving2 = sums[4];
+  const LocalRealType sumFixedMoving = sums[5];
+
   LocalRealType fixedMean = sumFixed / count;
   LocalRealType movingMean = sumMoving / count;
 
@@ -436,8 +557,6 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   LocalRealType sFixedMoving =
     sumFixedMoving - movingMean * sumFixed - fixedMean * sumMoving + count * movingMean * fixedMean;
 
-  typename VirtualImageType::IndexType oindex = scanIt.GetIndex();
-
   VirtualPointType        virtualPoint;
   FixedImagePointType     mappedFixedPoint;
   FixedImagePixelType     fixedImageValue;
@@ -447,7 +566,7 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   MovingImageGradientType movingImageGradient;
   bool                    pointIsValid;
 
-  this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(oindex, virtualPoint);
+  this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(virtualIndex, virtualPoint);
 
   try
   {
@@ -481,8 +600,8 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
 
   if (pointIsValid)
   {
-    scanMem.fixedA = fixedImageValue - fixedMean;
-    scanMem.movingA = movingImageValue - movingMean;
+    scanMem.fixedA = fixedImageValue - (fixedOffset + fixedMean);
+    scanMem.movingA = movingImageValue - (movingOffset + movingMean);
     scanMem.sFixedMoving = sFixedMoving;
     scanMem.sFixedFixed = sFixedFixed;
     scanMem.sMovingMoving = sMovingMoving;
@@ -535,7 +654,9 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
     if (!(sFixedFixed > NumericTraits<LocalRealType>::epsilon() &&
           sMovingMoving > NumericTraits<LocalRealType>::epsilon()))
     {
-      deriv.Fill(NumericTraits<DerivativeValueType>::ZeroValue());
+      // No parameter contributes: store an empty sparse derivative.
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].NonZeroJacobianIndices.clear();
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].UseSparseLocalDerivatives = true;
       return;
     }
 
@@ -545,20 +666,13 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
                           (fixedI - sFixedMoving / sMovingMoving * movingI) * movingImageGradient[qq];
     }
 
-    /* Use a pre-allocated jacobian object for efficiency */
-    using JacobianReferenceType = JacobianType &;
-    JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-
-    /** For dense transforms, this returns identity */
-    this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      scanMem.virtualPoint, jacobian, jacobianPositional);
+    /* Use the pre-allocated per-thread jacobian, holding only the columns of
+     * the parameters the point depends on. For dense transforms this is identity. */
+    const NumberOfParametersType numberOfNonZeroParameters =
+      this->ComputeMovingTransformSparseJacobian(scanMem.virtualPoint, threadId);
+    const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-    NumberOfParametersType numberOfLocalParameters =
-      this->m_Associate->GetMovingTransform()->GetNumberOfLocalParameters();
-
-    for (NumberOfParametersType par = 0; par < numberOfLocalParameters; par++)
+    for (NumberOfParametersType par = 0; par < numberOfNonZeroParameters; par++)
     {
       deriv[par] = NumericTraits<DerivativeValueType>::ZeroValue();
       for (ImageDimensionType dim = 0; dim < TImageToImageMetric::MovingImageDimension; dim++)
@@ -611,8 +725,15 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
   {
     pointIsValid = false;
 
-    this->UpdateQueues(scanIt, scanMem, scanParameters, threadId);
-    pointIsValid = this->ComputeInformationFromQueues(scanIt, scanMem, scanParameters, threadId);
+    if (this->m_ANTSAssociate->m_UseIntegralImages)
+    {
+      pointIsValid = this->ComputeInformationFromIntegralImage(virtualIndex, scanMem, threadId);
+    }
+    else
+    {
+      this->UpdateQueues(scanIt, scanMem, scanParameters, threadId);
+      pointIsValid = this->ComputeInformationFromQueues(scanIt, scanMem, scanParameters, threadId);
+    }
     if (pointIsValid)
     {
       this->ComputeMovingTransformDerivative(
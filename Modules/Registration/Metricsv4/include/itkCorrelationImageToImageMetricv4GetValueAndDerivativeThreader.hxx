@@ -224,12 +224,13 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   try
   {
     pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateMovingPoint(
-      virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
-    if (pointIsValid && this->m_CorrelationAssociate->GetComputeDerivative() &&
-        this->m_CorrelationAssociate->GetGradientSourceIncludesMoving())
-    {
-      this->m_CorrelationAssociate->ComputeMovingImageGradientAtPoint(mappedMovingPoint, mappedMovingImageGradient);
-    }
+      virtualIndex,
+      virtualPoint,
+      this->m_CorrelationAssociate->GetComputeDerivative() &&
+        this->m_CorrelationAssociate->GetGradientSourceIncludesMoving(),
+      mappedMovingPoint,
+      mappedMovingPixelValue,
+      mappedMovingImageGradient);
   }
   catch (ExceptionObject & exc)
   {
@@ -313,24 +314,21 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
 
   if (this->m_CorrelationAssociate->GetComputeDerivative())
   {
-    /* Use a pre-allocated jacobian object for efficiency */
-    using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
-    JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-
-    /** For dense transforms, this returns identity */
-    this->m_CorrelationAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      virtualPoint, jacobian, jacobianPositional);
+    /* Use the pre-allocated per-thread jacobian, holding only the columns of
+     * the parameters the point depends on. For dense transforms this is identity. */
+    const NumberOfParametersType numberOfNonZeroParameters =
+      this->ComputeMovingTransformSparseJacobian(virtualPoint, threadId);
+    const auto & threadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
 
-    for (unsigned int par = 0; par < this->m_CorrelationAssociate->GetNumberOfLocalParameters(); par++)
+    for (NumberOfParametersType k = 0; k < numberOfNonZeroParameters; k++)
     {
       InternalComputationValueType sum = NumericTraits<InternalComputationValueType>::ZeroValue();
       for (SizeValueType dim = 0; dim < ImageToImageMetricv4Type::MovingImageDimension; dim++)
       {
-        sum += movingImageGradient[dim] * jacobian(dim, par);
+        sum += movingImageGradient[dim] * threadVariables.MovingTransformJacobian(dim, k);
       }
 
+      const NumberOfParametersType par = threadVariables.NonZeroJacobianIndices[k];
       cumsum.fdm[par] += f1 * sum;
       cumsum.mdm[par] += m1 * sum;
     }
@@ -102,15 +102,16 @@ CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner, TImageToImageM
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TCorrelationMetric>
 bool
 CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner, TImageToImageMetric, TCorrelationMetric>::
-  ProcessVirtualPoint(const VirtualIndexType & itkNotUsed(virtualIndex),
+  ProcessVirtualPoint(const VirtualIndexType & virtualIndex,
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId)
 {
-  FixedImagePointType  mappedFixedPoint;
-  FixedImagePixelType  mappedFixedPixelValue;
-  MovingImagePointType mappedMovingPoint;
-  MovingImagePixelType mappedMovingPixelValue;
-  bool                 pointIsValid = false;
+  FixedImagePointType     mappedFixedPoint;
+  FixedImagePixelType     mappedFixedPixelValue;
+  MovingImagePointType    mappedMovingPoint;
+  MovingImagePixelType    mappedMovingPixelValue;
+  MovingImageGradientType mappedMovingImageGradient;
+  bool                    pointIsValid = false;
 
   /* Transform the point into fixed and moving spaces, and evaluate.
    * Different behavior with pre-warping enabled is handled transparently.
@@ -137,7 +138,7 @@ CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner, TImageToImageM
   try
   {
     pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateMovingPoint(
-      virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+      virtualIndex, virtualPoint, false, mappedMovingPoint, mappedMovingPixelValue, mappedMovingImageGradient);
   }
   catch (ExceptionObject & exc)
   {
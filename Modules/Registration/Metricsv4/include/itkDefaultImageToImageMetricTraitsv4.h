@@ -24,6 +24,8 @@
 #include "itkGradientRecursiveGaussianImageFilter.h"
 #include "itkObjectToObjectMetricBase.h"
 
+#include <type_traits>
+
 namespace itk
 {
 /** \class DefaultImageToImageMetricTraitsv4
@@ -34,6 +36,13 @@ namespace itk
  * scalar pixel types. For images with vector pixel types, see
  * itkVectorImageToImageMetricTraitsv4.
  *
+ * The pixel type of the gradient images, FixedImageGradientImageType and
+ * MovingImageGradientImageType, depends on TCoordRep: its components are of
+ * the coordinate representation type when it is narrower than the real type
+ * of the image pixels. They used to always be of the real pixel type, so
+ * a metric with a float coordinate representation now expects float
+ * gradient images; gradient filters set by the user must produce them.
+ *
  * \sa itkVectorImageToImageMetricTraitsv4
  *
  * \ingroup ITKMetricsv4
@@ -72,15 +81,25 @@ public:
   using FixedImageGradientConvertType = DefaultConvertPixelTraits<FixedImageGradientType>;
   using MovingImageGradientConvertType = DefaultConvertPixelTraits<MovingImageGradientType>;
 
-  /** Type of the filter used to calculate the gradients. */
+  /** Type of the filter used to calculate the gradients. The gradient images
+   * hold the real type of the pixels, or the coordinate representation type
+   * when it is narrower, so that a float registration stores float gradients. */
   using FixedRealType = typename NumericTraits<FixedImagePixelType>::RealType;
-  using FixedGradientPixelType = CovariantVector<FixedRealType, Self::FixedImageDimension>;
+  using FixedGradientValueType =
+    typename std::conditional<(sizeof(CoordinateRepresentationType) < sizeof(FixedRealType)),
+                              CoordinateRepresentationType,
+                              FixedRealType>::type;
+  using FixedGradientPixelType = CovariantVector<FixedGradientValueType, Self::FixedImageDimension>;
   using FixedImageGradientImageType = Image<FixedGradientPixelType, Self::FixedImageDimension>;
 
   using FixedImageGradientFilterType = ImageToImageFilter<FixedImageType, FixedImageGradientImageType>;
 
   using MovingRealType = typename NumericTraits<MovingImagePixelType>::RealType;
-  using MovingGradientPixelType = CovariantVector<MovingRealType, Self::MovingImageDimension>;
+  using MovingGradientValueType =
+    typename std::conditional<(sizeof(CoordinateRepresentationType) < sizeof(MovingRealType)),
+                              CoordinateRepresentationType,
+                              MovingRealType>::type;
+  using MovingGradientPixelType = CovariantVector<MovingGradientValueType, Self::MovingImageDimension>;
   using MovingImageGradientImageType = Image<MovingGradientPixelType, Self::MovingImageDimension>;
 
   using MovingImageGradientFilterType = ImageToImageFilter<MovingImageType, MovingImageGradientImageType>;
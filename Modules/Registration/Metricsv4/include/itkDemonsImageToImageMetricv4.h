@@ -140,6 +140,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 private:
   /** Threshold below which the denominator term is considered zero.
    *  Fixed programmatically in constructor. */
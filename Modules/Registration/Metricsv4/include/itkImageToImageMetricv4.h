@@ -308,7 +308,8 @@ public:
 
   /** Type of the filter used to calculate the gradients.
    * Note that RealType is always double (or long double for
-   * long double pixel-type).*/
+   * long double pixel-type). The gradient images may be stored in the
+   * narrower InternalComputationValueType, see the metric traits. */
   using FixedRealType = typename MetricTraits::FixedRealType;
   using MovingRealType = typename MetricTraits::MovingRealType;
 
@@ -480,8 +481,8 @@ public:
   /** Set number of work units to use. This the maximum number of work units to use
    * when multithreaded.  The actual number of work units used (may be less than
    * this value) can be obtained with \c GetNumberOfWorkUnitsUsed. */
-  virtual void
-  SetMaximumNumberOfWorkUnits(const ThreadIdType workUnits);
+  void
+  SetMaximumNumberOfWorkUnits(const ThreadIdType workUnits) override;
   virtual ThreadIdType
   GetMaximumNumberOfWorkUnits() const;
 
@@ -608,6 +609,20 @@ public:
     return MetricCategoryType::IMAGE_METRIC;
   }
 
+  /** Reuse the moving space samples of \c source, an image metric with the
+   * same image types that is evaluated first. Sharing requires dense sampling
+   * in both metrics, the same moving transform and the same virtual domain.
+   * The mapped moving points are always shared. The moving image values are
+   * shared as well when both metrics read the same moving image through the
+   * same mask with linear interpolation, and the moving image gradients when
+   * both also use their default gradient filter or calculator. While the
+   * sharing is active the source stores one sample per virtual domain pixel,
+   * i.e. a moving point, pixel value and gradient: about 64 bytes per pixel
+   * for 3D scalar double images. The samples are freed when the sharing
+   * stops. */
+  bool
+  SetMovingSampleSource(const Superclass * source) override;
+
 protected:
   /* Interpolators for image gradient filters. */
   using FixedImageGradientInterpolatorType =
@@ -659,6 +674,20 @@ protected:
                                   MovingImagePointType &   mappedMovingPoint,
                                   MovingImagePixelType &   mappedMovingPixelValue) const;
 
+  /** Transform and evaluate a point from VirtualImage domain to MovingImage
+   * domain, and compute the moving image gradient there if \c computeGradient
+   * is true. The sample of \c virtualIndex is reused or recorded when moving
+   * samples are shared with other metrics (see SetMovingSampleSource).
+   * Otherwise this is TransformAndEvaluateMovingPoint followed by
+   * ComputeMovingImageGradientAtPoint. */
+  bool
+  TransformAndEvaluateMovingPoint(const VirtualIndexType &  virtualIndex,
+                                  const VirtualPointType &  virtualPoint,
+                                  bool                      computeGradient,
+                                  MovingImagePointType &    mappedMovingPoint,
+                                  MovingImagePixelType &    mappedMovingPixelValue,
+                                  MovingImageGradientType & mappedMovingImageGradient) const;
+
   /** Compute image derivatives for a Fixed point. */
   virtual void
   ComputeFixedImageGradientAtPoint(const FixedImagePointType & mappedPoint, FixedImageGradientType & gradient) const;
@@ -763,11 +792,48 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** The clone shares the images, masks, sampled points, interpolators and
+   * gradient filters and calculators, which are only read during evaluation,
+   * and has its own transforms. It must be initialized before use. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 private:
   /** Map the fixed point set samples to the virtual domain */
   void
   MapFixedSampledPointSetToVirtual();
 
+  /** Check the moving mask and buffer at a point mapped into the moving
+   * domain, and evaluate the moving image there. */
+  bool
+  EvaluateMappedMovingPoint(const MovingImagePointType & mappedMovingPoint,
+                            MovingImagePixelType &       mappedMovingPixelValue) const;
+
+  /** Clear the recorded moving samples before the metric is evaluated as a
+   * source of moving samples. */
+  void
+  StartRecordingMovingSamples() const;
+
+  /** Stop recording the moving samples and free them. */
+  void
+  StopRecordingMovingSamples() const;
+
+  enum class MovingSampleStateEnum : uint8_t
+  {
+    NotEvaluated,
+    Outside,
+    Inside,
+    InsideWithGradient
+  };
+
+  struct MovingSampleType
+  {
+    MovingImagePointType    Point;
+    MovingImagePixelType    Value;
+    MovingImageGradientType Gradient;
+    MovingSampleStateEnum   State;
+  };
+
   /** Transform a point. Avoid cast if possible */
   void
   LocalTransformPoint(const typename FixedTransformType::OutputPointType & virtualPoint,
@@ -830,6 +896,13 @@ private:
   /** Flag to know if derivative should be calculated */
   mutable bool m_ComputeDerivative;
 
+  /** Moving samples shared with other metrics, see SetMovingSampleSource. */
+  const Self *                          m_MovingSampleSource{ nullptr };
+  bool                                  m_ShareMovingSampleValues{ false };
+  bool                                  m_ShareMovingSampleGradients{ false };
+  mutable bool                          m_RecordMovingSamples{ false };
+  mutable std::vector<MovingSampleType> m_MovingSamples;
+
 /** Only floating-point images are currently supported. To support integer images,
  * several small changes must be made */
 #ifdef ITK_USE_CONCEPT_CHECKING
@@ -371,6 +371,21 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   localMappedMovingPoint = this->m_MovingTransform->TransformPoint(localVirtualPoint);
   mappedMovingPoint.CastFrom(localMappedMovingPoint);
 
+  return this->EvaluateMappedMovingPoint(mappedMovingPoint, mappedMovingPixelValue);
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+bool
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  EvaluateMappedMovingPoint(const MovingImagePointType & mappedMovingPoint,
+                            MovingImagePixelType &       mappedMovingPixelValue) const
+{
+  bool pointIsValid = true;
+
   // check against the mask if one is assigned
   if (this->m_MovingImageMask)
   {
@@ -395,6 +410,187 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   return pointIsValid;
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+bool
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  TransformAndEvaluateMovingPoint(const VirtualIndexType &  virtualIndex,
+                                  const VirtualPointType &  virtualPoint,
+                                  bool                      computeGradient,
+                                  MovingImagePointType &    mappedMovingPoint,
+                                  MovingImagePixelType &    mappedMovingPixelValue,
+                                  MovingImageGradientType & mappedMovingImageGradient) const
+{
+  const Self * source = this->m_MovingSampleSource;
+  if (source != nullptr && source->m_RecordMovingSamples)
+  {
+    const MovingSampleType & sample = source->m_MovingSamples[this->m_VirtualImage->ComputeOffset(virtualIndex)];
+    if (sample.State != MovingSampleStateEnum::NotEvaluated)
+    {
+      mappedMovingPoint = sample.Point;
+      if (!this->m_ShareMovingSampleValues)
+      {
+        mappedMovingPixelValue = NumericTraits<MovingImagePixelType>::ZeroValue();
+        if (!this->EvaluateMappedMovingPoint(mappedMovingPoint, mappedMovingPixelValue))
+        {
+          return false;
+        }
+      }
+      else if (sample.State == MovingSampleStateEnum::Outside)
+      {
+        mappedMovingPixelValue = NumericTraits<MovingImagePixelType>::ZeroValue();
+        return false;
+      }
+      else
+      {
+        mappedMovingPixelValue = sample.Value;
+      }
+
+      if (computeGradient)
+      {
+        if (this->m_ShareMovingSampleGradients && sample.State == MovingSampleStateEnum::InsideWithGradient)
+        {
+          mappedMovingImageGradient = sample.Gradient;
+        }
+        else
+        {
+          this->ComputeMovingImageGradientAtPoint(mappedMovingPoint, mappedMovingImageGradient);
+        }
+      }
+      return true;
+    }
+  }
+
+  const bool pointIsValid =
+    this->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+  if (pointIsValid && computeGradient)
+  {
+    this->ComputeMovingImageGradientAtPoint(mappedMovingPoint, mappedMovingImageGradient);
+  }
+
+  if (this->m_RecordMovingSamples)
+  {
+    // Each virtual index is processed by a single thread.
+    MovingSampleType & sample = this->m_MovingSamples[this->m_VirtualImage->ComputeOffset(virtualIndex)];
+    sample.Point = mappedMovingPoint;
+    sample.Value = mappedMovingPixelValue;
+    if (!pointIsValid)
+    {
+      sample.State = MovingSampleStateEnum::Outside;
+    }
+    else if (computeGradient)
+    {
+      sample.Gradient = mappedMovingImageGradient;
+      sample.State = MovingSampleStateEnum::InsideWithGradient;
+    }
+    else
+    {
+      sample.State = MovingSampleStateEnum::Inside;
+    }
+  }
+
+  return pointIsValid;
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+bool
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  SetMovingSampleSource(const Superclass * source)
+{
+  if (this->m_MovingSampleSource != nullptr)
+  {
+    this->m_MovingSampleSource->StopRecordingMovingSamples();
+  }
+  this->m_MovingSampleSource = nullptr;
+  this->m_ShareMovingSampleValues = false;
+  this->m_ShareMovingSampleGradients = false;
+
+  const auto * imageSource = dynamic_cast<const Self *>(source);
+  if (imageSource == nullptr || imageSource == this || imageSource->m_MovingSampleSource != nullptr)
+  {
+    return false;
+  }
+
+  // The samples are indexed by their offset in the virtual domain.
+  if (this->m_UseSampledPointSet || imageSource->m_UseSampledPointSet || this->m_VirtualImage.IsNull() ||
+      imageSource->m_VirtualImage.IsNull() || this->m_MovingTransform.IsNull() ||
+      this->m_MovingTransform != imageSource->m_MovingTransform)
+  {
+    return false;
+  }
+  if (this->GetVirtualRegion() != imageSource->GetVirtualRegion() ||
+      this->GetVirtualOrigin() != imageSource->GetVirtualOrigin() ||
+      this->GetVirtualSpacing() != imageSource->GetVirtualSpacing() ||
+      this->GetVirtualDirection() != imageSource->GetVirtualDirection())
+  {
+    return false;
+  }
+
+  // Subclasses of the linear interpolator may change its behavior, so only the exact type is shared.
+  using MovingLinearInterpolatorType = LinearInterpolateImageFunction<MovingImageType, CoordinateRepresentationType>;
+  this->m_ShareMovingSampleValues =
+    this->m_MovingImage == imageSource->m_MovingImage && this->m_MovingImageMask == imageSource->m_MovingImageMask &&
+    this->m_MovingInterpolator.IsNotNull() && imageSource->m_MovingInterpolator.IsNotNull() &&
+    typeid(*this->m_MovingInterpolator) == typeid(MovingLinearInterpolatorType) &&
+    typeid(*imageSource->m_MovingInterpolator) == typeid(MovingLinearInterpolatorType);
+
+  if (this->m_ShareMovingSampleValues)
+  {
+    if (this->m_UseMovingImageGradientFilter && imageSource->m_UseMovingImageGradientFilter)
+    {
+      this->m_ShareMovingSampleGradients =
+        this->m_MovingImageGradientFilter == this->m_DefaultMovingImageGradientFilter.GetPointer() &&
+        imageSource->m_MovingImageGradientFilter == imageSource->m_DefaultMovingImageGradientFilter.GetPointer();
+    }
+    else if (!this->m_UseMovingImageGradientFilter && !imageSource->m_UseMovingImageGradientFilter)
+    {
+      this->m_ShareMovingSampleGradients =
+        this->m_MovingImageGradientCalculator == this->m_DefaultMovingImageGradientCalculator.GetPointer() &&
+        imageSource->m_MovingImageGradientCalculator ==
+          imageSource->m_DefaultMovingImageGradientCalculator.GetPointer();
+    }
+  }
+
+  this->m_MovingSampleSource = imageSource;
+  imageSource->StartRecordingMovingSamples();
+  return true;
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  StartRecordingMovingSamples() const
+{
+  MovingSampleType notEvaluated;
+  notEvaluated.State = MovingSampleStateEnum::NotEvaluated;
+  this->m_MovingSamples.assign(this->GetVirtualRegion().GetNumberOfPixels(), notEvaluated);
+  this->m_RecordMovingSamples = true;
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  StopRecordingMovingSamples() const
+{
+  this->m_RecordMovingSamples = false;
+  std::vector<MovingSampleType>().swap(this->m_MovingSamples);
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -658,6 +854,44 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+typename LightObject::Pointer
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_FixedImage = this->m_FixedImage;
+  rval->m_MovingImage = this->m_MovingImage;
+  rval->m_FixedInterpolator = this->m_FixedInterpolator;
+  rval->m_MovingInterpolator = this->m_MovingInterpolator;
+  rval->m_UseFixedImageGradientFilter = this->m_UseFixedImageGradientFilter;
+  rval->m_UseMovingImageGradientFilter = this->m_UseMovingImageGradientFilter;
+  rval->m_FixedImageGradientFilter = this->m_FixedImageGradientFilter;
+  rval->m_MovingImageGradientFilter = this->m_MovingImageGradientFilter;
+  rval->m_FixedImageGradientCalculator = this->m_FixedImageGradientCalculator;
+  rval->m_MovingImageGradientCalculator = this->m_MovingImageGradientCalculator;
+  rval->m_FixedImageMask = this->m_FixedImageMask;
+  rval->m_MovingImageMask = this->m_MovingImageMask;
+  rval->m_FixedSampledPointSet = this->m_FixedSampledPointSet;
+  rval->m_VirtualSampledPointSet = this->m_VirtualSampledPointSet;
+  rval->m_UseSampledPointSet = this->m_UseSampledPointSet;
+  rval->m_UseVirtualSampledPointSet = this->m_UseVirtualSampledPointSet;
+  rval->m_UseFloatingPointCorrection = this->m_UseFloatingPointCorrection;
+  rval->m_FloatingPointCorrectionResolution = this->m_FloatingPointCorrectionResolution;
+  rval->SetMaximumNumberOfWorkUnits(this->GetMaximumNumberOfWorkUnits());
+  return loPtr;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -81,6 +81,7 @@ public:
   using DerivativeType = typename ImageToImageMetricv4Type::DerivativeType;
   using DerivativeValueType = typename ImageToImageMetricv4Type::DerivativeValueType;
   using JacobianType = typename ImageToImageMetricv4Type::JacobianType;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
   using ImageDimensionType = typename ImageToImageMetricv4Type::ImageDimensionType;
 
   using InternalComputationValueType = typename ImageToImageMetricv4Type::InternalComputationValueType;
@@ -88,6 +89,7 @@ public:
 
   using CompensatedDerivativeValueType = CompensatedSummation<DerivativeValueType>;
   using CompensatedDerivativeType = std::vector<CompensatedDerivativeValueType>;
+  using CompensatedMeasureType = CompensatedSummation<InternalComputationValueType>;
 
   /** Access the GetValueAndDerivative() accesor in image metric base. */
   virtual bool
@@ -163,15 +165,30 @@ protected:
 
 
   /** Store derivative result from a single point calculation.
+   * When ComputeMovingTransformSparseJacobian() was called for the point, only
+   * the first NonZeroJacobianIndices.size() local derivatives are read and
+   * scattered to the listed parameters.
    * \warning If this method is overridden or otherwise not used
    * in a derived class, be sure to *accumulate* results. */
   virtual void
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId);
 
+  /** Compute the Jacobian of the moving transform with respect to its
+   * parameters at \c virtualPoint in sparse form, into the per-thread
+   * MovingTransformJacobian and NonZeroJacobianIndices, and return the number
+   * of nonzero columns. A derived class that calls this from \c ProcessPoint
+   * returns in element \c k of \c localDerivativeReturn the derivative with
+   * respect to parameter NonZeroJacobianIndices[k], so that transforms with
+   * local support, e.g. B-splines, only cost their support region per point.
+   * \warning This is called from the threader, and thus must be thread-safe. */
+  NumberOfParametersType
+  ComputeMovingTransformSparseJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const;
+
   struct GetValueAndDerivativePerThreadStruct
   {
-    /** Intermediary threaded metric value storage. */
-    InternalComputationValueType Measure;
+    /** Intermediary threaded metric value storage. Compensated, so that a
+     * float computation type does not lose the contribution of late points. */
+    CompensatedMeasureType Measure;
     /** Intermediary threaded metric value storage. */
     DerivativeType Derivatives;
     /** Intermediary threaded metric value storage. This is used only with global transforms. */
@@ -184,6 +201,10 @@ protected:
      * classes for efficiency. */
     JacobianType MovingTransformJacobian;
     JacobianType MovingTransformJacobianPositional;
+    /** Parameters of the columns of MovingTransformJacobian, and whether the
+     * local derivatives of the current point are stored in sparse form. */
+    NonZeroJacobianIndicesType NonZeroJacobianIndices;
+    bool                       UseSparseLocalDerivatives;
   };
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT,
                GetValueAndDerivativePerThreadStruct,
@@ -100,8 +100,8 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   {
     this->m_GetValueAndDerivativePerThreadVariables[thread].NumberOfValidPoints =
       NumericTraits<SizeValueType>::ZeroValue();
-    this->m_GetValueAndDerivativePerThreadVariables[thread].Measure =
-      NumericTraits<InternalComputationValueType>::ZeroValue();
+    this->m_GetValueAndDerivativePerThreadVariables[thread].Measure.ResetToZero();
+    this->m_GetValueAndDerivativePerThreadVariables[thread].UseSparseLocalDerivatives = false;
     if (this->m_Associate->GetComputeDerivative())
     {
       if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
@@ -160,13 +160,13 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   if (this->m_Associate->VerifyNumberOfValidPoints(this->m_Associate->m_Value,
                                                    *(this->m_Associate->m_DerivativeResult)))
   {
-    this->m_Associate->m_Value = NumericTraits<MeasureType>::ZeroValue();
     /* Accumulate the metric value from threads and store the average. */
+    CompensatedMeasureType value;
     for (ThreadIdType threadId = 0; threadId < numThreadsUsed; ++threadId)
     {
-      this->m_Associate->m_Value += this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure;
+      value += this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure;
     }
-    this->m_Associate->m_Value /= this->m_Associate->m_NumberOfValidPoints;
+    this->m_Associate->m_Value = value.GetSum() / this->m_Associate->m_NumberOfValidPoints;
 
     /* For global transforms, calculate the average values */
     if (this->m_Associate->GetComputeDerivative())
@@ -224,13 +224,13 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
 
   try
   {
-    pointIsValid =
-      this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
-    if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
-        this->m_Associate->GetGradientSourceIncludesMoving())
-    {
-      this->m_Associate->ComputeMovingImageGradientAtPoint(mappedMovingPoint, mappedMovingImageGradient);
-    }
+    pointIsValid = this->m_Associate->TransformAndEvaluateMovingPoint(
+      virtualIndex,
+      virtualPoint,
+      this->m_Associate->GetComputeDerivative() && this->m_Associate->GetGradientSourceIncludesMoving(),
+      mappedMovingPoint,
+      mappedMovingPixelValue,
+      mappedMovingImageGradient);
   }
   catch (ExceptionObject & exc)
   {
@@ -246,6 +246,7 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
 
   /* Call the user method in derived classes to do the specific
    * calculations for value and derivative. */
+  this->m_GetValueAndDerivativePerThreadVariables[threadId].UseSparseLocalDerivatives = false;
   try
   {
     pointIsValid = this->ProcessPoint(virtualIndex,
@@ -286,6 +287,12 @@ void
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId)
 {
+  AlignedGetValueAndDerivativePerThreadStruct & threadVariables =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  const bool                   sparse = threadVariables.UseSparseLocalDerivatives;
+  const NumberOfParametersType numberOfLocalDerivatives =
+    sparse ? threadVariables.NonZeroJacobianIndices.size() : this->m_CachedNumberOfLocalParameters;
+
   if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
       MovingTransformType::TransformCategoryEnum::DisplacementField)
   {
@@ -293,18 +300,27 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
     if (this->m_Associate->GetUseFloatingPointCorrection())
     {
       DerivativeValueType correctionResolution = this->m_Associate->GetFloatingPointCorrectionResolution();
-      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; p++)
+      for (NumberOfParametersType p = 0; p < numberOfLocalDerivatives; p++)
+      {
+        auto test = static_cast<intmax_t>(threadVariables.LocalDerivatives[p] * correctionResolution);
+        threadVariables.LocalDerivatives[p] = static_cast<DerivativeValueType>(test / correctionResolution);
+      }
+    }
+    if (sparse)
+    {
+      /* Only the parameters in the support of the point are touched. */
+      for (NumberOfParametersType k = 0; k < numberOfLocalDerivatives; k++)
       {
-        auto test = static_cast<intmax_t>(
-          this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p] * correctionResolution);
-        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p] =
-          static_cast<DerivativeValueType>(test / correctionResolution);
+        threadVariables.CompensatedDerivatives[threadVariables.NonZeroJacobianIndices[k]] +=
+          threadVariables.LocalDerivatives[k];
       }
     }
-    for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; p++)
+    else
     {
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[p] +=
-        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p];
+      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; p++)
+      {
+        threadVariables.CompensatedDerivatives[p] += threadVariables.LocalDerivatives[p];
+      }
     }
   }
   else
@@ -317,12 +333,12 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
     {
       OffsetValueType offset =
         this->m_Associate->ComputeParameterOffsetFromVirtualIndex(virtualIndex, this->m_CachedNumberOfLocalParameters);
-      for (NumberOfParametersType i = 0; i < this->m_CachedNumberOfLocalParameters; i++)
+      for (NumberOfParametersType i = 0; i < numberOfLocalDerivatives; i++)
       {
         /* Be sure to *add* here and not assign. Required for proper behavior
          * with multi-variate metric. */
-        this->m_GetValueAndDerivativePerThreadVariables[threadId].Derivatives[offset + i] +=
-          this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[i];
+        const NumberOfParametersType localIndex = sparse ? threadVariables.NonZeroJacobianIndices[i] : i;
+        threadVariables.Derivatives[offset + localIndex] += threadVariables.LocalDerivatives[i];
       }
     }
     catch (ExceptionObject & exc)
@@ -335,6 +351,20 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+auto
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ComputeMovingTransformSparseJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const
+  -> NumberOfParametersType
+{
+  AlignedGetValueAndDerivativePerThreadStruct & threadVariables =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  this->m_Associate->GetMovingTransform()->ComputeSparseJacobianWithRespectToParameters(
+    virtualPoint, threadVariables.MovingTransformJacobian, threadVariables.NonZeroJacobianIndices);
+  threadVariables.UseSparseLocalDerivatives = true;
+  return threadVariables.NonZeroJacobianIndices.size();
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 bool
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::GetComputeDerivative()
@@ -64,23 +64,24 @@ JointHistogramMutualInformationComputeJointPDFThreaderBase<TDomainPartitioner,
 template <typename TDomainPartitioner, typename TJointHistogramMetric>
 void
 JointHistogramMutualInformationComputeJointPDFThreaderBase<TDomainPartitioner, TJointHistogramMetric>::ProcessPoint(
-  const VirtualIndexType & itkNotUsed(virtualIndex),
+  const VirtualIndexType & virtualIndex,
   const VirtualPointType & virtualPoint,
   const ThreadIdType       threadId)
 {
-  typename AssociateType::Superclass::FixedImagePointType  mappedFixedPoint;
-  typename AssociateType::Superclass::FixedImagePixelType  fixedImageValue;
-  typename AssociateType::Superclass::MovingImagePointType mappedMovingPoint;
-  typename AssociateType::Superclass::MovingImagePixelType movingImageValue;
-  bool                                                     pointIsValid = false;
+  typename AssociateType::Superclass::FixedImagePointType     mappedFixedPoint;
+  typename AssociateType::Superclass::FixedImagePixelType     fixedImageValue;
+  typename AssociateType::Superclass::MovingImagePointType    mappedMovingPoint;
+  typename AssociateType::Superclass::MovingImagePixelType    movingImageValue;
+  typename AssociateType::Superclass::MovingImageGradientType movingImageGradient;
+  bool                                                        pointIsValid = false;
 
   try
   {
     pointIsValid = this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue);
     if (pointIsValid)
     {
-      pointIsValid =
-        this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue);
+      pointIsValid = this->m_Associate->TransformAndEvaluateMovingPoint(
+        virtualIndex, virtualPoint, false, mappedMovingPoint, movingImageValue, movingImageGradient);
     }
   }
   catch (ExceptionObject & exc)
@@ -166,17 +166,13 @@ JointHistogramMutualInformationGetValueAndDerivativeThreader<
     scalingfactor = NumericTraits<InternalComputationValueType>::ZeroValue();
   }
 
-  /* Use a pre-allocated jacobian object for efficiency */
-  using JacobianReferenceType = JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  JacobianReferenceType jacobianPositional =
-    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  /* Use the pre-allocated per-thread jacobian, holding only the columns of
+   * the parameters the point depends on. For dense transforms this is identity. */
+  const NumberOfParametersType numberOfNonZeroParameters =
+    this->ComputeMovingTransformSparseJacobian(virtualPoint, threadId);
+  const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-  /** For dense transforms, this returns identity */
-  this->m_JointAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-    virtualPoint, jacobian, jacobianPositional);
-
-  for (NumberOfParametersType par = 0; par < this->GetCachedNumberOfLocalParameters(); par++)
+  for (NumberOfParametersType par = 0; par < numberOfNonZeroParameters; par++)
   {
     InternalComputationValueType sum = NumericTraits<InternalComputationValueType>::ZeroValue();
     for (SizeValueType dim = 0; dim < TImageToImageMetric::MovingImageDimension; dim++)
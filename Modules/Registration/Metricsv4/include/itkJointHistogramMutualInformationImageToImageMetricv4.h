@@ -210,6 +210,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   /** Count of the number of valid histogram points. */
   SizeValueType m_JointHistogramTotalCount{ 0 };
 
@@ -136,6 +136,7 @@ public:
 
   using MovingTransformType = typename Superclass::MovingTransformType;
   using JacobianType = typename Superclass::JacobianType;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
   using VirtualImageType = typename Superclass::VirtualImageType;
   using VirtualIndexType = typename Superclass::VirtualIndexType;
   using VirtualPointType = typename Superclass::VirtualPointType;
@@ -223,6 +224,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   using JointPDFIndexType = typename JointPDFType::IndexType;
   using JointPDFValueType = typename JointPDFType::PixelType;
   using JointPDFRegionType = typename JointPDFType::RegionType;
@@ -339,6 +343,16 @@ protected:
       return PDFBufferForWriting;
     }
 
+    /** Same as GetNextElementAndAddOffset(), for a line that holds the
+     * contributions to the parameters listed in \c nonZeroIndices only, in
+     * that order. \c nonZeroIndices must not be empty. */
+    PDFValueType *
+    GetNextSparseElementAndAddOffset(const OffsetValueType & offset, const NonZeroJacobianIndicesType & nonZeroIndices)
+    {
+      m_BufferNonZeroIndicesContainer[m_CurrentFillSize] = nonZeroIndices;
+      return this->GetNextElementAndAddOffset(offset);
+    }
+
     /**
      * Apply the operations stored in the buffer.
      * This method is not thread safe and requires a lock while threading.
@@ -357,6 +371,8 @@ protected:
     std::vector<OffsetValueType> m_BufferOffsetContainer;
     size_t                       m_CachedNumberOfLocalParameters;
     size_t                       m_MaxBufferSize;
+    // Parameter indices of the sparse lines, empty for dense lines
+    std::vector<NonZeroJacobianIndicesType> m_BufferNonZeroIndicesContainer;
     // Pointer handle to parent version
     std::mutex * m_ParentJointPDFDerivativesLockPtr;
     // Smart pointer handle to parent version
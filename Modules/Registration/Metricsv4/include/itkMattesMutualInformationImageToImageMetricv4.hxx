@@ -493,6 +493,29 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
 }
 
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+typename LightObject::Pointer
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->SetNumberOfHistogramBins(this->m_NumberOfHistogramBins);
+  return loPtr;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -567,6 +590,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   m_MemoryBlockSize = cachedNumberOfLocalParameters * maxBufferLength;
   m_BufferPDFValuesContainer.resize(maxBufferLength, nullptr);
   m_BufferOffsetContainer.resize(maxBufferLength, 0);
+  m_BufferNonZeroIndicesContainer.resize(maxBufferLength);
   m_CachedNumberOfLocalParameters = cachedNumberOfLocalParameters;
   m_MaxBufferSize = maxBufferLength;
   m_ParentJointPDFDerivativesLockPtr = parentDerivativeLockPtr;
@@ -597,6 +621,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   m_MemoryBlockSize = m_MemoryBlockSize * 2;
   m_BufferPDFValuesContainer.resize(m_MaxBufferSize, nullptr);
   m_BufferOffsetContainer.resize(m_MaxBufferSize, 0);
+  m_BufferNonZeroIndicesContainer.resize(m_MaxBufferSize);
   m_MemoryBlock.resize(m_MemoryBlockSize, 0.0);
   for (size_t index = 0; index < m_MaxBufferSize; ++index)
   {
@@ -685,18 +710,32 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
     const OffsetValueType          ThisIndexOffset = *BufferOffsetContainerIter;
     JointPDFDerivativesValueType * derivPtr = this->m_ParentJointPDFDerivatives->GetBufferPointer() + ThisIndexOffset;
 
-    PDFValueType *             derivativeContribution = *BufferPDFValuesContainerIter;
-    const PDFValueType * const endContribution = derivativeContribution + m_CachedNumberOfLocalParameters;
-    while (derivativeContribution < endContribution)
+    PDFValueType *               derivativeContribution = *BufferPDFValuesContainerIter;
+    NonZeroJacobianIndicesType & nonZeroIndices = this->m_BufferNonZeroIndicesContainer[bufferIndex];
+    if (!nonZeroIndices.empty())
     {
-      *(derivPtr) += *(derivativeContribution);
-      // NOTE: Preliminary inconclusive tests indicates that setting to zero
-      // while it's local in cache is faster than bulk memset after the loop
-      // for small data sets
-      *(derivativeContribution) = 0.0; // Reset to zero after getting
-                                       // value
-      ++derivativeContribution;
-      ++derivPtr;
+      // Sparse line: only the parameters in the support of the point.
+      for (size_t k = 0; k < nonZeroIndices.size(); ++k)
+      {
+        derivPtr[nonZeroIndices[k]] += derivativeContribution[k];
+        derivativeContribution[k] = 0.0;
+      }
+      nonZeroIndices.clear();
+    }
+    else
+    {
+      const PDFValueType * const endContribution = derivativeContribution + m_CachedNumberOfLocalParameters;
+      while (derivativeContribution < endContribution)
+      {
+        *(derivPtr) += *(derivativeContribution);
+        // NOTE: Preliminary inconclusive tests indicates that setting to zero
+        // while it's local in cache is faster than bulk memset after the loop
+        // for small data sets
+        *(derivativeContribution) = 0.0; // Reset to zero after getting
+                                         // value
+        ++derivativeContribution;
+        ++derivPtr;
+      }
     }
 
     ++BufferOffsetContainerIter;
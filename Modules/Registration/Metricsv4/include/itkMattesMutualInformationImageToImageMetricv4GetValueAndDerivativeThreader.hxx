@@ -333,21 +333,30 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     }
   }
 
-  // Compute the transform Jacobian.
+  const bool transformIsDisplacement = this->m_MattesAssociate->m_MovingTransform->GetTransformCategory() ==
+                                       MovingTransformType::TransformCategoryEnum::DisplacementField;
+
+  // Compute the transform Jacobian. For global transforms, only the columns
+  // of the parameters the point depends on are computed and buffered.
   using JacobianReferenceType = JacobianType &;
   JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+  NumberOfParametersType numberOfNonZeroParameters = 0;
   if (doComputeDerivative)
   {
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-    this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      virtualPoint, jacobian, jacobianPositional);
+    if (transformIsDisplacement)
+    {
+      JacobianReferenceType jacobianPositional =
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+      this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+        virtualPoint, jacobian, jacobianPositional);
+    }
+    else
+    {
+      numberOfNonZeroParameters = this->ComputeMovingTransformSparseJacobian(virtualPoint, threadId);
+    }
   }
 
   SizeValueType movingParzenBin = 0;
-
-  const bool transformIsDisplacement = this->m_MattesAssociate->m_MovingTransform->GetTransformCategory() ==
-                                       MovingTransformType::TransformCategoryEnum::DisplacementField;
   while (pdfMovingIndex <= pdfMovingIndexMax)
   {
     const auto val =
@@ -373,7 +382,7 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
         this->ComputePDFDerivativesLocalSupportTransform(
           jacobian, movingImageGradient, cubicBSplineDerivativeValue, localSupportDerivativeResultPtr);
       }
-      else
+      else if (numberOfNonZeroParameters > 0)
       {
         // Update bins in the PDF derivatives for the current intensity pair
         const OffsetValueType ThisIndexOffset =
@@ -381,9 +390,9 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
           (pdfMovingIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[1]);
 
         PDFValueType * derivativeContributionPtr =
-          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
-        for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
-             ++mu)
+          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextSparseElementAndAddOffset(
+            ThisIndexOffset, this->m_GetValueAndDerivativePerThreadVariables[threadId].NonZeroJacobianIndices);
+        for (NumberOfParametersType mu = 0; mu < numberOfNonZeroParameters; ++mu)
         {
           PDFValueType innerProduct = 0.0;
           for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
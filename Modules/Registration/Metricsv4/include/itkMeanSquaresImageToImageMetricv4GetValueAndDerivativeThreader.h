@@ -62,6 +62,7 @@ public:
   using MeasureType = typename Superclass::MeasureType;
   using DerivativeType = typename Superclass::DerivativeType;
   using DerivativeValueType = typename Superclass::DerivativeValueType;
+  using JacobianType = typename Superclass::JacobianType;
   using NumberOfParametersType = typename Superclass::NumberOfParametersType;
 
 protected:
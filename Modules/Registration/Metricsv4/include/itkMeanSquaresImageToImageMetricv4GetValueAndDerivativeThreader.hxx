@@ -57,17 +57,13 @@ MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
     return true;
   }
 
-  /* Use a pre-allocated jacobian object for efficiency */
-  using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  JacobianReferenceType jacobianPositional =
-    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  /* Use the pre-allocated per-thread jacobian, holding only the columns of
+   * the parameters the point depends on. For dense transforms this is identity. */
+  const NumberOfParametersType numberOfNonZeroParameters =
+    this->ComputeMovingTransformSparseJacobian(virtualPoint, threadId);
+  const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-  /** For dense transforms, this returns identity */
-  this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-    virtualPoint, jacobian, jacobianPositional);
-
-  for (unsigned int par = 0; par < this->GetCachedNumberOfLocalParameters(); par++)
+  for (NumberOfParametersType par = 0; par < numberOfNonZeroParameters; par++)
   {
     localDerivativeReturn[par] = NumericTraits<DerivativeValueType>::ZeroValue();
     for (unsigned int nc = 0; nc < nComponents; nc++)
@@ -245,10 +245,50 @@ ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TI
     }
   }
 
+  /* Find the components that can reuse the moving samples of an earlier
+   * component. A component that shares the samples of another one is not
+   * used as a source itself. */
+  this->m_MovingSampleSources.resize(this->GetNumberOfMetrics());
+  for (SizeValueType j = 0; j < this->GetNumberOfMetrics(); j++)
+  {
+    this->m_MovingSampleSources[j] = j;
+    if (!this->m_UseSharedMovingSamples)
+    {
+      continue;
+    }
+    for (SizeValueType k = 0; k < j; k++)
+    {
+      if (this->m_MovingSampleSources[k] == k && this->m_MetricQueue[j]->SetMovingSampleSource(this->m_MetricQueue[k]))
+      {
+        this->m_MovingSampleSources[j] = k;
+        break;
+      }
+    }
+  }
+  this->ShareMovingSamples(false);
+
   /* Do this after we've setup local copy of virtual domain */
   Superclass::Initialize();
 }
 
+template <unsigned int TFixedDimension,
+          unsigned int TMovingDimension,
+          typename TVirtualImage,
+          typename TInternalComputationValueType>
+void
+ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TInternalComputationValueType>::
+  ShareMovingSamples(bool share) const
+{
+  for (SizeValueType j = 0; j < this->m_MovingSampleSources.size(); j++)
+  {
+    const SizeValueType k = this->m_MovingSampleSources[j];
+    if (k != j)
+    {
+      this->m_MetricQueue[j]->SetMovingSampleSource(share ? this->m_MetricQueue[k].GetPointer() : nullptr);
+    }
+  }
+}
+
 template <unsigned int TFixedDimension,
           unsigned int TMovingDimension,
           typename TVirtualImage,
@@ -260,10 +300,20 @@ typename ObjectToObjectMultiMetricv4<TFixedDimension,
 ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TInternalComputationValueType>::GetValue()
   const
 {
-  for (SizeValueType j = 0; j < this->GetNumberOfMetrics(); j++)
+  this->ShareMovingSamples(true);
+  try
+  {
+    for (SizeValueType j = 0; j < this->GetNumberOfMetrics(); j++)
+    {
+      this->m_MetricValueArray[j] = this->m_MetricQueue[j]->GetValue();
+    }
+  }
+  catch (...)
   {
-    this->m_MetricValueArray[j] = this->m_MetricQueue[j]->GetValue();
+    this->ShareMovingSamples(false);
+    throw;
   }
+  this->ShareMovingSamples(false);
 
   MeasureType firstValue = this->m_MetricValueArray[0];
   this->m_Value = firstValue;
@@ -301,9 +351,18 @@ ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TI
 
   // Loop over metrics
   DerivativeValueType totalMagnitude = NumericTraits<DerivativeValueType>::ZeroValue();
+  this->ShareMovingSamples(true);
   for (SizeValueType j = 0; j < this->GetNumberOfMetrics(); j++)
   {
-    this->m_MetricQueue[j]->GetValueAndDerivative(metricValue, metricDerivative);
+    try
+    {
+      this->m_MetricQueue[j]->GetValueAndDerivative(metricValue, metricDerivative);
+    }
+    catch (...)
+    {
+      this->ShareMovingSamples(false);
+      throw;
+    }
     this->m_MetricValueArray[j] = metricValue;
 
     DerivativeValueType magnitude = metricDerivative.magnitude();
@@ -322,6 +381,8 @@ ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TI
     }
   }
 
+  this->ShareMovingSamples(false);
+
   // Scale by totalMagnitude to prevent what amounts to implicit step estimation from magnitude scaling.
   // This keeps the behavior of this metric the same as a regular metric, with respect to derivative
   // magnitudes.
@@ -380,6 +441,20 @@ ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TI
   return this->m_MetricQueue;
 }
 
+template <unsigned int TFixedDimension,
+          unsigned int TMovingDimension,
+          typename TVirtualImage,
+          typename TInternalComputationValueType>
+const typename ObjectToObjectMultiMetricv4<TFixedDimension,
+                                           TMovingDimension,
+                                           TVirtualImage,
+                                           TInternalComputationValueType>::MovingSampleSourcesType &
+ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TInternalComputationValueType>::
+  GetMovingSampleSources() const
+{
+  return this->m_MovingSampleSources;
+}
+
 
 template <unsigned int TFixedDimension,
           unsigned int TMovingDimension,
@@ -409,6 +484,7 @@ ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TI
   Indent         indent) const
 {
   os << indent << "Weights of metric derivatives: " << this->m_MetricWeights << std::endl;
+  os << indent << "Use shared moving samples: " << this->m_UseSharedMovingSamples << std::endl;
   os << indent << "The multivariate contains the following metrics: " << std::endl << std::endl;
   for (SizeValueType i = 0; i < this->GetNumberOfMetrics(); i++)
   {
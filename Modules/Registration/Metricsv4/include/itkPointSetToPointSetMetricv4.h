@@ -115,6 +115,7 @@ public:
   using JacobianType = typename Superclass::JacobianType;
   using FixedTransformJacobianType = typename Superclass::FixedTransformJacobianType;
   using MovingTransformJacobianType = typename Superclass::MovingTransformJacobianType;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
 
   using DisplacementFieldTransformType = typename Superclass::MovingDisplacementFieldTransformType;
 
@@ -337,6 +338,17 @@ public:
   itkGetConstMacro(CalculateValueAndDerivativeInTangentSpace, bool);
   itkBooleanMacro(CalculateValueAndDerivativeInTangentSpace);
 
+  /**
+   * Largest displacement, in physical units, by which the transformed points
+   * may move away from where they were when the points locators were last
+   * built before the locators are rebuilt.  Below this threshold the locators
+   * are refit in place, which keeps the closest point queries exact while
+   * avoiding a full tree construction for each small transform update.
+   * The default of 0 rebuilds the locators whenever the points move.
+   */
+  itkSetMacro(PointsLocatorMaximumRefitDisplacement, double);
+  itkGetConstMacro(PointsLocatorMaximumRefitDisplacement, double);
+
 protected:
   PointSetToPointSetMetricv4();
   ~PointSetToPointSetMetricv4() override = default;
@@ -353,6 +365,8 @@ protected:
 
   mutable typename PointsLocatorType::Pointer m_MovingTransformedPointsLocator;
 
+  double m_PointsLocatorMaximumRefitDisplacement;
+
   /** Holds the fixed points after transformation into virtual domain. */
   mutable VirtualPointSetPointer m_VirtualTransformedPointSet;
 
@@ -38,6 +38,7 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
 
   this->m_FixedTransformedPointsLocator = nullptr;
   this->m_MovingTransformedPointsLocator = nullptr;
+  this->m_PointsLocatorMaximumRefitDisplacement = 0.0;
 
   this->m_MovingTransformPointLocatorsNeedInitialization = false;
   this->m_FixedTransformPointLocatorsNeedInitialization = false;
@@ -295,6 +296,7 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
 
       MovingTransformJacobianType jacobian(MovingPointDimension, numberOfLocalParameters);
       MovingTransformJacobianType jacobianCache;
+      NonZeroJacobianIndicesType  nonZeroJacobianIndices;
 
       DerivativeType threadLocalTransformDerivative(numberOfLocalParameters);
       threadLocalTransformDerivative.Fill(NumericTraits<DerivativeValueType>::ZeroValue());
@@ -337,6 +339,23 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
           pointDerivative = this->GetLocalNeighborhoodDerivative(fixedTransformedPointSet[index], pixel);
         }
 
+        // Global transforms: only the parameters the point depends on are accumulated.
+        if (!this->HasLocalSupport() && !this->m_CalculateValueAndDerivativeInTangentSpace)
+        {
+          this->GetMovingTransform()->ComputeSparseJacobianWithRespectToParameters(
+            virtualTransformedPointSet[index], jacobian, nonZeroJacobianIndices);
+          for (NumberOfParametersType k = 0; k < nonZeroJacobianIndices.size(); k++)
+          {
+            DerivativeValueType parameterDerivative = NumericTraits<DerivativeValueType>::ZeroValue();
+            for (DimensionType d = 0; d < PointDimension; ++d)
+            {
+              parameterDerivative += jacobian(d, k) * pointDerivative[d];
+            }
+            threadDerivativeSum[nonZeroJacobianIndices[k]] += parameterDerivative;
+          }
+          continue;
+        }
+
         // Map into parameter space
         threadLocalTransformDerivative.Fill(NumericTraits<DerivativeValueType>::ZeroValue());
 
@@ -607,9 +626,15 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
     if (!this->m_FixedTransformedPointsLocator)
     {
       this->m_FixedTransformedPointsLocator = PointsLocatorType::New();
+      this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
+      this->m_FixedTransformedPointsLocator->Initialize();
+    }
+    else
+    {
+      this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
+      this->m_FixedTransformedPointsLocator->SetMaximumRefitDisplacement(this->m_PointsLocatorMaximumRefitDisplacement);
+      this->m_FixedTransformedPointsLocator->Refit();
     }
-    this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
-    this->m_FixedTransformedPointsLocator->Initialize();
   }
 
   if (this->RequiresMovingPointsLocator() && this->m_MovingTransformPointLocatorsNeedInitialization)
@@ -621,9 +646,16 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
     if (!this->m_MovingTransformedPointsLocator)
     {
       this->m_MovingTransformedPointsLocator = PointsLocatorType::New();
+      this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
+      this->m_MovingTransformedPointsLocator->Initialize();
+    }
+    else
+    {
+      this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
+      this->m_MovingTransformedPointsLocator->SetMaximumRefitDisplacement(
+        this->m_PointsLocatorMaximumRefitDisplacement);
+      this->m_MovingTransformedPointsLocator->Refit();
     }
-    this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
-    this->m_MovingTransformedPointsLocator->Initialize();
   }
 }
 
@@ -684,6 +716,9 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
   {
     os << "false." << std::endl;
   }
+
+  os << indent << "Points locator maximum refit displacement: " << this->m_PointsLocatorMaximumRefitDisplacement
+     << std::endl;
 }
 } // end namespace itk
 
@@ -412,6 +412,49 @@ itkANTSNeighborhoodCorrelationImageToImageMetricv4Test(int, char ** const)
       fixedImage, derivativeReturn, ImageDimension);
   }
 
+  // Compare the summed-area table engine to the queues, with the dense and
+  // the sparse threaders and with windows clipped by the image boundaries.
+  for (itk::SizeValueType radius = 1; radius <= 2; ++radius)
+  {
+    itk::Size<ImageDimension> integralRadius;
+    integralRadius.Fill(radius);
+
+    for (bool useSampledPointSet : { false, true })
+    {
+      // queues first, then integral images
+      MetricType::MeasureType    values[2];
+      MetricType::DerivativeType derivatives[2];
+      for (unsigned int engine = 0; engine < 2; ++engine)
+      {
+        const bool        useIntegralImages = (engine == 1);
+        MetricTypePointer engineMetric = MetricType::New();
+        engineMetric->SetRadius(integralRadius);
+        engineMetric->SetFixedImage(fixedImage);
+        engineMetric->SetMovingImage(movingImage);
+        engineMetric->SetFixedTransform(transformFId);
+        engineMetric->SetMovingTransform(transformMdisplacement);
+        if (useSampledPointSet)
+        {
+          engineMetric->SetFixedSampledPointSet(pset);
+          engineMetric->SetUseSampledPointSet(true);
+        }
+        ITK_TEST_SET_GET_BOOLEAN(engineMetric, UseIntegralImages, useIntegralImages);
+        ITK_TRY_EXPECT_NO_EXCEPTION(engineMetric->Initialize());
+        ITK_TRY_EXPECT_NO_EXCEPTION(engineMetric->GetValueAndDerivative(values[engine], derivatives[engine]));
+      }
+
+      std::cout << "radius " << radius << (useSampledPointSet ? " sparse" : " dense") << ": queues " << values[0]
+                << ", integral images " << values[1] << std::endl;
+      if (std::abs(values[0] - values[1]) > tolerance || !derivatives[0].is_equal(derivatives[1], tolerance))
+      {
+        std::cerr << "Results of the integral images don't match the queues: " << std::endl
+                  << "  queues: " << derivatives[0] << std::endl
+                  << "  integral images: " << derivatives[1] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
   // Test that non-overlapping images will generate a warning
   // and return max value for metric value.
   DisplacementTransformType::ParametersType parameters(transformMdisplacement->GetNumberOfParameters());
@@ -359,6 +359,69 @@ itkObjectToObjectMultiMetricv4TestRun(bool useDisplacementTransform)
     return EXIT_FAILURE;
   }
 
+  std::cout << "*** Test with shared moving samples *** " << std::endl;
+  {
+    // Move away from identity so that the mapped points differ from the virtual points.
+    MultiMetricType::ParametersType parameters = transform->GetParameters();
+    MultiMetricType::ParametersType originalParameters = parameters;
+    for (unsigned int p = 0; p < parameters.GetSize(); ++p)
+    {
+      parameters[p] = (p % 2 == 0) ? 0.75 : -0.35;
+    }
+    transform->SetParameters(parameters);
+
+    ITK_TEST_SET_GET_BOOLEAN(multiVariateMetric, UseSharedMovingSamples, false);
+    multiVariateMetric->Initialize();
+    MultiMetricType::MeasureType    value;
+    MultiMetricType::DerivativeType derivative;
+    MultiMetricType::DerivativeType sharedDerivative;
+    multiVariateMetric->GetValueAndDerivative(value, derivative);
+    const MultiMetricType::MetricValueArrayType values = multiVariateMetric->GetValueArray();
+    multiVariateMetric->GetValue();
+    const MultiMetricType::MetricValueArrayType valuesOnly = multiVariateMetric->GetValueArray();
+
+    for (itk::SizeValueType n = 0; n < multiVariateMetric->GetNumberOfMetrics(); n++)
+    {
+      ITK_TEST_EXPECT_EQUAL(multiVariateMetric->GetMovingSampleSources()[n], n);
+    }
+
+    // All the components are dense image metrics of the same images and transform: they share the samples of m1.
+    multiVariateMetric->UseSharedMovingSamplesOn();
+    multiVariateMetric->Initialize();
+    for (itk::SizeValueType n = 0; n < multiVariateMetric->GetNumberOfMetrics(); n++)
+    {
+      ITK_TEST_EXPECT_EQUAL(multiVariateMetric->GetMovingSampleSources()[n], 0);
+    }
+    multiVariateMetric->GetValueAndDerivative(value, sharedDerivative);
+    const MultiMetricType::MetricValueArrayType sharedValues = multiVariateMetric->GetValueArray();
+    multiVariateMetric->GetValue();
+    const MultiMetricType::MetricValueArrayType sharedValuesOnly = multiVariateMetric->GetValueArray();
+
+    auto notClose = [](double a, double b) { return std::fabs(a - b) > 1e-10 * std::max(1.0, std::fabs(a)); };
+    for (itk::SizeValueType n = 0; n < multiVariateMetric->GetNumberOfMetrics(); n++)
+    {
+      if (notClose(values[n], sharedValues[n]) || notClose(valuesOnly[n], sharedValuesOnly[n]))
+      {
+        std::cerr << "Metric " << n << " changed with shared moving samples: " << values[n] << " vs "
+                  << sharedValues[n] << ", " << valuesOnly[n] << " vs " << sharedValuesOnly[n] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    for (unsigned int p = 0; p < derivative.GetSize(); ++p)
+    {
+      if (notClose(derivative[p], sharedDerivative[p]))
+      {
+        std::cerr << "Derivative changed with shared moving samples at " << p << ": " << derivative[p] << " vs "
+                  << sharedDerivative[p] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    multiVariateMetric->UseSharedMovingSamplesOff();
+    transform->SetParameters(originalParameters);
+    multiVariateMetric->Initialize();
+  }
+
   std::cout << "*** Test with mismatched transforms *** " << std::endl;
   TranslationTransformType::Pointer transform2 = TranslationTransformType::New();
   m4->SetMovingTransform(transform2);
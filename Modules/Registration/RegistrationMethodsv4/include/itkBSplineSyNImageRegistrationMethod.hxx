@@ -46,26 +46,26 @@ BSplineSyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform, T
   using BSplineDisplacementFieldTransformAdaptorType =
     BSplineSmoothingOnUpdateDisplacementFieldTransformParametersAdaptor<OutputTransformType>;
 
-  if (level == 0)
+  if (level == this->m_InitialLevel)
   {
     this->m_FixedToMiddleTransform->SetSplineOrder(this->m_OutputTransform->GetSplineOrder());
     this->m_FixedToMiddleTransform->SetNumberOfControlPointsForTheUpdateField(
       dynamic_cast<BSplineDisplacementFieldTransformAdaptorType *>(
-        this->m_TransformParametersAdaptorsPerLevel[0].GetPointer())
+        this->m_TransformParametersAdaptorsPerLevel[level].GetPointer())
         ->GetNumberOfControlPointsForTheUpdateField());
     this->m_FixedToMiddleTransform->SetNumberOfControlPointsForTheTotalField(
       dynamic_cast<BSplineDisplacementFieldTransformAdaptorType *>(
-        this->m_TransformParametersAdaptorsPerLevel[0].GetPointer())
+        this->m_TransformParametersAdaptorsPerLevel[level].GetPointer())
         ->GetNumberOfControlPointsForTheTotalField());
 
     this->m_MovingToMiddleTransform->SetSplineOrder(this->m_OutputTransform->GetSplineOrder());
     this->m_MovingToMiddleTransform->SetNumberOfControlPointsForTheUpdateField(
       dynamic_cast<BSplineDisplacementFieldTransformAdaptorType *>(
-        this->m_TransformParametersAdaptorsPerLevel[0].GetPointer())
+        this->m_TransformParametersAdaptorsPerLevel[level].GetPointer())
         ->GetNumberOfControlPointsForTheUpdateField());
     this->m_MovingToMiddleTransform->SetNumberOfControlPointsForTheTotalField(
       dynamic_cast<BSplineDisplacementFieldTransformAdaptorType *>(
-        this->m_TransformParametersAdaptorsPerLevel[0].GetPointer())
+        this->m_TransformParametersAdaptorsPerLevel[level].GetPointer())
         ->GetNumberOfControlPointsForTheTotalField());
   }
 }
@@ -372,6 +372,27 @@ public:
   SetNumberOfLevels(const SizeValueType);
   itkGetConstMacro(NumberOfLevels, SizeValueType);
 
+  /**
+   * Set/Get the level at which the registration starts.  Default = 0.
+   *
+   * This is used to resume a registration at a level boundary only.  The
+   * MultiResolutionIterationEvent is invoked at the start of each level,
+   * before the transform is adapted to that level, so the state observed at
+   * that point, i.e. GetCurrentLevel(), the output transform (see
+   * GetTransform()) and GetCurrentRandomSeed(), is all that is needed to
+   * continue the registration.  Passing the transform back as the
+   * InitialTransform, the level to SetInitialLevel() and the seed to
+   * MetricSamplingReinitializeSeed() reproduces the remaining levels of the
+   * original run.
+   *
+   * No checkpoint file format is provided: saving that state, e.g. with the
+   * HDF5 transform IO, is left to the caller.  Resuming within a level is not
+   * supported, since the optimizers do not expose their internal state; every
+   * level starts a new optimization instead.
+   */
+  itkSetMacro(InitialLevel, SizeValueType);
+  itkGetConstMacro(InitialLevel, SizeValueType);
+
   /**
    * Set the shrink factors for each level where each level has a constant
    * shrink factor for each dimension.  For example, input to the function
@@ -475,6 +496,10 @@ public:
   /** Get the current convergence state per level.  This is a helper function for reporting observations. */
   itkGetConstReferenceMacro(IsConverged, bool);
 
+  /** Get the seed used for the next metric sampling.  This is a helper function for checkpointing,
+   * see SetInitialLevel(). */
+  itkGetConstMacro(CurrentRandomSeed, int);
+
   /** Request that the InitialTransform be grafted onto the output,
    * there by not creating a copy.
    */
@@ -533,6 +558,7 @@ protected:
 
   SizeValueType m_CurrentLevel;
   SizeValueType m_NumberOfLevels;
+  SizeValueType m_InitialLevel;
   SizeValueType m_CurrentIteration;
   RealType      m_CurrentMetricValue;
   RealType      m_CurrentConvergenceValue;
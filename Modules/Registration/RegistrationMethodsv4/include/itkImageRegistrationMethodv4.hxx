@@ -56,6 +56,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   Self::ReleaseDataBeforeUpdateFlagOff();
 
   this->m_CurrentLevel = 0;
+  this->m_InitialLevel = 0;
   this->m_CurrentIteration = 0;
   this->m_CurrentMetricValue = 0.0;
   this->m_CurrentConvergenceValue = 0.0;
@@ -300,7 +301,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 
   // Sanity checks and find the virtual domain image
 
-  if (level == 0)
+  if (level == this->m_InitialLevel)
   {
     SizeValueType numberOfObjectPairs = static_cast<unsigned int>(0.5 * this->GetNumberOfIndexedInputs());
     if (numberOfObjectPairs == 0)
@@ -363,7 +364,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 
   // Set-up the composite transform at initialization
   // Also, find the virtual domain image
-  if (level == 0)
+  if (level == this->m_InitialLevel)
   {
     this->m_CompositeTransform->ClearTransformQueue();
 
@@ -825,12 +826,18 @@ template <typename TFixedImage, typename TMovingImage, typename TTransform, type
 void
 ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::GenerateData()
 {
+  if (this->m_InitialLevel >= this->m_NumberOfLevels)
+  {
+    itkExceptionMacro("The initial level must be less than the number of levels.");
+  }
+
   this->AllocateOutputs();
 
   // Ensure the same seed is used for each update
   this->m_CurrentRandomSeed = this->m_RandomSeed;
 
-  for (this->m_CurrentLevel = 0; this->m_CurrentLevel < this->m_NumberOfLevels; this->m_CurrentLevel++)
+  for (this->m_CurrentLevel = this->m_InitialLevel; this->m_CurrentLevel < this->m_NumberOfLevels;
+       this->m_CurrentLevel++)
   {
     this->InitializeRegistrationAtEachLevel(this->m_CurrentLevel);
 
@@ -1205,6 +1212,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   os << indent << "ReseedIterator: " << m_ReseedIterator << std::endl;
   os << indent << "RandomSeed: " << m_RandomSeed << std::endl;
   os << indent << "CurrentRandomSeed: " << m_CurrentRandomSeed << std::endl;
+  os << indent << "InitialLevel: " << this->m_InitialLevel << std::endl;
 
   os << indent << "InPlace: " << (this->m_InPlace ? "On" : "Off") << std::endl;
 
@@ -185,11 +185,22 @@ public:
   itkSetMacro(GaussianSmoothingVarianceForTheTotalField, RealType);
   itkGetConstReferenceMacro(GaussianSmoothingVarianceForTheTotalField, RealType);
 
+  /**
+   * Smooth the update and total fields in place with a recursive Gaussian
+   * instead of the GaussianOperator convolution. Default false.
+   * \sa GaussianSmoothingOnUpdateDisplacementFieldTransform::RecursiveGaussianSmoothDisplacementField
+   */
+  itkSetMacro(UseRecursiveGaussianSmoothing, bool);
+  itkGetConstMacro(UseRecursiveGaussianSmoothing, bool);
+  itkBooleanMacro(UseRecursiveGaussianSmoothing);
+
   /** Get modifiable FixedToMiddle and MovingToMidle transforms to save the current state of the registration. */
   itkGetModifiableObjectMacro(FixedToMiddleTransform, OutputTransformType);
   itkGetModifiableObjectMacro(MovingToMiddleTransform, OutputTransformType);
 
-  /** Set FixedToMiddle and MovingToMidle transforms to restore the registration from a saved state. */
+  /** Set FixedToMiddle and MovingToMidle transforms to restore the registration from a saved state.
+   * Both transforms need their inverse displacement fields.  When saved at the MultiResolutionIterationEvent
+   * they are restored at the level given to SetInitialLevel(). */
   itkSetObjectMacro(FixedToMiddleTransform, OutputTransformType);
   itkSetObjectMacro(MovingToMiddleTransform, OutputTransformType);
 
@@ -257,6 +268,7 @@ protected:
 private:
   RealType m_GaussianSmoothingVarianceForTheUpdateField{ 3.0 };
   RealType m_GaussianSmoothingVarianceForTheTotalField{ 0.5 };
+  bool     m_UseRecursiveGaussianSmoothing{ false };
 };
 } // end namespace itk
 
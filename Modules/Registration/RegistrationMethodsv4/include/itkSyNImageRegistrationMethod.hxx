@@ -22,6 +22,7 @@
 
 #include "itkComposeDisplacementFieldsImageFilter.h"
 #include "itkGaussianOperator.h"
+#include "itkGaussianSmoothingOnUpdateDisplacementFieldTransform.h"
 #include "itkImageMaskSpatialObject.h"
 #include "itkImportImageFilter.h"
 #include "itkInvertDisplacementFieldImageFilter.h"
@@ -62,7 +63,7 @@ SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform, TVirtual
 {
   Superclass::InitializeRegistrationAtEachLevel(level);
 
-  if (level == 0)
+  if (level == this->m_InitialLevel)
   {
     // If FixedToMiddle and MovingToMiddle transforms are not set already for state restoration
     //
@@ -113,10 +114,10 @@ SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform, TVirtual
           this->m_MovingToMiddleTransform->GetInverseDisplacementField())
       {
         itkDebugMacro("SyN registration is initialized by restoring the state.");
-        this->m_TransformParametersAdaptorsPerLevel[0]->SetTransform(this->m_MovingToMiddleTransform);
-        this->m_TransformParametersAdaptorsPerLevel[0]->AdaptTransformParameters();
-        this->m_TransformParametersAdaptorsPerLevel[0]->SetTransform(this->m_FixedToMiddleTransform);
-        this->m_TransformParametersAdaptorsPerLevel[0]->AdaptTransformParameters();
+        this->m_TransformParametersAdaptorsPerLevel[level]->SetTransform(this->m_MovingToMiddleTransform);
+        this->m_TransformParametersAdaptorsPerLevel[level]->AdaptTransformParameters();
+        this->m_TransformParametersAdaptorsPerLevel[level]->SetTransform(this->m_FixedToMiddleTransform);
+        this->m_TransformParametersAdaptorsPerLevel[level]->AdaptTransformParameters();
       }
       else
       {
@@ -751,6 +752,14 @@ typename SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform,
     return smoothField;
   }
 
+  if (this->m_UseRecursiveGaussianSmoothing)
+  {
+    using GaussianSmoothingTransformType =
+      GaussianSmoothingOnUpdateDisplacementFieldTransform<RealType, ImageDimension>;
+    GaussianSmoothingTransformType::RecursiveGaussianSmoothDisplacementField(smoothField, variance);
+    return smoothField;
+  }
+
   using GaussianSmoothingOperatorType = GaussianOperator<RealType, ImageDimension>;
   GaussianSmoothingOperatorType gaussianSmoothingOperator;
 
@@ -838,9 +847,18 @@ template <typename TFixedImage,
 void
 SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform, TVirtualImage, TPointSet>::GenerateData()
 {
+  if (this->m_InitialLevel >= this->m_NumberOfLevels)
+  {
+    itkExceptionMacro("The initial level must be less than the number of levels.");
+  }
+
   this->AllocateOutputs();
 
-  for (this->m_CurrentLevel = 0; this->m_CurrentLevel < this->m_NumberOfLevels; this->m_CurrentLevel++)
+  // Ensure the same seed is used for each update
+  this->m_CurrentRandomSeed = this->m_RandomSeed;
+
+  for (this->m_CurrentLevel = this->m_InitialLevel; this->m_CurrentLevel < this->m_NumberOfLevels;
+       this->m_CurrentLevel++)
   {
     this->InitializeRegistrationAtEachLevel(this->m_CurrentLevel);
 
@@ -898,6 +916,7 @@ SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform, TVirtual
   os << indent
      << "Gaussian smoothing variance for the total field: " << this->m_GaussianSmoothingVarianceForTheTotalField
      << std::endl;
+  os << indent << "Use recursive Gaussian smoothing: " << this->m_UseRecursiveGaussianSmoothing << std::endl;
 }
 
 } // end namespace itk
@@ -75,6 +75,12 @@ namespace itk
  * (but not sufficient) condition being that the velocity
  * field have a constant norm for all time points.
  *
+ * A registration is resumed at a level boundary, see SetInitialLevel(), from
+ * a copy of the velocity field taken at the MultiResolutionIterationEvent,
+ * set as the velocity field of the initial transform.  The transform IO does
+ * not support time-varying velocity field transforms: the velocity field has
+ * to be saved as an image.
+ *
  * \author Nick Tustison
  * \author Brian Avants
  *
@@ -424,10 +424,18 @@ TimeVaryingVelocityFieldImageRegistrationMethodv4<TFixedImage,
                                                   TVirtualImage,
                                                   TPointSet>::GenerateData()
 {
+  if (this->m_InitialLevel >= this->m_NumberOfLevels)
+  {
+    itkExceptionMacro("The initial level must be less than the number of levels.");
+  }
 
   this->AllocateOutputs();
 
-  for (this->m_CurrentLevel = 0; this->m_CurrentLevel < this->m_NumberOfLevels; this->m_CurrentLevel++)
+  // Ensure the same seed is used for each update
+  this->m_CurrentRandomSeed = this->m_RandomSeed;
+
+  for (this->m_CurrentLevel = this->m_InitialLevel; this->m_CurrentLevel < this->m_NumberOfLevels;
+       this->m_CurrentLevel++)
   {
     this->InitializeRegistrationAtEachLevel(this->m_CurrentLevel);
 
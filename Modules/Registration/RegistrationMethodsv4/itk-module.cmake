@@ -7,6 +7,8 @@ itk_module(ITKRegistrationMethodsv4
     ITKMetricsv4
   TEST_DEPENDS
     ITKTestKernel
+    ITKIOTransformBase
+    ITKIOTransformHDF5
   DESCRIPTION
     "${DOCUMENTATION}"
 )
@@ -0,0 +1,547 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegistrationMethodv4.h"
+#include "itkSyNImageRegistrationMethod.h"
+#include "itkTimeVaryingVelocityFieldImageRegistrationMethodv4.h"
+
+#include "itkAffineTransform.h"
+#include "itkDisplacementFieldTransformParametersAdaptor.h"
+#include "itkGradientDescentOptimizerv4.h"
+#include "itkImageDuplicator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkShrinkImageFilter.h"
+#include "itkTimeVaryingVelocityFieldTransformParametersAdaptor.h"
+#include "itkTransformFileReader.h"
+#include "itkTransformFileWriter.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Save the state of a registration at the start of a level, then resume the
+ * registration at that level from the saved state.  The resumed registration
+ * must reproduce the result of the uninterrupted one.
+ *
+ * The affine transform and the SyN half transforms are saved in HDF5 format.
+ * The time-varying velocity field transform has no transform IO, so its
+ * velocity field is kept in memory.
+ */
+
+namespace
+{
+
+constexpr unsigned int ImageDimension = 2;
+
+using ImageType = itk::Image<double, ImageDimension>;
+using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+using TransformWriterType = itk::TransformFileWriterTemplate<double>;
+using TransformReaderType = itk::TransformFileReaderTemplate<double>;
+
+ImageType::Pointer
+MakeImage(double shift)
+{
+  ImageType::RegionType region;
+  region.SetSize(0, 64);
+  region.SetSize(1, 64);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> It(image, region);
+  for (It.GoToBegin(); !It.IsAtEnd(); ++It)
+  {
+    const double x = It.GetIndex()[0] - 32.0 - shift;
+    const double y = It.GetIndex()[1] - 30.0;
+    It.Set(100.0 * std::exp(-(x * x + 2.0 * y * y) / 150.0));
+  }
+  return image;
+}
+
+TransformReaderType::TransformListType
+ReadCheckpoint(const std::string & fileName)
+{
+  TransformReaderType::Pointer reader = TransformReaderType::New();
+  reader->SetFileName(fileName);
+  reader->Update();
+  return *reader->GetTransformList();
+}
+
+/** Shrink the fixed image as the registration does at the given level. */
+ImageType::Pointer
+ShrinkImage(const ImageType * image, unsigned int shrinkFactor)
+{
+  using ShrinkFilterType = itk::ShrinkImageFilter<ImageType, ImageType>;
+  ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
+  shrinkFilter->SetShrinkFactors(shrinkFactor);
+  shrinkFilter->SetInput(image);
+  shrinkFilter->UpdateOutputInformation();
+  return shrinkFilter->GetOutput();
+}
+
+bool
+CheckSameParameters(const char *                             name,
+                    const itk::OptimizerParameters<double> & parameters,
+                    const itk::OptimizerParameters<double> & resumedParameters)
+{
+  double maximumDifference = 0.0;
+  for (unsigned int i = 0; i < parameters.Size() && i < resumedParameters.Size(); ++i)
+  {
+    maximumDifference = std::max(maximumDifference, std::abs(parameters[i] - resumedParameters[i]));
+  }
+  std::cout << name << ": maximum difference of the resumed parameters: " << maximumDifference << std::endl;
+  if (parameters.Size() != resumedParameters.Size() || parameters != resumedParameters)
+  {
+    std::cerr << "The resumed " << name << " registration differs from the uninterrupted one." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Affine registration, resumed at its last level
+
+using AffineTransformType = itk::AffineTransform<double, ImageDimension>;
+using AffineRegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, AffineTransformType>;
+
+AffineRegistrationType::Pointer
+MakeAffineRegistration(const ImageType * fixedImage, const ImageType * movingImage)
+{
+  using OptimizerType = itk::GradientDescentOptimizerv4;
+
+  AffineRegistrationType::Pointer registration = AffineRegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(MetricType::New());
+
+  OptimizerType::Pointer    optimizer = OptimizerType::New();
+  OptimizerType::ScalesType scales(6);
+  scales.Fill(1000.0);
+  scales[4] = scales[5] = 1.0;
+  optimizer->SetScales(scales);
+  optimizer->SetLearningRate(0.5);
+  optimizer->SetNumberOfIterations(10);
+  registration->SetOptimizer(optimizer);
+
+  AffineRegistrationType::ShrinkFactorsArrayType   shrinkFactors(3);
+  AffineRegistrationType::SmoothingSigmasArrayType smoothingSigmas(3);
+  for (unsigned int level = 0; level < 3; ++level)
+  {
+    shrinkFactors[level] = 4 >> level;
+    smoothingSigmas[level] = 2 - level;
+  }
+  registration->SetNumberOfLevels(3);
+  registration->SetShrinkFactorsPerLevel(shrinkFactors);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmas);
+  registration->SetMetricSamplingStrategy(AffineRegistrationType::MetricSamplingStrategyEnum::RANDOM);
+  registration->SetMetricSamplingPercentage(0.5);
+  registration->MetricSamplingReinitializeSeed(121213);
+  return registration;
+}
+
+/** Save the transform and the seed when the checkpoint level starts. */
+struct AffineCheckpoint
+{
+  const AffineRegistrationType * m_Registration;
+  std::string                    m_FileName;
+  itk::SizeValueType             m_Level;
+  int                            m_Seed;
+
+  void
+  Save()
+  {
+    if (m_Registration->GetCurrentLevel() == m_Level)
+    {
+      TransformWriterType::Pointer writer = TransformWriterType::New();
+      writer->SetFileName(m_FileName);
+      writer->SetInput(m_Registration->GetTransform());
+      writer->Update();
+      m_Seed = m_Registration->GetCurrentRandomSeed();
+    }
+  }
+};
+
+int
+AffineCheckpointTest(const std::string & fileName)
+{
+  constexpr itk::SizeValueType checkpointLevel = 2;
+
+  const ImageType::Pointer fixedImage = MakeImage(0.0);
+  const ImageType::Pointer movingImage = MakeImage(4.0);
+
+  // uninterrupted run, saving the checkpoint at the start of the last level
+  AffineRegistrationType::Pointer registration = MakeAffineRegistration(fixedImage, movingImage);
+
+  AffineCheckpoint checkpoint{ registration, fileName, checkpointLevel, 0 };
+  auto             command = itk::SimpleMemberCommand<AffineCheckpoint>::New();
+  command->SetCallbackFunction(&checkpoint, &AffineCheckpoint::Save);
+  registration->AddObserver(itk::MultiResolutionIterationEvent(), command);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+
+  // resume at the checkpoint level
+  TransformReaderType::TransformListType transforms = ReadCheckpoint(fileName);
+  auto * checkpointTransform = dynamic_cast<AffineTransformType *>(transforms.front().GetPointer());
+  ITK_TEST_EXPECT_TRUE(checkpointTransform != nullptr);
+
+  AffineRegistrationType::Pointer resumedRegistration = MakeAffineRegistration(fixedImage, movingImage);
+  resumedRegistration->SetInitialTransform(checkpointTransform);
+  resumedRegistration->SetInitialLevel(checkpointLevel);
+  resumedRegistration->MetricSamplingReinitializeSeed(checkpoint.m_Seed);
+  ITK_TEST_SET_GET_VALUE(checkpointLevel, resumedRegistration->GetInitialLevel());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(resumedRegistration->Update());
+  if (!CheckSameParameters("affine",
+                           registration->GetTransform()->GetParameters(),
+                           resumedRegistration->GetTransform()->GetParameters()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // an initial level past the last level is rejected
+  resumedRegistration->SetInitialLevel(3);
+  ITK_TRY_EXPECT_EXCEPTION(resumedRegistration->Update());
+
+  return EXIT_SUCCESS;
+}
+
+// SyN registration, resumed at its second level from the half transforms
+
+using DisplacementFieldTransformType = itk::DisplacementFieldTransform<double, ImageDimension>;
+using SyNRegistrationType = itk::SyNImageRegistrationMethod<ImageType, ImageType, DisplacementFieldTransformType>;
+
+SyNRegistrationType::Pointer
+MakeSyNRegistration(const ImageType * fixedImage, const ImageType * movingImage)
+{
+  using DisplacementFieldType = DisplacementFieldTransformType::DisplacementFieldType;
+  using AdaptorType = itk::DisplacementFieldTransformParametersAdaptor<DisplacementFieldTransformType>;
+
+  SyNRegistrationType::Pointer registration = SyNRegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(MetricType::New());
+
+  SyNRegistrationType::ShrinkFactorsArrayType      shrinkFactors(2);
+  SyNRegistrationType::SmoothingSigmasArrayType    smoothingSigmas(2);
+  SyNRegistrationType::NumberOfIterationsArrayType numberOfIterations(2);
+  shrinkFactors[0] = 2;
+  shrinkFactors[1] = 1;
+  smoothingSigmas[0] = 1;
+  smoothingSigmas[1] = 0;
+  numberOfIterations[0] = 10;
+  numberOfIterations[1] = 5;
+  registration->SetNumberOfLevels(2);
+  registration->SetShrinkFactorsPerLevel(shrinkFactors);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmas);
+  registration->SetNumberOfIterationsPerLevel(numberOfIterations);
+  registration->SetLearningRate(0.5);
+
+  // The output transform starts as a zero displacement field, resampled at each level by the adaptors
+  DisplacementFieldType::Pointer displacementField = DisplacementFieldType::New();
+  displacementField->CopyInformation(fixedImage);
+  displacementField->SetRegions(fixedImage->GetBufferedRegion());
+  displacementField->Allocate();
+  displacementField->FillBuffer(DisplacementFieldType::PixelType(0.0));
+
+  DisplacementFieldTransformType::Pointer outputTransform = DisplacementFieldTransformType::New();
+  outputTransform->SetDisplacementField(displacementField);
+  registration->SetInitialTransform(outputTransform);
+
+  SyNRegistrationType::TransformParametersAdaptorsContainerType adaptors;
+  for (unsigned int level = 0; level < 2; ++level)
+  {
+    const ImageType::Pointer shrunkImage = ShrinkImage(fixedImage, shrinkFactors[level]);
+    AdaptorType::Pointer     adaptor = AdaptorType::New();
+    adaptor->SetRequiredSpacing(shrunkImage->GetSpacing());
+    adaptor->SetRequiredSize(shrunkImage->GetLargestPossibleRegion().GetSize());
+    adaptor->SetRequiredDirection(shrunkImage->GetDirection());
+    adaptor->SetRequiredOrigin(shrunkImage->GetOrigin());
+    adaptors.push_back(adaptor.GetPointer());
+  }
+  registration->SetTransformParametersAdaptorsPerLevel(adaptors);
+  return registration;
+}
+
+/** Save the half transforms, each followed by a transform holding its
+ * inverse field, and the seed when the checkpoint level starts. */
+struct SyNCheckpoint
+{
+  SyNRegistrationType * m_Registration;
+  std::string           m_FileName;
+  itk::SizeValueType    m_Level;
+  int                   m_Seed;
+
+  void
+  Save()
+  {
+    if (m_Registration->GetCurrentLevel() == m_Level)
+    {
+      TransformWriterType::Pointer writer = TransformWriterType::New();
+      writer->SetFileName(m_FileName);
+      for (DisplacementFieldTransformType * transform : { m_Registration->GetModifiableFixedToMiddleTransform(),
+                                                           m_Registration->GetModifiableMovingToMiddleTransform() })
+      {
+        DisplacementFieldTransformType::Pointer inverse = DisplacementFieldTransformType::New();
+        inverse->SetDisplacementField(transform->GetModifiableInverseDisplacementField());
+        writer->AddTransform(transform);
+        writer->AddTransform(inverse);
+      }
+      writer->Update();
+      m_Seed = m_Registration->GetCurrentRandomSeed();
+    }
+  }
+};
+
+int
+SyNCheckpointTest(const std::string & fileName)
+{
+  constexpr itk::SizeValueType checkpointLevel = 1;
+
+  const ImageType::Pointer fixedImage = MakeImage(0.0);
+  const ImageType::Pointer movingImage = MakeImage(3.0);
+
+  // uninterrupted run, saving the checkpoint at the start of the second level
+  SyNRegistrationType::Pointer registration = MakeSyNRegistration(fixedImage, movingImage);
+
+  SyNCheckpoint checkpoint{ registration, fileName, checkpointLevel, 0 };
+  auto          command = itk::SimpleMemberCommand<SyNCheckpoint>::New();
+  command->SetCallbackFunction(&checkpoint, &SyNCheckpoint::Save);
+  registration->AddObserver(itk::MultiResolutionIterationEvent(), command);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+
+  // resume at the checkpoint level from the half transforms and their inverses
+  TransformReaderType::TransformListType transforms = ReadCheckpoint(fileName);
+  ITK_TEST_EXPECT_EQUAL(transforms.size(), 4);
+  std::vector<DisplacementFieldTransformType::Pointer> fields;
+  for (auto & transform : transforms)
+  {
+    fields.push_back(dynamic_cast<DisplacementFieldTransformType *>(transform.GetPointer()));
+    ITK_TEST_EXPECT_TRUE(fields.back().IsNotNull());
+  }
+  fields[0]->SetInverseDisplacementField(fields[1]->GetModifiableDisplacementField());
+  fields[2]->SetInverseDisplacementField(fields[3]->GetModifiableDisplacementField());
+
+  SyNRegistrationType::Pointer resumedRegistration = MakeSyNRegistration(fixedImage, movingImage);
+  resumedRegistration->SetFixedToMiddleTransform(fields[0]);
+  resumedRegistration->SetMovingToMiddleTransform(fields[2]);
+  resumedRegistration->SetInitialLevel(checkpointLevel);
+  resumedRegistration->MetricSamplingReinitializeSeed(checkpoint.m_Seed);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(resumedRegistration->Update());
+  if (!CheckSameParameters("SyN",
+                           registration->GetTransform()->GetParameters(),
+                           resumedRegistration->GetTransform()->GetParameters()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// Time-varying velocity field registration, resumed at its second level
+
+using TimeVaryingRegistrationType = itk::TimeVaryingVelocityFieldImageRegistrationMethodv4<ImageType, ImageType>;
+using VelocityFieldTransformType = TimeVaryingRegistrationType::OutputTransformType;
+using TimeVaryingVelocityFieldType = VelocityFieldTransformType::TimeVaryingVelocityFieldType;
+
+TimeVaryingRegistrationType::Pointer
+MakeTimeVaryingRegistration(const ImageType * fixedImage,
+                            const ImageType * movingImage,
+                            TimeVaryingVelocityFieldType * velocityField)
+{
+  using AdaptorType = itk::TimeVaryingVelocityFieldTransformParametersAdaptor<VelocityFieldTransformType>;
+  constexpr itk::SizeValueType numberOfTimePoints = 4;
+
+  TimeVaryingRegistrationType::Pointer registration = TimeVaryingRegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(MetricType::New());
+
+  TimeVaryingRegistrationType::ShrinkFactorsArrayType   shrinkFactors(2);
+  TimeVaryingRegistrationType::SmoothingSigmasArrayType smoothingSigmas(2);
+  TimeVaryingRegistrationType::ShrinkFactorsArrayType   numberOfIterations(2);
+  shrinkFactors[0] = 2;
+  shrinkFactors[1] = 1;
+  smoothingSigmas[0] = 1;
+  smoothingSigmas[1] = 0;
+  numberOfIterations[0] = 5;
+  numberOfIterations[1] = 3;
+  registration->SetNumberOfLevels(2);
+  registration->SetShrinkFactorsPerLevel(shrinkFactors);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmas);
+  registration->SetNumberOfIterationsPerLevel(numberOfIterations);
+  registration->SetLearningRate(0.5);
+
+  // The velocity field covers the fixed image at each time point
+  if (velocityField->GetBufferPointer() == nullptr)
+  {
+    TimeVaryingVelocityFieldType::RegionType    region;
+    TimeVaryingVelocityFieldType::PointType     origin;
+    TimeVaryingVelocityFieldType::SpacingType   spacing;
+    TimeVaryingVelocityFieldType::DirectionType direction;
+    origin.Fill(0.0);
+    spacing.Fill(1.0);
+    direction.SetIdentity();
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      region.SetSize(i, fixedImage->GetBufferedRegion().GetSize(i));
+      origin[i] = fixedImage->GetOrigin()[i];
+      spacing[i] = fixedImage->GetSpacing()[i];
+    }
+    region.SetSize(ImageDimension, numberOfTimePoints);
+    velocityField->SetOrigin(origin);
+    velocityField->SetSpacing(spacing);
+    velocityField->SetDirection(direction);
+    velocityField->SetRegions(region);
+    velocityField->Allocate();
+    velocityField->FillBuffer(TimeVaryingVelocityFieldType::PixelType(0.0));
+  }
+
+  VelocityFieldTransformType::Pointer outputTransform = VelocityFieldTransformType::New();
+  outputTransform->SetGaussianSpatialSmoothingVarianceForTheTotalField(0.0);
+  outputTransform->SetGaussianSpatialSmoothingVarianceForTheUpdateField(3.0);
+  outputTransform->SetGaussianTemporalSmoothingVarianceForTheTotalField(0.0);
+  outputTransform->SetGaussianTemporalSmoothingVarianceForTheUpdateField(0.5);
+  outputTransform->SetVelocityField(velocityField);
+  outputTransform->SetLowerTimeBound(0.0);
+  outputTransform->SetUpperTimeBound(1.0);
+  outputTransform->IntegrateVelocityField();
+  registration->SetInitialTransform(outputTransform);
+
+  // Only the spatial resolution of the velocity field changes with the level
+  TimeVaryingRegistrationType::TransformParametersAdaptorsContainerType adaptors;
+  for (unsigned int level = 0; level < 2; ++level)
+  {
+    const ImageType::Pointer shrunkImage = ShrinkImage(fixedImage, shrinkFactors[level]);
+
+    TimeVaryingVelocityFieldType::SizeType      size;
+    TimeVaryingVelocityFieldType::PointType     origin;
+    TimeVaryingVelocityFieldType::SpacingType   spacing;
+    TimeVaryingVelocityFieldType::DirectionType direction;
+    size.Fill(numberOfTimePoints);
+    origin.Fill(0.0);
+    spacing.Fill(1.0);
+    direction.SetIdentity();
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      size[i] = shrunkImage->GetLargestPossibleRegion().GetSize(i);
+      origin[i] = shrunkImage->GetOrigin()[i];
+      spacing[i] = shrunkImage->GetSpacing()[i];
+    }
+
+    AdaptorType::Pointer adaptor = AdaptorType::New();
+    adaptor->SetRequiredSpacing(spacing);
+    adaptor->SetRequiredSize(size);
+    adaptor->SetRequiredDirection(direction);
+    adaptor->SetRequiredOrigin(origin);
+    adaptors.push_back(adaptor.GetPointer());
+  }
+  registration->SetTransformParametersAdaptorsPerLevel(adaptors);
+  return registration;
+}
+
+/** Copy the velocity field and the seed when the checkpoint level starts. */
+struct TimeVaryingCheckpoint
+{
+  const TimeVaryingRegistrationType *   m_Registration;
+  itk::SizeValueType                    m_Level;
+  TimeVaryingVelocityFieldType::Pointer m_VelocityField;
+  int                                   m_Seed;
+
+  void
+  Save()
+  {
+    if (m_Registration->GetCurrentLevel() == m_Level)
+    {
+      using DuplicatorType = itk::ImageDuplicator<TimeVaryingVelocityFieldType>;
+      DuplicatorType::Pointer duplicator = DuplicatorType::New();
+      duplicator->SetInputImage(m_Registration->GetTransform()->GetVelocityField());
+      duplicator->Update();
+      m_VelocityField = duplicator->GetOutput();
+      m_Seed = m_Registration->GetCurrentRandomSeed();
+    }
+  }
+};
+
+int
+TimeVaryingCheckpointTest()
+{
+  constexpr itk::SizeValueType checkpointLevel = 1;
+
+  const ImageType::Pointer fixedImage = MakeImage(0.0);
+  const ImageType::Pointer movingImage = MakeImage(3.0);
+
+  // uninterrupted run, saving the checkpoint at the start of the second level
+  TimeVaryingRegistrationType::Pointer registration =
+    MakeTimeVaryingRegistration(fixedImage, movingImage, TimeVaryingVelocityFieldType::New());
+
+  TimeVaryingCheckpoint checkpoint{ registration, checkpointLevel, nullptr, 0 };
+  auto                  command = itk::SimpleMemberCommand<TimeVaryingCheckpoint>::New();
+  command->SetCallbackFunction(&checkpoint, &TimeVaryingCheckpoint::Save);
+  registration->AddObserver(itk::MultiResolutionIterationEvent(), command);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+  ITK_TEST_EXPECT_TRUE(checkpoint.m_VelocityField.IsNotNull());
+
+  // resume at the checkpoint level from the velocity field
+  TimeVaryingRegistrationType::Pointer resumedRegistration =
+    MakeTimeVaryingRegistration(fixedImage, movingImage, checkpoint.m_VelocityField);
+  resumedRegistration->SetInitialLevel(checkpointLevel);
+  resumedRegistration->MetricSamplingReinitializeSeed(checkpoint.m_Seed);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(resumedRegistration->Update());
+  if (!CheckSameParameters("time-varying velocity field",
+                           registration->GetTransform()->GetParameters(),
+                           resumedRegistration->GetTransform()->GetParameters()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkImageRegistrationCheckpointTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string outputDirectory = argv[1];
+
+  int result = AffineCheckpointTest(outputDirectory + "/itkImageRegistrationCheckpointTestAffine.h5");
+  if (result == EXIT_SUCCESS)
+  {
+    result = SyNCheckpointTest(outputDirectory + "/itkImageRegistrationCheckpointTestSyN.h5");
+  }
+  if (result == EXIT_SUCCESS)
+  {
+    result = TimeVaryingCheckpointTest();
+  }
+
+  if (result == EXIT_SUCCESS)
+  {
+    std::cout << "Test finished." << std::endl;
+  }
+  return result;
+}
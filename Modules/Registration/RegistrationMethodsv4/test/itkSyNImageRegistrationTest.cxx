@@ -29,6 +29,8 @@
 #include "itkVector.h"
 #include "itkTestingMacros.h"
 
+#include <cstring>
+
 template <typename TFilter>
 class CommandIterationUpdate : public itk::Command
 {
@@ -107,13 +109,13 @@ public:
   }
 };
 
-template <unsigned int TDimension>
+template <unsigned int TDimension, typename TRealType>
 int
 PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
 {
   const unsigned int ImageDimension = TDimension;
 
-  using PixelType = double;
+  using PixelType = TRealType;
   using FixedImageType = itk::Image<PixelType, ImageDimension>;
   using MovingImageType = itk::Image<PixelType, ImageDimension>;
 
@@ -133,7 +135,7 @@ PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
   movingImage->Update();
   movingImage->DisconnectPipeline();
 
-  using AffineTransformType = itk::AffineTransform<double, ImageDimension>;
+  using AffineTransformType = itk::AffineTransform<TRealType, ImageDimension>;
   using AffineRegistrationType = itk::ImageRegistrationMethodv4<FixedImageType, MovingImageType, AffineTransformType>;
   typename AffineRegistrationType::Pointer affineSimple = AffineRegistrationType::New();
   affineSimple->SetFixedImage(fixedImage);
@@ -149,7 +151,7 @@ PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
   affineSimple->SetShrinkFactorsPerLevel(affineShrinkFactorsPerLevel);
 
   // Set the number of iterations
-  using GradientDescentOptimizerv4Type = itk::GradientDescentOptimizerv4;
+  using GradientDescentOptimizerv4Type = itk::GradientDescentOptimizerv4Template<TRealType>;
   auto * optimizer = dynamic_cast<GradientDescentOptimizerv4Type *>(affineSimple->GetModifiableOptimizer());
   ITK_TEST_EXPECT_TRUE(optimizer != nullptr);
 #ifdef NDEBUG
@@ -180,7 +182,7 @@ PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
   typename CompositeTransformType::Pointer compositeTransform = CompositeTransformType::New();
   compositeTransform->AddTransform(affineSimple->GetModifiableTransform());
 
-  using AffineResampleFilterType = itk::ResampleImageFilter<MovingImageType, FixedImageType>;
+  using AffineResampleFilterType = itk::ResampleImageFilter<MovingImageType, FixedImageType, double, TRealType>;
   typename AffineResampleFilterType::Pointer affineResampler = AffineResampleFilterType::New();
   affineResampler->SetTransform(compositeTransform);
   affineResampler->SetInput(movingImage);
@@ -217,7 +219,10 @@ PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
   inverseDisplacementField->Allocate();
   inverseDisplacementField->FillBuffer(zeroVector);
 
-  using DisplacementFieldRegistrationType = itk::SyNImageRegistrationMethod<FixedImageType, MovingImageType>;
+  using DisplacementFieldRegistrationType =
+    itk::SyNImageRegistrationMethod<FixedImageType,
+                                    MovingImageType,
+                                    itk::DisplacementFieldTransform<TRealType, ImageDimension>>;
   typename DisplacementFieldRegistrationType::Pointer displacementFieldRegistration =
     DisplacementFieldRegistrationType::New();
 
@@ -312,7 +317,8 @@ PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
     adaptors.push_back(fieldTransformAdaptor);
   }
 
-  using CorrelationMetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<FixedImageType, MovingImageType>;
+  using CorrelationMetricType =
+    itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<FixedImageType, MovingImageType, FixedImageType, TRealType>;
   typename CorrelationMetricType::Pointer    correlationMetric = CorrelationMetricType::New();
   typename CorrelationMetricType::RadiusType radius;
   radius.Fill(4);
@@ -386,7 +392,7 @@ PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
 
   compositeTransform->AddTransform(outputTransform);
 
-  using ResampleFilterType = itk::ResampleImageFilter<MovingImageType, FixedImageType>;
+  using ResampleFilterType = itk::ResampleImageFilter<MovingImageType, FixedImageType, double, TRealType>;
   typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
   resampler->SetTransform(compositeTransform);
   resampler->SetInput(movingImage);
@@ -405,7 +411,7 @@ PerformDisplacementFieldImageRegistration(int itkNotUsed(argc), char * argv[])
   writer->SetInput(resampler->GetOutput());
   writer->Update();
 
-  using InverseResampleFilterType = itk::ResampleImageFilter<FixedImageType, MovingImageType>;
+  using InverseResampleFilterType = itk::ResampleImageFilter<FixedImageType, MovingImageType, double, TRealType>;
   typename InverseResampleFilterType::Pointer inverseResampler = ResampleFilterType::New();
   inverseResampler->SetTransform(compositeTransform->GetInverseTransform());
   inverseResampler->SetInput(fixedImage);
@@ -442,18 +448,27 @@ itkSyNImageRegistrationTest(int argc, char * argv[])
   {
     std::cout << itkNameOfTestExecutableMacro(argv)
               << " imageDimension fixedImage movingImage outputPrefix numberOfDeformableIterations learningRate"
-              << std::endl;
+              << " [realType]" << std::endl;
     exit(1);
   }
 
+  // The registration computes in single precision end to end when realType is "float".
+  const bool useFloat = argc > 7 && strcmp(argv[7], "float") == 0;
+
   switch (std::stoi(argv[1]))
   {
     case 2:
-      PerformDisplacementFieldImageRegistration<2>(argc, argv);
-      break;
+      if (useFloat)
+      {
+        return PerformDisplacementFieldImageRegistration<2, float>(argc, argv);
+      }
+      return PerformDisplacementFieldImageRegistration<2, double>(argc, argv);
     case 3:
-      PerformDisplacementFieldImageRegistration<3>(argc, argv);
-      break;
+      if (useFloat)
+      {
+        return PerformDisplacementFieldImageRegistration<3, float>(argc, argv);
+      }
+      return PerformDisplacementFieldImageRegistration<3, double>(argc, argv);
     default:
       std::cerr << "Unsupported dimension" << std::endl;
       exit(EXIT_FAILURE);